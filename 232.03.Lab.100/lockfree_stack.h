@@ -0,0 +1,302 @@
+/***********************************************************************
+ * Module:
+ *    Lock-Free Stack
+ * Summary:
+ *    A concurrent stack that many threads can push onto and pop from
+ *    without a mutex (a Treiber stack)
+ *
+ *    This will contain the class definition of:
+ *       lockfree_stack    : thread-safe First-in-Last-out container
+ *
+ *    The head of the stack is a tagged pointer: the node address lives in
+ *    the low bits of a 64-bit word and a modification counter lives in the
+ *    high bits. Every successful compare-and-swap bumps the counter, so a
+ *    node that is popped and pushed back between our read and our CAS
+ *    (the ABA problem) will not fool us.
+ *
+ *    Nodes are never handed back to the heap while the stack is alive.
+ *    Popped nodes go to an internal free list (itself a tagged Treiber
+ *    stack) and are recycled by later pushes, so a thread that is still
+ *    reading pNext from a node another thread just popped is reading
+ *    valid memory.
+ * Author
+ *    David Schaad, Tori Tremelling
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>  // because I am paranoid
+#include <atomic>   // for std::atomic
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint64_t and uintptr_t
+#include <new>      // for placement new
+#include <utility>  // for std::move
+
+class TestLockFreeStack; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * LOCK-FREE STACK
+ * First-in-Last-out data structure, safe to share
+ * between threads
+ *************************************************/
+template<class T>
+class lockfree_stack
+{
+   friend class ::TestLockFreeStack; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   lockfree_stack() : head(0), freeList(0), numElements(0) { }
+   lockfree_stack(const lockfree_stack <T> & rhs) = delete;
+   lockfree_stack <T> & operator = (const lockfree_stack <T> & rhs) = delete;
+   ~lockfree_stack();
+
+   //
+   // Insert
+   //
+
+   void push(const T& t)  { pushChain(allocate(t), nullptr); }
+   void push(T&& t)       { pushChain(allocate(std::move(t)), nullptr); }
+   template <class Iterator>
+   void push(Iterator first, Iterator last);
+
+   //
+   // Remove
+   //
+
+   bool pop(T& t);
+   bool pop();
+
+   //
+   // Status
+   //
+   size_t size () const { return numElements.load(std::memory_order_relaxed); }
+   bool empty   () const { return ptrOf(head.load(std::memory_order_acquire)) == nullptr; }
+
+private:
+
+   struct Node
+   {
+      alignas(T) unsigned char storage[sizeof(T)]; // the user data, built in place
+      std::atomic<Node*> pNext;                    // next node down the stack
+
+      T& data() { return *reinterpret_cast<T*>(storage); }
+   };
+
+   // where the tag starts within a tagged pointer
+   static constexpr int TAG_SHIFT = (sizeof(void*) == 8 ? 48 : 32);
+   static constexpr uint64_t PTR_MASK = ((uint64_t)1 << TAG_SHIFT) - 1;
+
+   static Node* ptrOf(uint64_t tagged) { return reinterpret_cast<Node*>((uintptr_t)(tagged & PTR_MASK)); }
+   static uint64_t tagOf(uint64_t tagged) { return tagged >> TAG_SHIFT; }
+   static uint64_t pack(Node* p, uint64_t tag)
+   {
+      assert(((uint64_t)reinterpret_cast<uintptr_t>(p) & ~PTR_MASK) == 0);
+      return (uint64_t)reinterpret_cast<uintptr_t>(p) | (tag << TAG_SHIFT);
+   }
+
+   // push or pop a chain of nodes on a tagged head
+   static void pushNodes(std::atomic<uint64_t>& top, Node* pFirst, Node* pLast);
+   static Node* popNode(std::atomic<uint64_t>& top);
+
+   template <class U>
+   Node* allocate(U&& u);
+   void pushChain(Node* pFirst, Node* pLast);
+
+   std::atomic<uint64_t> head;        // tagged pointer to the top of the stack
+   std::atomic<uint64_t> freeList;    // tagged pointer to the recycled nodes
+   std::atomic<size_t>   numElements; // number of elements on the stack
+};
+
+/*****************************************************
+ * LOCK-FREE STACK :: DESTRUCTOR
+ * Only one thread may be using the stack now, so we can
+ * walk both chains and hand the nodes back to the heap
+ ****************************************************/
+template <class T>
+lockfree_stack <T> :: ~lockfree_stack()
+{
+   for (Node* p = ptrOf(head.load()); p; )
+   {
+      Node* pDelete = p;
+      p = p->pNext.load(std::memory_order_relaxed);
+      pDelete->data().~T();
+      delete pDelete;
+   }
+
+   for (Node* p = ptrOf(freeList.load()); p; )
+   {
+      Node* pDelete = p;
+      p = p->pNext.load(std::memory_order_relaxed);
+      delete pDelete;
+   }
+}
+
+/*****************************************************
+ * LOCK-FREE STACK :: PUSH NODES
+ * Attach the chain pFirst ... pLast on top of a tagged
+ * head with a single compare-and-swap
+ ****************************************************/
+template <class T>
+void lockfree_stack <T> ::pushNodes(std::atomic<uint64_t>& top, Node* pFirst, Node* pLast)
+{
+   uint64_t oldTop = top.load(std::memory_order_relaxed);
+   do
+   {
+      pLast->pNext.store(ptrOf(oldTop), std::memory_order_relaxed);
+   }
+   while (!top.compare_exchange_weak(oldTop, pack(pFirst, tagOf(oldTop) + 1),
+                                     std::memory_order_release,
+                                     std::memory_order_relaxed));
+}
+
+/*****************************************************
+ * LOCK-FREE STACK :: POP NODE
+ * Detach the top node of a tagged head, or return
+ * nullptr if there is nothing there
+ ****************************************************/
+template <class T>
+typename lockfree_stack <T> ::Node* lockfree_stack <T> ::popNode(std::atomic<uint64_t>& top)
+{
+   uint64_t oldTop = top.load(std::memory_order_acquire);
+   Node* pTop;
+   do
+   {
+      pTop = ptrOf(oldTop);
+      if (!pTop)
+         return nullptr;
+
+      // pTop may be popped and recycled by another thread right now. That is
+      // fine: the node is never freed, and the tag makes our CAS fail.
+   }
+   while (!top.compare_exchange_weak(oldTop,
+                                     pack(pTop->pNext.load(std::memory_order_relaxed), tagOf(oldTop) + 1),
+                                     std::memory_order_acquire,
+                                     std::memory_order_acquire));
+   return pTop;
+}
+
+/*****************************************************
+ * LOCK-FREE STACK :: ALLOCATE
+ * Grab a recycled node if there is one, otherwise go
+ * to the heap, and build the user data in it
+ ****************************************************/
+template <class T>
+template <class U>
+typename lockfree_stack <T> ::Node* lockfree_stack <T> ::allocate(U&& u)
+{
+   Node* pNode = popNode(freeList);
+   if (!pNode)
+      pNode = new Node;
+
+   try
+   {
+      new (pNode->storage) T(std::forward<U>(u));
+   }
+   catch (...)
+   {
+      pushNodes(freeList, pNode, pNode);
+      throw;
+   }
+   return pNode;
+}
+
+/*****************************************************
+ * LOCK-FREE STACK :: PUSH CHAIN
+ * Publish a chain of nodes already holding user data
+ ****************************************************/
+template <class T>
+void lockfree_stack <T> ::pushChain(Node* pFirst, Node* pLast)
+{
+   size_t num = 1;
+   if (!pLast)
+      pLast = pFirst;
+   else
+      for (Node* p = pFirst; p != pLast; p = p->pNext.load(std::memory_order_relaxed))
+         num++;
+
+   // count first so a racing pop never sees the size go below zero
+   numElements.fetch_add(num, std::memory_order_relaxed);
+   pushNodes(head, pFirst, pLast);
+}
+
+/*****************************************************
+ * LOCK-FREE STACK :: PUSH RANGE
+ * Push an entire range with one compare-and-swap. The
+ * last item in the range ends up on top, just as if
+ * each had been pushed in turn
+ ****************************************************/
+template <class T>
+template <class Iterator>
+void lockfree_stack <T> ::push(Iterator first, Iterator last)
+{
+   if (first == last)
+      return;
+
+   // build the chain privately: nobody else can see it yet
+   Node* pBottom = allocate(*first);
+   Node* pTop = pBottom;
+   try
+   {
+      for (++first; first != last; ++first)
+      {
+         Node* pNew = allocate(*first);
+         pNew->pNext.store(pTop, std::memory_order_relaxed);
+         pTop = pNew;
+      }
+   }
+   catch (...)
+   {
+      for (Node* p = pTop; p; p = (p == pBottom ? nullptr : p->pNext.load(std::memory_order_relaxed)))
+         p->data().~T();
+      pushNodes(freeList, pTop, pBottom);
+      throw;
+   }
+
+   pushChain(pTop, pBottom);
+}
+
+/*****************************************************
+ * LOCK-FREE STACK :: POP
+ * Remove the top element, handing it to the caller.
+ * Returns false if the stack was empty
+ ****************************************************/
+template <class T>
+bool lockfree_stack <T> ::pop(T& t)
+{
+   Node* pNode = popNode(head);
+   if (!pNode)
+      return false;
+   numElements.fetch_sub(1, std::memory_order_relaxed);
+
+   t = std::move(pNode->data());
+   pNode->data().~T();
+   pushNodes(freeList, pNode, pNode);
+   return true;
+}
+
+/*****************************************************
+ * LOCK-FREE STACK :: POP
+ * Discard the top element.
+ * Returns false if the stack was empty
+ ****************************************************/
+template <class T>
+bool lockfree_stack <T> ::pop()
+{
+   Node* pNode = popNode(head);
+   if (!pNode)
+      return false;
+   numElements.fetch_sub(1, std::memory_order_relaxed);
+
+   pNode->data().~T();
+   pushNodes(freeList, pNode, pNode);
+   return true;
+}
+
+} // custom namespace
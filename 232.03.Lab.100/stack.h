@@ -22,6 +22,7 @@
 #pragma once
 
 #include <cassert>  // because I am paranoid
+#include <cstddef>  // for size_t
 //#include "vector.h"
 #include <vector>
 
@@ -0,0 +1,291 @@
+/***********************************************************************
+ * Header:
+ *    TEST LOCK-FREE STACK
+ * Summary:
+ *    Unit tests for lockfree_stack
+ * Author
+ *    David Schaad, Tori Tremelling
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "lockfree_stack.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <thread>
+#include <vector>
+
+class TestLockFreeStack : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_destructor_standard();
+
+      // Insert
+      test_pushCopy_empty();
+      test_pushMove_empty();
+      test_pushRange_empty();
+      test_pushRange_standard();
+
+      // Remove
+      test_pop_empty();
+      test_pop_standard();
+      test_pop_recycle();
+
+      // Threads
+      test_threads_pushPop();
+
+      report("LockFreeStack");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, no allocations
+   void test_construct_default()
+   {  // setup
+      Spy::reset();
+      // exercise
+      custom::lockfree_stack<Spy> s;
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(s.empty());
+      assertUnit(s.size() == 0);
+      assertUnit(s.freeList == 0);
+   }
+
+   // destructor of a 4-element collection
+   void test_destructor_standard()
+   {  // setup
+      {
+         custom::lockfree_stack<Spy> s;
+         setupStandardFixture(s);
+         Spy::reset();
+      } // exercise
+      // verify
+      assertUnit(Spy::numDestructor() == 4); // destructor for [26,49,67,89]
+      assertUnit(Spy::numDelete() == 4);     // delete [26,49,67,89]
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+   }
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // push a copy onto an empty stack
+   void test_pushCopy_empty()
+   {  // setup
+      custom::lockfree_stack<Spy> s;
+      Spy s26(26);
+      Spy::reset();
+      // exercise
+      s.push(s26);
+      // verify
+      assertUnit(Spy::numCopy() == 1);      // copy-create [26]
+      assertUnit(Spy::numAlloc() == 1);     // allocate [26]
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(s.size() == 1);
+      assertUnit(!s.empty());
+      assertUnit(s.ptrOf(s.head)->data() == Spy(26));
+   }  // teardown
+
+   // move a value onto an empty stack
+   void test_pushMove_empty()
+   {  // setup
+      custom::lockfree_stack<Spy> s;
+      Spy s26(26);
+      Spy::reset();
+      // exercise
+      s.push(std::move(s26));
+      // verify
+      assertUnit(Spy::numCopyMove() == 1);  // move-create [26]
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(s26.empty());
+      assertUnit(s.size() == 1);
+      assertUnit(s.ptrOf(s.head)->data() == Spy(26));
+   }  // teardown
+
+   // push an empty range, nothing happens
+   void test_pushRange_empty()
+   {  // setup
+      custom::lockfree_stack<Spy> s;
+      std::vector<Spy> v;
+      Spy::reset();
+      // exercise
+      s.push(v.begin(), v.end());
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(s.empty());
+      assertUnit(s.size() == 0);
+      assertUnit(s.tagOf(s.head) == 0);     // never touched the head
+   }  // teardown
+
+   // push four elements in one batch
+   void test_pushRange_standard()
+   {  // setup
+      custom::lockfree_stack<Spy> s;
+      std::vector<Spy> v { Spy(26), Spy(49), Spy(67), Spy(89) };
+      Spy::reset();
+      // exercise
+      s.push(v.begin(), v.end());
+      // verify
+      assertUnit(Spy::numCopy() == 4);      // copy-create [26,49,67,89]
+      assertUnit(Spy::numAlloc() == 4);     // allocate [26,49,67,89]
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(s.tagOf(s.head) == 1);     // one compare-and-swap
+      assertStandardFixture(s);
+   }  // teardown
+
+   /***************************************
+    * POP
+    ***************************************/
+
+   // pop from an empty stack
+   void test_pop_empty()
+   {  // setup
+      custom::lockfree_stack<Spy> s;
+      Spy value;
+      Spy::reset();
+      // exercise
+      bool popped = s.pop(value);
+      // verify
+      assertUnit(!popped);
+      assertUnit(!s.pop());
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(value.empty());
+      assertUnit(s.empty());
+   }  // teardown
+
+   // pop the top off the standard fixture
+   void test_pop_standard()
+   {  // setup
+      custom::lockfree_stack<Spy> s;
+      setupStandardFixture(s);
+      Spy value;
+      Spy::reset();
+      // exercise
+      bool popped = s.pop(value);
+      // verify
+      assertUnit(popped);
+      assertUnit(Spy::numAssignMove() == 1);  // move [89] out
+      assertUnit(Spy::numDestructor() == 1);  // the moved-from [89]
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(value == Spy(89));
+      assertUnit(s.size() == 3);
+      assertUnit(s.ptrOf(s.head)->data() == Spy(67));
+      assertUnit(s.ptrOf(s.freeList) != nullptr);
+   }  // teardown
+
+   // popped nodes are reused by the next push
+   void test_pop_recycle()
+   {  // setup
+      custom::lockfree_stack<int> s;
+      s.push(26);
+      s.push(49);
+      auto pTop = s.ptrOf(s.head);
+      s.pop();
+      // exercise
+      s.push(67);
+      // verify
+      assertUnit(s.ptrOf(s.head) == pTop);
+      assertUnit(s.ptrOf(s.freeList) == nullptr);
+      assertUnit(s.size() == 2);
+      int value = 0;
+      assertUnit(s.pop(value) && value == 67);
+      assertUnit(s.pop(value) && value == 26);
+      assertUnit(!s.pop(value));
+   }  // teardown
+
+   /***************************************
+    * THREADS
+    ***************************************/
+
+   // several threads pushing and popping at once lose nothing
+   void test_threads_pushPop()
+   {  // setup
+      custom::lockfree_stack<int> s;
+      const int numThreads = 4;
+      const int numPerThread = 20000;
+      std::vector<long long> sums(numThreads, 0);
+      std::vector<std::thread> threads;
+      // exercise
+      for (int id = 0; id < numThreads; id++)
+         threads.push_back(std::thread([&s, &sums, id]()
+         {
+            for (int i = 1; i <= numPerThread; i++)
+            {
+               s.push(i);
+               int value;
+               if (i % 2 == 0 && s.pop(value))
+                  sums[id] += value;
+            }
+         }));
+      for (auto& thread : threads)
+         thread.join();
+      // verify
+      long long sum = 0;
+      for (auto value : sums)
+         sum += value;
+      int value;
+      while (s.pop(value))
+         sum += value;
+      long long expected = (long long)numThreads * numPerThread * (numPerThread + 1) / 2;
+      assertUnit(sum == expected);
+      assertUnit(s.empty());
+      assertUnit(s.size() == 0);
+   }  // teardown
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *      [ 26, 49, 67, 89 ]  (89 on top)
+    *************************************************************/
+   void setupStandardFixture(custom::lockfree_stack<Spy>& s)
+   {
+      s.push(Spy(26));
+      s.push(Spy(49));
+      s.push(Spy(67));
+      s.push(Spy(89));
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *      [ 26, 49, 67, 89 ]  (89 on top)
+    *************************************************************/
+   void assertStandardFixtureParameters(const custom::lockfree_stack<Spy>& s, int line, const char* function)
+   {
+      assertIndirect(s.size() == 4);
+      assertIndirect(!s.empty());
+      auto p = s.ptrOf(s.head);
+      for (int value : { 89, 67, 49, 26 })
+      {
+         assertIndirect(p != nullptr);
+         if (!p)
+            return;
+         assertIndirect(p->data() == Spy(value));
+         p = p->pNext;
+      }
+      assertIndirect(p == nullptr);
+   }
+};
+
+#endif // DEBUG
@@ -13,6 +13,7 @@
  //#undef DEBUG  // Remove this comment to disable unit tests
 
 #include "testStack.h"       // for the stack unit tests
+#include "testLockFreeStack.h" // for the lock-free stack unit tests
 #include "testSpy.h"         // for the spy unit tests
 int Spy::counters[] = {};
 
@@ -26,6 +27,7 @@ int main()
    // unit tests
    TestSpy().run();
    TestStack().run();
+   TestLockFreeStack().run();
 #endif // DEBUG
   
    return 0;
@@ -23,6 +23,11 @@
 
 #include <cassert>     // for ASSERT
 #include <iostream>    // for NULL
+#include <memory>      // for std::allocator
+#include <new>         // for placement new
+#include <type_traits> // for std::is_trivially_destructible
+
+class TestNode; // forward declaration for unit tests
 
  /*************************************************
   * NODE
@@ -57,6 +62,123 @@ public:
    Node <T>* pPrev;       // pointer to previous node
 };
 
+/*************************************************
+ * NODE POOL
+ * Hands out nodes carved from large slabs instead of
+ * calling new and delete for every node. Freed nodes
+ * are kept on an intrusive free list and reused.
+ *
+ * The free list is a list of chains: within a chain the
+ * nodes are linked through pNext, and the first node of
+ * each chain uses pPrev to point to the next chain. That
+ * lets clear() give back a whole list in O(1) when T
+ * has nothing to destroy.
+ *
+ * Nodes still in use when the pool goes away are not
+ * destroyed, their memory is simply handed back.
+ *************************************************/
+template <class T>
+class NodePool
+{
+   friend class ::TestNode; // give unit tests access to the privates
+public:
+   NodePool(size_t numPerSlab = 256) : numPerSlab(numPerSlab ? numPerSlab : 1),
+      pSlabs(nullptr), pBump(nullptr), numBump(0), pFree(nullptr) {}
+   NodePool(const NodePool& rhs) = delete;
+   NodePool& operator = (const NodePool& rhs) = delete;
+   ~NodePool()
+   {
+      while (pSlabs)
+      {
+         Slab* pDelete = pSlabs;
+         pSlabs = pSlabs->pNext;
+         ::operator delete(pDelete);
+      }
+   }
+
+   // build a new node holding t
+   template <class U>
+   Node <T>* create(U&& t)
+   {
+      Node <T>* pNode = take();
+      try
+      {
+         return new (pNode) Node <T>(std::forward<U>(t));
+      }
+      catch (...)
+      {
+         pNode->pNext = nullptr;
+         pNode->pPrev = pFree;
+         pFree = pNode;
+         throw;
+      }
+   }
+
+   // give back a single node
+   void destroy(Node <T>* pNode)
+   {
+      pNode->data.~T();
+      pNode->pNext = nullptr;
+      pNode->pPrev = pFree;
+      pFree = pNode;
+   }
+
+   // give back every node from pHead to the end of the list
+   void destroyChain(Node <T>* pHead)
+   {
+      if (!pHead)
+         return;
+
+      if (!std::is_trivially_destructible<T>::value)
+         for (Node <T>* p = pHead; p; p = p->pNext)
+            p->data.~T();
+
+      pHead->pPrev = pFree;
+      pFree = pHead;
+   }
+
+private:
+   // each slab starts with this header, followed by the nodes
+   struct alignas(Node <T>) Slab
+   {
+      Slab* pNext;
+   };
+
+   // find storage for one node: the free list first, then the slab
+   Node <T>* take()
+   {
+      if (pFree)
+      {
+         Node <T>* pNode = pFree;
+         if (pNode->pNext)
+         {
+            pNode->pNext->pPrev = pNode->pPrev;
+            pFree = pNode->pNext;
+         }
+         else
+            pFree = pNode->pPrev;
+         return pNode;
+      }
+
+      if (!numBump)
+      {
+         Slab* pSlab = static_cast<Slab*>(::operator new(sizeof(Slab) + numPerSlab * sizeof(Node <T>)));
+         pSlab->pNext = pSlabs;
+         pSlabs = pSlab;
+         pBump = reinterpret_cast<Node <T>*>(pSlab + 1);
+         numBump = numPerSlab;
+      }
+      numBump--;
+      return pBump++;
+   }
+
+   size_t numPerSlab;      // number of nodes carved from each slab
+   Slab* pSlabs;           // every slab we own
+   Node <T>* pBump;        // next untouched node in the newest slab
+   size_t numBump;         // number of untouched nodes left in it
+   Node <T>* pFree;        // first chain of recycled nodes
+};
+
 /***********************************************
  * COPY
  * Copy the list from the pSource and return
@@ -82,6 +204,29 @@ inline Node <T>* copy(const Node <T>* pSource)
    return pDestination;
 }
 
+/***********************************************
+ * COPY
+ * Copy the list from the pSource, taking the new
+ * nodes from a pool
+ *   INPUT  : the list to be copied
+ *            the pool to draw nodes from
+ *   OUTPUT : return the new list
+ *   COST   : O(n)
+ **********************************************/
+template <class T>
+inline Node <T>* copy(const Node <T>* pSource, NodePool <T>& pool)
+{
+   if (!pSource)
+      return nullptr;
+
+   Node <T>* pDestination = pool.create(pSource->data);
+
+   Node <T>* pDes = pDestination;
+   for (auto p = pSource->pNext; p; p = p->pNext)
+      pDes = insert(pDes, p->data, true, pool);
+   return pDestination;
+}
+
 /***********************************************
  * Assign
  * Copy the values from pSource into pDestination
@@ -128,6 +273,128 @@ inline void assign(Node <T>*& pDestination, const Node <T>* pSource)
    }
 }
 
+/***********************************************
+ * Assign
+ * Copy the values from pSource into pDestination
+ * reusing the nodes already created in pDestination.
+ * Extra nodes come from and go back to the pool.
+ *   INPUT  : the list to be copied
+ *            the pool to draw nodes from
+ *   OUTPUT : return the new list
+ *   COST   : O(n)
+ **********************************************/
+template <class T>
+inline void assign(Node <T>*& pDestination, const Node <T>* pSource, NodePool <T>& pool)
+{
+   const Node<T>* pSrc = pSource;
+   Node<T>* pDes = pDestination;
+   Node<T>* pLast = nullptr;
+
+   while (pSrc && pDes)
+   {
+      pDes->data = pSrc->data;
+      pLast = pDes;
+      pDes = pDes->pNext;
+      pSrc = pSrc->pNext;
+   }
+
+   // Source list is longer
+   while (pSrc)
+   {
+      if (pLast)
+         pLast = insert(pLast, pSrc->data, true, pool);
+      else
+         pDestination = pLast = pool.create(pSrc->data);
+
+      pSrc = pSrc->pNext;
+   }
+
+   // Destination list is longer
+   if (pDes)
+   {
+      if (pLast)
+         pLast->pNext = nullptr;
+      else
+         pDestination = nullptr;
+
+      clear(pDes, pool);
+   }
+}
+
+/***********************************************
+ * Assign
+ * Copy the values from pSource into pDestination
+ * reusing the nodes already created in pDestination.
+ * Extra nodes are parked in pCache rather than deleted,
+ * and missing nodes come from pCache before the heap,
+ * so repeated snapshots and restores stop allocating
+ * once the cache is warm. The cached nodes still hold
+ * their old values and are reused by assignment.
+ * Free the cache with clear() when done.
+ *   INPUT  : the list to be copied
+ *            the cache of spare nodes
+ *   OUTPUT : return the new list
+ *   COST   : O(n)
+ **********************************************/
+template <class T>
+inline void assign(Node <T>*& pDestination, const Node <T>* pSource, Node <T>*& pCache)
+{
+   const Node<T>* pSrc = pSource;
+   Node<T>* pDes = pDestination;
+   Node<T>* pLast = nullptr;
+
+   while (pSrc && pDes)
+   {
+      pDes->data = pSrc->data;
+      pLast = pDes;
+      pDes = pDes->pNext;
+      pSrc = pSrc->pNext;
+   }
+
+   // Source list is longer: draw on the cache first
+   while (pSrc)
+   {
+      Node<T>* pNew;
+      if (pCache)
+      {
+         pNew = pCache;
+         pCache = pCache->pNext;
+         if (pCache)
+            pCache->pPrev = nullptr;
+         pNew->data = pSrc->data;
+         pNew->pNext = pNew->pPrev = nullptr;
+      }
+      else
+         pNew = new Node<T>(pSrc->data);
+
+      if (pLast)
+         pLast = link(pLast, pNew, true);
+      else
+         pDestination = pLast = pNew;
+
+      pSrc = pSrc->pNext;
+   }
+
+   // Destination list is longer: park the rest in the cache
+   if (pDes)
+   {
+      if (pLast)
+         pLast->pNext = nullptr;
+      else
+         pDestination = nullptr;
+
+      Node<T>* pTail = pDes;
+      while (pTail->pNext)
+         pTail = pTail->pNext;
+
+      pTail->pNext = pCache;
+      if (pCache)
+         pCache->pPrev = pTail;
+      pDes->pPrev = nullptr;
+      pCache = pDes;
+   }
+}
+
 /***********************************************
  * SWAP
  * Swap the list from LHS to RHS
@@ -141,20 +408,16 @@ inline void swap(Node <T>*& pLHS, Node <T>*& pRHS)
 }
 
 /***********************************************
- * REMOVE
- * Remove the node pSource in the linked list
- *   INPUT  : the node to be removed
+ * UNLINK
+ * Take the node pRemove out of the linked list
+ * without freeing it
+ *   INPUT  : the node to be unlinked
  *   OUTPUT : the pointer to the parent node
  *   COST   : O(1)
  **********************************************/
 template <class T>
-inline Node <T>* remove(const Node <T>* pRemove)
+inline Node <T>* unlink(const Node <T>* pRemove)
 {
-   if (!pRemove)
-      return nullptr;
-
-   Node <T>* pReturn;
-
    // If there is a node before pRemove, set their pNext to pRemove's pNext
    if (pRemove->pPrev)
       pRemove->pPrev->pNext = pRemove->pNext;
@@ -166,33 +429,68 @@ inline Node <T>* remove(const Node <T>* pRemove)
    // If there is a node before pRemove, return a node pointing to that node. 
    // Otherwise, return a node pointing to the node following pRemove
    if (pRemove->pPrev)
-      pReturn = pRemove->pPrev;
+      return pRemove->pPrev;
    else
-      pReturn = pRemove->pNext;
+      return pRemove->pNext;
+}
+
+/***********************************************
+ * REMOVE
+ * Remove the node pSource in the linked list
+ *   INPUT  : the node to be removed
+ *   OUTPUT : the pointer to the parent node
+ *   COST   : O(1)
+ **********************************************/
+template <class T>
+inline Node <T>* remove(const Node <T>* pRemove)
+{
+   if (!pRemove)
+      return nullptr;
+
+   Node <T>* pReturn = unlink(pRemove);
 
    delete pRemove;
    return pReturn;
 }
 
+/***********************************************
+ * REMOVE
+ * Remove the node pSource in the linked list,
+ * giving it back to the pool
+ *   INPUT  : the node to be removed
+ *            the pool it came from
+ *   OUTPUT : the pointer to the parent node
+ *   COST   : O(1)
+ **********************************************/
+template <class T>
+inline Node <T>* remove(const Node <T>* pRemove, NodePool <T>& pool)
+{
+   if (!pRemove)
+      return nullptr;
+
+   Node <T>* pReturn = unlink(pRemove);
+
+   pool.destroy(const_cast<Node <T>*>(pRemove));
+   return pReturn;
+}
+
 
 /**********************************************
- * INSERT
- * Insert a new node the the value in "t" into a linked
- * list immediately before the current position.
- *   INPUT   : t - the value to be used for the new node
- *             pCurrent - a pointer to the node before which
- *                we will be inserting the new node
- *             after - whether we will be inserting after
- *   OUTPUT  : return the newly inserted item
+ * LINK
+ * Link an existing node pNew into a linked list
+ * immediately before (or after) the current position.
+ *   INPUT   : pCurrent - a pointer to the node before which
+ *                we will be linking the new node
+ *             pNew - the node to be linked
+ *             after - whether we will be linking after
+ *   OUTPUT  : return the newly linked item
  *   COST    : O(1)
  **********************************************/
 template <class T>
-inline Node <T>* insert(Node <T>* pCurrent,
-   const T& t,
+inline Node <T>* link(Node <T>* pCurrent,
+   Node <T>* pNew,
    bool after = false)
 {
-   Node<T>* pNew = new Node<T>(t);
-
    // Inserting before pCurrent
    if ((pCurrent) && (!after))
    {
@@ -226,6 +524,46 @@ inline Node <T>* insert(Node <T>* pCurrent,
    return pNew;
 }
 
+/**********************************************
+ * INSERT
+ * Insert a new node the the value in "t" into a linked
+ * list immediately before the current position.
+ *   INPUT   : t - the value to be used for the new node
+ *             pCurrent - a pointer to the node before which
+ *                we will be inserting the new node
+ *             after - whether we will be inserting after
+ *   OUTPUT  : return the newly inserted item
+ *   COST    : O(1)
+ **********************************************/
+template <class T>
+inline Node <T>* insert(Node <T>* pCurrent,
+   const T& t,
+   bool after = false)
+{
+   return link(pCurrent, new Node<T>(t), after);
+}
+
+/**********************************************
+ * INSERT
+ * Insert a new node taken from the pool into a linked
+ * list immediately before (or after) the current position.
+ *   INPUT   : t - the value to be used for the new node
+ *             pCurrent - a pointer to the node before which
+ *                we will be inserting the new node
+ *             after - whether we will be inserting after
+ *             pool - where the new node comes from
+ *   OUTPUT  : return the newly inserted item
+ *   COST    : O(1)
+ **********************************************/
+template <class T>
+inline Node <T>* insert(Node <T>* pCurrent,
+   const T& t,
+   bool after,
+   NodePool <T>& pool)
+{
+   return link(pCurrent, pool.create(t), after);
+}
+
 /******************************************************
  * SIZE
  * Find the size an unsorted linked list.
@@ -276,3 +614,19 @@ inline void clear(Node <T>*& pHead)
       delete pDelete;
    }
 }
+
+/*****************************************************
+ * FREE DATA
+ * Give all the nodes in the linked list back to the pool
+ *   INPUT   : pointer to the head of the linked list
+ *             the pool the nodes came from
+ *   OUTPUT  : pHead set to NULL
+ *   COST    : O(1) if T has a trivial destructor, O(n) otherwise
+ ****************************************************/
+template <class T>
+inline void clear(Node <T>*& pHead, NodePool <T>& pool)
+{
+   pool.destroyChain(pHead);
+   pHead = nullptr;
+}
+
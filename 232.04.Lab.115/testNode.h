@@ -17,6 +17,8 @@
 #include <cassert>
 #include <memory>
 
+#define assertLongFixture(p, num)  assertLongFixtureParameters(p, num, __LINE__, __FUNCTION__)
+
 class TestNode : public UnitTest
 {
 public:
@@ -31,6 +33,7 @@ public:
       test_copy_nullptr();
       test_copy_one();
       test_copy_standard();
+      test_copy_long();
       
       // Assign
       test_assign_emptyToEmpty();
@@ -38,6 +41,10 @@ public:
       test_assign_emptyToStandard();
       test_assign_smallToBig();
       test_assign_bigToSmall();
+      test_assign_long();
+      test_assign_cacheBigToSmall();
+      test_assign_cacheSmallToBig();
+      test_assign_cacheSteadyState();
       test_swap_emptyEmpty();
       test_swap_emptyStandard();
       test_swap_standardEmpty();
@@ -66,6 +73,15 @@ public:
       test_size_empty();
       test_size_standard();
       test_size_standardMiddle();
+
+      // Pool
+      test_pool_create();
+      test_pool_copyStandard();
+      test_pool_clearStandard();
+      test_pool_clearTrivial();
+      test_pool_removeMiddle();
+      test_pool_assignBigToSmall();
+      test_pool_slabs();
       
       report("Node");
    }
@@ -260,6 +276,23 @@ public:
       teardownStandardFixture(pDes);
    }
 
+   // copy a million-node chain: nothing may recurse once per node
+   void test_copy_long()
+   {  // setup
+      Node <int>* pSrc = setupLongFixture(1000000);
+      // exercise
+      Node <int>* pDes = copy(pSrc);
+      // verify
+      assertUnit(pDes != pSrc);
+      assertUnit(size(pDes) == 1000000);
+      assertLongFixture(pDes, 1000000);
+      // teardown
+      clear(pSrc);
+      clear(pDes);
+      assertUnit(pSrc == nullptr);
+      assertUnit(pDes == nullptr);
+   }
+
    /***************************************
     * ASSIGN
     ***************************************/
@@ -483,6 +516,125 @@ public:
       teardownStandardFixture(p67);
    }
 
+   // assign a million-node chain onto a half-million-node chain
+   void test_assign_long()
+   {  // setup
+      Node <int>* pSrc = setupLongFixture(1000000);
+      Node <int>* pDes = setupLongFixture(500000);
+      // exercise
+      assign(pDes, pSrc);
+      // verify
+      assertUnit(size(pDes) == 1000000);
+      assertLongFixture(pDes, 1000000);
+      // exercise
+      clear(pSrc);
+      pSrc = setupLongFixture(10);
+      assign(pDes, pSrc);
+      // verify
+      assertUnit(size(pDes) == 10);
+      assertLongFixture(pDes, 10);
+      // teardown
+      clear(pSrc);
+      clear(pDes);
+   }
+
+   // assign one node onto the standard fixture, the extras go to the cache
+   void test_assign_cacheBigToSmall()
+   {  // setup
+      //     pDes
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      Node <Spy>* p11, * p26, * p31;
+      setupStandardFixture(p11, p26, p31);
+      Node <Spy>* pDes = p11;
+      Node <Spy>* pSrc = new Node <Spy>(Spy(99));
+      Node <Spy>* pCache = nullptr;
+      Spy::reset();
+      // exercise
+      assign(pDes, pSrc, pCache);
+      // verify
+      assertUnit(Spy::numAssign() == 1);      // [99] onto [11]
+      assertUnit(Spy::numDestructor() == 0);  // nothing destroyed
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      //     pDes          pCache
+      //    +----+        +----+   +----+
+      //    | 99 |        | 26 | - | 31 |
+      //    +----+        +----+   +----+
+      assertUnit(pDes == p11);
+      assertUnit(pDes->pNext == nullptr);
+      assertUnit(pCache == p26);
+      assertUnit(p26->pPrev == nullptr);
+      assertUnit(p26->pNext == p31);
+      assertUnit(p31->pPrev == p26);
+      assertUnit(p31->pNext == nullptr);
+      // teardown
+      clear(pDes);
+      clear(pSrc);
+      clear(pCache);
+   }
+
+   // assign the standard fixture onto one node, the cache supplies the rest
+   void test_assign_cacheSmallToBig()
+   {  // setup
+      Node <Spy>* p11, * p26, * p31;
+      setupStandardFixture(p11, p26, p31);
+      Node <Spy>* pDes = new Node <Spy>(Spy(99));
+      Node <Spy>* pCache = new Node <Spy>(Spy(88));
+      Node <Spy>* pCached = pCache;
+      Spy::reset();
+      // exercise
+      assign(pDes, p11, pCache);
+      // verify
+      assertUnit(Spy::numAssign() == 2);      // [11] onto [99], [26] onto [88]
+      assertUnit(Spy::numCopy() == 1);        // copy-create [31]
+      assertUnit(Spy::numAlloc() == 1);       // allocate [31]
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(pCache == nullptr);
+      assertUnit(pDes->pNext == pCached);
+      assertStandardFixture(pDes);
+      // teardown
+      teardownStandardFixture(p11);
+      teardownStandardFixture(pDes);
+   }
+
+   // snapshot and restore back and forth: once warm, nothing is allocated
+   void test_assign_cacheSteadyState()
+   {  // setup
+      Node <Spy>* p11, * p26, * p31;
+      setupStandardFixture(p11, p26, p31);
+      Node <Spy>* pShort = new Node <Spy>(Spy(99));
+      Node <Spy>* pDes = nullptr;
+      Node <Spy>* pCache = nullptr;
+      assign(pDes, p11, pCache);
+      assign(pDes, pShort, pCache);
+      Node <Spy>* pFirst = pDes;
+      Spy::reset();
+      // exercise
+      for (int i = 0; i < 10; i++)
+      {
+         assign(pDes, p11, pCache);
+         assign(pDes, pShort, pCache);
+      }
+      assign(pDes, p11, pCache);
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(Spy::numAssign() == 43);     // 3 + 1 per round trip, plus the last 3
+      assertUnit(pDes == pFirst);
+      assertUnit(pCache == nullptr);
+      assertStandardFixture(pDes);
+      // teardown
+      teardownStandardFixture(p11);
+      teardownStandardFixture(pDes);
+      clear(pShort);
+   }
+
    /***************************************
     * SWAP
     ***************************************/
@@ -1413,6 +1565,207 @@ public:
    }  // teardown
 
 
+
+   /***************************************
+    * POOL
+    ***************************************/
+
+   // create one node from an empty pool
+   void test_pool_create()
+   {  // setup
+      NodePool <Spy> pool(4);
+      Spy s26(26);
+      Spy::reset();
+      // exercise
+      Node <Spy>* p = pool.create(s26);
+      // verify
+      assertUnit(Spy::numCopy() == 1);        // copy [26] into the node
+      assertUnit(Spy::numAlloc() == 1);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(p != nullptr);
+      assertUnit(p->data == Spy(26));
+      assertUnit(p->pNext == nullptr);
+      assertUnit(p->pPrev == nullptr);
+      assertUnit(pool.pSlabs != nullptr);
+      assertUnit(pool.numBump == 3);
+      assertUnit(pool.pFree == nullptr);
+      // teardown
+      clear(p, pool);
+   }
+
+   // copy the standard fixture with nodes from a pool
+   void test_pool_copyStandard()
+   {  // setup
+      //     p11      p26      p31
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      Node <Spy>* p11, * p26, * p31;
+      setupStandardFixture(p11, p26, p31);
+      NodePool <Spy> pool(4);
+      Spy::reset();
+      // exercise
+      Node <Spy>* pDes = copy(p11, pool);
+      // verify
+      assertUnit(Spy::numCopy() == 3);        // copy [11][26][31] to pDes
+      assertUnit(Spy::numAlloc() == 3);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(pool.numBump == 1);          // three of the four are used
+      assertStandardFixture(p11);
+      assertStandardFixture(pDes);
+      // teardown
+      teardownStandardFixture(p11);
+      clear(pDes, pool);
+   }
+
+   // give the standard fixture back to the pool and use it again
+   void test_pool_clearStandard()
+   {  // setup
+      Node <Spy>* p11, * p26, * p31;
+      setupStandardFixture(p11, p26, p31);
+      NodePool <Spy> pool(4);
+      Node <Spy>* pDes = copy(p11, pool);
+      Node <Spy>* pFirst = pDes;
+      Spy::reset();
+      // exercise
+      clear(pDes, pool);
+      // verify
+      assertUnit(Spy::numDestructor() == 3);  // destroy [11][26][31]
+      assertUnit(Spy::numDelete() == 3);      // delete [11][26][31]
+      assertUnit(pDes == nullptr);
+      assertUnit(pool.pFree == pFirst);
+      // exercise
+      pDes = copy(p11, pool);
+      // verify
+      assertUnit(pDes == pFirst);             // the same nodes come back
+      assertUnit(pool.numBump == 1);          // nothing new carved
+      assertUnit(pool.pFree == nullptr);
+      assertStandardFixture(pDes);
+      // teardown
+      teardownStandardFixture(p11);
+      clear(pDes, pool);
+   }
+
+   // a list of ints goes back to the pool without visiting every node
+   void test_pool_clearTrivial()
+   {  // setup
+      Node <int>* p11, * p26, * p31;
+      setupStandardFixture(p11, p26, p31);
+      NodePool <int> pool(8);
+      Node <int>* pA = copy(p11, pool);
+      Node <int>* pB = copy(p11, pool);
+      Node <int>* pFirstA = pA;
+      Node <int>* pFirstB = pB;
+      // exercise
+      clear(pA, pool);
+      clear(pB, pool);
+      // verify
+      assertUnit(pA == nullptr);
+      assertUnit(pB == nullptr);
+      assertUnit(pool.pFree == pFirstB);      // whole chains on the free list
+      assertUnit(pool.pFree->pPrev == pFirstA);
+      // exercise
+      Node <int>* pC = copy(p11, pool);
+      Node <int>* pD = copy(p11, pool);
+      // verify
+      assertUnit(pC == pFirstB);              // chain B is reused, then chain A
+      assertUnit(pD == pFirstA);
+      assertUnit(pool.pFree == nullptr);
+      assertUnit(pool.numBump == 2);
+      assertStandardFixture(pC);
+      assertStandardFixture(pD);
+      // teardown
+      teardownStandardFixture(p11);
+      clear(pC, pool);
+      clear(pD, pool);
+   }
+
+   // remove the middle node of a pooled list
+   void test_pool_removeMiddle()
+   {  // setup
+      Node <Spy>* p11, * p26, * p31;
+      setupStandardFixture(p11, p26, p31);
+      NodePool <Spy> pool(4);
+      Node <Spy>* pDes = copy(p11, pool);
+      Node <Spy>* pMiddle = pDes->pNext;
+      Spy::reset();
+      // exercise
+      Node <Spy>* pReturn = remove(pMiddle, pool);
+      // verify
+      assertUnit(Spy::numDestructor() == 1);  // destroy [26]
+      assertUnit(Spy::numDelete() == 1);      // delete [26]
+      assertUnit(pReturn == pDes);
+      assertUnit(pDes->pNext != nullptr && pDes->pNext->data == Spy(31));
+      assertUnit(pDes->pNext->pPrev == pDes);
+      assertUnit(pool.pFree == pMiddle);
+      // exercise
+      Node <Spy>* pNew = insert(pDes, Spy(26), true, pool);
+      // verify
+      assertUnit(pNew == pMiddle);            // the removed node is reused
+      assertUnit(pool.pFree == nullptr);
+      assertStandardFixture(pDes);
+      // teardown
+      teardownStandardFixture(p11);
+      clear(pDes, pool);
+   }
+
+   // assign a short list onto a long one, the extras go back to the pool
+   void test_pool_assignBigToSmall()
+   {  // setup
+      Node <Spy>* p11, * p26, * p31;
+      setupStandardFixture(p11, p26, p31);
+      NodePool <Spy> pool(4);
+      Node <Spy>* pSrc = pool.create(Spy(99));
+      Node <Spy>* pDes = copy(p11, pool);
+      Node <Spy>* pExtra = pDes->pNext;
+      Spy::reset();
+      // exercise
+      assign(pDes, pSrc, pool);
+      // verify
+      assertUnit(Spy::numAssign() == 1);      // [99] onto [11]
+      assertUnit(Spy::numDestructor() == 2);  // destroy [26][31]
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(pDes != nullptr && pDes->data == Spy(99));
+      assertUnit(pDes->pNext == nullptr);
+      assertUnit(pool.pFree == pExtra);
+      // exercise
+      assign(pDes, p11, pool);
+      // verify
+      assertUnit(pool.pFree == nullptr);      // the extras are reused
+      assertUnit(pool.numBump == 0);
+      assertUnit(pool.pSlabs->pNext == nullptr);
+      assertStandardFixture(pDes);
+      // teardown
+      teardownStandardFixture(p11);
+      clear(pDes, pool);
+      clear(pSrc, pool);
+   }
+
+   // once a slab is used up, another one is carved
+   void test_pool_slabs()
+   {  // setup
+      NodePool <int> pool(2);
+      Node <int>* pHead = pool.create(1);
+      // exercise
+      Node <int>* p = pHead;
+      for (int i = 2; i <= 5; i++)
+         p = insert(p, i, true, pool);
+      // verify
+      int numSlabs = 0;
+      for (auto pSlab = pool.pSlabs; pSlab; pSlab = pSlab->pNext)
+         numSlabs++;
+      assertUnit(numSlabs == 3);
+      assertUnit(pool.numBump == 1);
+      assertUnit(size(pHead) == 5);
+      int expected = 1;
+      for (p = pHead; p; p = p->pNext)
+         assertUnit(p->data == expected++);
+      // teardown
+      clear(pHead, pool);
+   }
+
    /*************************************************************
     * SETUP STANDARD FIXTURE
     *    +----+   +----+   +----+
@@ -1557,6 +1910,44 @@ public:
       }
    }
 
+   /*************************************************************
+    * SETUP LONG FIXTURE
+    *    +---+   +---+         +-----+
+    *    | 0 | - | 1 | - ... - | n-1 |
+    *    +---+   +---+         +-----+
+    *************************************************************/
+   Node <int>* setupLongFixture(int num)
+   {
+      Node <int>* pHead = nullptr;
+      Node <int>* pTail = nullptr;
+      for (int i = 0; i < num; i++)
+      {
+         pTail = insert(pTail, i, true);
+         if (!pHead)
+            pHead = pTail;
+      }
+      return pHead;
+   }
+
+   /*************************************************************
+    * VERIFY LONG FIXTURE
+    *************************************************************/
+   void assertLongFixtureParameters(const Node <int>* pHead, int num, int line, const char* function)
+   {
+      assertIndirect(pHead != nullptr);
+      assertIndirect(pHead == nullptr || pHead->pPrev == nullptr);
+
+      int i = 0;
+      bool fOk = true;
+      for (const Node <int>* p = pHead; p; p = p->pNext, i++)
+      {
+         fOk = fOk && p->data == i;
+         fOk = fOk && (!p->pNext || p->pNext->pPrev == p);
+      }
+      assertIndirect(fOk);
+      assertIndirect(i == num);
+   }
+
    /*************************************************************
     * TEARDOWN STANDARD FIXTURE
     *    +----+   +----+   +----+
@@ -49,15 +49,40 @@ public:
 
 /*******************************************************************
  * SIZE BTREE
- * Return the size of a b-tree under the current node
+ * Return the size of a b-tree under the current node. We walk the
+ * tree with the parent pointers so a degenerate tree cannot
+ * overflow the call stack.
  *******************************************************************/
 template <class T>
 inline size_t size(const BNode <T>* p)
 {
-   if (!p)
-      return 0;
-   else
-      return size(p->pLeft) + 1 + size(p->pRight);
+   size_t num = 0;
+   const BNode <T>* pRoot = p;
+
+   while (p)
+   {
+      num++;
+
+      // preorder: go down whenever we can
+      if (p->pLeft)
+         p = p->pLeft;
+      else if (p->pRight)
+         p = p->pRight;
+      else
+      {
+         // go up until we find a right subtree we have not visited
+         const BNode <T>* pNext = nullptr;
+         while (p != pRoot && !pNext)
+         {
+            if (p->pParent->pLeft == p && p->pParent->pRight)
+               pNext = p->pParent->pRight;
+            p = p->pParent;
+         }
+         p = pNext;
+      }
+   }
+
+   return num;
 }
 
 
@@ -125,20 +150,34 @@ void addRight(BNode <T>* pNode, T&& t)
 
 /*****************************************************
  * DELETE BINARY TREE
- * Delete all the nodes below pThis including pThis
- * using postfix traverse: LRV
+ * Delete all the nodes below pThis including pThis.
+ * Rather than recursing, we rotate each left child up
+ * until the top node has no left child, then delete it
+ * and move on to its right. Constant extra space.
  ****************************************************/
 template <class T>
 void clear(BNode <T>*& pThis)
 {
-   if (pThis == nullptr)
-      return;
+   BNode <T>* p = pThis;
 
-   // Recursively delete every node on the left, then every node on the right
-   clear(pThis->pLeft);
-   clear(pThis->pRight);
+   while (p)
+   {
+      if (p->pLeft)
+      {
+         // rotate right: our left child becomes the top
+         BNode <T>* pLeft = p->pLeft;
+         p->pLeft = pLeft->pRight;
+         pLeft->pRight = p;
+         p = pLeft;
+      }
+      else
+      {
+         BNode <T>* pDelete = p;
+         p = p->pRight;
+         delete pDelete;
+      }
+   }
 
-   delete pThis;
    pThis = nullptr;
 }
 
@@ -158,7 +197,9 @@ inline void swap(BNode <T>*& pLHS, BNode <T>*& pRHS)
 /**********************************************
  * COPY BINARY TREE
  * Copy pSrc->pRight to pDest->pRight and
- * pSrc->pLeft onto pDest->pLeft
+ * pSrc->pLeft onto pDest->pLeft. We walk both trees
+ * in step, climbing back up through the parent
+ * pointers instead of recursing.
  *********************************************/
 template <class T>
 BNode <T>* copy(const BNode <T>* pSrc)
@@ -168,15 +209,35 @@ BNode <T>* copy(const BNode <T>* pSrc)
 
    BNode<T>* pNew = new BNode<T>(pSrc->data);
 
-   // Recursively copy every node on the left side
-   pNew->pLeft = copy(pSrc->pLeft);
-   if (pNew->pLeft)
-      pNew->pLeft->pParent = pNew;
+   const BNode <T>* pS = pSrc;
+   BNode <T>* pD = pNew;
+   while (true)
+   {
+      // copy the left side first
+      if (pS->pLeft && !pD->pLeft)
+      {
+         addLeft(pD, new BNode<T>(pS->pLeft->data));
+         pS = pS->pLeft;
+         pD = pD->pLeft;
+      }
+
+      // then the right side
+      else if (pS->pRight && !pD->pRight)
+      {
+         addRight(pD, new BNode<T>(pS->pRight->data));
+         pS = pS->pRight;
+         pD = pD->pRight;
+      }
 
-   // Recursively copy every node on the right side
-   pNew->pRight = copy(pSrc->pRight);
-   if (pNew->pRight)
-      pNew->pRight->pParent = pNew;
+      // both sides are done: go back up
+      else if (pS != pSrc)
+      {
+         pS = pS->pParent;
+         pD = pD->pParent;
+      }
+      else
+         break;
+   }
 
    return pNew;
 }
@@ -184,7 +245,8 @@ BNode <T>* copy(const BNode <T>* pSrc)
 /**********************************************
  * assign
  * copy the values from pSrc onto pDest preserving
- * as many of the nodes as possible.
+ * as many of the nodes as possible. Like copy, we
+ * walk both trees in step without recursing.
  *********************************************/
 template <class T>
 void assign(BNode <T>*& pDest, const BNode <T>* pSrc)
@@ -204,16 +266,54 @@ void assign(BNode <T>*& pDest, const BNode <T>* pSrc)
       return;
    }
 
-   // We only want to preserve existing nodes 
-   pDest->data = pSrc->data;
+   // where we are in the current pair of nodes
+   enum { ARRIVED, LEFT_DONE, RIGHT_DONE } state = ARRIVED;
+   const BNode <T>* pS = pSrc;
+   BNode <T>* pD = pDest;
 
-   // Recursively assign all the nodes on the left
-   assign(pDest->pLeft, pSrc->pLeft);
-   if (pDest->pLeft)
-      pDest->pLeft->pParent = pDest;
+   while (true)
+   {
+      if (state == ARRIVED)
+      {
+         // We only want to preserve existing nodes
+         pD->data = pS->data;
 
-   // Recursively assign all the nodes on the right
-   assign(pDest->pRight, pSrc->pRight);
-   if (pDest->pRight)
-      pDest->pRight->pParent = pDest;
+         state = LEFT_DONE;
+         if (!pS->pLeft)
+            clear(pD->pLeft);
+         else if (!pD->pLeft)
+            addLeft(pD, copy(pS->pLeft));
+         else
+         {
+            pD->pLeft->pParent = pD;
+            pS = pS->pLeft;
+            pD = pD->pLeft;
+            state = ARRIVED;
+         }
+      }
+      else if (state == LEFT_DONE)
+      {
+         state = RIGHT_DONE;
+         if (!pS->pRight)
+            clear(pD->pRight);
+         else if (!pD->pRight)
+            addRight(pD, copy(pS->pRight));
+         else
+         {
+            pD->pRight->pParent = pD;
+            pS = pS->pRight;
+            pD = pD->pRight;
+            state = ARRIVED;
+         }
+      }
+      else if (pD != pDest)
+      {
+         // go back up, remembering which side we came from
+         state = (pD->pParent->pLeft == pD) ? LEFT_DONE : RIGHT_DONE;
+         pS = pS->pParent;
+         pD = pD->pParent;
+      }
+      else
+         break;
+   }
 }
@@ -19,6 +19,8 @@
 #include <iostream>
 #include <sstream>
 
+#define assertSkewedFixture(p, num, left)  assertSkewedFixtureParameters(p, num, left, __LINE__, __FUNCTION__)
+
 
 class TestBNode : public UnitTest
 {
@@ -72,6 +74,11 @@ public:
       test_size_one();
       test_size_standard();
 
+      // Degenerate trees
+      test_copy_skewed();
+      test_assign_skewed();
+      test_clear_skewed();
+
       report("BNode");
    }
 
@@ -1536,6 +1543,74 @@ public:
 
 
 
+   /***************************************
+    * DEGENERATE TREES
+    * A million nodes in a line would overflow the call
+    * stack if any of these recursed once per node.
+    ***************************************/
+
+   // copy a tree that leans all the way left, and one that leans all the way right
+   void test_copy_skewed()
+   {  // setup
+      BNode <int>* pLeft = setupSkewedFixture(NUM_SKEWED, true /*left*/);
+      BNode <int>* pRight = setupSkewedFixture(NUM_SKEWED, false /*right*/);
+      // exercise
+      BNode <int>* pLeftCopy = copy(pLeft);
+      BNode <int>* pRightCopy = copy(pRight);
+      // verify
+      assertUnit(pLeftCopy != pLeft);
+      assertUnit(pRightCopy != pRight);
+      assertUnit(size(pLeftCopy) == NUM_SKEWED);
+      assertUnit(size(pRightCopy) == NUM_SKEWED);
+      assertSkewedFixture(pLeftCopy, NUM_SKEWED, true /*left*/);
+      assertSkewedFixture(pRightCopy, NUM_SKEWED, false /*right*/);
+      // teardown
+      clear(pLeft);
+      clear(pRight);
+      clear(pLeftCopy);
+      clear(pRightCopy);
+   }
+
+   // assign a right-leaning tree onto a shorter left-leaning one
+   void test_assign_skewed()
+   {  // setup
+      BNode <int>* pSrc = setupSkewedFixture(NUM_SKEWED, false /*right*/);
+      BNode <int>* pDes = setupSkewedFixture(NUM_SKEWED / 2, true /*left*/);
+      // exercise
+      assign(pDes, pSrc);
+      // verify
+      assertUnit(pDes != pSrc);
+      assertUnit(size(pDes) == NUM_SKEWED);
+      assertSkewedFixture(pDes, NUM_SKEWED, false /*right*/);
+      // exercise
+      assign(pDes, setupSkewedFixture(0, true));
+      // verify
+      assertUnit(pDes == nullptr);
+      // teardown
+      clear(pSrc);
+   }
+
+   // delete a tree that leans all the way left
+   void test_clear_skewed()
+   {  // setup
+      BNode <Spy>* p = new BNode <Spy>(Spy(0));
+      BNode <Spy>* pBottom = p;
+      for (int i = 1; i < 100000; i++)
+      {
+         addLeft(pBottom, new BNode <Spy>(Spy(i)));
+         pBottom = pBottom->pLeft;
+      }
+      Spy::reset();
+      // exercise
+      clear(p);
+      // verify
+      assertUnit(Spy::numDestructor() == 100000);
+      assertUnit(Spy::numDelete() == 100000);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(p == nullptr);
+   }  // teardown
+
    /*************************************************************
     * SETUP STANDARD FIXTURE
     *                   (50)
@@ -1647,6 +1722,56 @@ public:
       }
    }
 
+   /*************************************************************
+    * SETUP SKEWED FIXTURE
+    * A tree where every node has only one child:
+    *    (0)                (0)
+    *    /                    \
+    *  (1)        or          (1)
+    *  /                        \
+    * ...                       ...
+    *************************************************************/
+   static const size_t NUM_SKEWED = 1000000;
+   BNode <int>* setupSkewedFixture(size_t num, bool left)
+   {
+      BNode <int>* pRoot = nullptr;
+      BNode <int>* pBottom = nullptr;
+      for (size_t i = 0; i < num; i++)
+      {
+         BNode <int>* pNew = new BNode <int>((int)i);
+         if (!pRoot)
+            pRoot = pNew;
+         else if (left)
+            addLeft(pBottom, pNew);
+         else
+            addRight(pBottom, pNew);
+         pBottom = pNew;
+      }
+      return pRoot;
+   }
+
+   /*************************************************************
+    * VERIFY SKEWED FIXTURE
+    *************************************************************/
+   void assertSkewedFixtureParameters(const BNode <int>* pRoot, size_t num, bool left,
+                                      int line, const char* function)
+   {
+      assertIndirect(pRoot != nullptr);
+      assertIndirect(pRoot == nullptr || pRoot->pParent == nullptr);
+
+      size_t i = 0;
+      bool fOk = true;
+      for (const BNode <int>* p = pRoot; p; p = (left ? p->pLeft : p->pRight), i++)
+      {
+         fOk = fOk && p->data == (int)i;
+         fOk = fOk && (left ? p->pRight : p->pLeft) == nullptr;
+         if (p != pRoot)
+            fOk = fOk && p->pParent && (left ? p->pParent->pLeft : p->pParent->pRight) == p;
+      }
+      assertIndirect(fOk);
+      assertIndirect(i == num);
+   }
+
    /*************************************************************
     * TEARDOWN STANDARD FIXTURE
     *                   ( )
@@ -31,6 +31,13 @@
 #include <functional>       // for std::less
 #include <utility>          // for std::pair
 #include <initializer_list> // for the initializer list, of course!
+#include <new>              // for placement new
+#include <type_traits>      // for std::is_trivially_destructible
+#include <iterator>         // for std::iterator_traits
+#include <algorithm>        // for std::min and std::max
+#include <future>           // for std::async
+#include <thread>           // for std::thread::hardware_concurrency
+#include "arena.h"          // where the nodes come from
 
 class TestBST; // forward declaration for unit tests
 class TestSet;
@@ -39,26 +46,46 @@ class TestMap;
 namespace custom
 {
 
-   template <typename TT>
+   template <typename TT, typename AA, typename TTree>
    class set;
-   template <typename KK, typename VV>
+   template <typename KK, typename VV, typename AA, typename TTree>
    class map;
 
+   /*****************************************************************
+    * SUBTREE SIZE
+    * How many nodes hang from a node, itself included. Only the
+    * nodes of a ranked BST carry one
+    *****************************************************************/
+   template <bool Ranked>
+   struct SubtreeSize
+   {
+      size_t size = 1;         // nodes in the subtree rooted here
+   };
+   template <>
+   struct SubtreeSize<false>
+   {
+   };
+
    /*****************************************************************
     * BINARY SEARCH TREE
-    * Create a Binary Search Tree
+    * Create a Binary Search Tree. The nodes are packed into slabs
+    * drawn from A, so clear() gives them back a slab at a time.
+    * A Ranked tree counts every subtree, which select and rank
+    * need. Keeping the counts costs a size_t per node and a walk
+    * up to the root on every insert and erase, even an append,
+    * so a tree only keeps them when asked to
     *****************************************************************/
-   template <typename T>
+   template <typename T, typename A = std::allocator<T>, bool Ranked = false>
    class BST
    {
       friend class ::TestBST; // give unit tests access to the privates
       friend class ::TestSet;
       friend class ::TestMap;
 
-      template <class TT>
+      template <class TT, class AA, class TTree>
       friend class custom::set;
 
-      template <class KK, class VV>
+      template <class KK, class VV, class AA, class TTree>
       friend class custom::map;
    public:
       //
@@ -80,13 +107,20 @@ namespace custom
       BST& operator = (const std::initializer_list<T>& il);
       void swap(BST& rhs);
 
+      // replace everything with [first, last). Sorted input with no
+      // duplicates is built directly, already balanced
+      template <class Iterator>
+      void assign(Iterator first, Iterator last, bool keepUnique = false);
+
       //
       // Iterator
       //
 
       class iterator;
-      iterator   begin() const noexcept;
-      iterator   end()   const noexcept { return iterator(nullptr); }
+      iterator   begin()  const noexcept { return iterator(leftmost);  }
+      iterator   end()    const noexcept { return iterator(nullptr);   }
+      iterator   rbegin() const noexcept { return iterator(rightmost); }
+      iterator   rend()   const noexcept { return iterator(nullptr);   }
 
       //
       // Access
@@ -94,6 +128,17 @@ namespace custom
 
       iterator find(const T& t);
 
+      // the first element not less than t, the first greater than
+      // t, and both together: the span of elements equal to t
+      iterator lower_bound(const T& t) const;
+      iterator upper_bound(const T& t) const;
+      std::pair<iterator, iterator> equal_range(const T& t) const;
+
+      // order statistics: the k-th smallest element counting from
+      // zero, and how many elements are smaller than t. Ranked only
+      iterator select(size_t k) const;
+      size_t   rank(const T& t) const;
+
       // 
       // Insert
       //
@@ -101,6 +146,11 @@ namespace custom
       std::pair<iterator, bool> insert(const T& t, bool keepUnique = false);
       std::pair<iterator, bool> insert(T&& t, bool keepUnique = false);
 
+      // when t belongs right next to hint, hang it there without
+      // walking down from the root
+      std::pair<iterator, bool> insert(iterator hint, const T& t, bool keepUnique = false);
+      std::pair<iterator, bool> insert(iterator hint, T&& t, bool keepUnique = false);
+
       //
       // Remove
       // 
@@ -108,6 +158,18 @@ namespace custom
       iterator erase(iterator& it);
       void   clear() noexcept;
 
+      //
+      // Set algebra
+      //
+
+      // keep what is in either tree, what is in both, or what is only
+      // in this one. Each cuts this tree apart at rhs's elements and
+      // joins the pieces back, so trees of m and n elements cost
+      // O(m log(n/m + 1)). Big trees share the work among threads
+      void unite(const BST& rhs);
+      void intersect(const BST& rhs);
+      void subtract(const BST& rhs);
+
       // 
       // Status
       //
@@ -118,8 +180,94 @@ namespace custom
    private:
 
       class BNode;
+
+      // a piece of the tree cut loose during set algebra: its root,
+      // which is black, and the black nodes on every path down
+      struct Subtree
+      {
+         BNode* pRoot;
+         size_t blackHeight;
+      };
+
+      // below this many black nodes on a path, fewer than 2^12 - 1
+      // elements, a thread costs more than it saves
+      static constexpr size_t FORK_HEIGHT = 12;
+
+      // cut pieces apart and glue them back together, red-black all
+      // the while. split leaves the element equal to t in pFound
+      static Subtree subtree(BNode* pRoot);
+      static size_t blackHeight(const BNode* pRoot);
+      static Subtree child(const Subtree& tree, BNode* pChild);
+      static Subtree join(Subtree left, BNode* pMiddle, Subtree right);
+      static Subtree join(Subtree left, Subtree right);
+      static void split(Subtree tree, const T& t, Subtree& left, BNode*& pFound, Subtree& right);
+      static BNode* splitLast(Subtree tree, Subtree& rest);
+
+      // the recursion behind unite, intersect and subtract. The arena
+      // is not shared between threads, so nodes to destroy go on
+      // pDropped, linked through pParent, until the threads are done.
+      // pOther is only read, so its black height comes along with it
+      static Subtree unionOf(Subtree tree, Subtree other, size_t numThreads, BNode*& pDropped);
+      static Subtree intersectionOf(Subtree tree, const BNode* pOther, size_t heightOther,
+                                    size_t numThreads, BNode*& pDropped);
+      static Subtree differenceOf(Subtree tree, const BNode* pOther, size_t heightOther,
+                                  size_t numThreads, BNode*& pDropped);
+      static void drop(BNode* pNode, BNode*& pDropped) { pNode->pParent = pDropped; pDropped = pNode; }
+
+      // run two halves, on two threads when both are tall enough
+      template <class Left, class Right>
+      static void forkJoin(size_t numThreads, size_t heightLeft, size_t heightRight,
+                           Left left, Right right, BNode*& pDropped);
+
+      // make a set algebra result the whole tree. It holds the num
+      // elements there were, less the ones dropped
+      void adopt(Subtree tree, size_t num, BNode* pDropped);
+
+      // rotate pNode down to the left or right, its child taking its place
+      void rotateLeft(BNode* pNode);
+      void rotateRight(BNode* pNode);
+
+      // hang a new node off pParent and balance
+      iterator attach(BNode* pParent, bool isLeft, BNode* pNode);
+
+      // insert beside a hint, if that is where u goes
+      template <class U>
+      std::pair<iterator, bool> insertHint(iterator hint, U&& u, bool keepUnique);
+
+      // restore the red-black rules after a black node was removed
+      void balanceErase(BNode* pNode, BNode* pParent);
+
+      // build a node in the arena, and destroy one back into it
+      template <class U>
+      BNode* newNode(U&& u);
+      void deleteNode(BNode* pNode);
+
+      // is [first, last) strictly increasing? Only a forward iterator
+      // over T can be read twice to find out
+      template <class Iterator>
+      static bool isSortedUnique(Iterator first, Iterator last, size_t& num, std::true_type);
+      template <class Iterator>
+      static bool isSortedUnique(Iterator first, Iterator last, size_t& num, std::false_type) { return false; }
+
+      // build a balanced subtree of num sorted elements
+      template <class Iterator>
+      BNode* buildTree(Iterator& it, size_t num, size_t depth, size_t depthRed);
+
+      // copy or destroy a whole subtree without recursion. Destroying
+      // says how many nodes went
+      BNode* copyTree(const BNode* pSrc);
+      size_t destroyTree(BNode* pNode);
+
+      // find leftmost and rightmost again after the whole tree changed
+      void resetEnds();
+
+      using NodeAlloc = typename std::allocator_traits<A>::template rebind_alloc<BNode>;
+
       BNode* root;              // root node of the binary search tree
+      BNode* leftmost;          // smallest node, where begin() points
+      BNode* rightmost;         // largest node, where rbegin() points
       size_t numElements;        // number of elements currently in the tree
+      arena<BNode, NodeAlloc> nodes;  // where the nodes live
    };
 
 
@@ -128,8 +276,8 @@ namespace custom
     * A single node in a binary tree. Note that the node does not know
     * anything about the properties of the tree so no validation can be done.
     *****************************************************************/
-   template <typename T>
-   class BST <T> ::BNode
+   template <typename T, typename A, bool Ranked>
+   class BST <T, A, Ranked> ::BNode : public SubtreeSize<Ranked>
    {
    public:
       // 
@@ -144,10 +292,6 @@ namespace custom
       //
       void addLeft(BNode* pNode);
       void addRight(BNode* pNode);
-      void addLeft(const T& t);
-      void addRight(const T& t);
-      void addLeft(T&& t);
-      void addRight(T&& t);
 
       // 
       // Status
@@ -155,8 +299,18 @@ namespace custom
       bool isRightChild(BNode* pNode) const { return pParent && pParent->pRight == this; }
       bool isLeftChild(BNode* pNode) const { return pParent && pParent->pLeft == this; }
 
-      // balance the tree
-      void balance();
+      // balance the tree. True when the recoloring reached the root,
+      // making every path one black node longer
+      bool balance();
+
+      // count the subtree again from the children's counts. Only a
+      // ranked tree has counts to keep
+      static size_t sizeOf(const BNode* pNode) { return pNode ? pNode->size : 0; }
+      void resize()
+      {
+         if constexpr (Ranked)
+            this->size = 1 + sizeOf(pLeft) + sizeOf(pRight);
+      }
 
 #ifdef DEBUG
       //
@@ -182,14 +336,15 @@ namespace custom
     * BINARY SEARCH TREE ITERATOR
     * Forward and reverse iterator through a BST
     *********************************************************/
-   template <typename T>
-   class BST <T> ::iterator
+   template <typename T, typename A, bool Ranked>
+   class BST <T, A, Ranked> ::iterator
    {
       friend class ::TestBST; // give unit tests access to the privates
       friend class ::TestSet;
       friend class ::TestMap;
+      friend class BST <T, A, Ranked>;   // a hinted insert starts from the node
 
-      template <class KK, class VV>
+      template <class KK, class VV, class AA, class TTree>
       friend class custom::map;
    public:
       // constructors and assignment
@@ -222,20 +377,20 @@ namespace custom
       iterator& operator ++ ();
       iterator   operator ++ (int postfix)
       {
-         BNode* oldNode = pNode;
-         pNode += postfix;
-         return oldNode;
+         iterator temp(*this);
+         ++(*this);
+         return temp;
       }
       iterator& operator -- ();
       iterator   operator -- (int postfix)
       {
-         BNode* oldNode = pNode;
-         pNode -= postfix;
-         return oldNode;
+         iterator temp(*this);
+         --(*this);
+         return temp;
       }
 
       // must give friend status to remove so it can call getNode() from it
-      friend BST <T> ::iterator BST <T> ::erase(iterator& it);
+      friend BST <T, A, Ranked> ::iterator BST <T, A, Ranked> ::erase(iterator& it);
 
    private:
 
@@ -256,30 +411,34 @@ namespace custom
     /*********************************************
      * BST :: DEFAULT CONSTRUCTOR
      ********************************************/
-   template <typename T>
-   BST <T> ::BST() : root(nullptr), numElements(0) {}
+   template <typename T, typename A, bool Ranked>
+   BST <T, A, Ranked> ::BST() : root(nullptr), leftmost(nullptr), rightmost(nullptr), numElements(0) {}
 
    /*********************************************
     * BST :: COPY CONSTRUCTOR
     * Copy one tree to another
     ********************************************/
-   template <typename T>
-   BST <T> ::BST(const BST<T>& rhs) : root(nullptr), numElements(rhs.numElements)
+   template <typename T, typename A, bool Ranked>
+   BST <T, A, Ranked> ::BST(const BST <T, A, Ranked>& rhs) : root(nullptr), numElements(rhs.numElements)
    {
-      *this = rhs;
+      root = copyTree(rhs.root);
+      resetEnds();
    }
 
    /*********************************************
     * BST :: MOVE CONSTRUCTOR
     * Move one tree to another
     ********************************************/
-   template <typename T>
-   BST <T> ::BST(BST <T>&& rhs)
+   template <typename T, typename A, bool Ranked>
+   BST <T, A, Ranked> ::BST(BST <T, A, Ranked>&& rhs)
    {
       root = rhs.root;
+      leftmost = rhs.leftmost;
+      rightmost = rhs.rightmost;
       numElements = rhs.numElements;
+      nodes = std::move(rhs.nodes);
 
-      rhs.root = nullptr;
+      rhs.root = rhs.leftmost = rhs.rightmost = nullptr;
       rhs.numElements = 0;
    }
 
@@ -287,19 +446,17 @@ namespace custom
     * BST :: INITIALIZER LIST CONSTRUCTOR
     * Create a BST from an initializer list
     ********************************************/
-   template <typename T>
-   BST <T> ::BST(const std::initializer_list<T>& il)
+   template <typename T, typename A, bool Ranked>
+   BST <T, A, Ranked> ::BST(const std::initializer_list<T>& il) : root(nullptr), leftmost(nullptr), rightmost(nullptr), numElements(0)
    {
-      clear();
-      for (const auto& item : il)
-         insert(item);
+      assign(il.begin(), il.end());
    }
 
    /*********************************************
     * BST :: DESTRUCTOR
     ********************************************/
-   template <typename T>
-   BST <T> :: ~BST()
+   template <typename T, typename A, bool Ranked>
+   BST <T, A, Ranked> :: ~BST()
    {
       clear();
    }
@@ -309,67 +466,82 @@ namespace custom
     * BST :: ASSIGNMENT OPERATOR
     * Copy one tree to another
     ********************************************/
-   template <typename T>
-   BST <T>& BST <T> :: operator = (const BST <T>& rhs)
+   template <typename T, typename A, bool Ranked>
+   BST <T, A, Ranked>& BST <T, A, Ranked> :: operator = (const BST <T, A, Ranked>& rhs)
    {
       if (this == &rhs)
          return *this;
 
-      std::function<BNode* (BNode*, BNode*)> clone =
-         [&](BNode* src, BNode* parent) -> BNode*
-         {
-            if (!src)
-               return nullptr;
-
-            BNode* n = new BNode(src->data);
-            n->isRed = src->isRed;
-            n->pParent = parent;
-            n->pLeft = clone(src->pLeft, n);
-            n->pRight = clone(src->pRight, n);
-            return n;
-         };
-
-      // helper: delete subtree
-      std::function<void(BNode*)> destroy =
-         [&](BNode* n)
-         {
-            if (!n) return;
-            destroy(n->pLeft);
-            destroy(n->pRight);
-            delete n;
-         };
-
-      // helper: assign while reusing nodes when possible
-      std::function<void(BNode*&, BNode*, BNode*)> assign =
-         [&](BNode*& dest, BNode* src, BNode* parent)
-         {
-            if (!src && !dest)
-               return;
+      if (!rhs.root || !root)
+      {
+         destroyTree(root);
+         root = copyTree(rhs.root);
+         numElements = rhs.numElements;
+         resetEnds();
+         return *this;
+      }
 
-            if (!src && dest)
+      // walk both trees together, reusing the nodes they have in
+      // common, trimming what rhs lacks and copying what we lack
+      const BNode* pSrc = rhs.root;
+      BNode* pDest = root;
+      BNode* pFrom = nullptr;        // child we just climbed out of
+      bool arriving = true;
+      while (true)
+      {
+         if (arriving)
+         {
+            pDest->data = pSrc->data;
+            pDest->isRed = pSrc->isRed;
+            if constexpr (Ranked)
+               pDest->size = pSrc->size;
+            if (!pSrc->pLeft && pDest->pLeft)
             {
-               destroy(dest);
-               dest = nullptr;
-               return;
+               destroyTree(pDest->pLeft);
+               pDest->pLeft = nullptr;
             }
-
-            if (src && !dest)
+            if (!pSrc->pRight && pDest->pRight)
             {
-               dest = clone(src, parent);
-               return;
+               destroyTree(pDest->pRight);
+               pDest->pRight = nullptr;
             }
+            if (pSrc->pLeft && pDest->pLeft)
+            {
+               pSrc = pSrc->pLeft;
+               pDest = pDest->pLeft;
+               continue;
+            }
+            if (pSrc->pLeft)
+            {
+               pDest->pLeft = copyTree(pSrc->pLeft);
+               pDest->pLeft->pParent = pDest;
+            }
+         }
 
-            // both exist reuse node
-            dest->data = src->data;
-            dest->isRed = src->isRed;
-            dest->pParent = parent;
-
-            assign(dest->pLeft, src->pLeft, dest);
-            assign(dest->pRight, src->pRight, dest);
-         };
+         // the left side is done, so now the right
+         if (pSrc->pRight && (arriving || pFrom != pDest->pRight))
+         {
+            if (pDest->pRight)
+            {
+               pSrc = pSrc->pRight;
+               pDest = pDest->pRight;
+               arriving = true;
+               continue;
+            }
+            pDest->pRight = copyTree(pSrc->pRight);
+            pDest->pRight->pParent = pDest;
+         }
 
-      assign(root, rhs.root, nullptr);
+         // both sides are done, so climb
+         if (pSrc == rhs.root)
+            break;
+         pFrom = pDest;
+         pSrc = pSrc->pParent;
+         pDest = pDest->pParent;
+         arriving = false;
+      }
       numElements = rhs.numElements;
+      resetEnds();
 
       if (root)
          root->isRed = false;
@@ -380,14 +552,10 @@ namespace custom
     * BST :: ASSIGNMENT OPERATOR with INITIALIZATION LIST
     * Copy nodes onto a BTree
     ********************************************/
-   template <typename T>
-   BST <T>& BST <T> :: operator = (const std::initializer_list<T>& il)
+   template <typename T, typename A, bool Ranked>
+   BST <T, A, Ranked>& BST <T, A, Ranked> :: operator = (const std::initializer_list<T>& il)
    {
-      clear();
-
-      for (const T& value : il)
-         insert(value);
-
+      assign(il.begin(), il.end());
       return *this;
    }
 
@@ -395,8 +563,8 @@ namespace custom
     * BST :: ASSIGN-MOVE OPERATOR
     * Move one tree to another
     ********************************************/
-   template <typename T>
-   BST <T>& BST <T> :: operator = (BST <T>&& rhs)
+   template <typename T, typename A, bool Ranked>
+   BST <T, A, Ranked>& BST <T, A, Ranked> :: operator = (BST <T, A, Ranked>&& rhs)
    {
       if (this == &rhs)
          return *this;
@@ -404,9 +572,12 @@ namespace custom
       clear();
 
       root = rhs.root;
+      leftmost = rhs.leftmost;
+      rightmost = rhs.rightmost;
       numElements = rhs.numElements;
+      nodes = std::move(rhs.nodes);
 
-      rhs.root = nullptr;
+      rhs.root = rhs.leftmost = rhs.rightmost = nullptr;
       rhs.numElements = 0;
 
       return *this;
@@ -416,19 +587,129 @@ namespace custom
     * BST :: SWAP
     * Swap two trees
     ********************************************/
-   template <typename T>
-   void BST <T> ::swap(BST <T>& rhs)
+   template <typename T, typename A, bool Ranked>
+   void BST <T, A, Ranked> ::swap(BST <T, A, Ranked>& rhs)
    {
       std::swap(this->root, rhs.root);
+      std::swap(this->leftmost, rhs.leftmost);
+      std::swap(this->rightmost, rhs.rightmost);
       std::swap(this->numElements, rhs.numElements);
+      nodes.swap(rhs.nodes);
+   }
+
+   /*********************************************
+    * BST :: ASSIGN
+    * Replace the contents of the tree with a range. When the
+    * range is already sorted with no duplicates, lay it out as
+    * a balanced tree in O(n) without a single comparison
+    * against the tree or a rotation. Otherwise, insert one at
+    * a time
+    ********************************************/
+   template <typename T, typename A, bool Ranked>
+   template <class Iterator>
+   void BST <T, A, Ranked> ::assign(Iterator first, Iterator last, bool keepUnique)
+   {
+      using Traits = std::iterator_traits<Iterator>;
+      using CanReread = std::integral_constant<bool,
+         std::is_same<typename Traits::value_type, T>::value &&
+         std::is_base_of<std::forward_iterator_tag, typename Traits::iterator_category>::value>;
+
+      clear();
+
+      size_t num = 0;
+      if (!isSortedUnique(first, last, num, CanReread()))
+      {
+         for (; first != last; ++first)
+            insert(*first, keepUnique);
+         return;
+      }
+
+      // every level is full but the last, so the last is red
+      size_t depthRed = 0;
+      while (((size_t)2 << depthRed) <= num)
+         depthRed++;
+
+      root = buildTree(first, num, 0, depthRed);
+      if (root)
+         root->isRed = false;
+      numElements = num;
+      resetEnds();
+   }
+
+   /*********************************************
+    * BST :: IS SORTED UNIQUE
+    * Count the range, checking that each element is
+    * smaller than the next
+    ********************************************/
+   template <typename T, typename A, bool Ranked>
+   template <class Iterator>
+   bool BST <T, A, Ranked> ::isSortedUnique(Iterator first, Iterator last, size_t& num, std::true_type)
+   {
+      num = 0;
+      for (Iterator itPrev = first; first != last; itPrev = first++)
+         if (num++ && !(*itPrev < *first))
+            return false;
+      return true;
+   }
+
+   /*********************************************
+    * BST :: BUILD TREE
+    * The middle element is the root, the ones before it the
+    * left subtree and the ones after the right. Taking them in
+    * that order reads the range front to back exactly once.
+    * Every path to a leaf has the same black nodes because
+    * only the nodes on the deepest level are red
+    ********************************************/
+   template <typename T, typename A, bool Ranked>
+   template <class Iterator>
+   typename BST <T, A, Ranked> ::BNode* BST <T, A, Ranked> ::buildTree(Iterator& it, size_t num, size_t depth, size_t depthRed)
+   {
+      if (num == 0)
+         return nullptr;
+
+      size_t numLeft = (num - 1) / 2;
+      BNode* pLeft = buildTree(it, numLeft, depth + 1, depthRed);
+
+      BNode* pNode;
+      try
+      {
+         pNode = newNode(*it);
+      }
+      catch (...)
+      {
+         destroyTree(pLeft);
+         throw;
+      }
+      ++it;
+
+      pNode->isRed = (depth == depthRed);
+      if constexpr (Ranked)
+         pNode->size = num;
+      pNode->pLeft = pLeft;
+      if (pLeft)
+         pLeft->pParent = pNode;
+
+      try
+      {
+         pNode->pRight = buildTree(it, num - 1 - numLeft, depth + 1, depthRed);
+      }
+      catch (...)
+      {
+         destroyTree(pNode);
+         throw;
+      }
+      if (pNode->pRight)
+         pNode->pRight->pParent = pNode;
+
+      return pNode;
    }
 
    /*****************************************************
     * BST :: INSERT
     * Insert a node at a given location in the tree
     ****************************************************/
-   template <typename T>
-   std::pair<typename BST <T> ::iterator, bool> BST <T> ::insert(const T& t, bool keepUnique)
+   template <typename T, typename A, bool Ranked>
+   std::pair<typename BST <T, A, Ranked> ::iterator, bool> BST <T, A, Ranked> ::insert(const T& t, bool keepUnique)
    {
       bool done = false;
       BNode* currentNode = root;
@@ -437,13 +718,18 @@ namespace custom
       // If there is no root node, create one
       if (!root)
       {
-         root = new BNode(t);
+         root = leftmost = rightmost = newNode(t);
          root->isRed = false;
          numElements = 1;
          pairReturn = std::pair<iterator, bool>(iterator(root), true);
          return pairReturn;
       }
 
+      // keys that only grow, such as timestamps, always go after the
+      // largest; there is no need to walk down to find that out
+      if (rightmost->data < t)
+         return std::pair<iterator, bool>(attach(rightmost, false, newNode(t)), true);
+
       while (!done)
       {
          if (keepUnique)
@@ -465,7 +751,9 @@ namespace custom
             // Otherwise, insert a new node as the current node's left child
             else
             {
-               currentNode->addLeft(t);
+               currentNode->addLeft(newNode(t));
+               if (currentNode == leftmost)
+                  leftmost = currentNode->pLeft;
                BNode* inserted = currentNode->pLeft;
                numElements++;
 
@@ -483,7 +771,9 @@ namespace custom
             // Otherwise, insert a new node as the current node's right child
             else
             {
-               currentNode->addRight(t);
+               currentNode->addRight(newNode(t));
+               if (currentNode == rightmost)
+                  rightmost = currentNode->pRight;
                BNode* inserted = currentNode->pRight;
                numElements++;
 
@@ -503,8 +793,8 @@ namespace custom
       return pairReturn;
    }
 
-   template <typename T>
-   std::pair<typename BST <T> ::iterator, bool> BST <T> ::insert(T&& t, bool keepUnique) // unsure if there's a way to only need one insert defined
+   template <typename T, typename A, bool Ranked>
+   std::pair<typename BST <T, A, Ranked> ::iterator, bool> BST <T, A, Ranked> ::insert(T&& t, bool keepUnique) // unsure if there's a way to only need one insert defined
    {
       bool done = false;
       BNode* currentNode = root;
@@ -513,13 +803,17 @@ namespace custom
       // If there is no root node, create one
       if (!root)
       {
-         root = new BNode(std::move(t));
+         root = leftmost = rightmost = newNode(std::move(t));
          root->isRed = false;
          numElements = 1;
          pairReturn = std::pair<iterator, bool>(iterator(root), true);
          return pairReturn;
       }
 
+      // keys that only grow always go after the largest
+      if (rightmost->data < t)
+         return std::pair<iterator, bool>(attach(rightmost, false, newNode(std::move(t))), true);
+
       while (!done)
       {
          if (keepUnique)
@@ -541,7 +835,9 @@ namespace custom
             // Otherwise, insert a new node as the current node's left child
             else
             {
-               currentNode->addLeft(std::move(t));
+               currentNode->addLeft(newNode(std::move(t)));
+               if (currentNode == leftmost)
+                  leftmost = currentNode->pLeft;
                numElements++;
                pairReturn = std::pair<iterator, bool>(iterator(currentNode->pLeft), true);
                done = true;
@@ -557,7 +853,9 @@ namespace custom
             // Otherwise, insert a new node as the current node's right child
             else
             {
-               currentNode->addRight(std::move(t));
+               currentNode->addRight(newNode(std::move(t)));
+               if (currentNode == rightmost)
+                  rightmost = currentNode->pRight;
                numElements++;
                pairReturn = std::pair<iterator, bool>(iterator(currentNode->pRight), true);
                done = true;
@@ -572,12 +870,112 @@ namespace custom
       return pairReturn;
    }
 
+   /*****************************************************
+    * BST :: INSERT with HINT
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   std::pair<typename BST <T, A, Ranked> ::iterator, bool> BST <T, A, Ranked> ::insert(iterator hint, const T& t, bool keepUnique)
+   {
+      return insertHint(hint, t, keepUnique);
+   }
+
+   template <typename T, typename A, bool Ranked>
+   std::pair<typename BST <T, A, Ranked> ::iterator, bool> BST <T, A, Ranked> ::insert(iterator hint, T&& t, bool keepUnique)
+   {
+      return insertHint(hint, std::move(t), keepUnique);
+   }
+
+   /*****************************************************
+    * BST :: INSERT HINT
+    * If u falls between the hint and its neighbor, one of the
+    * two has a free child pointer right where u goes: the
+    * neighbor is in the hint's subtree exactly when the hint's
+    * own pointer on that side is taken. Stepping to a neighbor
+    * is amortized O(1), so inserting in order costs no walk
+    * down from the root. A hint that is off, or end() when the
+    * largest element is not the spot, gets an ordinary insert
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   template <class U>
+   std::pair<typename BST <T, A, Ranked> ::iterator, bool> BST <T, A, Ranked> ::insertHint(iterator hint, U&& u, bool keepUnique)
+   {
+      BNode* pHint = hint.pNode;
+      if (!pHint)
+         return insert(std::forward<U>(u), keepUnique);
+
+      // just before the hint?
+      if (u < pHint->data)
+      {
+         iterator itPrev = hint;
+         --itPrev;
+         if (!itPrev.pNode || itPrev.pNode->data < u)
+         {
+            BNode* pNode = newNode(std::forward<U>(u));
+            if (!pHint->pLeft)
+               return std::pair<iterator, bool>(attach(pHint, true, pNode), true);
+            return std::pair<iterator, bool>(attach(itPrev.pNode, false, pNode), true);
+         }
+      }
+
+      // just after it?
+      else if (pHint->data < u)
+      {
+         iterator itNext = hint;
+         ++itNext;
+         if (!itNext.pNode || u < itNext.pNode->data)
+         {
+            BNode* pNode = newNode(std::forward<U>(u));
+            if (!pHint->pRight)
+               return std::pair<iterator, bool>(attach(pHint, false, pNode), true);
+            return std::pair<iterator, bool>(attach(itNext.pNode, true, pNode), true);
+         }
+      }
+
+      // the hint is the same as u
+      else if (keepUnique)
+         return std::pair<iterator, bool>(hint, false);
+
+      return insert(std::forward<U>(u), keepUnique);
+   }
+
+   /*****************************************************
+    * BST :: ATTACH
+    * Hang a new node off an empty child pointer of pParent,
+    * balance, and keep the ends, the count, and the root
+    * up to date
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::iterator BST <T, A, Ranked> ::attach(BNode* pParent, bool isLeft, BNode* pNode)
+   {
+      if (isLeft)
+      {
+         pParent->addLeft(pNode);
+         if (pParent == leftmost)
+            leftmost = pNode;
+      }
+      else
+      {
+         pParent->addRight(pNode);
+         if (pParent == rightmost)
+            rightmost = pNode;
+      }
+      numElements++;
+
+      // a rotation at the top leaves the old root one level down
+      while (root->pParent)
+         root = root->pParent;
+
+      return iterator(pNode);
+   }
+
    /*************************************************
     * BST :: ERASE
-    * Remove a given node as specified by the iterator
+    * Remove a given node as specified by the iterator.
+    * If we take out a black node, the path through it is
+    * one black short, so we rebalance from where it was
     ************************************************/
-   template <typename T>
-   typename BST<T>::iterator BST<T>::erase(iterator& it)
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked>::iterator BST <T, A, Ranked>::erase(iterator& it)
    {
       if (it == end())
          return end();
@@ -587,70 +985,70 @@ namespace custom
       // compute next iterator BEFORE structural change
       iterator itNext = ++it;
 
-      // Case 1: No Children
-      if (!node->pRight && !node->pLeft)
+      // rotations never change the order, so only the node
+      // leaving can move the ends
+      if (node == leftmost)
+         leftmost = itNext.pNode;
+      if (node == rightmost)
       {
-         if (node->pParent && node->pParent->pRight == node)
-            node->pParent->pRight = nullptr;
-         if (node->pParent && node->pParent->pLeft == node)
-            node->pParent->pLeft = nullptr;
-
-         delete node;
-         numElements--;
+         rightmost = node->pParent;
+         if (node->pLeft)
+            for (rightmost = node->pLeft; rightmost->pRight; )
+               rightmost = rightmost->pRight;
       }
 
-      // Case 2: One Child
-      else if (!node->pRight && node->pLeft)
-      {
-         node->pLeft->pParent = node->pParent;
-         if (node->pParent && node->pParent->pRight == node)
-            node->pParent->pRight = node->pLeft;
-         if (node->pParent && node->pParent->pLeft == node)
-            node->pParent->pLeft = node->pLeft;
-
-         delete node;
-         numElements--;
-      }
+      BNode* child;            // what takes the place of the removed node
+      BNode* childParent;      // where that is, even if child is null
+      bool isRemovedRed;       // color of the node leaving its spot
 
-      else if (!node->pLeft && node->pRight)
+      // Case 1 and 2: No Children or One Child
+      if (!node->pLeft || !node->pRight)
       {
-         node->pRight->pParent = node->pParent;
-         if (node->pParent && node->pParent->pRight == node)
-            node->pParent->pRight = node->pRight;
-         if (node->pParent && node->pParent->pLeft == node)
-            node->pParent->pLeft = node->pRight;
+         child = node->pLeft ? node->pLeft : node->pRight;
+         childParent = node->pParent;
+         isRemovedRed = node->isRed;
 
-         delete node;
-         numElements--;
+         if (child)
+            child->pParent = node->pParent;
+
+         if (!node->pParent)
+            root = child;
+         else if (node->pParent->pLeft == node)
+            node->pParent->pLeft = child;
+         else
+            node->pParent->pRight = child;
       }
 
-      // Case 3: 2 Children
-      else if (node->pLeft && node->pRight)
+      // Case 3: Two Children
+      // successor is the next in-order node (itNext was computed before deletion)
+      else
       {
          BNode* succ = itNext.pNode;
 
-         // Detach the successor from its parent
-         BNode* succParent = succ->pParent;
-         BNode* succRight = succ->pRight;
+         // the successor leaves its spot, its right child taking it
+         child = succ->pRight;
+         isRemovedRed = succ->isRed;
 
-         if (succParent != node)
+         // detach the successor from its parent
+         if (succ->pParent != node)
          {
-            if (succParent->pLeft == succ)
-               succParent->pLeft = succRight;
-            else
-               succParent->pRight = succRight;
-
-            if (succRight)
-               succRight->pParent = succParent;
+            childParent = succ->pParent;
+            childParent->pLeft = child;
+            if (child)
+               child->pParent = childParent;
 
             // successor takes node's right subtree
             succ->pRight = node->pRight;
-            if (succ->pRight)
-               succ->pRight->pParent = succ;
+            succ->pRight->pParent = succ;
          }
+         else
+            childParent = succ;
 
-         // --- replace node with successor ---
+         // replace node with successor, color, count and all
          succ->pParent = node->pParent;
+         succ->isRed = node->isRed;
+         if constexpr (Ranked)
+            succ->size = node->size;
 
          if (!node->pParent)
             root = succ;
@@ -659,59 +1057,775 @@ namespace custom
          else
             node->pParent->pRight = succ;
 
-         // attach children
+         // attach left child
          succ->pLeft = node->pLeft;
-         if (succ->pLeft)
-            succ->pLeft->pParent = succ;
+         succ->pLeft->pParent = succ;
+      }
 
-         delete node;
-         numElements--;
+      // every subtree the node left is one smaller
+      if constexpr (Ranked)
+         for (BNode* p = childParent; p; p = p->pParent)
+            p->size--;
 
-         itNext = iterator(succ);
-      }
+      deleteNode(node);
+      --numElements;
+
+      // a red node never changes the black count
+      if (!isRemovedRed)
+         balanceErase(child, childParent);
 
       return itNext;
    }
 
+   /*************************************************
+    * BST :: BALANCE ERASE
+    * pNode (which may be null) sits one black node short
+    * of its sibling's side. Either soak the shortfall up
+    * into a red node, or push it up the tree until it can be
+    *    Case 1: sibling is red: rotate so it is black
+    *    Case 2: sibling's children are black: recolor it red
+    *            and move the problem up to the parent
+    *    Case 3: sibling's far child is black: rotate the
+    *            near red child into the sibling's place
+    *    Case 4: sibling's far child is red: rotate the parent
+    *            toward us and we are done
+    ************************************************/
+   template <typename T, typename A, bool Ranked>
+   void BST <T, A, Ranked>::balanceErase(BNode* pNode, BNode* pParent)
+   {
+      while (pNode != root && (!pNode || !pNode->isRed))
+      {
+         if (pNode == pParent->pLeft)
+         {
+            BNode* pSibling = pParent->pRight;
+
+            // Case 1: red sibling
+            if (pSibling->isRed)
+            {
+               pSibling->isRed = false;
+               pParent->isRed = true;
+               rotateLeft(pParent);
+               pSibling = pParent->pRight;
+            }
+
+            // Case 2: sibling with no red children
+            if ((!pSibling->pLeft || !pSibling->pLeft->isRed) &&
+                (!pSibling->pRight || !pSibling->pRight->isRed))
+            {
+               pSibling->isRed = true;
+               pNode = pParent;
+               pParent = pNode->pParent;
+               continue;
+            }
+
+            // Case 3: only the near child is red
+            if (!pSibling->pRight || !pSibling->pRight->isRed)
+            {
+               pSibling->pLeft->isRed = false;
+               pSibling->isRed = true;
+               rotateRight(pSibling);
+               pSibling = pParent->pRight;
+            }
+
+            // Case 4: the far child is red
+            pSibling->isRed = pParent->isRed;
+            pParent->isRed = false;
+            pSibling->pRight->isRed = false;
+            rotateLeft(pParent);
+            pNode = root;
+         }
+         else
+         {
+            BNode* pSibling = pParent->pLeft;
+
+            // Case 1: red sibling
+            if (pSibling->isRed)
+            {
+               pSibling->isRed = false;
+               pParent->isRed = true;
+               rotateRight(pParent);
+               pSibling = pParent->pLeft;
+            }
+
+            // Case 2: sibling with no red children
+            if ((!pSibling->pLeft || !pSibling->pLeft->isRed) &&
+                (!pSibling->pRight || !pSibling->pRight->isRed))
+            {
+               pSibling->isRed = true;
+               pNode = pParent;
+               pParent = pNode->pParent;
+               continue;
+            }
+
+            // Case 3: only the near child is red
+            if (!pSibling->pLeft || !pSibling->pLeft->isRed)
+            {
+               pSibling->pRight->isRed = false;
+               pSibling->isRed = true;
+               rotateLeft(pSibling);
+               pSibling = pParent->pLeft;
+            }
+
+            // Case 4: the far child is red
+            pSibling->isRed = pParent->isRed;
+            pParent->isRed = false;
+            pSibling->pLeft->isRed = false;
+            rotateRight(pParent);
+            pNode = root;
+         }
+      }
+
+      if (pNode)
+         pNode->isRed = false;
+   }
+
+   /*************************************************
+    * BST :: ROTATE LEFT
+    * pNode's right child takes its place, and pNode
+    * becomes that child's left child
+    *
+    *        pNode                 pRight
+    *        /   \                /    \
+    *       a   pRight    ==>    pNode   c
+    *           /    \          /   \
+    *          b      c        a     b
+    ************************************************/
+   template <typename T, typename A, bool Ranked>
+   void BST <T, A, Ranked>::rotateLeft(BNode* pNode)
+   {
+      BNode* pRight = pNode->pRight;
+
+      pNode->pRight = pRight->pLeft;
+      if (pRight->pLeft)
+         pRight->pLeft->pParent = pNode;
+
+      pRight->pParent = pNode->pParent;
+      if (!pNode->pParent)
+         root = pRight;
+      else if (pNode->pParent->pLeft == pNode)
+         pNode->pParent->pLeft = pRight;
+      else
+         pNode->pParent->pRight = pRight;
+
+      pRight->pLeft = pNode;
+      pNode->pParent = pRight;
+
+      pNode->resize();
+      pRight->resize();
+   }
+
+   /*************************************************
+    * BST :: ROTATE RIGHT
+    * pNode's left child takes its place, and pNode
+    * becomes that child's right child
+    *
+    *          pNode             pLeft
+    *          /   \             /   \
+    *      pLeft    c    ==>    a   pNode
+    *      /   \                    /   \
+    *     a     b                  b     c
+    ************************************************/
+   template <typename T, typename A, bool Ranked>
+   void BST <T, A, Ranked>::rotateRight(BNode* pNode)
+   {
+      BNode* pLeft = pNode->pLeft;
+
+      pNode->pLeft = pLeft->pRight;
+      if (pLeft->pRight)
+         pLeft->pRight->pParent = pNode;
+
+      pLeft->pParent = pNode->pParent;
+      if (!pNode->pParent)
+         root = pLeft;
+      else if (pNode->pParent->pLeft == pNode)
+         pNode->pParent->pLeft = pLeft;
+      else
+         pNode->pParent->pRight = pLeft;
+
+      pLeft->pRight = pNode;
+      pNode->pParent = pLeft;
+
+      pNode->resize();
+      pLeft->resize();
+   }
+
    /*****************************************************
     * BST :: CLEAR
-    * Removes all the BNodes from a tree
+    * Removes all the BNodes from a tree. The nodes only need to be
+    * visited when T has a destructor to run; the memory goes back
+    * a slab at a time either way
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   void BST <T, A, Ranked> ::clear() noexcept
+   {
+      if (!std::is_trivially_destructible<T>::value)
+         destroyTree(root);
+      nodes.release();
+      root = leftmost = rightmost = nullptr;
+      numElements = 0;
+   }
+
+   /*****************************************************
+    * BST :: NEW NODE
+    * Build a node holding u in memory from the arena
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   template <class U>
+   typename BST <T, A, Ranked> ::BNode* BST <T, A, Ranked> ::newNode(U&& u)
+   {
+      BNode* pNode = nodes.allocate();
+      try
+      {
+         return new (pNode) BNode(std::forward<U>(u));
+      }
+      catch (...)
+      {
+         nodes.deallocate(pNode);
+         throw;
+      }
+   }
+
+   /*****************************************************
+    * BST :: DELETE NODE
+    * Destroy a node and give its memory back to the arena
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   void BST <T, A, Ranked> ::deleteNode(BNode* pNode)
+   {
+      pNode->~BNode();
+      nodes.deallocate(pNode);
+   }
+
+   /*****************************************************
+    * BST :: COPY TREE
+    * Copy a subtree, returning the root of the copy. The walk
+    * follows the parent pointers back up, so it needs neither
+    * recursion nor a stack
     ****************************************************/
-   template <typename T>
-   void BST <T> ::clear() noexcept
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::BNode* BST <T, A, Ranked> ::copyTree(const BNode* pSrcRoot)
    {
-      std::function<void(BNode*)> destroy = [&](BNode* node)
+      if (!pSrcRoot)
+         return nullptr;
+
+      BNode* pDestRoot = newNode(pSrcRoot->data);
+      pDestRoot->isRed = pSrcRoot->isRed;
+      if constexpr (Ranked)
+         pDestRoot->size = pSrcRoot->size;
+
+      try
+      {
+         const BNode* pSrc = pSrcRoot;
+         BNode* pDest = pDestRoot;
+         while (true)
          {
-            if (!node)
-               return;
+            // go down the first side not yet copied
+            if (pSrc->pLeft && !pDest->pLeft)
+            {
+               pDest->pLeft = newNode(pSrc->pLeft->data);
+               pDest->pLeft->pParent = pDest;
+               pSrc = pSrc->pLeft;
+               pDest = pDest->pLeft;
+            }
+            else if (pSrc->pRight && !pDest->pRight)
+            {
+               pDest->pRight = newNode(pSrc->pRight->data);
+               pDest->pRight->pParent = pDest;
+               pSrc = pSrc->pRight;
+               pDest = pDest->pRight;
+            }
+            // both sides are copied, so climb
+            else if (pSrc == pSrcRoot)
+               break;
+            else
+            {
+               pSrc = pSrc->pParent;
+               pDest = pDest->pParent;
+               continue;
+            }
+            pDest->isRed = pSrc->isRed;
+            if constexpr (Ranked)
+               pDest->size = pSrc->size;
+         }
+      }
+      catch (...)
+      {
+         destroyTree(pDestRoot);
+         throw;
+      }
 
-            destroy(node->pLeft);
-            destroy(node->pRight);
+      return pDestRoot;
+   }
 
-            delete node;
-         };
+   /*****************************************************
+    * BST :: DESTROY TREE
+    * Destroy a subtree, returning how many nodes it had.
+    * Rotating each left child up until there
+    * is none leaves a node that can go before its right subtree,
+    * so this takes no recursion, no stack and no parent pointers
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   size_t BST <T, A, Ranked> ::destroyTree(BNode* pNode)
+   {
+      size_t num = 0;
+      while (pNode)
+      {
+         if (pNode->pLeft)
+         {
+            BNode* pLeft = pNode->pLeft;
+            pNode->pLeft = pLeft->pRight;
+            pLeft->pRight = pNode;
+            pNode = pLeft;
+         }
+         else
+         {
+            BNode* pRight = pNode->pRight;
+            deleteNode(pNode);
+            pNode = pRight;
+            num++;
+         }
+      }
+      return num;
+   }
 
-      destroy(root);
-      root = nullptr;
-      numElements = 0;
+   /*****************************************************
+    * BST :: RESET ENDS
+    * Walk down both sides of the tree to find the smallest
+    * and largest nodes. Only needed when the whole tree was
+    * replaced; insert and erase keep them up to date
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   void BST <T, A, Ranked> ::resetEnds()
+   {
+      leftmost = rightmost = root;
+      if (!root)
+         return;
+
+      while (leftmost->pLeft)
+         leftmost = leftmost->pLeft;
+      while (rightmost->pRight)
+         rightmost = rightmost->pRight;
    }
 
+
    /*****************************************************
-    * BST :: BEGIN
-    * Return the first node (left-most) in a binary search tree
+    * BST :: UNITE
+    * Add everything in rhs that is not already here. rhs
+    * is copied first, so nothing after that allocates: a
+    * failed copy leaves this tree as it was
     ****************************************************/
-   template <typename T>
-   typename BST <T> ::iterator custom::BST <T> ::begin() const noexcept
+   template <typename T, typename A, bool Ranked>
+   void BST <T, A, Ranked> ::unite(const BST <T, A, Ranked>& rhs)
    {
-      if (empty())
-         return end();
+      if (this == &rhs || !rhs.root)
+         return;
+
+      BNode* pCopy = copyTree(rhs.root);
+      BNode* pDropped = nullptr;
+      size_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+      Subtree tree = unionOf(subtree(root), subtree(pCopy), numThreads, pDropped);
+      adopt(tree, numElements + rhs.numElements, pDropped);
+   }
+
+   /*****************************************************
+    * BST :: INTERSECT
+    * Keep only what is also in rhs
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   void BST <T, A, Ranked> ::intersect(const BST <T, A, Ranked>& rhs)
+   {
+      if (this == &rhs)
+         return;
+
+      BNode* pDropped = nullptr;
+      size_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+      Subtree tree = intersectionOf(subtree(root), rhs.root, blackHeight(rhs.root), numThreads, pDropped);
+      adopt(tree, numElements, pDropped);
+   }
+
+   /*****************************************************
+    * BST :: SUBTRACT
+    * Take out everything that is in rhs
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   void BST <T, A, Ranked> ::subtract(const BST <T, A, Ranked>& rhs)
+   {
+      if (this == &rhs)
+      {
+         clear();
+         return;
+      }
+
+      BNode* pDropped = nullptr;
+      size_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+      Subtree tree = differenceOf(subtree(root), rhs.root, blackHeight(rhs.root), numThreads, pDropped);
+      adopt(tree, numElements, pDropped);
+   }
+
+   /*****************************************************
+    * BST :: ADOPT
+    * The result of the set algebra becomes the whole tree.
+    * Only now, back on one thread, are the dropped nodes
+    * given back to the arena, and counting them says how
+    * many of the num elements are left
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   void BST <T, A, Ranked> ::adopt(Subtree tree, size_t num, BNode* pDropped)
+   {
+      root = tree.pRoot;
+      resetEnds();
+
+      while (pDropped)
+      {
+         BNode* pNext = pDropped->pParent;
+         num -= destroyTree(pDropped);
+         pDropped = pNext;
+      }
+      numElements = num;
+   }
+
+   /*****************************************************
+    * BST :: UNION OF
+    * Cut other apart where tree's root goes, unite the
+    * two smaller sides and the two larger sides, and join
+    * the results around the root. An element in both keeps
+    * tree's copy
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::Subtree BST <T, A, Ranked> ::unionOf(Subtree tree, Subtree other,
+                                                      size_t numThreads, BNode*& pDropped)
+   {
+      if (!tree.pRoot)
+         return other;
+      if (!other.pRoot)
+         return tree;
+
+      BNode* pNode = tree.pRoot;
+      Subtree treeLeft = child(tree, pNode->pLeft);
+      Subtree treeRight = child(tree, pNode->pRight);
+
+      Subtree otherLeft;
+      Subtree otherRight;
+      BNode* pSame;
+      split(other, pNode->data, otherLeft, pSame, otherRight);
+      if (pSame)
+         drop(pSame, pDropped);
+
+      Subtree left;
+      Subtree right;
+      forkJoin(numThreads,
+               std::min(treeLeft.blackHeight, otherLeft.blackHeight),
+               std::min(treeRight.blackHeight, otherRight.blackHeight),
+               [&](size_t num, BNode*& pDrop) { left = unionOf(treeLeft, otherLeft, num, pDrop); },
+               [&](size_t num, BNode*& pDrop) { right = unionOf(treeRight, otherRight, num, pDrop); },
+               pDropped);
+
+      return join(left, pNode, right);
+   }
+
+   /*****************************************************
+    * BST :: INTERSECTION OF
+    * Cut tree apart at pOther's element, keep what each
+    * side shares with pOther's matching subtree, and join
+    * them around that element if tree had it too. pOther
+    * is only read
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::Subtree BST <T, A, Ranked> ::intersectionOf(Subtree tree, const BNode* pOther,
+                                                                     size_t heightOther,
+                                                                     size_t numThreads, BNode*& pDropped)
+   {
+      if (!tree.pRoot)
+         return tree;
+      if (!pOther)
+      {
+         drop(tree.pRoot, pDropped);
+         return Subtree{ nullptr, 0 };
+      }
+
+      Subtree left;
+      Subtree right;
+      BNode* pFound;
+      split(tree, pOther->data, left, pFound, right);
+
+      size_t heightChild = heightOther - (pOther->isRed ? 0 : 1);
+      forkJoin(numThreads,
+               std::min(left.blackHeight, heightChild),
+               std::min(right.blackHeight, heightChild),
+               [&](size_t num, BNode*& pDrop) { left = intersectionOf(left, pOther->pLeft, heightChild, num, pDrop); },
+               [&](size_t num, BNode*& pDrop) { right = intersectionOf(right, pOther->pRight, heightChild, num, pDrop); },
+               pDropped);
+
+      return pFound ? join(left, pFound, right) : join(left, right);
+   }
+
+   /*****************************************************
+    * BST :: DIFFERENCE OF
+    * Cut tree apart at pOther's element, dropping it if
+    * tree has it, take pOther's matching subtree from each
+    * side, and join what is left
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::Subtree BST <T, A, Ranked> ::differenceOf(Subtree tree, const BNode* pOther,
+                                                                   size_t heightOther,
+                                                                   size_t numThreads, BNode*& pDropped)
+   {
+      if (!tree.pRoot || !pOther)
+         return tree;
+
+      Subtree left;
+      Subtree right;
+      BNode* pFound;
+      split(tree, pOther->data, left, pFound, right);
+      if (pFound)
+         drop(pFound, pDropped);
+
+      size_t heightChild = heightOther - (pOther->isRed ? 0 : 1);
+      forkJoin(numThreads,
+               std::min(left.blackHeight, heightChild),
+               std::min(right.blackHeight, heightChild),
+               [&](size_t num, BNode*& pDrop) { left = differenceOf(left, pOther->pLeft, heightChild, num, pDrop); },
+               [&](size_t num, BNode*& pDrop) { right = differenceOf(right, pOther->pRight, heightChild, num, pDrop); },
+               pDropped);
+
+      return join(left, right);
+   }
+
+   /*****************************************************
+    * BST :: FORK JOIN
+    * The two halves touch different nodes, so they can run
+    * at once. The left half goes to a new thread, with half
+    * the threads left to hand out and a list of dropped
+    * nodes of its own, while this thread does the right
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   template <class Left, class Right>
+   void BST <T, A, Ranked> ::forkJoin(size_t numThreads, size_t heightLeft, size_t heightRight,
+                                      Left left, Right right, BNode*& pDropped)
+   {
+      if (numThreads < 2 || heightLeft < FORK_HEIGHT || heightRight < FORK_HEIGHT)
+      {
+         left(numThreads, pDropped);
+         right(numThreads, pDropped);
+         return;
+      }
 
-      BNode* p = root;
+      BNode* pDroppedLeft = nullptr;
+      std::future<void> futureLeft = std::async(std::launch::async, [&] { left(numThreads / 2, pDroppedLeft); });
+      right(numThreads - numThreads / 2, pDropped);
+      futureLeft.get();
 
-      while (p->pLeft)
-         p = p->pLeft;
+      while (pDroppedLeft)
+      {
+         BNode* pNext = pDroppedLeft->pParent;
+         drop(pDroppedLeft, pDropped);
+         pDroppedLeft = pNext;
+      }
+   }
 
-      return iterator(p);
+   /*****************************************************
+    * BST :: SUBTREE
+    * A whole tree as a piece
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::Subtree BST <T, A, Ranked> ::subtree(BNode* pRoot)
+   {
+      return Subtree{ pRoot, blackHeight(pRoot) };
+   }
+
+   /*****************************************************
+    * BST :: BLACK HEIGHT
+    * The black nodes down the left side of a tree, which
+    * are as many as down any other path
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   size_t BST <T, A, Ranked> ::blackHeight(const BNode* pRoot)
+   {
+      size_t height = 0;
+      for (const BNode* p = pRoot; p; p = p->pLeft)
+         if (!p->isRed)
+            height++;
+      return height;
+   }
+
+   /*****************************************************
+    * BST :: CHILD
+    * Cut a child loose from the root of a piece. Its black
+    * height is one less than the black root's; a red child
+    * turns black, which adds the one back
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::Subtree BST <T, A, Ranked> ::child(const Subtree& tree, BNode* pChild)
+   {
+      Subtree sub = { pChild, tree.blackHeight - 1 };
+      if (pChild)
+      {
+         pChild->pParent = nullptr;
+         if (pChild->isRed)
+         {
+            pChild->isRed = false;
+            sub.blackHeight++;
+         }
+      }
+      return sub;
+   }
+
+   /*****************************************************
+    * BST :: JOIN
+    * Everything in left is smaller than pMiddle, and
+    * everything in right larger. Pieces the same height
+    * hang under pMiddle. Otherwise go down the taller
+    * one's side facing the shorter until a black node as
+    * high as the shorter piece, and put a red pMiddle in
+    * its place, over it and the shorter piece. That may
+    * leave red under red, which is what insert fixes too.
+    * The cost is the difference in heights, not the size
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::Subtree BST <T, A, Ranked> ::join(Subtree left, BNode* pMiddle, Subtree right)
+   {
+      pMiddle->pParent = nullptr;
+
+      if (left.blackHeight == right.blackHeight)
+      {
+         pMiddle->pLeft = left.pRoot;
+         pMiddle->pRight = right.pRoot;
+         if (left.pRoot)
+            left.pRoot->pParent = pMiddle;
+         if (right.pRoot)
+            right.pRoot->pParent = pMiddle;
+         pMiddle->isRed = false;
+         pMiddle->resize();
+         return Subtree{ pMiddle, left.blackHeight + 1 };
+      }
+
+      bool isLeftTaller = left.blackHeight > right.blackHeight;
+      const Subtree& tall = isLeftTaller ? left : right;
+      BNode* pShort = isLeftTaller ? right.pRoot : left.pRoot;
+      size_t heightShort = isLeftTaller ? right.blackHeight : left.blackHeight;
+
+      BNode* pParent = nullptr;
+      BNode* pNode = tall.pRoot;
+      size_t height = tall.blackHeight;
+      while (height > heightShort || (pNode && pNode->isRed))
+      {
+         if (!pNode->isRed)
+            height--;
+         pParent = pNode;
+         pNode = isLeftTaller ? pNode->pRight : pNode->pLeft;
+      }
+
+      if (isLeftTaller)
+      {
+         pMiddle->pLeft = pNode;
+         pMiddle->pRight = pShort;
+         pParent->pRight = pMiddle;
+      }
+      else
+      {
+         pMiddle->pLeft = pShort;
+         pMiddle->pRight = pNode;
+         pParent->pLeft = pMiddle;
+      }
+      pMiddle->pParent = pParent;
+      if (pNode)
+         pNode->pParent = pMiddle;
+      if (pShort)
+         pShort->pParent = pMiddle;
+      pMiddle->isRed = true;
+      pMiddle->resize();
+      if constexpr (Ranked)
+         for (BNode* p = pParent; p; p = p->pParent)
+            p->size += 1 + BNode::sizeOf(pShort);
+
+      bool isTaller = pMiddle->balance();
+
+      BNode* pRoot = pMiddle;
+      while (pRoot->pParent)
+         pRoot = pRoot->pParent;
+      return Subtree{ pRoot, tall.blackHeight + (isTaller ? 1 : 0) };
+   }
+
+   /*****************************************************
+    * BST :: JOIN without a middle
+    * Take the largest element out of left to go between
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::Subtree BST <T, A, Ranked> ::join(Subtree left, Subtree right)
+   {
+      if (!left.pRoot)
+         return right;
+      if (!right.pRoot)
+         return left;
+
+      Subtree rest;
+      BNode* pLast = splitLast(left, rest);
+      return join(rest, pLast, right);
+   }
+
+   /*****************************************************
+    * BST :: SPLIT
+    * Cut tree into the elements smaller than t and those
+    * larger. Going down toward t, each node passed joins
+    * the side it belongs to with its subtree away from t.
+    * The joins cost the differences in height, which add
+    * up to O(log n)
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   void BST <T, A, Ranked> ::split(Subtree tree, const T& t, Subtree& left, BNode*& pFound, Subtree& right)
+   {
+      pFound = nullptr;
+      if (!tree.pRoot)
+      {
+         left = right = tree;
+         return;
+      }
+
+      BNode* pNode = tree.pRoot;
+      Subtree treeLeft = child(tree, pNode->pLeft);
+      Subtree treeRight = child(tree, pNode->pRight);
+      Subtree middle;
+
+      if (t < pNode->data)
+      {
+         split(treeLeft, t, left, pFound, middle);
+         right = join(middle, pNode, treeRight);
+      }
+      else if (pNode->data < t)
+      {
+         split(treeRight, t, middle, pFound, right);
+         left = join(treeLeft, pNode, middle);
+      }
+      else
+      {
+         left = treeLeft;
+         right = treeRight;
+         pNode->pLeft = pNode->pRight = pNode->pParent = nullptr;
+         pNode->resize();
+         pFound = pNode;
+      }
+   }
+
+   /*****************************************************
+    * BST :: SPLIT LAST
+    * Take the largest node out of tree, leaving the rest
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::BNode* BST <T, A, Ranked> ::splitLast(Subtree tree, Subtree& rest)
+   {
+      BNode* pNode = tree.pRoot;
+      Subtree treeLeft = child(tree, pNode->pLeft);
+      if (!pNode->pRight)
+      {
+         rest = treeLeft;
+         pNode->pLeft = nullptr;
+         pNode->resize();
+         return pNode;
+      }
+
+      BNode* pLast = splitLast(child(tree, pNode->pRight), rest);
+      rest = join(treeLeft, pNode, rest);
+      return pLast;
    }
 
 
@@ -719,8 +1833,8 @@ namespace custom
     * BST :: FIND
     * Return the node corresponding to a given value
     ****************************************************/
-   template <typename T>
-   typename BST <T> ::iterator BST<T> ::find(const T& t)
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::iterator BST <T, A, Ranked> ::find(const T& t)
    {
       BNode* current = root;
 
@@ -739,6 +1853,175 @@ namespace custom
       return end();
    }
 
+   /****************************************************
+    * BST :: LOWER BOUND
+    * Return the first element not less than t. Every
+    * time we go left, the node we leave is the best so far
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::iterator BST <T, A, Ranked> ::lower_bound(const T& t) const
+   {
+      BNode* pBound = nullptr;
+      BNode* current = root;
+
+      while (current)
+      {
+         if (current->data < t)
+            current = current->pRight;
+
+         else
+         {
+            pBound = current;
+            current = current->pLeft;
+         }
+      }
+
+      return iterator(pBound);
+   }
+
+   /****************************************************
+    * BST :: UPPER BOUND
+    * Return the first element greater than t
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::iterator BST <T, A, Ranked> ::upper_bound(const T& t) const
+   {
+      BNode* pBound = nullptr;
+      BNode* current = root;
+
+      while (current)
+      {
+         if (t < current->data)
+         {
+            pBound = current;
+            current = current->pLeft;
+         }
+
+         else
+            current = current->pRight;
+      }
+
+      return iterator(pBound);
+   }
+
+   /****************************************************
+    * BST :: EQUAL RANGE
+    * Both bounds share the path from the root down to the
+    * first element equal to t. From there, the lower bound
+    * is in its left subtree and the upper bound in its right
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   std::pair<typename BST <T, A, Ranked> ::iterator, typename BST <T, A, Ranked> ::iterator>
+      BST <T, A, Ranked> ::equal_range(const T& t) const
+   {
+      BNode* pLower = nullptr;
+      BNode* pUpper = nullptr;
+      BNode* current = root;
+
+      // walk down together until the paths part
+      while (current)
+      {
+         if (current->data < t)
+            current = current->pRight;
+
+         else if (t < current->data)
+         {
+            pLower = pUpper = current;
+            current = current->pLeft;
+         }
+
+         else
+            break;
+      }
+
+      // nothing equal, so the range is empty
+      if (!current)
+         return std::pair<iterator, iterator>(iterator(pLower), iterator(pUpper));
+
+      // the upper bound is to the right
+      for (BNode* p = current->pRight; p; )
+      {
+         if (t < p->data)
+         {
+            pUpper = p;
+            p = p->pLeft;
+         }
+         else
+            p = p->pRight;
+      }
+
+      // the lower bound is to the left, or here
+      pLower = current;
+      for (BNode* p = current->pLeft; p; )
+      {
+         if (p->data < t)
+            p = p->pRight;
+         else
+         {
+            pLower = p;
+            p = p->pLeft;
+         }
+      }
+
+      return std::pair<iterator, iterator>(iterator(pLower), iterator(pUpper));
+   }
+
+   /****************************************************
+    * BST :: SELECT
+    * Return the k-th smallest element, counting from zero.
+    * The size of the left subtree says which way to go
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::iterator BST <T, A, Ranked> ::select(size_t k) const
+   {
+      static_assert(Ranked, "select needs a ranked BST");
+      BNode* current = root;
+
+      while (current)
+      {
+         size_t numLeft = BNode::sizeOf(current->pLeft);
+         if (k == numLeft)
+            return iterator(current);
+
+         else if (k < numLeft)
+            current = current->pLeft;
+
+         else
+         {
+            k -= numLeft + 1;
+            current = current->pRight;
+         }
+      }
+
+      return end();
+   }
+
+   /****************************************************
+    * BST :: RANK
+    * Return the number of elements smaller than t. Each
+    * step right skips a node and its whole left subtree
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   size_t BST <T, A, Ranked> ::rank(const T& t) const
+   {
+      static_assert(Ranked, "rank needs a ranked BST");
+      size_t numSmaller = 0;
+      BNode* current = root;
+
+      while (current)
+      {
+         if (current->data < t)
+         {
+            numSmaller += BNode::sizeOf(current->pLeft) + 1;
+            current = current->pRight;
+         }
+         else
+            current = current->pLeft;
+      }
+
+      return numSmaller;
+   }
+
    /******************************************************
     ******************************************************
     ******************************************************
@@ -752,12 +2035,16 @@ namespace custom
      * BINARY NODE :: ADD LEFT
      * Add a node to the left of the current node
      ******************************************************/
-   template <typename T>
-   void BST <T> ::BNode::addLeft(BNode* pNode)
+   template <typename T, typename A, bool Ranked>
+   void BST <T, A, Ranked> ::BNode::addLeft(BNode* pNode)
    {
       this->pLeft = pNode;
       pNode->pParent = this;
 
+      if constexpr (Ranked)
+         for (BNode* p = this; p; p = p->pParent)
+            p->size += pNode->size;
+
       pNode->balance();
    }
 
@@ -765,53 +2052,17 @@ namespace custom
     * BINARY NODE :: ADD RIGHT
     * Add a node to the right of the current node
     ******************************************************/
-   template <typename T>
-   void BST <T> ::BNode::addRight(BNode* pNode)
+   template <typename T, typename A, bool Ranked>
+   void BST <T, A, Ranked> ::BNode::addRight(BNode* pNode)
    {
       this->pRight = pNode;
       pNode->pParent = this;
 
-      pNode->balance();
-   }
-
-   /******************************************************
-    * BINARY NODE :: ADD LEFT
-    * Add a node to the left of the current node
-    ******************************************************/
-   template <typename T>
-   void BST<T> ::BNode::addLeft(const T& t)
-   {
-      addLeft(new BNode(t));
-   }
-
-   /******************************************************
-    * BINARY NODE :: ADD LEFT
-    * Add a node to the left of the current node
-    ******************************************************/
-   template <typename T>
-   void BST<T> ::BNode::addLeft(T&& t)
-   {
-      addLeft(new BNode(std::move(t)));
-   }
+      if constexpr (Ranked)
+         for (BNode* p = this; p; p = p->pParent)
+            p->size += pNode->size;
 
-   /******************************************************
-    * BINARY NODE :: ADD RIGHT
-    * Add a node to the right of the current node
-    ******************************************************/
-   template <typename T>
-   void BST <T> ::BNode::addRight(const T& t)
-   {
-      addRight(new BNode(t));
-   }
-
-   /******************************************************
-    * BINARY NODE :: ADD RIGHT
-    * Add a node to the right of the current node
-    ******************************************************/
-   template <typename T>
-   void BST <T> ::BNode::addRight(T&& t)
-   {
-      addRight(new BNode(std::move(t)));
+      pNode->balance();
    }
 
 #ifdef DEBUG
@@ -820,8 +2071,8 @@ namespace custom
     * Find the depth of the black nodes. This is useful for
     * verifying that a given red-black tree is valid
     ****************************************************/
-   template <typename T>
-   int BST <T> ::BNode::findDepth() const
+   template <typename T, typename A, bool Ranked>
+   int BST <T, A, Ranked> ::BNode::findDepth() const
    {
       // if there are no children, the depth is ourselves
       if (pRight == nullptr && pLeft == nullptr)
@@ -838,8 +2089,8 @@ namespace custom
     * BINARY NODE :: VERIFY RED BLACK
     * Do all four red-black rules work here?
     ***************************************************/
-   template <typename T>
-   bool BST <T> ::BNode::verifyRedBlack(int depth) const
+   template <typename T, typename A, bool Ranked>
+   bool BST <T, A, Ranked> ::BNode::verifyRedBlack(int depth) const
    {
       bool fReturn = true;
       depth -= (isRed == false) ? 1 : 0;
@@ -865,7 +2116,7 @@ namespace custom
       }
 
       // Rule d) Every path from a leaf to the root has the same # of black nodes
-      if (pLeft == nullptr && pRight && nullptr)
+      if (pLeft == nullptr && pRight == nullptr)
          if (depth != 0)
             fReturn = false;
       if (pLeft != nullptr)
@@ -883,8 +2134,8 @@ namespace custom
     * VERIFY B TREE
     * Verify that the tree is correctly formed
     ******************************************************/
-   template <typename T>
-   std::pair <T, T> BST <T> ::BNode::verifyBTree() const
+   template <typename T, typename A, bool Ranked>
+   std::pair <T, T> BST <T, A, Ranked> ::BNode::verifyBTree() const
    {
       // largest and smallest values
       std::pair <T, T> extremes;
@@ -927,8 +2178,8 @@ namespace custom
     * COMPUTE SIZE
     * Verify that the BST is as large as we think it is
     ********************************************/
-   template <typename T>
-   int BST <T> ::BNode::computeSize() const
+   template <typename T, typename A, bool Ranked>
+   int BST <T, A, Ranked> ::BNode::computeSize() const
    {
       return 1 +
          (pLeft == nullptr ? 0 : pLeft->computeSize()) +
@@ -940,8 +2191,8 @@ namespace custom
     * BINARY NODE :: BALANCE
     * Balance the tree from a given location
     ******************************************************/
-   template <typename T>
-   void BST <T> ::BNode::balance()
+   template <typename T, typename A, bool Ranked>
+   bool BST <T, A, Ranked> ::BNode::balance()
    {
       BNode* node = this;
 
@@ -949,18 +2200,18 @@ namespace custom
       if (!node->pParent)
       {
          node->isRed = false;
-         return;
+         return true;
       }
 
       // Case 2: if the parent is black, then there is nothing left to do
       if (!node->pParent->isRed)
-         return;
+         return false;
 
       BNode* parent = node->pParent;
       BNode* grandparent = parent->pParent;
 
       if (!grandparent)
-         return;
+         return false;
 
       BNode* aunt = (grandparent->pLeft == parent) ? grandparent->pRight : grandparent->pLeft;
 
@@ -970,8 +2221,7 @@ namespace custom
          parent->isRed = false;
          aunt->isRed = false;
          grandparent->isRed = true;
-         grandparent->balance();
-         return;
+         return grandparent->balance();
       }
 
       // Case 4: if the aunt is black or non-existant, then we need to rotate
@@ -1002,6 +2252,8 @@ namespace custom
          }
 
          grandparent->pParent = parent;
+         grandparent->resize();
+         parent->resize();
       }
 
       // Case 4b: right-right
@@ -1030,6 +2282,8 @@ namespace custom
          }
 
          grandparent->pParent = parent;
+         grandparent->resize();
+         parent->resize();
       }
 
       // Case 4c: left-right
@@ -1065,6 +2319,9 @@ namespace custom
 
          parent->pParent = node;
          grandparent->pParent = node;
+         parent->resize();
+         grandparent->resize();
+         node->resize();
       }
 
       // Case 4d: right-left
@@ -1100,13 +2357,14 @@ namespace custom
 
          parent->pParent = node;
          grandparent->pParent = node;
+         parent->resize();
+         grandparent->resize();
+         node->resize();
       }
 
-      // ensure root is black
-      BNode* r = node;
-      while (r->pParent)
-         r = r->pParent;
-      r->isRed = false;
+      // the root is never left red: case 1 colors it, case 3 reaches it
+      // through case 1, and case 4 leaves a black node on top
+      return false;
    }
 
    /*************************************************
@@ -1121,8 +2379,8 @@ namespace custom
      * BST ITERATOR :: INCREMENT PREFIX
      * advance by one
      *************************************************/
-   template <typename T>
-   typename BST <T> ::iterator& BST <T> ::iterator :: operator ++ ()
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::iterator& BST <T, A, Ranked> ::iterator :: operator ++ ()
    {
       // Can't increment from a null node
       if (!pNode)
@@ -1138,14 +2396,14 @@ namespace custom
       }
 
       // Case 2: No right child and we are our parent's left child
-      else if (!pNode->pRight && pNode->pParent->pLeft == pNode)
+      else if (pNode->pParent && pNode->pParent->pLeft == pNode)
       {
          // Go to our parent node
          pNode = pNode->pParent;
       }
 
-      // Case 3: No right child and we are our parent's right child
-      else if (!pNode->pRight && pNode->pParent->pRight == pNode)
+      // Case 3: No right child and we are our parent's right child, or the root
+      else
       {
          // Go up to our parent nodes until we're no longer a right child, then go to our parent
          while (pNode->pParent && pNode->pParent->pRight == pNode)
@@ -1161,8 +2419,8 @@ namespace custom
     * BST ITERATOR :: DECREMENT PREFIX
     * advance by one
     *************************************************/
-   template <typename T>
-   typename BST <T> ::iterator& BST <T> ::iterator :: operator -- ()
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::iterator& BST <T, A, Ranked> ::iterator :: operator -- ()
    {
       // Can't increment from a null node
       if (!pNode)
@@ -1178,14 +2436,14 @@ namespace custom
       }
 
       // Case 2: No left child and we are our parent's right child
-      else if (!pNode->pLeft && pNode->pParent->pRight == pNode)
+      else if (pNode->pParent && pNode->pParent->pRight == pNode)
       {
          // Go to our parent node
          pNode = pNode->pParent;
       }
 
-      // Case 3: No left child and we are our parent's left child
-      else if (!pNode->pLeft && pNode->pParent->pLeft == pNode)
+      // Case 3: No left child and we are our parent's left child, or the root
+      else
       {
          // Go up to our parent nodes until we're no longer a left child, then go to our parent
          while (pNode->pParent && pNode->pParent->pLeft == pNode)
@@ -0,0 +1,1020 @@
+/***********************************************************************
+ * Header:
+ *    BTREE
+ * Summary:
+ *    A B-tree: the same ordered collection as the BST, but each node
+ *    holds many elements side by side rather than one. A lookup then
+ *    reads a handful of nodes, each a few cache lines long, rather
+ *    than one node per level of a binary tree.
+ *
+ *    Every node but the root holds between MIN_KEYS and MAX_KEYS
+ *    elements, and all the leaves are the same depth. MAX_KEYS is
+ *    however many elements fit in an inner node of NodeBytes, child
+ *    pointers and all, so the fanout follows the size of T.
+ *
+ *    Unlike the BST, inserting or erasing moves elements from node
+ *    to node, so it invalidates other iterators into the tree.
+ *
+ *    This will contain the class definition of:
+ *        BTree                : An ordered collection of elements
+ *        BTree::iterator      : An iterator through the tree
+ * Author
+ *    David Schaad, Tori Tremelling
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>          // for size_t
+#include <cstring>          // for std::memmove
+#include <memory>           // for std::allocator
+#include <utility>          // for std::pair
+#include <initializer_list> // for the initializer list
+#include <new>              // for placement new
+#include <type_traits>      // for std::is_trivially_copyable
+#include "arena.h"          // where the nodes come from
+
+class TestBTree;            // forward declaration for unit tests
+
+namespace custom
+{
+
+   /*****************************************************************
+    * BTREE
+    * An ordered collection kept in wide nodes. NodeBytes is
+    * roughly how big an inner node is. A leaf holds as many
+    * elements but no children, so it is smaller
+    *****************************************************************/
+   template <typename T, typename A = std::allocator<T>, size_t NodeBytes = 256>
+   class BTree
+   {
+      friend class ::TestBTree; // give unit tests access to the privates
+
+      // what a node spends on bookkeeping before its elements
+      static constexpr size_t HEADER = 2 * sizeof(void*);
+
+      // an inner node pays for a child pointer beside each element,
+      // plus one more for the children past the last
+      static constexpr size_t keysFor(size_t bytes)
+      {
+         return bytes < HEADER + sizeof(void*) + 3 * (sizeof(T) + sizeof(void*)) ? 3 :
+            (bytes - HEADER - sizeof(void*)) / (sizeof(T) + sizeof(void*));
+      }
+
+   public:
+      static constexpr size_t MAX_KEYS = keysFor(NodeBytes);   // elements in a full node
+      static constexpr size_t MIN_KEYS = (MAX_KEYS - 1) / 2;   // elements in a thin one
+      static_assert(MAX_KEYS < 65535, "node too wide for its counters");
+
+      //
+      // Construct
+      //
+
+      BTree();
+      BTree(const BTree& rhs);
+      BTree(BTree&& rhs);
+      BTree(const std::initializer_list<T>& il);
+      ~BTree();
+
+      //
+      // Assign
+      //
+
+      BTree& operator = (const BTree& rhs);
+      BTree& operator = (BTree&& rhs);
+      BTree& operator = (const std::initializer_list<T>& il);
+      void swap(BTree& rhs);
+
+      // replace everything with [first, last)
+      template <class Iterator>
+      void assign(Iterator first, Iterator last, bool keepUnique = false);
+
+      //
+      // Iterator
+      //
+
+      class iterator;
+      iterator   begin()  const noexcept;
+      iterator   end()    const noexcept { return iterator(); }
+      iterator   rbegin() const noexcept;
+      iterator   rend()   const noexcept { return iterator(); }
+
+      //
+      // Access
+      //
+
+      iterator find(const T& t);
+
+      // the first element not less than t, the first greater than
+      // t, and both together: the span of elements equal to t
+      iterator lower_bound(const T& t) const;
+      iterator upper_bound(const T& t) const;
+      std::pair<iterator, iterator> equal_range(const T& t) const;
+
+      //
+      // Insert
+      //
+
+      std::pair<iterator, bool> insert(const T& t, bool keepUnique = false);
+      std::pair<iterator, bool> insert(T&& t, bool keepUnique = false);
+
+      // a hint does not save a B-tree much: the walk down is short
+      std::pair<iterator, bool> insert(iterator hint, const T& t, bool keepUnique = false) { return insert(t, keepUnique); }
+      std::pair<iterator, bool> insert(iterator hint, T&& t, bool keepUnique = false) { return insert(std::move(t), keepUnique); }
+
+      //
+      // Remove
+      //
+
+      iterator erase(iterator& it);
+      void   clear() noexcept;
+
+      //
+      // Status
+      //
+
+      bool   empty() const noexcept { return size() == 0; }
+      size_t size()  const noexcept { return numElements; }
+
+   private:
+
+      class Node;
+      class Inner;
+
+      // build and give back nodes
+      Node* newLeaf();
+      Inner* newInner();
+      void deleteNode(Node* pNode);
+
+      // where t goes among the elements of one node
+      size_t lowerBound(Node* pNode, const T& t) const;
+      size_t upperBound(Node* pNode, const T& t) const;
+
+      // move elements that are already built to where there are none
+      static void moveKeys(T* pSrc, T* pDest, size_t num);
+      static void setChild(Node* pParent, size_t iChild, Node* pChild);
+
+      template <class U>
+      std::pair<iterator, bool> insertValue(U&& u, bool keepUnique);
+      template <class U>
+      void insertKey(Node* pNode, size_t iKey, U&& u, Node* pRight);
+      void makeRoom(Node*& pNode, size_t& iKey);
+
+      // fix a node left with too few elements, keeping itTrack
+      // on the same element as things move around
+      void rebalance(Node* pNode, iterator& itTrack);
+      void rotateLeft(Node* pParent, size_t iKey, iterator& itTrack);
+      void rotateRight(Node* pParent, size_t iKey, iterator& itTrack);
+      void merge(Node* pParent, size_t iKey, iterator& itTrack);
+
+      void copyNode(const Node* pSrc, Node* pDest);
+      void destroyKeys(Node* pNode);
+      void resetEnds();
+
+      using LeafAlloc  = typename std::allocator_traits<A>::template rebind_alloc<Node>;
+      using InnerAlloc = typename std::allocator_traits<A>::template rebind_alloc<Inner>;
+
+      Node* root;                     // top of the tree
+      Node* leftmost;                 // leaf holding the smallest element
+      Node* rightmost;                // leaf holding the largest element
+      size_t numElements;             // number of elements in the tree
+      arena<Node, LeafAlloc> leaves;  // where the leaves live
+      arena<Inner, InnerAlloc> inners; // where everything else lives
+   };
+
+
+   /*****************************************************************
+    * BTREE NODE
+    * A leaf: up to MAX_KEYS elements in order
+    *****************************************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   class BTree <T, A, NodeBytes> ::Node
+   {
+   public:
+      Node(bool isLeaf = true) : pParent(nullptr), iParent(0), numKeys(0), isLeaf(isLeaf) {}
+
+      T* keys()             { return reinterpret_cast<T*>(storage);       }
+      const T* keys() const { return reinterpret_cast<const T*>(storage); }
+      Node** children()     { return static_cast<Inner*>(this)->pChildren; }
+      Node* const* children() const { return static_cast<const Inner*>(this)->pChildren; }
+
+      Node* pParent;              // node above us
+      unsigned short iParent;     // which of the parent's children we are
+      unsigned short numKeys;     // how many elements are built in storage
+      bool isLeaf;                // whether we have children
+      alignas(T) unsigned char storage[MAX_KEYS * sizeof(T)];
+   };
+
+   /*****************************************************************
+    * BTREE INNER
+    * A node with children: the elements of pChildren[i] all come
+    * before keys()[i], and those of pChildren[i + 1] after it
+    *****************************************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   class BTree <T, A, NodeBytes> ::Inner : public BTree <T, A, NodeBytes> ::Node
+   {
+   public:
+      Inner() : Node(false) {}
+
+      Node* pChildren[MAX_KEYS + 1];
+   };
+
+   /*****************************************************************
+    * BTREE ITERATOR
+    * A node and which element of it
+    *****************************************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   class BTree <T, A, NodeBytes> ::iterator
+   {
+      friend class ::TestBTree; // give unit tests access to the privates
+      friend class BTree;
+   public:
+      // constructors and assignment
+      iterator(Node* p = nullptr, size_t i = 0) : pNode(p), iKey(i) {}
+      iterator(const iterator& rhs) : pNode(rhs.pNode), iKey(rhs.iKey) {}
+
+      iterator& operator = (const iterator& rhs)
+      {
+         pNode = rhs.pNode;
+         iKey = rhs.iKey;
+         return *this;
+      }
+
+      // compare
+      bool operator == (const iterator& rhs) const
+      {
+         return pNode == rhs.pNode && iKey == rhs.iKey;
+      }
+      bool operator != (const iterator& rhs) const
+      {
+         return !(*this == rhs);
+      }
+
+      // de-reference. Cannot change because it will invalidate the tree
+      const T& operator * () const
+      {
+         return pNode->keys()[iKey];
+      }
+
+      // increment and decrement
+      iterator& operator ++ ();
+      iterator   operator ++ (int postfix)
+      {
+         iterator temp(*this);
+         ++(*this);
+         return temp;
+      }
+      iterator& operator -- ();
+      iterator   operator -- (int postfix)
+      {
+         iterator temp(*this);
+         --(*this);
+         return temp;
+      }
+
+   private:
+      Node* pNode;     // node the element is in, null for end()
+      size_t iKey;     // which of its elements
+   };
+
+
+   /*********************************************
+    * BTREE :: DEFAULT CONSTRUCTOR
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   BTree <T, A, NodeBytes> ::BTree() : root(nullptr), leftmost(nullptr), rightmost(nullptr), numElements(0) {}
+
+   /*********************************************
+    * BTREE :: COPY CONSTRUCTOR
+    * Copy node for node, so the copy has the same shape
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   BTree <T, A, NodeBytes> ::BTree(const BTree& rhs) : BTree()
+   {
+      if (!rhs.root)
+         return;
+
+      root = rhs.root->isLeaf ? newLeaf() : newInner();
+      copyNode(rhs.root, root);
+      numElements = rhs.numElements;
+      resetEnds();
+   }
+
+   /*********************************************
+    * BTREE :: MOVE CONSTRUCTOR
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   BTree <T, A, NodeBytes> ::BTree(BTree&& rhs) : BTree()
+   {
+      swap(rhs);
+   }
+
+   /*********************************************
+    * BTREE :: INITIALIZER LIST CONSTRUCTOR
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   BTree <T, A, NodeBytes> ::BTree(const std::initializer_list<T>& il) : BTree()
+   {
+      for (const auto& item : il)
+         insert(item);
+   }
+
+   /*********************************************
+    * BTREE :: DESTRUCTOR
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   BTree <T, A, NodeBytes> :: ~BTree()
+   {
+      clear();
+   }
+
+   /*********************************************
+    * BTREE :: ASSIGNMENT OPERATORS
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   BTree <T, A, NodeBytes>& BTree <T, A, NodeBytes> :: operator = (const BTree& rhs)
+   {
+      if (this != &rhs)
+      {
+         BTree temp(rhs);
+         swap(temp);
+      }
+      return *this;
+   }
+
+   template <typename T, typename A, size_t NodeBytes>
+   BTree <T, A, NodeBytes>& BTree <T, A, NodeBytes> :: operator = (BTree&& rhs)
+   {
+      if (this == &rhs)
+         return *this;
+      clear();
+      swap(rhs);
+      return *this;
+   }
+
+   template <typename T, typename A, size_t NodeBytes>
+   BTree <T, A, NodeBytes>& BTree <T, A, NodeBytes> :: operator = (const std::initializer_list<T>& il)
+   {
+      clear();
+      for (const auto& item : il)
+         insert(item);
+      return *this;
+   }
+
+   /*********************************************
+    * BTREE :: ASSIGN
+    * One element at a time; unlike BST there is no
+    * bulk build from sorted input yet
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   template <class Iterator>
+   void BTree <T, A, NodeBytes> ::assign(Iterator first, Iterator last, bool keepUnique)
+   {
+      clear();
+      for (; first != last; ++first)
+         insert(*first, keepUnique);
+   }
+
+   /*********************************************
+    * BTREE :: SWAP
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   void BTree <T, A, NodeBytes> ::swap(BTree& rhs)
+   {
+      std::swap(root, rhs.root);
+      std::swap(leftmost, rhs.leftmost);
+      std::swap(rightmost, rhs.rightmost);
+      std::swap(numElements, rhs.numElements);
+      leaves.swap(rhs.leaves);
+      inners.swap(rhs.inners);
+   }
+
+   /*********************************************
+    * BTREE :: BEGIN and RBEGIN
+    * The first element of the leftmost leaf, the last
+    * element of the rightmost one
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   typename BTree <T, A, NodeBytes> ::iterator BTree <T, A, NodeBytes> ::begin() const noexcept
+   {
+      return empty() ? end() : iterator(leftmost, 0);
+   }
+
+   template <typename T, typename A, size_t NodeBytes>
+   typename BTree <T, A, NodeBytes> ::iterator BTree <T, A, NodeBytes> ::rbegin() const noexcept
+   {
+      return empty() ? rend() : iterator(rightmost, rightmost->numKeys - 1);
+   }
+
+   /*********************************************
+    * BTREE :: FIND
+    * At each node, either it is here or we know
+    * which child to look in
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   typename BTree <T, A, NodeBytes> ::iterator BTree <T, A, NodeBytes> ::find(const T& t)
+   {
+      for (Node* pNode = root; pNode; )
+      {
+         size_t i = lowerBound(pNode, t);
+         if (i < pNode->numKeys && !(t < pNode->keys()[i]))
+            return iterator(pNode, i);
+         pNode = pNode->isLeaf ? nullptr : pNode->children()[i];
+      }
+      return end();
+   }
+
+   /*********************************************
+    * BTREE :: LOWER BOUND
+    * The key a lower bound lands on in a node is the
+    * answer unless the child before it has a closer one
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   typename BTree <T, A, NodeBytes> ::iterator BTree <T, A, NodeBytes> ::lower_bound(const T& t) const
+   {
+      iterator itBound = end();
+      for (Node* pNode = root; pNode; )
+      {
+         size_t i = lowerBound(pNode, t);
+         if (i < pNode->numKeys)
+            itBound = iterator(pNode, i);
+         pNode = pNode->isLeaf ? nullptr : pNode->children()[i];
+      }
+      return itBound;
+   }
+
+   /*********************************************
+    * BTREE :: UPPER BOUND
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   typename BTree <T, A, NodeBytes> ::iterator BTree <T, A, NodeBytes> ::upper_bound(const T& t) const
+   {
+      iterator itBound = end();
+      for (Node* pNode = root; pNode; )
+      {
+         size_t i = upperBound(pNode, t);
+         if (i < pNode->numKeys)
+            itBound = iterator(pNode, i);
+         pNode = pNode->isLeaf ? nullptr : pNode->children()[i];
+      }
+      return itBound;
+   }
+
+   /*********************************************
+    * BTREE :: EQUAL RANGE
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   std::pair<typename BTree <T, A, NodeBytes> ::iterator, typename BTree <T, A, NodeBytes> ::iterator>
+      BTree <T, A, NodeBytes> ::equal_range(const T& t) const
+   {
+      return std::pair<iterator, iterator>(lower_bound(t), upper_bound(t));
+   }
+
+   /*********************************************
+    * BTREE :: INSERT
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   std::pair<typename BTree <T, A, NodeBytes> ::iterator, bool> BTree <T, A, NodeBytes> ::insert(const T& t, bool keepUnique)
+   {
+      return insertValue(t, keepUnique);
+   }
+
+   template <typename T, typename A, size_t NodeBytes>
+   std::pair<typename BTree <T, A, NodeBytes> ::iterator, bool> BTree <T, A, NodeBytes> ::insert(T&& t, bool keepUnique)
+   {
+      return insertValue(std::move(t), keepUnique);
+   }
+
+   /*********************************************
+    * BTREE :: INSERT VALUE
+    * New elements always go into a leaf. Duplicates,
+    * when allowed, go after the ones already there
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   template <class U>
+   std::pair<typename BTree <T, A, NodeBytes> ::iterator, bool> BTree <T, A, NodeBytes> ::insertValue(U&& u, bool keepUnique)
+   {
+      if (!root)
+         root = leftmost = rightmost = newLeaf();
+
+      Node* pNode = root;
+      size_t i;
+      while (true)
+      {
+         i = keepUnique ? lowerBound(pNode, u) : upperBound(pNode, u);
+         if (keepUnique && i < pNode->numKeys && !(u < pNode->keys()[i]))
+            return std::pair<iterator, bool>(iterator(pNode, i), false);
+         if (pNode->isLeaf)
+            break;
+         pNode = pNode->children()[i];
+      }
+
+      makeRoom(pNode, i);
+      insertKey(pNode, i, std::forward<U>(u), nullptr);
+      numElements++;
+      return std::pair<iterator, bool>(iterator(pNode, i), true);
+   }
+
+   /*********************************************
+    * BTREE :: INSERT KEY
+    * Put a new element at iKey in a node that has room,
+    * and, in an inner node, pRight just after it
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   template <class U>
+   void BTree <T, A, NodeBytes> ::insertKey(Node* pNode, size_t iKey, U&& u, Node* pRight)
+   {
+      assert(pNode->numKeys < MAX_KEYS);
+      T* keys = pNode->keys();
+      moveKeys(keys + iKey, keys + iKey + 1, pNode->numKeys - iKey);
+      try
+      {
+         new (keys + iKey) T(std::forward<U>(u));
+      }
+      catch (...)
+      {
+         moveKeys(keys + iKey + 1, keys + iKey, pNode->numKeys - iKey);
+         throw;
+      }
+
+      if (!pNode->isLeaf)
+      {
+         for (size_t i = pNode->numKeys + 1; i > iKey + 1; i--)
+            setChild(pNode, i, pNode->children()[i - 1]);
+         setChild(pNode, iKey + 1, pRight);
+      }
+      pNode->numKeys++;
+   }
+
+   /*********************************************
+    * BTREE :: MAKE ROOM
+    * Split pNode if it is full, so that position iKey has
+    * room for one more. The middle element moves up to the
+    * parent, which may have to split first. pNode and iKey
+    * follow the position into whichever half it lands
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   void BTree <T, A, NodeBytes> ::makeRoom(Node*& pNode, size_t& iKey)
+   {
+      if (pNode->numKeys < MAX_KEYS)
+         return;
+
+      // the tree grows at the top
+      if (!pNode->pParent)
+      {
+         root = newInner();
+         setChild(root, 0, pNode);
+      }
+
+      // make room in the parent for the middle element
+      Node* pParent = pNode->pParent;
+      size_t iParent = pNode->iParent;
+      makeRoom(pParent, iParent);
+      pParent = pNode->pParent;
+      iParent = pNode->iParent;
+
+      // everything after the middle moves to a new right sibling
+      const size_t mid = MAX_KEYS / 2;
+      Node* pRight = pNode->isLeaf ? newLeaf() : newInner();
+      moveKeys(pNode->keys() + mid + 1, pRight->keys(), MAX_KEYS - mid - 1);
+      if (!pNode->isLeaf)
+         for (size_t i = mid + 1; i <= MAX_KEYS; i++)
+            setChild(pRight, i - mid - 1, pNode->children()[i]);
+      pRight->numKeys = MAX_KEYS - mid - 1;
+
+      insertKey(pParent, iParent, std::move(pNode->keys()[mid]), pRight);
+      pNode->keys()[mid].~T();
+      pNode->numKeys = mid;
+
+      if (rightmost == pNode)
+         rightmost = pRight;
+      if (iKey > mid)
+      {
+         pNode = pRight;
+         iKey -= mid + 1;
+      }
+   }
+
+   /*********************************************
+    * BTREE :: ERASE
+    * Take an element out of a leaf. To erase from an inner
+    * node, the successor (always in a leaf) takes its place
+    * and leaves the leaf instead. Either way, the leaf may
+    * then be too thin and need rebalancing
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   typename BTree <T, A, NodeBytes> ::iterator BTree <T, A, NodeBytes> ::erase(iterator& it)
+   {
+      if (it == end())
+         return end();
+
+      Node* pNode = it.pNode;
+      size_t iKey = it.iKey;
+      iterator itNext;
+
+      if (!pNode->isLeaf)
+      {
+         Node* pLeaf = pNode->children()[iKey + 1];
+         while (!pLeaf->isLeaf)
+            pLeaf = pLeaf->children()[0];
+         pNode->keys()[iKey] = std::move(pLeaf->keys()[0]);
+         itNext = iterator(pNode, iKey);
+         pNode = pLeaf;
+         iKey = 0;
+      }
+      else
+      {
+         itNext = it;
+         ++itNext;
+         if (itNext.pNode == pNode)
+            itNext.iKey--;
+      }
+
+      T* keys = pNode->keys();
+      keys[iKey].~T();
+      moveKeys(keys + iKey + 1, keys + iKey, pNode->numKeys - iKey - 1);
+      pNode->numKeys--;
+      numElements--;
+
+      rebalance(pNode, itNext);
+      return itNext;
+   }
+
+   /*********************************************
+    * BTREE :: REBALANCE
+    * A node short of MIN_KEYS borrows from a sibling
+    * that can spare one. If neither can, it merges with
+    * one, which takes an element from the parent, so the
+    * parent may now be short instead
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   void BTree <T, A, NodeBytes> ::rebalance(Node* pNode, iterator& itTrack)
+   {
+      while (pNode != root && pNode->numKeys < MIN_KEYS)
+      {
+         Node* pParent = pNode->pParent;
+         size_t iParent = pNode->iParent;
+         Node* pLeft  = iParent > 0 ? pParent->children()[iParent - 1] : nullptr;
+         Node* pRight = iParent < pParent->numKeys ? pParent->children()[iParent + 1] : nullptr;
+
+         if (pLeft && pLeft->numKeys > MIN_KEYS)
+            return rotateRight(pParent, iParent - 1, itTrack);
+         if (pRight && pRight->numKeys > MIN_KEYS)
+            return rotateLeft(pParent, iParent, itTrack);
+
+         merge(pParent, pLeft ? iParent - 1 : iParent, itTrack);
+         pNode = pParent;
+      }
+
+      // the tree shrinks at the top
+      if (root->numKeys == 0)
+      {
+         Node* pOld = root;
+         if (root->isLeaf)
+            root = leftmost = rightmost = nullptr;
+         else
+         {
+            root = root->children()[0];
+            root->pParent = nullptr;
+            root->iParent = 0;
+         }
+         deleteNode(pOld);
+      }
+   }
+
+   /*********************************************
+    * BTREE :: ROTATE LEFT
+    * The parent's element iKey moves down to the end of the
+    * left child, and the right child's first moves up
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   void BTree <T, A, NodeBytes> ::rotateLeft(Node* pParent, size_t iKey, iterator& itTrack)
+   {
+      Node* pLeft = pParent->children()[iKey];
+      Node* pRight = pParent->children()[iKey + 1];
+      size_t numLeft = pLeft->numKeys;
+
+      if (itTrack.pNode == pParent && itTrack.iKey == iKey)
+         itTrack = iterator(pLeft, numLeft);
+      else if (itTrack.pNode == pRight)
+         itTrack = itTrack.iKey == 0 ? iterator(pParent, iKey) : iterator(pRight, itTrack.iKey - 1);
+
+      moveKeys(pParent->keys() + iKey, pLeft->keys() + numLeft, 1);
+      moveKeys(pRight->keys(), pParent->keys() + iKey, 1);
+      moveKeys(pRight->keys() + 1, pRight->keys(), pRight->numKeys - 1);
+      if (!pLeft->isLeaf)
+      {
+         setChild(pLeft, numLeft + 1, pRight->children()[0]);
+         for (size_t i = 0; i < pRight->numKeys; i++)
+            setChild(pRight, i, pRight->children()[i + 1]);
+      }
+      pLeft->numKeys++;
+      pRight->numKeys--;
+   }
+
+   /*********************************************
+    * BTREE :: ROTATE RIGHT
+    * The parent's element iKey moves down to the front of the
+    * right child, and the left child's last moves up
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   void BTree <T, A, NodeBytes> ::rotateRight(Node* pParent, size_t iKey, iterator& itTrack)
+   {
+      Node* pLeft = pParent->children()[iKey];
+      Node* pRight = pParent->children()[iKey + 1];
+      size_t numLeft = pLeft->numKeys;
+
+      if (itTrack.pNode == pRight)
+         itTrack.iKey++;
+      else if (itTrack.pNode == pParent && itTrack.iKey == iKey)
+         itTrack = iterator(pRight, 0);
+      else if (itTrack.pNode == pLeft && itTrack.iKey == numLeft - 1)
+         itTrack = iterator(pParent, iKey);
+
+      moveKeys(pRight->keys(), pRight->keys() + 1, pRight->numKeys);
+      moveKeys(pParent->keys() + iKey, pRight->keys(), 1);
+      moveKeys(pLeft->keys() + numLeft - 1, pParent->keys() + iKey, 1);
+      if (!pLeft->isLeaf)
+      {
+         for (size_t i = pRight->numKeys + 1; i > 0; i--)
+            setChild(pRight, i, pRight->children()[i - 1]);
+         setChild(pRight, 0, pLeft->children()[numLeft]);
+      }
+      pLeft->numKeys--;
+      pRight->numKeys++;
+   }
+
+   /*********************************************
+    * BTREE :: MERGE
+    * Fold the right child and the parent's element iKey
+    * into the end of the left child
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   void BTree <T, A, NodeBytes> ::merge(Node* pParent, size_t iKey, iterator& itTrack)
+   {
+      Node* pLeft = pParent->children()[iKey];
+      Node* pRight = pParent->children()[iKey + 1];
+      size_t numLeft = pLeft->numKeys;
+
+      if (itTrack.pNode == pParent && itTrack.iKey == iKey)
+         itTrack = iterator(pLeft, numLeft);
+      else if (itTrack.pNode == pParent && itTrack.iKey > iKey)
+         itTrack.iKey--;
+      else if (itTrack.pNode == pRight)
+         itTrack = iterator(pLeft, numLeft + 1 + itTrack.iKey);
+
+      moveKeys(pParent->keys() + iKey, pLeft->keys() + numLeft, 1);
+      moveKeys(pRight->keys(), pLeft->keys() + numLeft + 1, pRight->numKeys);
+      if (!pLeft->isLeaf)
+         for (size_t i = 0; i <= pRight->numKeys; i++)
+            setChild(pLeft, numLeft + 1 + i, pRight->children()[i]);
+      pLeft->numKeys += 1 + pRight->numKeys;
+
+      moveKeys(pParent->keys() + iKey + 1, pParent->keys() + iKey, pParent->numKeys - iKey - 1);
+      for (size_t i = iKey + 1; i < pParent->numKeys; i++)
+         setChild(pParent, i, pParent->children()[i + 1]);
+      pParent->numKeys--;
+
+      if (rightmost == pRight)
+         rightmost = pLeft;
+      pRight->numKeys = 0;
+      deleteNode(pRight);
+   }
+
+   /*********************************************
+    * BTREE :: CLEAR
+    * Only visit the nodes when T has a destructor to
+    * run; the memory goes back a slab at a time
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   void BTree <T, A, NodeBytes> ::clear() noexcept
+   {
+      if (root && !std::is_trivially_destructible<T>::value)
+         destroyKeys(root);
+      leaves.release();
+      inners.release();
+      root = leftmost = rightmost = nullptr;
+      numElements = 0;
+   }
+
+   /*********************************************
+    * BTREE :: COPY NODE
+    * Fill pDest, already built, with copies of pSrc and
+    * everything below it. Recursion goes only as deep as
+    * the tree is tall, a few levels
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   void BTree <T, A, NodeBytes> ::copyNode(const Node* pSrc, Node* pDest)
+   {
+      for (size_t i = 0; i < pSrc->numKeys; i++)
+      {
+         new (pDest->keys() + i) T(pSrc->keys()[i]);
+         pDest->numKeys++;
+      }
+
+      if (!pSrc->isLeaf)
+         for (size_t i = 0; i <= pSrc->numKeys; i++)
+         {
+            const Node* pChild = pSrc->children()[i];
+            setChild(pDest, i, pChild->isLeaf ? newLeaf() : newInner());
+            copyNode(pChild, pDest->children()[i]);
+         }
+   }
+
+   /*********************************************
+    * BTREE :: DESTROY KEYS
+    * Run the destructor of every element at or below pNode
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   void BTree <T, A, NodeBytes> ::destroyKeys(Node* pNode)
+   {
+      for (size_t i = 0; i < pNode->numKeys; i++)
+         pNode->keys()[i].~T();
+      if (!pNode->isLeaf)
+         for (size_t i = 0; i <= pNode->numKeys; i++)
+            destroyKeys(pNode->children()[i]);
+   }
+
+   /*********************************************
+    * BTREE :: RESET ENDS
+    * Find the leftmost and rightmost leaves again
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   void BTree <T, A, NodeBytes> ::resetEnds()
+   {
+      leftmost = rightmost = root;
+      if (!root)
+         return;
+      while (!leftmost->isLeaf)
+         leftmost = leftmost->children()[0];
+      while (!rightmost->isLeaf)
+         rightmost = rightmost->children()[rightmost->numKeys];
+   }
+
+   /*********************************************
+    * BTREE :: NEW LEAF, NEW INNER, DELETE NODE
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   typename BTree <T, A, NodeBytes> ::Node* BTree <T, A, NodeBytes> ::newLeaf()
+   {
+      return new (leaves.allocate()) Node(true);
+   }
+
+   template <typename T, typename A, size_t NodeBytes>
+   typename BTree <T, A, NodeBytes> ::Inner* BTree <T, A, NodeBytes> ::newInner()
+   {
+      return new (inners.allocate()) Inner();
+   }
+
+   template <typename T, typename A, size_t NodeBytes>
+   void BTree <T, A, NodeBytes> ::deleteNode(Node* pNode)
+   {
+      assert(pNode->numKeys == 0);
+      if (pNode->isLeaf)
+         leaves.deallocate(pNode);
+      else
+         inners.deallocate(static_cast<Inner*>(pNode));
+   }
+
+   /*********************************************
+    * BTREE :: LOWER BOUND and UPPER BOUND
+    * The first element of a node not before t, and the
+    * first one after t, by binary search
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   size_t BTree <T, A, NodeBytes> ::lowerBound(Node* pNode, const T& t) const
+   {
+      size_t iLow = 0;
+      size_t iHigh = pNode->numKeys;
+      while (iLow < iHigh)
+      {
+         size_t iMid = (iLow + iHigh) / 2;
+         if (pNode->keys()[iMid] < t)
+            iLow = iMid + 1;
+         else
+            iHigh = iMid;
+      }
+      return iLow;
+   }
+
+   template <typename T, typename A, size_t NodeBytes>
+   size_t BTree <T, A, NodeBytes> ::upperBound(Node* pNode, const T& t) const
+   {
+      size_t iLow = 0;
+      size_t iHigh = pNode->numKeys;
+      while (iLow < iHigh)
+      {
+         size_t iMid = (iLow + iHigh) / 2;
+         if (t < pNode->keys()[iMid])
+            iHigh = iMid;
+         else
+            iLow = iMid + 1;
+      }
+      return iLow;
+   }
+
+   /*********************************************
+    * BTREE :: MOVE KEYS
+    * Move num built elements from pSrc to pDest, which may
+    * overlap, leaving pSrc's unbuilt. Plain bytes move
+    * with memmove, anything else one element at a time
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   void BTree <T, A, NodeBytes> ::moveKeys(T* pSrc, T* pDest, size_t num)
+   {
+      if (num == 0 || pSrc == pDest)
+         return;
+
+      if (std::is_trivially_copyable<T>::value)
+         std::memmove(static_cast<void*>(pDest), static_cast<const void*>(pSrc), num * sizeof(T));
+      else if (pDest < pSrc)
+         for (size_t i = 0; i < num; i++)
+         {
+            new (pDest + i) T(std::move(pSrc[i]));
+            pSrc[i].~T();
+         }
+      else
+         for (size_t i = num; i > 0; i--)
+         {
+            new (pDest + i - 1) T(std::move(pSrc[i - 1]));
+            pSrc[i - 1].~T();
+         }
+   }
+
+   /*********************************************
+    * BTREE :: SET CHILD
+    * Hang pChild under pParent at iChild
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   void BTree <T, A, NodeBytes> ::setChild(Node* pParent, size_t iChild, Node* pChild)
+   {
+      pParent->children()[iChild] = pChild;
+      pChild->pParent = pParent;
+      pChild->iParent = static_cast<unsigned short>(iChild);
+   }
+
+   /*********************************************
+    * BTREE ITERATOR :: INCREMENT
+    * In an inner node, the next element is the first of the
+    * subtree to its right. In a leaf, it is the next one over,
+    * or, past the last, the first ancestor we are left of
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   typename BTree <T, A, NodeBytes> ::iterator& BTree <T, A, NodeBytes> ::iterator::operator ++ ()
+   {
+      if (!pNode)
+         return *this;
+
+      if (!pNode->isLeaf)
+      {
+         pNode = pNode->children()[iKey + 1];
+         while (!pNode->isLeaf)
+            pNode = pNode->children()[0];
+         iKey = 0;
+         return *this;
+      }
+
+      iKey++;
+      while (pNode && iKey == pNode->numKeys)
+      {
+         iKey = pNode->iParent;
+         pNode = pNode->pParent;
+      }
+      if (!pNode)
+         iKey = 0;
+      return *this;
+   }
+
+   /*********************************************
+    * BTREE ITERATOR :: DECREMENT
+    * The mirror image of increment. Before the first
+    * element is end()
+    ********************************************/
+   template <typename T, typename A, size_t NodeBytes>
+   typename BTree <T, A, NodeBytes> ::iterator& BTree <T, A, NodeBytes> ::iterator::operator -- ()
+   {
+      if (!pNode)
+         return *this;
+
+      if (!pNode->isLeaf)
+      {
+         pNode = pNode->children()[iKey];
+         while (!pNode->isLeaf)
+            pNode = pNode->children()[pNode->numKeys];
+         iKey = pNode->numKeys - 1;
+         return *this;
+      }
+
+      if (iKey > 0)
+      {
+         iKey--;
+         return *this;
+      }
+      while (pNode->pParent && pNode->iParent == 0)
+         pNode = pNode->pParent;
+      iKey = pNode->pParent ? pNode->iParent - 1 : 0;
+      pNode = pNode->pParent;
+      return *this;
+   }
+
+} // namespace custom
@@ -21,6 +21,7 @@
 #include <cassert>
 #include <iostream>
 #include "bst.h"
+#include "btree.h"    // or, for lots of elements, a B-tree
 #include <memory>     // for std::allocator
 #include <functional> // for std::less
 
@@ -33,9 +34,14 @@ namespace custom
 
     /************************************************
      * SET
-     * A class that represents a Set
+     * A class that represents a Set. A is where the
+     * nodes of the tree get their memory, and Tree is
+     * what keeps them in order: a BST, a BST that
+     * counts its subtrees (see ranked_set), or a
+     * BTree (see btree_set)
      ***********************************************/
-    template <typename T>
+    template <typename T, typename A = std::allocator<T>,
+              typename Tree = custom::BST<T, A>>
     class set
     {
         friend class ::TestSet; // give unit tests access to the privates
@@ -48,17 +54,16 @@ namespace custom
         set(const set& rhs) : bst(rhs.bst) {}
         set(set&& rhs) : bst(std::move(rhs.bst)) {}
 
+        // sorted input builds the tree directly rather than inserting
         set(const std::initializer_list <T>& il)
         {
-            clear();
-            insert(il);
+            bst.assign(il.begin(), il.end(), true /*keepUnique*/);
         }
 
         template <class Iterator>
         set(Iterator first, Iterator last)
         {
-            clear();
-            insert(first, last);
+            bst.assign(first, last, true /*keepUnique*/);
         }
         ~set() {}
 
@@ -79,8 +84,7 @@ namespace custom
         }
         set& operator = (const std::initializer_list <T>& il)
         {
-            clear();
-            insert(il);
+            bst.assign(il.begin(), il.end(), true /*keepUnique*/);
             return *this;
         }
         void swap(set& rhs) noexcept
@@ -102,6 +106,16 @@ namespace custom
             return bst.end();
         }
 
+        // the largest element; walk backwards with -- until rend()
+        iterator rbegin() const noexcept
+        {
+            return bst.rbegin();
+        }
+        iterator rend() const noexcept
+        {
+            return bst.rend();
+        }
+
         //
         // Access
         //
@@ -110,6 +124,35 @@ namespace custom
             return bst.find(t);
         }
 
+        // the first element not less than t, the first greater than t,
+        // and both together
+        iterator lower_bound(const T& t) const
+        {
+            return bst.lower_bound(t);
+        }
+        iterator upper_bound(const T& t) const
+        {
+            return bst.upper_bound(t);
+        }
+        std::pair<iterator, iterator> equal_range(const T& t) const
+        {
+            auto range = bst.equal_range(t);
+            return std::pair<iterator, iterator>(iterator(range.first), iterator(range.second));
+        }
+
+        // the k-th smallest element counting from zero, or end().
+        // Only a ranked_set can answer these two
+        iterator select(size_t k) const
+        {
+            return bst.select(k);
+        }
+
+        // how many elements are smaller than t
+        size_t rank(const T& t) const
+        {
+            return bst.rank(t);
+        }
+
         //
         // Status
         //
@@ -135,6 +178,15 @@ namespace custom
             std::pair<iterator, bool> bst_pair = bst.insert(std::move(t), true);
             return std::pair<iterator, bool>(iterator(bst_pair.first), bst_pair.second);
         }
+        // t goes right next to hint when that is where it belongs
+        iterator insert(iterator hint, const T& t)
+        {
+            return iterator(bst.insert(hint.it, t, true).first);
+        }
+        iterator insert(iterator hint, T&& t)
+        {
+            return iterator(bst.insert(hint.it, std::move(t), true).first);
+        }
         void insert(const std::initializer_list <T>& il)
         {
             for (const auto& element : il)
@@ -171,15 +223,41 @@ namespace custom
         }
         iterator erase(iterator& itBegin, iterator& itEnd)
         {
-            while (itBegin != itEnd)
+            // a B-tree moves elements around as it erases, so
+            // itEnd may not stay put; count the elements instead
+            size_t num = 0;
+            for (iterator it = itBegin; it != itEnd; ++it)
+                num++;
+
+            while (num--)
                 itBegin = erase(itBegin);
 
-            return itEnd;
+            return itBegin;
+        }
+
+        //
+        // Set algebra
+        //
+
+        // keep what is in either set, what is in both, or what is
+        // only in this one. Cheaper than a find or an insert for every
+        // element of rhs: O(m log(n/m + 1)) for sets of m and n
+        void unite(const set& rhs)
+        {
+            bst.unite(rhs.bst);
+        }
+        void intersect(const set& rhs)
+        {
+            bst.intersect(rhs.bst);
+        }
+        void subtract(const set& rhs)
+        {
+            bst.subtract(rhs.bst);
         }
 
     private:
 
-        custom::BST <T> bst;
+        Tree bst;
     };
 
 
@@ -187,15 +265,15 @@ namespace custom
      * SET ITERATOR
      * An iterator through Set
      *************************************************/
-    template <typename T>
-    class set <T> ::iterator
+    template <typename T, typename A, typename Tree>
+    class set <T, A, Tree> ::iterator
     {
         friend class ::TestSet; // give unit tests access to the privates
-        friend class custom::set<T>;
+        friend class custom::set<T, A, Tree>;
     public:
         // constructors, destructors, and assignment operator
         iterator() {}
-        iterator(const typename custom::BST<T>::iterator& itRHS) : it(itRHS) {}
+        iterator(const typename Tree::iterator& itRHS) : it(itRHS) {}
         iterator(const iterator& rhs) : it(rhs.it) {}
 
         iterator& operator = (const iterator& rhs)
@@ -252,9 +330,24 @@ namespace custom
 
     private:
 
-        typename custom::BST<T>::iterator it;
+        typename Tree::iterator it;
     };
 
+    /************************************************
+     * BTREE SET
+     * A set kept in a B-tree rather than a BST
+     ***********************************************/
+    template <typename T, typename A = std::allocator<T>>
+    using btree_set = set<T, A, BTree<T, A>>;
 
+    /************************************************
+     * RANKED SET
+     * A set that can find the k-th smallest element
+     * and count what is smaller than a value, both in
+     * O(log n). It pays for that with a count in every
+     * node, kept up on every insert and erase
+     ***********************************************/
+    template <typename T, typename A = std::allocator<T>>
+    using ranked_set = set<T, A, BST<T, A, true>>;
 
 }; // namespace custom
@@ -20,6 +20,11 @@
 #include <iostream>
 #include <string>
 #include <functional> // for std::less and std::greater
+#include <algorithm>  // for std::max
+#include <cmath>      // for std::log2
+#include <cstdlib>    // for std::rand
+#include <vector>     // for std::vector
+#include <iterator>   // for std::back_inserter
 
  /***********************************************
   * TEST BST
@@ -38,11 +43,15 @@ public:
       test_constructCopy_empty();
       test_constructCopy_one();
       test_constructCopy_standard();
+      test_constructCopy_deep();
       test_constructMove_empty();
       test_constructMove_one();
       test_constructMove_standard();
       test_constructInitializer_empty();
       test_constructInitializer_standard();
+      test_constructInitializer_sorted();
+      test_assign_sortedEverySize();
+      test_assign_sortedDuplicates();
 
       // Assign
       test_assign_emptyToEmpty();
@@ -51,6 +60,7 @@ public:
       test_assign_oneToStandard();
       test_assign_standardToOne();
       test_assign_standardToStandard();
+      test_assign_otherShape();
       test_assignMove_emptyToEmpty();
       test_assignMove_standardToEmpty();
       test_assignMove_emptyToStandard();
@@ -68,6 +78,9 @@ public:
       test_begin_empty();
       test_begin_standard();
       test_end_standard();
+      test_rbegin_standard();
+      test_ends_orderedQueue();
+      test_ends_copySwap();
       test_iterator_increment_standardToParent();
       test_iterator_increment_standardToChild();
       test_iterator_increment_standardToGrandma();
@@ -82,6 +95,21 @@ public:
       test_find_standardLast();
       test_find_standardMissing();
 
+      // Bounds
+      test_lowerBound_standard();
+      test_upperBound_standard();
+      test_equalRange_standardMissing();
+      test_equalRange_duplicates();
+      test_bounds_randomStress();
+
+      // Order statistics
+      test_select_empty();
+      test_select_standard();
+      test_rank_standard();
+      test_order_randomStress();
+      test_order_copy();
+      test_order_unranked();
+
       // Insert
       test_insert_oneLeft();
       test_insert_oneRight();
@@ -91,6 +119,12 @@ public:
       test_insertMove_oneRight();
       test_insertMove_duplicate();
       test_insertMove_keepUnique();
+      test_insertHint_before();
+      test_insertHint_after();
+      test_insertHint_duplicate();
+      test_insertHint_wrong();
+      test_insertHint_descending();
+      test_insert_appendAscending();
       test_insert_case1();
       test_insert_case2();
       test_insert_case3();
@@ -109,8 +143,24 @@ public:
       test_erase_noChildren();
       test_erase_oneChild();
       test_erase_twoChildren();
+      test_erase_blackLeafRecolor();
+      test_erase_blackLeafRotate();
+      test_erase_randomStress();
+      test_erase_inOrderChurn();
       test_clear_empty();
       test_clear_standard();
+      test_clear_slabs();
+      test_clear_deep();
+
+      // Set algebra
+      test_unite_overlap();
+      test_intersect_overlap();
+      test_subtract_overlap();
+      test_setAlgebra_edges();
+      test_setAlgebra_lopsided();
+      test_setAlgebra_randomStress();
+      test_setAlgebra_threads();
+      test_setAlgebra_dropped();
 
       // Status
       test_empty_empty();
@@ -178,7 +228,7 @@ public:
       // setup
       //            (50b)
       custom::BST <Spy> bstSrc;
-      custom::BST<Spy>::BNode* p50 = new custom::BST<Spy>::BNode(Spy(50));
+      custom::BST<Spy>::BNode* p50 = bstSrc.newNode(Spy(50));
       p50->isRed = false;
       bstSrc.root = p50;
       bstSrc.numElements = 1;
@@ -218,11 +268,11 @@ public:
       }
       // teardown
       if (bstSrc.root)
-         delete bstSrc.root;
+         bstSrc.deleteNode(bstSrc.root);
       bstSrc.root = nullptr;
       bstSrc.numElements = 0;
       if (bstDest.root)
-         delete bstDest.root;
+         bstDest.deleteNode(bstDest.root);
       bstDest.root = nullptr;
       bstDest.numElements = 0;
    }
@@ -274,6 +324,30 @@ public:
     ***************************************/
 
     // move an empty BST
+   // copy a tree that is one long chain, far deeper than
+   // the stack would allow a recursive copy to go
+   void test_constructCopy_deep()
+   {  // setup
+      //   (0)
+      //     +--(1)
+      //          +--(2) ...
+      custom::BST<int> bstSrc;
+      buildChain(bstSrc, 200000);
+      // exercise
+      custom::BST<int> bstDest(bstSrc);
+      // verify
+      assertUnit(bstDest.numElements == 200000);
+      assertUnit(bstDest.root != bstSrc.root);
+      int i = 0;
+      bool sameShape = true;
+      for (auto p = bstDest.root, pParent = (custom::BST<int>::BNode*)nullptr;
+           p; pParent = p, p = p->pRight, i++)
+         sameShape = sameShape && p->data == i && p->pLeft == nullptr &&
+                     p->pParent == pParent && p->isRed == (i % 2 == 1);
+      assertUnit(sameShape);
+      assertUnit(i == 200000);
+   }  // teardown
+
    void test_constructMove_empty()
    {  // setup
       custom::BST<Spy> bstSrc;
@@ -301,7 +375,7 @@ public:
       // setup
       //            (50b)
       custom::BST <Spy> bstSrc;
-      custom::BST<Spy>::BNode* p50 = new custom::BST<Spy>::BNode(Spy(50));
+      custom::BST<Spy>::BNode* p50 = bstSrc.newNode(Spy(50));
       p50->isRed = false;
       bstSrc.root = p50;
       bstSrc.numElements = 1;
@@ -338,7 +412,7 @@ public:
       }
       // teardown
       if (bstDest.root)
-         delete bstDest.root;
+         bstDest.deleteNode(bstDest.root);
       bstDest.root = nullptr;
       bstDest.numElements = 0;
    }
@@ -421,12 +495,85 @@ public:
       assertUnit(Spy::numAssign() == 0);
       assertUnit(Spy::numAssignMove() == 0);
       assertUnit(Spy::numEquals() == 0);
-      assertUnit(Spy::numLessthan() == 10);
+      assertUnit(Spy::numLessthan() == 14);    // [50][30] shows it is not sorted, then 13 to insert
+      assertStandardFixture(bstDest);
+      // teardown
+      teardownStandardFixture(bstDest);
+   }
+
+   // sorted input is laid out in place: one comparison per neighbor
+   void test_constructInitializer_sorted()
+   {  // setup
+      //                (50b)
+      //          +-------+-------+
+      //        (30b)           (70b)
+      //     +----+----+     +----+----+
+      //   (20r)     (40r) (60r)     (80r)
+      std::initializer_list<Spy> ilSrc{Spy(20), Spy(30), Spy(40), Spy(50), Spy(60), Spy(70), Spy(80)};
+      Spy::reset();
+      // exercise
+      custom::BST <Spy, std::allocator<Spy>, true> bstDest(ilSrc);
+      // verify
+      assertUnit(Spy::numCopy() == 7);
+      assertUnit(Spy::numAlloc() == 7);
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(Spy::numLessthan() == 6);     // [20][30] [30][40] ... [70][80]
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(bstDest.root->size == 7);
+      assertUnit(bstDest.root->pLeft->size == 3);
       assertStandardFixture(bstDest);
       // teardown
       teardownStandardFixture(bstDest);
    }
 
+   // whether or not the last level is full, the colors work out
+   void test_assign_sortedEverySize()
+   {  // setup
+      bool isValid = true;
+      // exercise
+      for (int num = 0; num <= 130; num++)
+      {
+         std::vector<int> v;
+         for (int i = 0; i < num; i++)
+            v.push_back(i * 2);
+         custom::BST <int, std::allocator<int>, true> bst;
+         bst.insert(-1);
+         bst.assign(v.begin(), v.end());
+
+         isValid = isValid &&
+                   isRedBlack(bst) &&
+                   bst.numElements == (size_t)num &&
+                   bst.leftmost == findLeftmost(bst.root) &&
+                   bst.rightmost == findRightmost(bst.root) &&
+                   findHeight(bst.root) <= (int)std::log2((double)num + 1.0) + 1;
+         if (num)
+            isValid = isValid && *bst.select(num / 2) == num / 2 * 2;
+         bst.clear();
+      }
+      // verify
+      assertUnit(isValid);
+   }  // teardown
+
+   // a duplicate means it is not a sorted set, so insert instead
+   void test_assign_sortedDuplicates()
+   {  // setup
+      std::vector<int> v{ 10, 20, 20, 30 };
+      custom::BST <int> bstMulti;
+      custom::BST <int> bstUnique;
+      // exercise
+      bstMulti.assign(v.begin(), v.end());
+      bstUnique.assign(v.begin(), v.end(), true /*keepUnique*/);
+      // verify
+      assertUnit(bstMulti.size() == 4);
+      assertUnit(bstUnique.size() == 3);
+      assertUnit(isRedBlack(bstMulti));
+      assertUnit(isRedBlack(bstUnique));
+      // teardown
+      bstMulti.clear();
+      bstUnique.clear();
+   }
+
 
 
    /***************************************
@@ -650,7 +797,7 @@ public:
       setupStandardFixture(bstSrc);
       //                (99) = bstDest
       custom::BST <Spy> bstDest;
-      custom::BST <Spy>::BNode* p99 = new custom::BST<Spy>::BNode(Spy(99));
+      custom::BST <Spy>::BNode* p99 = bstDest.newNode(Spy(99));
       p99->isRed = false;
       bstDest.root = p99;
       bstDest.numElements = 1;
@@ -692,7 +839,7 @@ public:
    {  // setup
       //                (99) = bstSrc
       custom::BST <Spy> bstSrc;
-      custom::BST <Spy>::BNode* p99 = new custom::BST<Spy>::BNode(Spy(99));
+      custom::BST <Spy>::BNode* p99 = bstSrc.newNode(Spy(99));
       p99->isRed = false;
       bstSrc.root = p99;
       bstSrc.numElements = 1;
@@ -801,6 +948,32 @@ public:
     ***************************************/
 
     // assignment-move operator: empty = std::move(empty)
+   // assign onto a tree of another shape; what the two have in
+   // common is reused, the rest trimmed or copied
+   void test_assign_otherShape()
+   {  // setup
+      custom::BST<int> bstSrc;
+      for (int i = 0; i < 100; i++)
+         bstSrc.insert(i);
+      custom::BST<int> bstDest;
+      for (int i = 0; i < 60; i++)
+         bstDest.insert(1000 - i * 3);
+      auto pRootDest = bstDest.root;
+      // exercise
+      bstDest = bstSrc;
+      // verify
+      assertUnit(bstDest.numElements == 100);
+      assertUnit(bstDest.root == pRootDest);
+      assertUnit(isRedBlack(bstDest));
+      int i = 0;
+      bool inOrder = true;
+      for (auto it = bstDest.begin(); it != bstDest.end(); ++it, i++)
+         inOrder = inOrder && *it == i;
+      assertUnit(inOrder);
+      assertUnit(i == 100);
+      assertUnit(bstSrc.numElements == 100);
+   }  // teardown
+
    void test_assignMove_emptyToEmpty()
    {  // setup
       custom::BST <Spy> bstSrc;
@@ -896,7 +1069,7 @@ public:
       setupStandardFixture(bstSrc);
       //                (99) = bstDest
       custom::BST <Spy> bstDest;
-      custom::BST <Spy>::BNode* p99 = new custom::BST<Spy>::BNode(Spy(99));
+      custom::BST <Spy>::BNode* p99 = bstDest.newNode(Spy(99));
       p99->isRed = false;
       bstDest.root = p99;
       bstDest.numElements = 1;
@@ -931,7 +1104,7 @@ public:
    {  // setup
       //                (99) = bstSrc
       custom::BST <Spy> bstSrc;
-      custom::BST <Spy>::BNode* p99 = new custom::BST<Spy>::BNode(Spy(99));
+      custom::BST <Spy>::BNode* p99 = bstSrc.newNode(Spy(99));
       p99->isRed = false;
       bstSrc.root = p99;
       bstSrc.numElements = 1;
@@ -1050,7 +1223,7 @@ public:
       std::initializer_list<Spy> ilSrc{ Spy(50), Spy(30), Spy(70), Spy(20), Spy(40), Spy(60), Spy(80) };
       //                (99) = bstDest
       custom::BST <Spy> bstDest;
-      custom::BST <Spy>::BNode* p99 = new custom::BST<Spy>::BNode(Spy(99));
+      custom::BST <Spy>::BNode* p99 = bstDest.newNode(Spy(99));
       p99->isRed = false;
       bstDest.root = p99;
       bstDest.numElements = 1;
@@ -1067,7 +1240,7 @@ public:
       assertUnit(Spy::numAssign() == 0);
       assertUnit(Spy::numAssignMove() == 0);
       assertUnit(Spy::numEquals() == 0);
-      assertUnit(Spy::numLessthan() == 10);
+      assertUnit(Spy::numLessthan() == 14);    // [50][30] shows it is not sorted, then 13 to insert
       assertStandardFixture(bstDest);
       // teardown
       teardownStandardFixture(bstDest);
@@ -1265,6 +1438,41 @@ public:
       assertEmptyFixture(bst);
    }  // teardown
 
+   // clear gives the nodes back a slab at a time, and the tree
+   // can be filled again afterwards
+   void test_clear_slabs()
+   {  // setup
+      custom::BST<int> bst;
+      for (int i = 0; i < 1000; i++)
+         bst.insert(i * 7 % 1000);
+      size_t numSlabs = bst.nodes.slabs();
+      // exercise
+      bst.clear();
+      // verify
+      assertUnit(numSlabs > 1);
+      assertUnit(numSlabs < 20);             // not one per node
+      assertUnit(bst.nodes.slabs() == 0);
+      assertUnit(bst.root == nullptr);
+      assertUnit(bst.numElements == 0);
+      bst.insert(26);
+      assertUnit(bst.size() == 1);
+      assertUnit(bst.nodes.slabs() == 1);
+   }  // teardown
+
+   // clear a chain too deep to destroy recursively
+   void test_clear_deep()
+   {  // setup
+      custom::BST<Spy> bst;
+      buildChain(bst, 200000);
+      Spy::reset();
+      // exercise
+      bst.clear();
+      // verify
+      assertUnit(Spy::numDestructor() == 200000);
+      assertUnit(bst.nodes.slabs() == 0);
+      assertEmptyFixture(bst);
+   }  // teardown
+
    /***************************************
     * Iterator
     *     BST::begin()
@@ -1367,6 +1575,96 @@ public:
       teardownStandardFixture(bst);
    }
 
+   // rbegin() from the standard fixture
+   void test_rbegin_standard()
+   {  // setup
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //     +----+----+     +----+----+
+      //    20        40    60        80  
+      custom::BST <Spy> bst;
+      setupStandardFixture(bst);
+      custom::BST<Spy>::iterator it;
+      Spy::reset();
+      // exercise
+      it = bst.rbegin();
+      // verify
+      assertUnit(Spy::numLessthan() == 0);    // does not look at any element
+      assertUnit(Spy::numEquals() == 0);      // does not look at any element
+      assertUnit(it.pNode == bst.root->pRight->pRight);
+      assertUnit(*it == Spy(80));
+      assertUnit(*(--it) == Spy(70));
+      assertUnit(bst.rend().pNode == nullptr);
+      assertStandardFixture(bst);
+      // teardown
+      teardownStandardFixture(bst);
+   }
+
+   // take the smallest off again and again while adding more,
+   // begin() and rbegin() always pointing at the ends
+   void test_ends_orderedQueue()
+   {  // setup
+      custom::BST<int> bst;
+      std::srand(44);
+      for (int i = 0; i < 200; i++)
+         bst.insert(std::rand() % 1000);
+      bool atEnds = true;
+      // exercise
+      for (int i = 0; i < 2000; i++)
+      {
+         auto it = bst.begin();
+         if (i % 3 != 2)
+            bst.erase(it);
+         bst.insert(std::rand() % 1000);
+         if (i % 7 == 0)
+         {
+            auto itLast = bst.rbegin();
+            bst.erase(itLast);
+         }
+         // verify
+         atEnds = atEnds && bst.leftmost == findLeftmost(bst.root)
+                         && bst.rightmost == findRightmost(bst.root);
+      }
+      assertUnit(atEnds);
+      assertUnit(isRedBlack(bst));
+      // drain it from the front
+      while (!bst.empty())
+      {
+         auto it = bst.begin();
+         bst.erase(it);
+         atEnds = atEnds && bst.leftmost == findLeftmost(bst.root);
+      }
+      assertUnit(atEnds);
+      assertUnit(bst.leftmost == nullptr);
+      assertUnit(bst.rightmost == nullptr);
+   }  // teardown
+
+   // copies, assignments and swaps carry their own ends
+   void test_ends_copySwap()
+   {  // setup
+      custom::BST<int> bst1;
+      custom::BST<int> bst2;
+      for (int i = 0; i < 50; i++)
+         bst1.insert(i);
+      bst2.insert(99);
+      // exercise
+      custom::BST<int> bstCopy(bst1);
+      bst2.swap(bstCopy);
+      custom::BST<int> bstAssign;
+      bstAssign.insert(-1);
+      bstAssign = bst1;
+      // verify
+      assertUnit(*bst2.begin() == 0);
+      assertUnit(*bst2.rbegin() == 49);
+      assertUnit(bst2.leftmost != bst1.leftmost);
+      assertUnit(*bstCopy.begin() == 99);
+      assertUnit(bstCopy.begin() == bstCopy.rbegin());
+      assertUnit(bstAssign.leftmost == findLeftmost(bstAssign.root));
+      assertUnit(bstAssign.rightmost == findRightmost(bstAssign.root));
+      assertUnit(*bstAssign.begin() == 0);
+   }  // teardown
+
    // increment where the next node is the parent
    void test_iterator_increment_standardToParent()
    {  // setup
@@ -1798,7 +2096,304 @@ public:
       teardownStandardFixture(bst);
    }
 
+   /***************************************
+    * BOUNDS
+    *    BST::lower_bound(const T &)
+    *    BST::upper_bound(const T &)
+    *    BST::equal_range(const T &)
+    ***************************************/
+
+   // one trip down the tree, remembering where we last went left
+   void test_lowerBound_standard()
+   {  // setup
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //     +----+----+     +----+----+
+      //    20        40    60        80  
+      custom::BST <Spy> bst;
+      setupStandardFixture(bst);
+      Spy s(55);
+      Spy::reset();
+      // exercise
+      custom::BST<Spy>::iterator it = bst.lower_bound(s);
+      // verify
+      assertUnit(Spy::numLessthan() == 3);    // compare [50][70][60]
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(*it == Spy(60));
+      assertUnit(*bst.lower_bound(Spy(60)) == Spy(60));
+      assertUnit(*bst.lower_bound(Spy(10)) == Spy(20));
+      assertUnit(bst.lower_bound(Spy(81)) == bst.end());
+      assertStandardFixture(bst);
+      // teardown
+      teardownStandardFixture(bst);
+   }
+
+   // the upper bound skips past an equal element
+   void test_upperBound_standard()
+   {  // setup
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //     +----+----+     +----+----+
+      //    20        40    60        80  
+      custom::BST <Spy> bst;
+      setupStandardFixture(bst);
+      Spy s(40);
+      Spy::reset();
+      // exercise
+      custom::BST<Spy>::iterator it = bst.upper_bound(s);
+      // verify
+      assertUnit(Spy::numLessthan() == 3);    // compare [50][30][40]
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(*it == Spy(50));
+      assertUnit(*bst.upper_bound(Spy(10)) == Spy(20));
+      assertUnit(bst.upper_bound(Spy(80)) == bst.end());
+      assertStandardFixture(bst);
+      // teardown
+      teardownStandardFixture(bst);
+   }
+
+   // an empty range sits where the missing element would go
+   void test_equalRange_standardMissing()
+   {  // setup
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //     +----+----+     +----+----+
+      //    20        40    60        80  
+      custom::BST <Spy> bst;
+      setupStandardFixture(bst);
+      Spy s(65);
+      Spy::reset();
+      // exercise
+      auto range = bst.equal_range(s);
+      // verify
+      assertUnit(Spy::numLessthan() == 4);    // compare [50][70][70][60]
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(range.first == range.second);
+      assertUnit(*range.first == Spy(70));
+      assertStandardFixture(bst);
+      // teardown
+      teardownStandardFixture(bst);
+   }
+
+   // every copy of a duplicated element is inside the range
+   void test_equalRange_duplicates()
+   {  // setup
+      custom::BST <int, std::allocator<int>, true> bst;
+      for (int i = 0; i < 10; i++)
+         for (int j = 0; j < 3; j++)
+            bst.insert(i);
+      // exercise
+      auto range = bst.equal_range(4);
+      // verify
+      int num = 0;
+      bool isEqual = true;
+      for (auto it = range.first; it != range.second; ++it, ++num)
+         isEqual = isEqual && *it == 4;
+      assertUnit(num == 3);
+      assertUnit(isEqual);
+      assertUnit(range.first == bst.lower_bound(4));
+      assertUnit(range.second == bst.upper_bound(4));
+      assertUnit(*range.second == 5);
+      assertUnit(bst.rank(4) == 12);
+      // teardown
+      bst.clear();
+   }
+
+   // the bounds agree with a walk through every element
+   void test_bounds_randomStress()
+   {  // setup
+      custom::BST <int> bst;
+      std::srand(47);
+      for (int i = 0; i < 500; i++)
+         bst.insert(std::rand() % 200);
+      bool isValid = true;
+      // exercise
+      for (int value = -1; value <= 200; value++)
+      {
+         auto itLower = bst.begin();
+         while (itLower != bst.end() && *itLower < value)
+            ++itLower;
+         auto itUpper = itLower;
+         while (itUpper != bst.end() && !(value < *itUpper))
+            ++itUpper;
+
+         auto range = bst.equal_range(value);
+         isValid = isValid &&
+                   bst.lower_bound(value) == itLower &&
+                   bst.upper_bound(value) == itUpper &&
+                   range.first == itLower && range.second == itUpper;
+      }
+      // verify
+      assertUnit(isValid);
+      // teardown
+      bst.clear();
+   }
+
+   /***************************************
+    * ORDER STATISTICS
+    *    BST::select(size_t)
+    *    BST::rank(const T &)
+    ***************************************/
+
+   // nothing to select in an empty tree
+   void test_select_empty()
+   {  // setup
+      typedef custom::BST <Spy, std::allocator<Spy>, true> BST;
+      BST bst;
+      // exercise
+      BST::iterator it = bst.select(0);
+      size_t numSmaller = bst.rank(Spy(50));
+      // verify
+      assertUnit(it == bst.end());
+      assertUnit(numSmaller == 0);
+      assertEmptyFixture(bst);
+   }  // teardown
+
+   // select walks down by the size of the left subtrees
+   void test_select_standard()
+   {  // setup
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //     +----+----+     +----+----+
+      //    20        40    60        80  
+      typedef custom::BST <Spy, std::allocator<Spy>, true> BST;
+      BST bst;
+      setupStandardFixture(bst);
+      Spy::reset();
+      // exercise
+      BST::iterator it = bst.select(4);
+      // verify
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(it != bst.end());
+      assertUnit(*it == Spy(60));
+      assertUnit(*bst.select(0) == Spy(20));
+      assertUnit(*bst.select(3) == Spy(50));
+      assertUnit(*bst.select(6) == Spy(80));
+      assertUnit(bst.select(7) == bst.end());
+      assertStandardFixture(bst);
+      // teardown
+      teardownStandardFixture(bst);
+   }
+
+   // rank counts what is smaller, present or not
+   void test_rank_standard()
+   {  // setup
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //     +----+----+     +----+----+
+      //    20        40    60        80  
+      typedef custom::BST <Spy, std::allocator<Spy>, true> BST;
+      BST bst;
+      setupStandardFixture(bst);
+      Spy s(55);
+      Spy::reset();
+      // exercise
+      size_t numSmaller = bst.rank(s);
+      // verify
+      assertUnit(Spy::numLessthan() == 3);    // compare [50][70][60]
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(numSmaller == 4);
+      assertUnit(bst.rank(Spy(10)) == 0);
+      assertUnit(bst.rank(Spy(20)) == 0);
+      assertUnit(bst.rank(Spy(50)) == 3);
+      assertUnit(bst.rank(Spy(80)) == 6);
+      assertUnit(bst.rank(Spy(99)) == 7);
+      assertStandardFixture(bst);
+      // teardown
+      teardownStandardFixture(bst);
+   }
 
+   // the counts survive every rotation insert and erase can make
+   void test_order_randomStress()
+   {  // setup
+      typedef custom::BST <int, std::allocator<int>, true> BST;
+      BST bst;
+      std::srand(46);
+      bool isValid = true;
+      // exercise
+      for (int i = 0; i < 5000; i++)
+      {
+         int value = std::rand() % 300;
+         auto it = bst.find(value);
+         if (it == bst.end())
+            bst.insert(value);
+         else
+            bst.erase(it);
+
+         if (i % 50 == 0)
+         {
+            size_t k = 0;
+            for (auto itWalk = bst.begin(); itWalk != bst.end(); ++itWalk, ++k)
+               isValid = isValid && bst.select(k) == itWalk && bst.rank(*itWalk) == k;
+         }
+      }
+      // verify
+      assertUnit(isValid);
+      assertUnit(isRedBlack(bst));
+      assertUnit(bst.select(bst.size()) == bst.end());
+      // teardown
+      bst.clear();
+   }
+
+   // a copy carries the counts along
+   void test_order_copy()
+   {  // setup
+      typedef custom::BST <int, std::allocator<int>, true> BST;
+      BST bstSrc;
+      for (int i = 0; i < 100; i++)
+         bstSrc.insert(i * 37 % 100);
+      BST bstDest;
+      for (int i = 0; i < 10; i++)
+         bstDest.insert(i);
+      // exercise
+      BST bstCopy(bstSrc);
+      bstDest = bstSrc;
+      // verify
+      assertUnit(isRedBlack(bstCopy));
+      assertUnit(isRedBlack(bstDest));
+      assertUnit(*bstCopy.select(42) == 42);
+      assertUnit(*bstDest.select(99) == 99);
+      assertUnit(bstDest.rank(50) == 50);
+      // teardown
+      bstSrc.clear();
+      bstDest.clear();
+      bstCopy.clear();
+   }
+
+   // without the counts the nodes are smaller, and insert and
+   // erase keep the tree just as balanced
+   void test_order_unranked()
+   {  // setup
+      typedef custom::BST <int, std::allocator<int>, false> BST;
+      BST bst;
+      std::srand(46);
+      // exercise
+      for (int i = 0; i < 5000; i++)
+      {
+         int value = std::rand() % 300;
+         auto it = bst.find(value);
+         if (it == bst.end())
+            bst.insert(value);
+         else
+            bst.erase(it);
+      }
+      for (int i = 300; i < 1300; i++)
+         bst.insert(i);
+      // verify
+      assertUnit(sizeof(BST::BNode) < sizeof(custom::BST <int, std::allocator<int>, true>::BNode));
+      assertUnit(isRedBlack(bst));
+      assertUnit(bst.rightmost->data == 1299);
+      // teardown
+      bst.clear();
+   }
 
    /***************************************
     * Insert
@@ -1810,10 +2405,11 @@ public:
    {  // setup
       //            (50b)
       custom::BST <Spy> bst;
-      custom::BST<Spy>::BNode* p50 = new custom::BST<Spy>::BNode(Spy(50));
+      custom::BST<Spy>::BNode* p50 = bst.newNode(Spy(50));
       p50->isRed = false;
       bst.root = p50;
       bst.numElements = 1;
+      bst.resetEnds();
       Spy s(60);
       Spy::reset();
       // exercise
@@ -1860,9 +2456,9 @@ public:
       }
       // teardown
       if (p50 && p50->pRight && p50->pRight != p50)
-         delete p50->pRight;
+         bst.deleteNode(p50->pRight);
       if (p50)
-         delete p50;
+         bst.deleteNode(p50);
       bst.root = nullptr;
       bst.numElements = 0;
    }
@@ -1872,16 +2468,17 @@ public:
    {  // setup
       //            (50b)
       custom::BST <Spy> bst;
-      custom::BST<Spy>::BNode* p50 = new custom::BST<Spy>::BNode(Spy(50));
+      custom::BST<Spy>::BNode* p50 = bst.newNode(Spy(50));
       p50->isRed = false;
       bst.root = p50;
       bst.numElements = 1;
+      bst.resetEnds();
       Spy s(40);
       Spy::reset();
       // exercise
       auto pairBST = bst.insert(s);
       // verify
-      assertUnit(Spy::numLessthan() == 1);    // compare [50]
+      assertUnit(Spy::numLessthan() == 2);    // compare the largest, then [50]
       assertUnit(Spy::numCopy() == 1);        // copy-create [40]
       assertUnit(Spy::numAlloc() == 1);       // allocate [40]
       assertUnit(Spy::numEquals() == 0);
@@ -1925,9 +2522,9 @@ public:
 
       // teardown
       if (p50 && p50->pLeft && p50->pLeft != p50)
-         delete p50->pLeft;
+         bst.deleteNode(p50->pLeft);
       if (p50)
-         delete p50;
+         bst.deleteNode(p50);
       bst.root = nullptr;
       bst.numElements = 0;
    }
@@ -1937,16 +2534,17 @@ public:
    {  // setup
       //            (50b)
       custom::BST <Spy> bst;
-      custom::BST<Spy>::BNode* p50 = new custom::BST<Spy>::BNode(Spy(50));
+      custom::BST<Spy>::BNode* p50 = bst.newNode(Spy(50));
       p50->isRed = false;
       bst.root = p50;
       bst.numElements = 1;
+      bst.resetEnds();
       Spy s(50);
       Spy::reset();
       // exercise
       auto pairBST = bst.insert(s, false /* keepUnique */);
       // verify
-      assertUnit(Spy::numLessthan() == 1);    // compare [50]
+      assertUnit(Spy::numLessthan() == 2);    // compare the largest, then [50]
       assertUnit(Spy::numCopy() == 1);        // copy-create [50]
       assertUnit(Spy::numAlloc() == 1);       // allocate [50]
       assertUnit(Spy::numEquals() == 0);
@@ -1989,9 +2587,9 @@ public:
 
       // teardown
       if (p50 && p50->pRight && p50->pRight != p50)
-         delete p50->pRight;
+         bst.deleteNode(p50->pRight);
       if (p50)
-         delete p50;
+         bst.deleteNode(p50);
       bst.root = nullptr;
       bst.numElements = 0;
    }
@@ -2011,7 +2609,7 @@ public:
       // exercise
       auto pairBST = bst.insert(s, true /* keepUnique */);
       // verify
-      assertUnit(Spy::numLessthan() == 2);    // compare [50][30]
+      assertUnit(Spy::numLessthan() == 3);    // compare the largest, then [50][30]
       assertUnit(Spy::numEquals() == 3);      // compare [50][30][40]
       assertUnit(Spy::numCopy() == 0);
       assertUnit(Spy::numAlloc() == 0);
@@ -2047,10 +2645,11 @@ public:
    {  // setup
       //            (50b)
       custom::BST <Spy> bst;
-      custom::BST<Spy>::BNode* p50 = new custom::BST<Spy>::BNode(Spy(50));
+      custom::BST<Spy>::BNode* p50 = bst.newNode(Spy(50));
       p50->isRed = false;
       bst.root = p50;
       bst.numElements = 1;
+      bst.resetEnds();
       Spy s(60);
       Spy::reset();
       // exercise
@@ -2097,9 +2696,9 @@ public:
       }
       // teardown
       if (p50 && p50->pRight && p50->pRight != p50)
-         delete p50->pRight;
+         bst.deleteNode(p50->pRight);
       if (p50)
-         delete p50;
+         bst.deleteNode(p50);
       bst.root = nullptr;
       bst.numElements = 0;
    }
@@ -2109,16 +2708,17 @@ public:
    {  // setup
       //            (50b)
       custom::BST <Spy> bst;
-      custom::BST<Spy>::BNode* p50 = new custom::BST<Spy>::BNode(Spy(50));
+      custom::BST<Spy>::BNode* p50 = bst.newNode(Spy(50));
       p50->isRed = false;
       bst.root = p50;
       bst.numElements = 1;
+      bst.resetEnds();
       Spy s(40);
       Spy::reset();
       // exercise
       auto pairBST = bst.insert(std::move(s));
       // verify
-      assertUnit(Spy::numLessthan() == 1);    // compare [50]
+      assertUnit(Spy::numLessthan() == 2);    // compare the largest, then [50]
       assertUnit(Spy::numCopyMove() == 1);    // assign move [40]
       assertUnit(Spy::numAssignMove() == 0);
       assertUnit(Spy::numCopy() == 0);
@@ -2163,9 +2763,9 @@ public:
 
       // teardown
       if (p50 && p50->pLeft && p50->pLeft != p50)
-         delete p50->pLeft;
+         bst.deleteNode(p50->pLeft);
       if (p50)
-         delete p50;
+         bst.deleteNode(p50);
       bst.root = nullptr;
       bst.numElements = 0;
    }
@@ -2175,16 +2775,17 @@ public:
    {  // setup
       //            (50b)
       custom::BST <Spy> bst;
-      custom::BST<Spy>::BNode* p50 = new custom::BST<Spy>::BNode(Spy(50));
+      custom::BST<Spy>::BNode* p50 = bst.newNode(Spy(50));
       p50->isRed = false;
       bst.root = p50;
       bst.numElements = 1;
+      bst.resetEnds();
       Spy s(50);
       Spy::reset();
       // exercise
       auto pairBST = bst.insert(std::move(s), false /* keepUnique */);
       // verify
-      assertUnit(Spy::numLessthan() == 1);    // compare [50]
+      assertUnit(Spy::numLessthan() == 2);    // compare the largest, then [50]
       assertUnit(Spy::numCopyMove() == 1);    // assign move [50]
       assertUnit(Spy::numAssignMove() == 0);
       assertUnit(Spy::numCopy() == 0);
@@ -2228,9 +2829,9 @@ public:
 
       // teardown
       if (p50 && p50->pRight && p50->pRight != p50)
-         delete p50->pRight;
+         bst.deleteNode(p50->pRight);
       if (p50)
-         delete p50;
+         bst.deleteNode(p50);
       bst.root = nullptr;
       bst.numElements = 0;
    }
@@ -2250,7 +2851,7 @@ public:
       // exercise
       auto pairBST = bst.insert(std::move(s), true /* keepUnique */);
       // verify
-      assertUnit(Spy::numLessthan() == 2);    // compare [50][30]
+      assertUnit(Spy::numLessthan() == 3);    // compare the largest, then [50][30]
       assertUnit(Spy::numEquals() == 3);      // compare [50][30][40]
       assertUnit(Spy::numCopy() == 0);
       assertUnit(Spy::numAlloc() == 0);
@@ -2281,6 +2882,158 @@ public:
     * Insert Balancing
     ***************************************/
    
+   /***************************************
+    * Insert with a hint
+    *    BST::insert(iterator, const T &)
+    ***************************************/
+
+   // 55 goes just before the hint, in its empty left child
+   void test_insertHint_before()
+   {  // setup
+      //                (50b)
+      //          +-------+-------+
+      //        (30b)           (70b)
+      //     +----+----+     +----+----+
+      //   (20r)     (40r) (60r)     (80r)
+      custom::BST <Spy> bst;
+      setupStandardFixture(bst);
+      custom::BST<Spy>::iterator itHint = bst.root->pRight->pLeft;
+      Spy s(55);
+      Spy::reset();
+      // exercise
+      auto pairBST = bst.insert(itHint, s);
+      // verify
+      assertUnit(Spy::numLessthan() == 2);    // compare [60] and the one before, [50]
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(Spy::numCopy() == 1);        // copy-create [55]
+      assertUnit(Spy::numAlloc() == 1);       // allocate [55]
+      assertUnit(pairBST.second == true);
+      assertUnit(*pairBST.first == Spy(55));
+      assertUnit(bst.size() == 8);
+      assertUnit(isRedBlack(bst));
+      // teardown
+      bst.clear();
+   }
+
+   // 45 goes just after the hint, in its empty right child
+   void test_insertHint_after()
+   {  // setup
+      //                (50b)
+      //          +-------+-------+
+      //        (30b)           (70b)
+      //     +----+----+     +----+----+
+      //   (20r)     (40r) (60r)     (80r)
+      custom::BST <Spy> bst;
+      setupStandardFixture(bst);
+      custom::BST<Spy>::iterator itHint = bst.root->pLeft->pRight;
+      Spy s(45);
+      Spy::reset();
+      // exercise
+      auto pairBST = bst.insert(itHint, s);
+      // verify
+      assertUnit(Spy::numLessthan() == 3);    // compare [40] both ways, and the one after, [50]
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(pairBST.second == true);
+      assertUnit(*pairBST.first == Spy(45));
+      assertUnit(pairBST.first.pNode->pParent->data == Spy(40));
+      assertUnit(bst.size() == 8);
+      assertUnit(isRedBlack(bst));
+      // teardown
+      bst.clear();
+   }
+
+   // the hint is already the element, so nothing goes in
+   void test_insertHint_duplicate()
+   {  // setup
+      //                (50b)
+      //          +-------+-------+
+      //        (30b)           (70b)
+      //     +----+----+     +----+----+
+      //   (20r)     (40r) (60r)     (80r)
+      custom::BST <Spy> bst;
+      setupStandardFixture(bst);
+      custom::BST<Spy>::iterator itHint = bst.root->pRight;
+      Spy s(70);
+      Spy::reset();
+      // exercise
+      auto pairBST = bst.insert(itHint, s, true /*keepUnique*/);
+      // verify
+      assertUnit(Spy::numLessthan() == 2);    // compare [70] both ways
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(pairBST.second == false);
+      assertUnit(pairBST.first == itHint);
+      assertStandardFixture(bst);
+      // teardown
+      teardownStandardFixture(bst);
+   }
+
+   // a hint in the wrong place costs a few comparisons, then the walk
+   void test_insertHint_wrong()
+   {  // setup
+      custom::BST <int> bst;
+      for (int i = 0; i < 100; i += 10)
+         bst.insert(i);
+      // exercise
+      auto pairFar = bst.insert(bst.begin(), 65);
+      auto pairEnd = bst.insert(bst.end(), 5);
+      auto pairDup = bst.insert(bst.find(20), 65, true /*keepUnique*/);
+      // verify
+      assertUnit(pairFar.second == true);
+      assertUnit(*pairFar.first == 65);
+      assertUnit(pairEnd.second == true);
+      assertUnit(*pairEnd.first == 5);
+      assertUnit(pairDup.second == false);
+      assertUnit(pairDup.first == pairFar.first);
+      assertUnit(bst.size() == 12);
+      assertUnit(*++bst.begin() == 5);
+      assertUnit(isRedBlack(bst));
+      // teardown
+      bst.clear();
+   }
+
+   // each new element goes just before the last one, never walking down
+   void test_insertHint_descending()
+   {  // setup
+      custom::BST <int> bst;
+      custom::BST<int>::iterator itHint = bst.end();
+      // exercise
+      for (int i = 10000; i > 0; i--)
+         itHint = bst.insert(itHint, i).first;
+      // verify
+      assertUnit(bst.size() == 10000);
+      assertUnit(*bst.begin() == 1);
+      assertUnit(*bst.rbegin() == 10000);
+      assertUnit(bst.leftmost == findLeftmost(bst.root));
+      assertUnit(isRedBlack(bst));
+      // teardown
+      bst.clear();
+   }
+
+   // growing keys go straight onto the end of the tree, and a
+   // ranked tree still counts them on the way
+   void test_insert_appendAscending()
+   {  // setup
+      custom::BST <int> bst;
+      custom::BST <int, std::allocator<int>, true> bstRanked;
+      // exercise
+      for (int i = 0; i < 10000; i++)
+      {
+         bst.insert(i);
+         bstRanked.insert(i);
+      }
+      // verify
+      assertUnit(bst.size() == 10000);
+      assertUnit(*bst.rbegin() == 9999);
+      assertUnit(bst.rightmost == findRightmost(bst.root));
+      assertUnit(isRedBlack(bst));
+      assertUnit(*bstRanked.select(5000) == 5000);
+      assertUnit(isRedBlack(bstRanked));
+      // teardown
+      bst.clear();
+      bstRanked.clear();
+   }
+
    // Red/Black balancing - Case 1
    void test_insert_case1()
    {  // setup
@@ -2314,7 +3067,7 @@ public:
          assertUnit(bst.root->pParent == nullptr);
       }
       // teardown
-      delete bst.root;
+      bst.deleteNode(bst.root);
       bst.root = nullptr;
       bst.numElements = 0;
    }
@@ -2324,16 +3077,17 @@ public:
    {  // setup
       //            (50b)
       custom::BST <Spy> bst;
-      custom::BST<Spy>::BNode *p50 = new custom::BST<Spy>::BNode(Spy(50));
+      custom::BST<Spy>::BNode *p50 = bst.newNode(Spy(50));
       p50->isRed = false;
       bst.root = p50;
       bst.numElements = 1;
+      bst.resetEnds();
       Spy s(30);
       Spy::reset();
       // exercise
       bst.insert(s);
       // verify
-      assertUnit(Spy::numLessthan() == 1);    // compare [50]
+      assertUnit(Spy::numLessthan() == 2);    // compare the largest, then [50]
       assertUnit(Spy::numCopy() == 1);        // copy-create [30]
       assertUnit(Spy::numAlloc() == 1);       // allocate [30]
       assertUnit(Spy::numEquals() == 0);
@@ -2372,9 +3126,9 @@ public:
 
       // teardown
       if (p50 && p50->pLeft && p50->pLeft != p50)
-         delete p50->pLeft;
+         bst.deleteNode(p50->pLeft);
       if (p50)
-         delete p50;
+         bst.deleteNode(p50);
       bst.root = nullptr;
       bst.numElements = 0;
    }
@@ -2385,9 +3139,10 @@ public:
       //           (50b)
       //        +----+----+
       //      (30r)     (70r)
-      custom::BST<Spy>::BNode* p30 = new custom::BST<Spy>::BNode(Spy(30));
-      custom::BST<Spy>::BNode* p50 = new custom::BST<Spy>::BNode(Spy(50));
-      custom::BST<Spy>::BNode* p70 = new custom::BST<Spy>::BNode(Spy(70));
+      custom::BST <Spy> bst;
+      custom::BST<Spy>::BNode* p30 = bst.newNode(Spy(30));
+      custom::BST<Spy>::BNode* p50 = bst.newNode(Spy(50));
+      custom::BST<Spy>::BNode* p70 = bst.newNode(Spy(70));
 
       p50->pLeft  = p30;
       p50->pRight = p70;
@@ -2396,9 +3151,9 @@ public:
       p50->isRed = false;
       p30->isRed = p70->isRed = true;
 
-      custom::BST <Spy> bst;
       bst.root = p50;
       bst.numElements = 3;
+      bst.resetEnds();
 
       Spy s(20);
       Spy::reset();
@@ -2407,7 +3162,7 @@ public:
       bst.insert(s);
 
       // verify
-      assertUnit(Spy::numLessthan() == 2);    // compare [50][30]
+      assertUnit(Spy::numLessthan() == 3);    // compare the largest, then [50][30]
       assertUnit(Spy::numCopy() == 1);        // copy-create [20]
       assertUnit(Spy::numAlloc() == 1);       // allocate [20]
       assertUnit(Spy::numEquals() == 0);
@@ -2465,13 +3220,13 @@ public:
       }
       // teardown
       if (p30->pLeft && p30->pLeft != p30)
-         delete p30->pLeft;
+         bst.deleteNode(p30->pLeft);
       if (p30)
-         delete p30;
+         bst.deleteNode(p30);
       if (p70)
-         delete p70;
+         bst.deleteNode(p70);
       if (p50)
-         delete p50;
+         bst.deleteNode(p50);
       bst.root = nullptr;
       bst.numElements = 0;
    }
@@ -2482,8 +3237,9 @@ public:
       //              (50b)
       //           +----+
       //         (30r)    
-      custom::BST<Spy>::BNode* p30 = new custom::BST<Spy>::BNode(Spy(30));
-      custom::BST<Spy>::BNode* p50 = new custom::BST<Spy>::BNode(Spy(50));
+      custom::BST <Spy> bst;
+      custom::BST<Spy>::BNode* p30 = bst.newNode(Spy(30));
+      custom::BST<Spy>::BNode* p50 = bst.newNode(Spy(50));
 
       p50->pLeft   = p30;
       p30->pParent = p50;
@@ -2491,9 +3247,9 @@ public:
       p50->isRed = false;
       p30->isRed = true;
 
-      custom::BST <Spy> bst;
       bst.root = p50;
       bst.numElements = 2;
+      bst.resetEnds();
 
       Spy s(10);
       Spy::reset();
@@ -2502,7 +3258,7 @@ public:
       bst.insert(s);
 
       // verify
-      assertUnit(Spy::numLessthan() == 2);    // compare [50][30]
+      assertUnit(Spy::numLessthan() == 3);    // compare the largest, then [50][30]
       assertUnit(Spy::numCopy() == 1);        // copy-create [10]
       assertUnit(Spy::numAlloc() == 1);       // allocate [10]
       assertUnit(Spy::numEquals() == 0);
@@ -2550,11 +3306,11 @@ public:
 
       // teardown
       if (p30 && p30->pLeft && p30->pLeft != p30)
-         delete p30->pLeft;
+         bst.deleteNode(p30->pLeft);
       if (p50)
-         delete p50;
+         bst.deleteNode(p50);
       if (p30)
-         delete p30;
+         bst.deleteNode(p30);
       bst.root = nullptr;
       bst.numElements = 0;
    }
@@ -2565,8 +3321,9 @@ public:
       //              (50b)
       //                +----+
       //                   (70r)    
-      custom::BST<Spy>::BNode* p50 = new custom::BST<Spy>::BNode(Spy(50));
-      custom::BST<Spy>::BNode* p70 = new custom::BST<Spy>::BNode(Spy(70));
+      custom::BST <Spy> bst;
+      custom::BST<Spy>::BNode* p50 = bst.newNode(Spy(50));
+      custom::BST<Spy>::BNode* p70 = bst.newNode(Spy(70));
 
       p50->pRight = p70;
       p70->pParent = p50;
@@ -2574,9 +3331,9 @@ public:
       p50->isRed = false;
       p70->isRed = true;
 
-      custom::BST <Spy> bst;
       bst.root = p50;
       bst.numElements = 2;
+      bst.resetEnds();
 
       Spy s(90);
       Spy::reset();
@@ -2585,7 +3342,7 @@ public:
       bst.insert(s);
 
       // verify
-      assertUnit(Spy::numLessthan() == 2);    // compare [50][70]
+      assertUnit(Spy::numLessthan() == 1);    // compare the largest [70], and append
       assertUnit(Spy::numCopy() == 1);        // copy-create [90]
       assertUnit(Spy::numAlloc() == 1);       // allocate [90]
       assertUnit(Spy::numEquals() == 0);
@@ -2633,11 +3390,11 @@ public:
       
       // teardown
       if (p70->pRight && p70->pRight != p70)
-         delete p70->pRight;
+         bst.deleteNode(p70->pRight);
       if (p50)
-         delete p50;
+         bst.deleteNode(p50);
       if (p70)
-         delete p70;
+         bst.deleteNode(p70);
       bst.root = nullptr;
       bst.numElements = 0;
    }
@@ -2648,8 +3405,9 @@ public:
       //                   (50b)
       //           +---------+
       //         (30r)     
-      custom::BST<Spy>::BNode* p30 = new custom::BST<Spy>::BNode(Spy(30));
-      custom::BST<Spy>::BNode* p50 = new custom::BST<Spy>::BNode(Spy(50));
+      custom::BST <Spy> bst;
+      custom::BST<Spy>::BNode* p30 = bst.newNode(Spy(30));
+      custom::BST<Spy>::BNode* p50 = bst.newNode(Spy(50));
 
       p50->pLeft = p30;
       p30->pParent = p50;
@@ -2657,9 +3415,9 @@ public:
       p30->isRed = true;
       p50->isRed = false;
 
-      custom::BST <Spy> bst;
       bst.root = p50;
       bst.numElements = 2;
+      bst.resetEnds();
 
       Spy s(40);
       Spy::reset();
@@ -2668,7 +3426,7 @@ public:
       bst.insert(s);
 
       // verify
-      assertUnit(Spy::numLessthan() == 2);    // compare [50][30]
+      assertUnit(Spy::numLessthan() == 3);    // compare the largest, then [50][30]
       assertUnit(Spy::numCopy() == 1);        // copy-create [40]
       assertUnit(Spy::numAlloc() == 1);       // allocate [40]
       assertUnit(Spy::numEquals() == 0);
@@ -2715,10 +3473,12 @@ public:
       }
 
       // teardown
+      if (bst.root && bst.root != p50 && bst.root != p30)
+         bst.deleteNode(bst.root);
       if (p50)
-         delete p50;
+         bst.deleteNode(p50);
       if (p30)
-         delete p30;
+         bst.deleteNode(p30);
       bst.numElements = 0;
       bst.root = nullptr;
    }
@@ -2729,8 +3489,9 @@ public:
       //         (50b)
       //           +---------+
       //                   (70r)     
-      custom::BST<Spy>::BNode* p50 = new custom::BST<Spy>::BNode(Spy(50));
-      custom::BST<Spy>::BNode* p70 = new custom::BST<Spy>::BNode(Spy(70));
+      custom::BST <Spy> bst;
+      custom::BST<Spy>::BNode* p50 = bst.newNode(Spy(50));
+      custom::BST<Spy>::BNode* p70 = bst.newNode(Spy(70));
 
       p50->pRight = p70;
       p70->pParent = p50;
@@ -2738,9 +3499,9 @@ public:
       p70->isRed = true;
       p50->isRed = false;
 
-      custom::BST <Spy> bst;
       bst.root = p50;
       bst.numElements = 2;
+      bst.resetEnds();
 
       Spy s(60);
       Spy::reset();
@@ -2749,7 +3510,7 @@ public:
       bst.insert(s);
 
       // verify
-      assertUnit(Spy::numLessthan() == 2);    // compare [50][70]
+      assertUnit(Spy::numLessthan() == 3);    // compare the largest, then [50][70]
       assertUnit(Spy::numCopy() == 1);        // copy-create [60]
       assertUnit(Spy::numAlloc() == 1);       // allocate [60]
       assertUnit(Spy::numEquals() == 0);
@@ -2796,10 +3557,12 @@ public:
          assertUnit(p70->pParent == bst.root);
       }
       // teardown
+      if (bst.root && bst.root != p50 && bst.root != p70)
+         bst.deleteNode(bst.root);
       if (p50)
-         delete p50;
+         bst.deleteNode(p50);
       if (p70)
-         delete p70;
+         bst.deleteNode(p70);
       bst.numElements = 0;
       bst.root = nullptr;
    }
@@ -2812,10 +3575,11 @@ public:
       //         (30b)     (70b)
       //       +---+
       //     (20r)    
-      custom::BST<Spy>::BNode* p20 = new custom::BST<Spy>::BNode(Spy(20));
-      custom::BST<Spy>::BNode* p30 = new custom::BST<Spy>::BNode(Spy(30));
-      custom::BST<Spy>::BNode* p50 = new custom::BST<Spy>::BNode(Spy(50));
-      custom::BST<Spy>::BNode* p70 = new custom::BST<Spy>::BNode(Spy(70));
+      custom::BST <Spy> bst;
+      custom::BST<Spy>::BNode* p20 = bst.newNode(Spy(20));
+      custom::BST<Spy>::BNode* p30 = bst.newNode(Spy(30));
+      custom::BST<Spy>::BNode* p50 = bst.newNode(Spy(50));
+      custom::BST<Spy>::BNode* p70 = bst.newNode(Spy(70));
 
       p50->pLeft  = p30;
       p50->pRight = p70;
@@ -2826,9 +3590,9 @@ public:
       p20->isRed = true;
       p30->isRed = p70->isRed = p50->isRed = false;
 
-      custom::BST <Spy> bst;
       bst.root = p50;
       bst.numElements = 4;
+      bst.resetEnds();
 
       Spy s(10);
       Spy::reset();
@@ -2837,7 +3601,7 @@ public:
       bst.insert(s);
 
       // verify
-      assertUnit(Spy::numLessthan() == 3);    // compare [50][30][20]
+      assertUnit(Spy::numLessthan() == 4);    // compare the largest, then [50][30][20]
       assertUnit(Spy::numCopy() == 1);        // copy-create [10]
       assertUnit(Spy::numAlloc() == 1);       // allocate [10]
       assertUnit(Spy::numEquals() == 0);
@@ -2905,15 +3669,15 @@ public:
 
       // teardown
       if (p20 && p20->pLeft && p20->pLeft != p20)
-        delete p20->pLeft;
+        bst.deleteNode(p20->pLeft);
       if (p30)
-         delete p30;
+         bst.deleteNode(p30);
       if (p70)
-         delete p70;
+         bst.deleteNode(p70);
       if (p20)
-         delete p20;
+         bst.deleteNode(p20);
       if (p50)
-         delete p50;
+         bst.deleteNode(p50);
       bst.root = nullptr;
       bst.numElements = 0;
    }
@@ -2926,10 +3690,11 @@ public:
       //         (30b)     (70b)
       //                     +---+
       //                       (80r)    
-      custom::BST<Spy>::BNode* p30 = new custom::BST<Spy>::BNode(Spy(30));
-      custom::BST<Spy>::BNode* p50 = new custom::BST<Spy>::BNode(Spy(50));
-      custom::BST<Spy>::BNode* p70 = new custom::BST<Spy>::BNode(Spy(70));
-      custom::BST<Spy>::BNode* p80 = new custom::BST<Spy>::BNode(Spy(80));
+      custom::BST <Spy> bst;
+      custom::BST<Spy>::BNode* p30 = bst.newNode(Spy(30));
+      custom::BST<Spy>::BNode* p50 = bst.newNode(Spy(50));
+      custom::BST<Spy>::BNode* p70 = bst.newNode(Spy(70));
+      custom::BST<Spy>::BNode* p80 = bst.newNode(Spy(80));
 
       p50->pLeft = p30;
       p50->pRight = p70;
@@ -2940,9 +3705,9 @@ public:
       p80->isRed = true;
       p30->isRed = p70->isRed = p50->isRed = false;
 
-      custom::BST <Spy> bst;
       bst.root = p50;
       bst.numElements = 4;
+      bst.resetEnds();
 
       Spy s(90);
       Spy::reset();
@@ -2951,7 +3716,7 @@ public:
       bst.insert(s);
 
       // verify
-      assertUnit(Spy::numLessthan() == 3);    // compare [50][70][80]
+      assertUnit(Spy::numLessthan() == 1);    // compare the largest [80], and append
       assertUnit(Spy::numCopy() == 1);        // copy-create [90]
       assertUnit(Spy::numAlloc() == 1);       // allocate [90]
       assertUnit(Spy::numEquals() == 0);
@@ -3019,15 +3784,15 @@ public:
 
       // teardown
       if (p80 && p80->pRight && p80->pRight != p80)
-         delete p80->pRight;
+         bst.deleteNode(p80->pRight);
       if (p70)
-         delete p70;
+         bst.deleteNode(p70);
       if (p30)
-         delete p30;
+         bst.deleteNode(p30);
       if (p80)
-         delete p80;
+         bst.deleteNode(p80);
       if (p50)
-         delete p50;
+         bst.deleteNode(p50);
       bst.root = nullptr;
       bst.numElements = 0;
    }
@@ -3042,13 +3807,14 @@ public:
       //   (10b)       (50b)
       //            +----+----+
       //          (30r)     (60r)
-      custom::BST<Spy>::BNode* p10 = new custom::BST<Spy>::BNode(Spy(10));
-      custom::BST<Spy>::BNode* p20 = new custom::BST<Spy>::BNode(Spy(20));
-      custom::BST<Spy>::BNode* p30 = new custom::BST<Spy>::BNode(Spy(30));
-      custom::BST<Spy>::BNode* p50 = new custom::BST<Spy>::BNode(Spy(50));
-      custom::BST<Spy>::BNode* p60 = new custom::BST<Spy>::BNode(Spy(60));
-      custom::BST<Spy>::BNode* p70 = new custom::BST<Spy>::BNode(Spy(70));
-      custom::BST<Spy>::BNode* p80 = new custom::BST<Spy>::BNode(Spy(80));
+      custom::BST <Spy> bst;
+      custom::BST<Spy>::BNode* p10 = bst.newNode(Spy(10));
+      custom::BST<Spy>::BNode* p20 = bst.newNode(Spy(20));
+      custom::BST<Spy>::BNode* p30 = bst.newNode(Spy(30));
+      custom::BST<Spy>::BNode* p50 = bst.newNode(Spy(50));
+      custom::BST<Spy>::BNode* p60 = bst.newNode(Spy(60));
+      custom::BST<Spy>::BNode* p70 = bst.newNode(Spy(70));
+      custom::BST<Spy>::BNode* p80 = bst.newNode(Spy(80));
 
       p20->pLeft  = p10;
       p20->pRight = p50;
@@ -3063,9 +3829,9 @@ public:
       p20->isRed = p30->isRed = p60->isRed = true;
       p10->isRed = p50->isRed = p70->isRed = p80->isRed = false;
 
-      custom::BST <Spy> bst;
       bst.root = p70;
       bst.numElements = 7;
+      bst.resetEnds();
 
       Spy s(40);
       Spy::reset();
@@ -3074,7 +3840,7 @@ public:
       bst.insert(s);
 
       // verify
-      assertUnit(Spy::numLessthan() == 4);    // compare [70][20][50][30]
+      assertUnit(Spy::numLessthan() == 5);    // compare the largest, then [70][20][50][30]
       assertUnit(Spy::numCopy() == 1);        // copy-create [40]
       assertUnit(Spy::numAlloc() == 1);       // allocate [40]
       assertUnit(Spy::numEquals() == 0);
@@ -3170,21 +3936,21 @@ public:
       }
       // teardown
       if (p30 && p30->pRight && p30->pRight != p30)
-         delete p30->pRight;
+         bst.deleteNode(p30->pRight);
       if (p10)
-         delete p10;
+         bst.deleteNode(p10);
       if (p20)
-         delete p20;
+         bst.deleteNode(p20);
       if (p30)
-         delete p30;
+         bst.deleteNode(p30);
       if (p50)
-         delete p50;
+         bst.deleteNode(p50);
       if (p60)
-         delete p60;
+         bst.deleteNode(p60);
       if (p70)
-         delete p70;
+         bst.deleteNode(p70);
       if (p80)
-         delete p80;
+         bst.deleteNode(p80);
       bst.numElements = 0;
       bst.root = nullptr;
    }
@@ -3199,13 +3965,14 @@ public:
       //                       (50b)       (90b)
       //                    +----+----+
       //                  (40r)     (70r)
-      custom::BST<Spy>::BNode* p20 = new custom::BST<Spy>::BNode(Spy(20));
-      custom::BST<Spy>::BNode* p30 = new custom::BST<Spy>::BNode(Spy(30));
-      custom::BST<Spy>::BNode* p40 = new custom::BST<Spy>::BNode(Spy(40));
-      custom::BST<Spy>::BNode* p50 = new custom::BST<Spy>::BNode(Spy(50));
-      custom::BST<Spy>::BNode* p70 = new custom::BST<Spy>::BNode(Spy(70));
-      custom::BST<Spy>::BNode* p80 = new custom::BST<Spy>::BNode(Spy(80));
-      custom::BST<Spy>::BNode* p90 = new custom::BST<Spy>::BNode(Spy(90));
+      custom::BST <Spy> bst;
+      custom::BST<Spy>::BNode* p20 = bst.newNode(Spy(20));
+      custom::BST<Spy>::BNode* p30 = bst.newNode(Spy(30));
+      custom::BST<Spy>::BNode* p40 = bst.newNode(Spy(40));
+      custom::BST<Spy>::BNode* p50 = bst.newNode(Spy(50));
+      custom::BST<Spy>::BNode* p70 = bst.newNode(Spy(70));
+      custom::BST<Spy>::BNode* p80 = bst.newNode(Spy(80));
+      custom::BST<Spy>::BNode* p90 = bst.newNode(Spy(90));
 
       p30->pLeft  = p20;
       p30->pRight = p80;
@@ -3220,9 +3987,9 @@ public:
       p40->isRed = p70->isRed = p80->isRed = true;
       p20->isRed = p30->isRed = p50->isRed = p90->isRed = false;
 
-      custom::BST <Spy> bst;
       bst.root = p30;
       bst.numElements = 7;
+      bst.resetEnds();
 
       Spy s(60);
       Spy::reset();
@@ -3231,7 +3998,7 @@ public:
       bst.insert(s);
 
       // verify
-      assertUnit(Spy::numLessthan() == 4);    // compare [30][80][50][70]
+      assertUnit(Spy::numLessthan() == 5);    // compare the largest, then [30][80][50][70]
       assertUnit(Spy::numCopy() == 1);        // copy-create [60]
       assertUnit(Spy::numAlloc() == 1);       // allocate [60]
       assertUnit(Spy::numEquals() == 0);
@@ -3328,21 +4095,21 @@ public:
 
       // teardown
       if (p70 && p70->pLeft && p70->pLeft != p70)
-         delete p70->pLeft;
+         bst.deleteNode(p70->pLeft);
       if (p20)
-         delete p20;
+         bst.deleteNode(p20);
       if (p30)
-         delete p30;
+         bst.deleteNode(p30);
       if (p40)
-         delete p40;
+         bst.deleteNode(p40);
       if (p50)
-         delete p50;
+         bst.deleteNode(p50);
       if (p70)
-         delete p70;
+         bst.deleteNode(p70);
       if (p80)
-         delete p80;
+         bst.deleteNode(p80);
       if (p90)
-         delete p90;
+         bst.deleteNode(p90);
       bst.numElements = 0;
       bst.root = nullptr;
    }
@@ -3442,7 +4209,7 @@ public:
       assertUnit(itReturn == custom::BST <Spy> ::iterator(bst.root->pRight));
       assertUnit(bst.root->pRight->pLeft == nullptr);
       assertUnit(bst.numElements == 6);
-      bst.root->pRight->pLeft = new custom::BST<Spy>::BNode(Spy(60));
+      bst.root->pRight->pLeft = bst.newNode(Spy(60));
       bst.root->pRight->pLeft->pParent = bst.root->pRight;
       bst.numElements = 7;
       assertStandardFixture(bst);
@@ -3460,12 +4227,12 @@ public:
       //            +--+--+
       //           20    40
       custom :: BST <int> bst;
-      auto p10 = new custom::BST<int>::BNode(10);
-      auto p20 = new custom::BST<int>::BNode(20);
-      auto p30 = new custom::BST<int>::BNode(30);
-      auto p40 = new custom::BST<int>::BNode(40);
-      auto p60 = new custom::BST<int>::BNode(60);
-      auto p50 = new custom::BST<int>::BNode(50);
+      auto p10 = bst.newNode(10);
+      auto p20 = bst.newNode(20);
+      auto p30 = bst.newNode(30);
+      auto p40 = bst.newNode(40);
+      auto p60 = bst.newNode(60);
+      auto p50 = bst.newNode(50);
       bst.root = p10->pParent = p60->pParent = p50;
       p50->pLeft = p30->pParent = p10;
       p50->pRight = p60;
@@ -3499,11 +4266,11 @@ public:
       assertUnit(p50->data == 50);
       assertUnit(p60->data == 60);
       // teardown
-      delete p20;
-      delete p30;
-      delete p40;
-      delete p50;
-      delete p60;
+      bst.deleteNode(p20);
+      bst.deleteNode(p30);
+      bst.deleteNode(p40);
+      bst.deleteNode(p50);
+      bst.deleteNode(p60);
       bst.numElements = 0;
       bst.root = nullptr;
    }
@@ -3520,14 +4287,14 @@ public:
       //            +-+
       //              40 
       custom::BST <int> bst;
-      auto p10 = new custom::BST<int>::BNode(10);
-      auto p20 = new custom::BST<int>::BNode(20);
-      auto p30 = new custom::BST<int>::BNode(30);
-      auto p40 = new custom::BST<int>::BNode(40);
-      auto p50 = new custom::BST<int>::BNode(50);
-      auto p60 = new custom::BST<int>::BNode(60);
-      auto p70 = new custom::BST<int>::BNode(70);
-      auto p80 = new custom::BST<int>::BNode(80);
+      auto p10 = bst.newNode(10);
+      auto p20 = bst.newNode(20);
+      auto p30 = bst.newNode(30);
+      auto p40 = bst.newNode(40);
+      auto p50 = bst.newNode(50);
+      auto p60 = bst.newNode(60);
+      auto p70 = bst.newNode(70);
+      auto p80 = bst.newNode(80);
       bst.root = p20->pParent = p80->pParent = p70;
       p10->pParent = p50->pParent = p70->pLeft = p20;
       p70->pRight = p80;
@@ -3571,17 +4338,554 @@ public:
       assertUnit(p70->data == 70);
       assertUnit(p80->data == 80);
       // teardown
-      delete p10;
-      delete p30;
-      delete p40;
-      delete p50;
-      delete p60;
-      delete p70;
-      delete p80;
+      bst.deleteNode(p10);
+      bst.deleteNode(p30);
+      bst.deleteNode(p40);
+      bst.deleteNode(p50);
+      bst.deleteNode(p60);
+      bst.deleteNode(p70);
+      bst.deleteNode(p80);
       bst.numElements = 0;
       bst.root = nullptr;
    }
 
+   // erase a black leaf whose sibling has no red children
+   void test_erase_blackLeafRecolor()
+   {  // setup
+      //                 (20b)
+      //          +-------+-------+
+      //      [[(10b)]]         (30b)
+      custom::BST <int> bst;
+      auto p10 = bst.newNode(10);
+      auto p20 = bst.newNode(20);
+      auto p30 = bst.newNode(30);
+      p10->isRed = p20->isRed = p30->isRed = false;
+      bst.root = p10->pParent = p30->pParent = p20;
+      p20->pLeft = p10;
+      p20->pRight = p30;
+      bst.numElements = 3;
+      auto it = custom::BST <int> ::iterator(p10);
+      // exercise
+      auto itReturn = bst.erase(it);
+      // verify
+      //                 (20b)
+      //                  +-------+
+      //                        (30r)
+      assertUnit(itReturn == custom::BST <int> ::iterator(p20));
+      assertUnit(bst.root == p20);
+      assertUnit(bst.numElements == 2);
+      assertUnit(p20->pLeft == nullptr);
+      assertUnit(p20->pRight == p30);
+      assertUnit(p20->isRed == false);
+      assertUnit(p30->isRed == true);
+      assertUnit(bst.root->verifyRedBlack(bst.root->findDepth()));
+      // teardown
+      bst.deleteNode(p20);
+      bst.deleteNode(p30);
+      bst.numElements = 0;
+      bst.root = nullptr;
+   }
+
+   // erase a black leaf whose sibling has a red child on the far side
+   void test_erase_blackLeafRotate()
+   {  // setup
+      //                 (20b)
+      //          +-------+-------+
+      //      [[(10b)]]         (30b)
+      //                          +--+
+      //                           (35r)
+      custom::BST <int> bst;
+      auto p10 = bst.newNode(10);
+      auto p20 = bst.newNode(20);
+      auto p30 = bst.newNode(30);
+      auto p35 = bst.newNode(35);
+      p10->isRed = p20->isRed = p30->isRed = false;
+      bst.root = p10->pParent = p30->pParent = p20;
+      p20->pLeft = p10;
+      p20->pRight = p35->pParent = p30;
+      p30->pRight = p35;
+      bst.numElements = 4;
+      auto it = custom::BST <int> ::iterator(p10);
+      // exercise
+      auto itReturn = bst.erase(it);
+      // verify
+      //                 (30b)
+      //          +-------+-------+
+      //        (20b)           (35b)
+      assertUnit(itReturn == custom::BST <int> ::iterator(p20));
+      assertUnit(bst.root == p30);
+      assertUnit(bst.numElements == 3);
+      assertUnit(p30->pParent == nullptr);
+      assertUnit(p30->pLeft == p20);
+      assertUnit(p30->pRight == p35);
+      assertUnit(p20->pParent == p30);
+      assertUnit(p35->pParent == p30);
+      assertUnit(p20->pLeft == nullptr);
+      assertUnit(p20->pRight == nullptr);
+      assertUnit(p30->isRed == false);
+      assertUnit(p20->isRed == false);
+      assertUnit(p35->isRed == false);
+      // teardown
+      bst.deleteNode(p20);
+      bst.deleteNode(p30);
+      bst.deleteNode(p35);
+      bst.numElements = 0;
+      bst.root = nullptr;
+   }
+
+   // a long random mix of inserts and erases stays a red-black tree
+   void test_erase_randomStress()
+   {  // setup
+      custom::BST <int> bst;
+      std::srand(232);
+      bool isValid = true;
+      // exercise
+      for (int i = 0; i < 20000; i++)
+      {
+         int value = std::rand() % 500;
+         auto it = bst.find(value);
+         if (it == bst.end())
+            bst.insert(value);
+         else
+            bst.erase(it);
+
+         if (i % 100 == 0)
+            isValid = isValid && isRedBlack(bst);
+      }
+      // verify
+      assertUnit(isValid);
+      assertUnit(isRedBlack(bst));
+      // teardown
+      bst.clear();
+   }
+
+   // erasing from one end while inserting at the other used to leave
+   // a long spine down one side
+   void test_erase_inOrderChurn()
+   {  // setup
+      custom::BST <int> bst;
+      for (int i = 0; i < 1000; i++)
+         bst.insert(i);
+      bool isValid = true;
+      // exercise
+      for (int i = 1000; i < 5000; i++)
+      {
+         auto it = bst.begin();
+         bst.erase(it);
+         bst.insert(i);
+         if (i % 50 == 0)
+            isValid = isValid && isRedBlack(bst);
+      }
+      // verify
+      assertUnit(isValid);
+      assertUnit(bst.numElements == 1000);
+      assertUnit(*bst.begin() == 4000);
+      assertUnit(isRedBlack(bst));
+      // teardown
+      bst.clear();
+   }
+
+   /***************************************
+    * SET ALGEBRA
+    *     BST::unite(const BST &)
+    *     BST::intersect(const BST &)
+    *     BST::subtract(const BST &)
+    ***************************************/
+
+   // multiples of 2 and multiples of 3 share the multiples of 6
+   void test_unite_overlap()
+   {  // setup
+      custom::BST <int> bst;
+      custom::BST <int> bstOther;
+      for (int i = 0; i < 200; i += 2)
+         bst.insert(i);
+      for (int i = 0; i < 300; i += 3)
+         bstOther.insert(i);
+      auto it60 = bst.find(60);
+      // exercise
+      bst.unite(bstOther);
+      // verify
+      std::vector<int> v;
+      for (int i = 0; i < 300; i++)
+         if ((i % 2 == 0 && i < 200) || i % 3 == 0)
+            v.push_back(i);
+      assertUnit(toVector(bst) == v);
+      assertUnit(bst.find(60) == it60);     // our own copy stays
+      assertUnit(bstOther.size() == 100);   // the other is only read
+      assertUnit(bst.leftmost == findLeftmost(bst.root));
+      assertUnit(bst.rightmost == findRightmost(bst.root));
+      assertUnit(isRedBlack(bst));
+      assertUnit(isRedBlack(bstOther));
+      // teardown
+      bst.clear();
+      bstOther.clear();
+   }
+
+   void test_intersect_overlap()
+   {  // setup
+      custom::BST <int> bst;
+      custom::BST <int> bstOther;
+      for (int i = 0; i < 200; i += 2)
+         bst.insert(i);
+      for (int i = 0; i < 300; i += 3)
+         bstOther.insert(i);
+      // exercise
+      bst.intersect(bstOther);
+      // verify
+      std::vector<int> v;
+      for (int i = 0; i < 200; i += 6)
+         v.push_back(i);
+      assertUnit(toVector(bst) == v);
+      assertUnit(bst.leftmost == findLeftmost(bst.root));
+      assertUnit(bst.rightmost == findRightmost(bst.root));
+      assertUnit(isRedBlack(bst));
+      // teardown
+      bst.clear();
+      bstOther.clear();
+   }
+
+   void test_subtract_overlap()
+   {  // setup
+      custom::BST <int> bst;
+      custom::BST <int> bstOther;
+      for (int i = 0; i < 200; i += 2)
+         bst.insert(i);
+      for (int i = 0; i < 300; i += 3)
+         bstOther.insert(i);
+      // exercise
+      bst.subtract(bstOther);
+      // verify
+      std::vector<int> v;
+      for (int i = 0; i < 200; i += 2)
+         if (i % 3 != 0)
+            v.push_back(i);
+      assertUnit(toVector(bst) == v);
+      assertUnit(bst.leftmost == findLeftmost(bst.root));
+      assertUnit(bst.rightmost == findRightmost(bst.root));
+      assertUnit(isRedBlack(bst));
+      // teardown
+      bst.clear();
+      bstOther.clear();
+   }
+
+   // an empty side, or the tree with itself
+   void test_setAlgebra_edges()
+   {  // setup
+      custom::BST <int> bstEmpty;
+      custom::BST <int> bst;
+      for (int i = 0; i < 10; i++)
+         bst.insert(i);
+      std::vector<int> v = toVector(bst);
+      // exercise
+      custom::BST <int> bstUnite;
+      bstUnite.unite(bst);
+      bst.unite(bstEmpty);
+      bst.unite(bst);
+      bst.intersect(bst);
+      custom::BST <int> bstIntersect(bst);
+      bstIntersect.intersect(bstEmpty);
+      custom::BST <int> bstSubtract(bst);
+      bstSubtract.subtract(bstEmpty);
+      bstEmpty.subtract(bst);
+      custom::BST <int> bstSelf(bst);
+      bstSelf.subtract(bstSelf);
+      // verify
+      assertUnit(toVector(bstUnite) == v);
+      assertUnit(toVector(bst) == v);
+      assertUnit(bstIntersect.empty());
+      assertUnit(bstIntersect.leftmost == nullptr);
+      assertUnit(toVector(bstSubtract) == v);
+      assertUnit(bstEmpty.empty());
+      assertUnit(bstSelf.empty());
+      assertUnit(isRedBlack(bstUnite));
+      assertUnit(isRedBlack(bst));
+      assertUnit(isRedBlack(bstIntersect));
+      assertUnit(isRedBlack(bstSubtract));
+      // teardown
+      bst.clear();
+      bstUnite.clear();
+      bstSubtract.clear();
+   }
+
+   // one tree far bigger than the other takes joins of very
+   // different heights
+   void test_setAlgebra_lopsided()
+   {  // setup
+      custom::BST <int> bstBig;
+      custom::BST <int> bstSmall;
+      for (int i = 0; i < 5000; i++)
+         bstBig.insert(i * 2);
+      for (int i = 0; i < 10; i++)
+         bstSmall.insert(i * 1001);
+      // exercise
+      custom::BST <int> bstUnite(bstBig);
+      bstUnite.unite(bstSmall);
+      custom::BST <int> bstUniteSmall(bstSmall);
+      bstUniteSmall.unite(bstBig);
+      custom::BST <int> bstIntersect(bstBig);
+      bstIntersect.intersect(bstSmall);
+      custom::BST <int> bstSubtract(bstBig);
+      bstSubtract.subtract(bstSmall);
+      // verify
+      assertUnit(bstUnite.size() == 5005);       // 1001, 3003, 5005, 7007, 9009 are odd
+      assertUnit(toVector(bstUniteSmall) == toVector(bstUnite));
+      assertUnit(bstIntersect.size() == 5);
+      assertUnit(*bstIntersect.rbegin() == 8008);
+      assertUnit(bstSubtract.size() == 4995);
+      assertUnit(isRedBlack(bstUnite));
+      assertUnit(isRedBlack(bstUniteSmall));
+      assertUnit(isRedBlack(bstIntersect));
+      assertUnit(isRedBlack(bstSubtract));
+      // teardown
+      bstBig.clear();
+      bstSmall.clear();
+      bstUnite.clear();
+      bstUniteSmall.clear();
+      bstIntersect.clear();
+      bstSubtract.clear();
+   }
+
+   // random trees of many sizes, checked against a plain walk. The
+   // largest are big enough to be split across threads
+   void test_setAlgebra_randomStress()
+   {  // setup
+      std::srand(50);
+      bool isValid = true;
+      // exercise
+      for (int num : { 1, 7, 60, 500, 3000, 40000 })
+      {
+         custom::BST <int> bst;
+         custom::BST <int> bstOther;
+         for (int i = 0; i < num; i++)
+         {
+            bst.insert(std::rand() % (num * 3), true /*keepUnique*/);
+            bstOther.insert(std::rand() % (num * 3), true /*keepUnique*/);
+         }
+         std::vector<int> v = toVector(bst);
+         std::vector<int> vOther = toVector(bstOther);
+         std::vector<int> vUnion;
+         std::vector<int> vIntersection;
+         std::vector<int> vDifference;
+         std::set_union(v.begin(), v.end(), vOther.begin(), vOther.end(), std::back_inserter(vUnion));
+         std::set_intersection(v.begin(), v.end(), vOther.begin(), vOther.end(), std::back_inserter(vIntersection));
+         std::set_difference(v.begin(), v.end(), vOther.begin(), vOther.end(), std::back_inserter(vDifference));
+
+         custom::BST <int> bstUnite(bst);
+         bstUnite.unite(bstOther);
+         custom::BST <int> bstIntersect(bst);
+         bstIntersect.intersect(bstOther);
+         custom::BST <int> bstSubtract(bst);
+         bstSubtract.subtract(bstOther);
+
+         isValid = isValid &&
+                   toVector(bstUnite) == vUnion && isBalanced(bstUnite) &&
+                   toVector(bstIntersect) == vIntersection && isBalanced(bstIntersect) &&
+                   toVector(bstSubtract) == vDifference && isBalanced(bstSubtract) &&
+                   bstSubtract.rightmost == findRightmost(bstSubtract.root);
+      }
+      // verify
+      assertUnit(isValid);
+   }  // teardown
+
+   // the same answers when the work is split four ways, however
+   // many cores this machine has
+   void test_setAlgebra_threads()
+   {  // setup
+      typedef custom::BST <int> BST;
+      BST bst;
+      BST bstOther;
+      for (int i = 0; i < 60000; i++)
+      {
+         bst.insert(i * 7 % 60000 * 2);
+         bstOther.insert(i * 3);
+      }
+      BST bstUnite(bst);
+      BST bstIntersect(bst);
+      BST bstSubtract(bst);
+      BST bstUniteSerial(bst);
+      BST bstIntersectSerial(bst);
+      BST bstSubtractSerial(bst);
+      bstUniteSerial.unite(bstOther);
+      bstIntersectSerial.intersect(bstOther);
+      bstSubtractSerial.subtract(bstOther);
+      BST::BNode* pDropped = nullptr;
+      BST::Subtree tree;
+      // exercise
+      tree = BST::unionOf(BST::subtree(bstUnite.root),
+                          BST::subtree(bstUnite.copyTree(bstOther.root)), 4, pDropped);
+      bstUnite.adopt(tree, bstUnite.size() + bstOther.size(), pDropped);
+      pDropped = nullptr;
+      tree = BST::intersectionOf(BST::subtree(bstIntersect.root), bstOther.root,
+                                 BST::blackHeight(bstOther.root), 4, pDropped);
+      bstIntersect.adopt(tree, bstIntersect.size(), pDropped);
+      pDropped = nullptr;
+      tree = BST::differenceOf(BST::subtree(bstSubtract.root), bstOther.root,
+                               BST::blackHeight(bstOther.root), 4, pDropped);
+      bstSubtract.adopt(tree, bstSubtract.size(), pDropped);
+      // verify
+      assertUnit(bstUnite.size() == 100000);      // the multiples of 6 below 120000 are in both
+      assertUnit(toVector(bstUnite) == toVector(bstUniteSerial));
+      assertUnit(bstIntersect.size() == 20000);
+      assertUnit(toVector(bstIntersect) == toVector(bstIntersectSerial));
+      assertUnit(bstSubtract.size() == 40000);
+      assertUnit(toVector(bstSubtract) == toVector(bstSubtractSerial));
+      assertUnit(isBalanced(bstUnite));
+      assertUnit(isBalanced(bstIntersect));
+      assertUnit(isBalanced(bstSubtract));
+      // teardown
+      bst.clear();
+      bstOther.clear();
+   }
+
+   // what a tree lets go of is destroyed, and counting it says
+   // how many are left
+   void test_setAlgebra_dropped()
+   {  // setup
+      typedef custom::BST <Spy> BST;
+      BST bstUnite;
+      BST bstOther;
+      for (int i = 0; i < 10; i++)
+      {
+         bstUnite.insert(Spy(i));
+         bstOther.insert(Spy(i + 5));
+      }
+      BST bstIntersect(bstUnite);
+      BST bstSubtract(bstUnite);
+      Spy::reset();
+      // exercise
+      bstUnite.unite(bstOther);
+      int numUnite = Spy::numDestructor();
+      bstIntersect.intersect(bstOther);
+      int numIntersect = Spy::numDestructor() - numUnite;
+      bstSubtract.subtract(bstOther);
+      int numSubtract = Spy::numDestructor() - numUnite - numIntersect;
+      // verify
+      assertUnit(numUnite == 5);       // the copies of [5..9] from the other
+      assertUnit(numIntersect == 5);   // [0..4]
+      assertUnit(numSubtract == 5);    // [5..9]
+      assertUnit(bstUnite.size() == 15);
+      assertUnit(bstIntersect.size() == 5);
+      assertUnit(bstSubtract.size() == 5);
+      assertUnit(isRedBlack(bstUnite));
+      assertUnit(isRedBlack(bstIntersect));
+      assertUnit(isRedBlack(bstSubtract));
+      // teardown
+      bstUnite.clear();
+      bstOther.clear();
+      bstIntersect.clear();
+      bstSubtract.clear();
+   }
+
+   // isRedBlack without the order check, which is too slow for big
+   // trees; comparing the elements in order covers that
+   template <class T, class A, bool Ranked>
+   bool isBalanced(const custom::BST <T, A, Ranked>& bst)
+   {
+      if (!bst.root)
+         return bst.numElements == 0;
+      if constexpr (Ranked)
+         if (bst.root->size != bst.numElements || !hasSizes(bst.root))
+            return false;
+      return !bst.root->isRed && bst.root->verifyRedBlack(bst.root->findDepth()) &&
+             findHeight(bst.root) <= 2.0 * std::log2((double)bst.numElements + 1.0);
+   }
+
+   // the elements in order, the easy way to compare trees
+   template <class T, class A, bool Ranked>
+   std::vector<T> toVector(const custom::BST <T, A, Ranked>& bst)
+   {
+      std::vector<T> v;
+      for (auto it = bst.begin(); it != bst.end(); ++it)
+         v.push_back(*it);
+      return v;
+   }
+
+   /**************************************************************
+    * IS RED BLACK
+    * The root is black, no red node has a red child, every path
+    * has the same number of black nodes, the nodes are in order,
+    * and the height is within 2 log2(n + 1)
+    *************************************************************/
+   template <class T, class A, bool Ranked>
+   bool isRedBlack(const custom::BST <T, A, Ranked>& bst)
+   {
+      if (!bst.root)
+         return bst.numElements == 0;
+
+      if (bst.root->isRed || bst.root->pParent)
+         return false;
+      if (!bst.root->verifyRedBlack(bst.root->findDepth()))
+         return false;
+      if ((size_t)bst.root->computeSize() != bst.numElements)
+         return false;
+      if constexpr (Ranked)
+         if (!hasSizes(bst.root))
+            return false;
+      bst.root->verifyBTree();
+
+      return findHeight(bst.root) <= 2.0 * std::log2((double)bst.numElements + 1.0);
+   }
+
+   // the smallest and largest nodes, found the slow way
+   template <class BNode>
+   BNode* findLeftmost(BNode* pNode)
+   {
+      while (pNode && pNode->pLeft)
+         pNode = pNode->pLeft;
+      return pNode;
+   }
+   template <class BNode>
+   BNode* findRightmost(BNode* pNode)
+   {
+      while (pNode && pNode->pRight)
+         pNode = pNode->pRight;
+      return pNode;
+   }
+
+   // does every node know how big its subtree is?
+   template <class BNode>
+   bool hasSizes(const BNode* pNode)
+   {
+      if (!pNode)
+         return true;
+      return pNode->size == 1 + BNode::sizeOf(pNode->pLeft) + BNode::sizeOf(pNode->pRight) &&
+             hasSizes(pNode->pLeft) && hasSizes(pNode->pRight);
+   }
+
+   // the number of nodes on the longest path from pNode down to a leaf
+   template <class BNode>
+   int findHeight(const BNode* pNode)
+   {
+      if (!pNode)
+         return 0;
+      return 1 + std::max(findHeight(pNode->pLeft), findHeight(pNode->pRight));
+   }
+
+   /**************************************************************
+    * BUILD CHAIN
+    * A tree of num nodes, each the right child of the one before,
+    * alternating black and red. Not balanced, on purpose
+    *************************************************************/
+   template <class T, class A, bool Ranked>
+   void buildChain(custom::BST <T, A, Ranked>& bst, int num)
+   {
+      typename custom::BST <T, A, Ranked>::BNode* pTail = nullptr;
+      for (int i = 0; i < num; i++)
+      {
+         auto pNode = bst.newNode(T(i));
+         pNode->isRed = (i % 2 == 1);
+         if constexpr (Ranked)
+            pNode->size = num - i;
+         pNode->pParent = pTail;
+         if (pTail)
+            pTail->pRight = pNode;
+         else
+            bst.root = pNode;
+         pTail = pNode;
+      }
+      bst.numElements = num;
+   }
+
    /**************************************************************
     * SETUP STANDARD FIXTURE
     *                (50b)
@@ -3590,20 +4894,22 @@ public:
     *     +----+----+     +----+----+
     *   (20r)     (40r) (60r)     (80r)
     *************************************************************/
-   void setupStandardFixture(custom::BST <Spy>& bst)
+   template <bool Ranked>
+   void setupStandardFixture(custom::BST <Spy, std::allocator<Spy>, Ranked>& bst)
    {
       // make sure that bst is clean
       assertUnit(bst.numElements == 0);
       assertUnit(bst.root == nullptr);
 
       // allocate
-      custom::BST<Spy>::BNode* p20 = new custom::BST<Spy>::BNode(Spy(20));
-      custom::BST<Spy>::BNode* p30 = new custom::BST<Spy>::BNode(Spy(30));
-      custom::BST<Spy>::BNode* p40 = new custom::BST<Spy>::BNode(Spy(40));
-      custom::BST<Spy>::BNode* p50 = new custom::BST<Spy>::BNode(Spy(50));
-      custom::BST<Spy>::BNode* p60 = new custom::BST<Spy>::BNode(Spy(60));
-      custom::BST<Spy>::BNode* p70 = new custom::BST<Spy>::BNode(Spy(70));
-      custom::BST<Spy>::BNode* p80 = new custom::BST<Spy>::BNode(Spy(80));
+      typedef typename custom::BST <Spy, std::allocator<Spy>, Ranked>::BNode BNode;
+      BNode* p20 = bst.newNode(Spy(20));
+      BNode* p30 = bst.newNode(Spy(30));
+      BNode* p40 = bst.newNode(Spy(40));
+      BNode* p50 = bst.newNode(Spy(50));
+      BNode* p60 = bst.newNode(Spy(60));
+      BNode* p70 = bst.newNode(Spy(70));
+      BNode* p80 = bst.newNode(Spy(80));
 
       // hook up the pointers down
       p30->pLeft  = p20;
@@ -3622,17 +4928,29 @@ public:
       p50->isRed = p30->isRed = p70->isRed = false;
       p20->isRed = p40->isRed = p60->isRed = p80->isRed = true;
 
+      // count every subtree
+      if constexpr (Ranked)
+      {
+         p30->size = p70->size = 3;
+         p50->size = 7;
+      }
+
       // now assign everything to the bst
       bst.root = p50;
+      bst.leftmost = p20;
+      bst.rightmost = p80;
       bst.numElements = 7;
    }
 
    /**************************************************************
     * VERIFY EMPTY FIXTURE
     *************************************************************/
-   void assertEmptyFixtureParameters(const custom::BST <Spy>& bst, int line, const char* function)
+   template <bool Ranked>
+   void assertEmptyFixtureParameters(const custom::BST <Spy, std::allocator<Spy>, Ranked>& bst, int line, const char* function)
    {
       assertUnit(bst.root == nullptr);
+      assertUnit(bst.leftmost == nullptr);
+      assertUnit(bst.rightmost == nullptr);
       assertUnit(bst.numElements == 0);
    }
 
@@ -3644,7 +4962,8 @@ public:
     *     +----+----+     +----+----+
     *   (20r)     (40r) (60r)     (80r)
     *************************************************************/
-   void assertStandardFixtureParameters(const custom::BST <Spy>& bst, int line, const char* function)
+   template <bool Ranked>
+   void assertStandardFixtureParameters(const custom::BST <Spy, std::allocator<Spy>, Ranked>& bst, int line, const char* function)
    {
       // verify the member variables
       assertIndirect(bst.numElements == 7);
@@ -3719,28 +5038,29 @@ public:
     *     +----+----+     +----+----+
     *    ( )       ( )   ( )       ( )
     *************************************************************/
-   void teardownStandardFixture(custom::BST <Spy>& bst)
+   template <bool Ranked>
+   void teardownStandardFixture(custom::BST <Spy, std::allocator<Spy>, Ranked>& bst)
    {
       if (bst.root)
       {
          if (bst.root->pLeft && bst.root->pLeft != bst.root)
          {
             if (bst.root->pLeft->pLeft && bst.root->pLeft->pLeft != bst.root->pLeft && bst.root->pLeft->pLeft != bst.root)
-               delete bst.root->pLeft->pLeft;
+               bst.deleteNode(bst.root->pLeft->pLeft);
             if (bst.root->pLeft->pRight && bst.root->pLeft->pRight != bst.root->pLeft && bst.root->pLeft->pRight != bst.root)
-               delete bst.root->pLeft->pRight;
-            delete bst.root->pLeft;
+               bst.deleteNode(bst.root->pLeft->pRight);
+            bst.deleteNode(bst.root->pLeft);
          }
          if (bst.root->pRight && bst.root->pRight != bst.root)
          {
             if (bst.root->pRight->pLeft && bst.root->pRight->pLeft != bst.root->pRight && bst.root->pRight->pLeft != bst.root)
-               delete bst.root->pRight->pLeft;
+               bst.deleteNode(bst.root->pRight->pLeft);
             if (bst.root->pRight->pRight && bst.root->pRight->pRight != bst.root->pRight && bst.root->pRight->pRight != bst.root)
-               delete bst.root->pRight->pRight;
+               bst.deleteNode(bst.root->pRight->pRight);
 
-            delete bst.root->pRight;
+            bst.deleteNode(bst.root->pRight);
          }
-         delete bst.root;
+         bst.deleteNode(bst.root);
       }
       bst.root = nullptr;
       bst.numElements = 0;
@@ -13,7 +13,9 @@
  //#undef DEBUG  // Remove this comment to disable unit tests
 
 #include "testSet.h"        // for the set unit tests
+#include "testArena.h"      // for the arena unit tests
 #include "testBST.h"        // for the BST unit tests
+#include "testBTree.h"      // for the B-tree unit tests
 #include "testSpy.h"        // for the spy unit tests
 int Spy::counters[] = {};
 
@@ -26,7 +28,9 @@ int main()
 #ifdef DEBUG
    // unit tests
    TestSpy().run();
+   TestArena().run();
    TestBST().run();
+   TestBTree().run();
    TestSet().run();
 #endif // DEBUG
    
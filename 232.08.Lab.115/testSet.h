@@ -44,6 +44,7 @@ public:
       test_constructRange_empty();
       test_constructRange_one();
       test_constructRange_standard();
+      test_constructRange_sorted();
       test_destructor_empty();
       test_destructor_standard();
 
@@ -75,6 +76,7 @@ public:
       test_begin_empty();
       test_begin_standard();
       test_end_standard();
+      test_rbegin_standard();
       test_iterator_increment_standardToParent();
       test_iterator_increment_standardToChild();
       test_iterator_increment_standardToGrandma();
@@ -89,12 +91,22 @@ public:
       test_find_standardLast();
       test_find_standardMissing();
 
+      // Bounds
+      test_lowerBound_standard();
+      test_equalRange_standard();
+      test_bounds_rangeScan();
+
+      // Order statistics
+      test_select_standard();
+      test_rank_standard();
+
       // Insert
       test_insert_empty();
       test_insert_standardEnd();
       test_insert_standardFront();
       test_insert_standardMiddle();
       test_insert_standardDuplicate();
+      test_insertHint_standardMiddle();
       test_insertMove_empty();
       test_insertMove_standardEnd();
       test_insertMove_standardFront();
@@ -126,12 +138,21 @@ public:
       test_eraseRange_oneChild();
       test_eraseRange_twoChildren();
 
+      // Set algebra
+      test_unite_standard();
+      test_intersect_standard();
+      test_subtract_standard();
+
       // Status
       test_empty_empty();
       test_empty_standard();
       test_size_empty();
       test_size_standard();
 
+      // B-tree backend
+      test_btree_insertFind();
+      test_btree_eraseRange();
+
       report("Set");
    }
    
@@ -182,9 +203,10 @@ public:
    {  // setup
       //            (50b)
       custom::set<Spy> sSrc;
-      sSrc.bst.root = new custom::BST<Spy>::BNode(Spy(50));
+      sSrc.bst.root = sSrc.bst.newNode(Spy(50));
       sSrc.bst.root->isRed = false;
       sSrc.bst.numElements = 1;
+      sSrc.bst.resetEnds();
       Spy::reset();
       // exercise
       custom::set<Spy> sDest(sSrc);
@@ -220,11 +242,11 @@ public:
       }
       // teardown
       if (sSrc.bst.root)
-         delete sSrc.bst.root;
+         sSrc.bst.deleteNode(sSrc.bst.root);
       sSrc.bst.root = nullptr;
       sSrc.bst.numElements = 0;
       if (sDest.bst.root)
-         delete sDest.bst.root;
+         sDest.bst.deleteNode(sDest.bst.root);
       sDest.bst.root = nullptr;
       sDest.bst.numElements = 0;
    }
@@ -304,9 +326,10 @@ public:
       // setup
       //            (50b)
       custom::set <Spy> sSrc;
-      sSrc.bst.root = new custom::BST<Spy>::BNode(Spy(50));
+      sSrc.bst.root = sSrc.bst.newNode(Spy(50));
       sSrc.bst.root->isRed = false;
       sSrc.bst.numElements = 1;
+      sSrc.bst.resetEnds();
       Spy::reset();
       // exercise
       custom::set <Spy> sDest(std::move(sSrc));
@@ -338,7 +361,7 @@ public:
       }
       // teardown
       if (sDest.bst.root)
-         delete sDest.bst.root;
+         sDest.bst.deleteNode(sDest.bst.root);
       sDest.bst.root = nullptr;
       sDest.bst.numElements = 0;
    }
@@ -394,8 +417,8 @@ public:
       // verify
       assertUnit(Spy::numCopy() == 7);     // copy-create [50][30][70][20][40][60][80]
       assertUnit(Spy::numAlloc() == 7);    // allocate    [50][30][70][20][40][60][80]
-      assertUnit(Spy::numLessthan() == 10);// compare 50: 30:[50] 70:[50] 20:[50][30] 40:[50][30] 60:[50][70] 80:[50][70]
-      assertUnit(Spy::numEquals() == 10);  // compare 50: 30:[50] 70:[50] 20:[50][30] 40:[50][30] 60:[50][70] 80:[50][70]
+      assertUnit(Spy::numLessthan() == 14);// sorted? 30:[50], then max 50: 30:[50][50] 70:[50] 20:[70][50][30] 40:[70][50][30] 60:[70][50][70] 80:[70]
+      assertUnit(Spy::numEquals() == 7);  // equal   50: 30:[50] 20:[50][30] 40:[50][30] 60:[50][70], 70 and 80 go after the max
       assertUnit(Spy::numDelete() == 0);
       assertUnit(Spy::numDefault() == 0);
       assertUnit(Spy::numNondefault() == 0);
@@ -446,7 +469,7 @@ public:
       }
       // teardown
       if (s.bst.root)
-         delete s.bst.root;
+         s.bst.deleteNode(s.bst.root);
       s.bst.root = nullptr;
       s.bst.numElements = 0;
    }
@@ -463,9 +486,9 @@ public:
       // verify
       assertUnit(Spy::numCopy() == 7);      // copy-construct [50,30,70,20,40,60,80] 
       assertUnit(Spy::numAlloc() == 7);     // allocate [50,30,70,20,40,60,80]
-      assertUnit(Spy::numLessthan() == 10); // compare 50: 30:[50] 70:[50] 20:[50][30] 40:[50][30] 60:[50][70] 80:[50][70]
-      assertUnit(Spy::numEquals() == 10);   // equal   50: 30:[50] 70:[50] 20:[50][30] 40:[50][30] 60:[50][70] 80:[50][70]
-      assertUnit(Spy::numEquals() == 10);
+      assertUnit(Spy::numLessthan() == 14); // sorted? 30:[50], then max 50: 30:[50][50] 70:[50] 20:[70][50][30] 40:[70][50][30] 60:[70][50][70] 80:[70]
+      assertUnit(Spy::numEquals() == 7);   // equal   50: 30:[50] 20:[50][30] 40:[50][30] 60:[50][70], 70 and 80 go after the max
+      assertUnit(Spy::numEquals() == 7);
       assertUnit(Spy::numDelete() == 0);
       assertUnit(Spy::numDefault() == 0);
       assertUnit(Spy::numNondefault() == 0);
@@ -483,6 +506,33 @@ public:
       teardownStandardFixture(s);
    }
 
+   // create a new set from a sorted range, building the tree directly
+   void test_constructRange_sorted()
+   {  // setup
+      std::initializer_list<Spy> il{ Spy(20), Spy(30), Spy(40), Spy(50), Spy(60), Spy(70), Spy(80) };
+      auto itBegin = il.begin();
+      auto itEnd = il.end();
+      Spy::reset();
+      // exercise
+      custom::set <Spy> s(itBegin, itEnd);
+      // verify
+      assertUnit(Spy::numCopy() == 7);      // copy-construct [20,30,40,50,60,70,80]
+      assertUnit(Spy::numAlloc() == 7);     // allocate [20,30,40,50,60,70,80]
+      assertUnit(Spy::numLessthan() == 6);  // sorted? 30:[20] 40:[30] 50:[40] 60:[50] 70:[60] 80:[70]
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      //                (50b)
+      //          +-------+-------+
+      //        (30b)           (70b)
+      //     +----+----+     +----+----+
+      //   (20r)     (40r) (60r)     (80r)
+      assertStandardFixture(s);
+      // teardown
+      teardownStandardFixture(s);
+   }
+
    /***************************************
     * CONSTRUCTOR INITIALIZE LIST
     ***************************************/
@@ -538,7 +588,7 @@ public:
       }
       // teardown
       if (s.bst.root)
-         delete s.bst.root;
+         s.bst.deleteNode(s.bst.root);
       s.bst.root = nullptr;
       s.bst.numElements = 0;
    }
@@ -553,9 +603,9 @@ public:
       // verify
       assertUnit(Spy::numCopy() == 7);      // copy-construct [50,30,70,20,40,60,80] 
       assertUnit(Spy::numAlloc() == 7);     // allocate [50,30,70,20,40,60,80]
-      assertUnit(Spy::numLessthan() == 10); // compare 50: 30:[50] 70:[50] 20:[50][30] 40:[50][30] 60:[50][70] 80:[50][70]
-      assertUnit(Spy::numEquals() == 10);   // equal   50: 30:[50] 70:[50] 20:[50][30] 40:[50][30] 60:[50][70] 80:[50][70]
-      assertUnit(Spy::numEquals() == 10);
+      assertUnit(Spy::numLessthan() == 14); // sorted? 30:[50], then max 50: 30:[50][50] 70:[50] 20:[70][50][30] 40:[70][50][30] 60:[70][50][70] 80:[70]
+      assertUnit(Spy::numEquals() == 7);   // equal   50: 30:[50] 20:[50][30] 40:[50][30] 60:[50][70], 70 and 80 go after the max
+      assertUnit(Spy::numEquals() == 7);
       assertUnit(Spy::numDelete() == 0);
       assertUnit(Spy::numDefault() == 0);
       assertUnit(Spy::numNondefault() == 0);
@@ -847,10 +897,11 @@ public:
       setupStandardFixture(sSrc);
       //                (99) = sDest
       custom::set <Spy> sDest;
-      custom::BST <Spy>::BNode* p99 = new custom::BST<Spy>::BNode(Spy(99));
+      custom::BST <Spy>::BNode* p99 = sDest.bst.newNode(Spy(99));
       p99->isRed = false;
       sDest.bst.root = p99;
       sDest.bst.numElements = 1;
+      sDest.bst.resetEnds();
       Spy::reset();
       // exercise
       sDest = sSrc;
@@ -889,10 +940,11 @@ public:
    {  // setup
       //                (99) = sSrc
       custom::set <Spy> sSrc;
-      custom::BST <Spy>::BNode* p99 = new custom::BST<Spy>::BNode(Spy(99));
+      custom::BST <Spy>::BNode* p99 = sSrc.bst.newNode(Spy(99));
       p99->isRed = false;
       sSrc.bst.root = p99;
       sSrc.bst.numElements = 1;
+      sSrc.bst.resetEnds();
       //                (50b) = sDest
       //          +-------+-------+
       //        (30b)           (70b)
@@ -1092,10 +1144,11 @@ public:
       setupStandardFixture(sSrc);
       //                (99) = bstDest
       custom::set <Spy> sDest;
-      custom::BST <Spy>::BNode* p99 = new custom::BST<Spy>::BNode(Spy(99));
+      custom::BST <Spy>::BNode* p99 = sDest.bst.newNode(Spy(99));
       p99->isRed = false;
       sDest.bst.root = p99;
       sDest.bst.numElements = 1;
+      sDest.bst.resetEnds();
       Spy::reset();
       // exercise
       sDest = std::move(sSrc);
@@ -1127,10 +1180,11 @@ public:
    {  // setup
       //                (99) = sSrc
       custom::set <Spy> sSrc;
-      custom::BST <Spy>::BNode* p99 = new custom::BST<Spy>::BNode(Spy(99));
+      custom::BST <Spy>::BNode* p99 = sSrc.bst.newNode(Spy(99));
       p99->isRed = false;
       sSrc.bst.root = p99;
       sSrc.bst.numElements = 1;
+      sSrc.bst.resetEnds();
       //                (50b) = sDest
       //          +-------+-------+
       //        (30b)           (70b)
@@ -1249,8 +1303,8 @@ public:
       // verify
       assertUnit(Spy::numCopy() == 7);      // copy     [20][30][40][50][60][70][80]
       assertUnit(Spy::numAlloc() == 7);     // allocate [20][30][40][50][60][70][80]
-      assertUnit(Spy::numLessthan() == 10); // compare 50: 30:[50] 70:[50] 20:[50][30] 40:[50][30] 60:[50][70] 80:[50][70]
-      assertUnit(Spy::numEquals() == 10);   // equal   50: 30:[50] 70:[50] 20:[50][30] 40:[50][30] 60:[50][70] 80:[50][70]
+      assertUnit(Spy::numLessthan() == 14); // sorted? 30:[50], then max 50: 30:[50][50] 70:[50] 20:[70][50][30] 40:[70][50][30] 60:[70][50][70] 80:[70]
+      assertUnit(Spy::numEquals() == 7);   // equal   50: 30:[50] 20:[50][30] 40:[50][30] 60:[50][70], 70 and 80 go after the max
       assertUnit(Spy::numDefault() == 0);
       assertUnit(Spy::numDelete() == 0);
       assertUnit(Spy::numNondefault() == 0);
@@ -1303,10 +1357,11 @@ public:
       std::initializer_list<Spy> il{ Spy(50), Spy(30), Spy(70), Spy(20), Spy(40), Spy(60), Spy(80) };
       //                (99) = s
       custom::set <Spy> s;
-      custom::BST <Spy>::BNode* p99 = new custom::BST<Spy>::BNode(Spy(99));
+      custom::BST <Spy>::BNode* p99 = s.bst.newNode(Spy(99));
       p99->isRed = false;
       s.bst.root = p99;
       s.bst.numElements = 1;
+      s.bst.resetEnds();
       Spy::reset();
       // exercise
       s = il;
@@ -1315,8 +1370,8 @@ public:
       assertUnit(Spy::numDelete() == 1);      // delete [99]
       assertUnit(Spy::numCopy() == 7);        // copy     [20][30][40][50][60][70][80]
       assertUnit(Spy::numAlloc() == 7);       // allocate [20][30][40][50][60][70][80]
-      assertUnit(Spy::numLessthan() == 10);   // compare 50: 30:[50] 70:[50] 20:[50][30] 40:[50][30] 60:[50][70] 80:[50][70]
-      assertUnit(Spy::numEquals() == 10);     // equal   50: 30:[50] 70:[50] 20:[50][30] 40:[50][30] 60:[50][70] 80:[50][70]
+      assertUnit(Spy::numLessthan() == 14);   // sorted? 30:[50], then max 50: 30:[50][50] 70:[50] 20:[70][50][30] 40:[70][50][30] 60:[70][50][70] 80:[70]
+      assertUnit(Spy::numEquals() == 7);     // equal   50: 30:[50] 20:[50][30] 40:[50][30] 60:[50][70], 70 and 80 go after the max
       assertUnit(Spy::numDefault() == 0);
       assertUnit(Spy::numNondefault() == 0);
       assertUnit(Spy::numCopyMove() == 0);
@@ -1385,8 +1440,8 @@ public:
       assertUnit(Spy::numDelete() == 7);      // delete   [20][30][40][50][60][70][80]
       assertUnit(Spy::numCopy() == 7);        // copy     [20][30][40][50][60][70][80]
       assertUnit(Spy::numAlloc() == 7);       // allocate [20][30][40][50][60][70][80]
-      assertUnit(Spy::numLessthan() == 10);   // compare 50: 30:[50] 70:[50] 20:[50][30] 40:[50][30] 60:[50][70] 80:[50][70]
-      assertUnit(Spy::numEquals() == 10);     // equal   50: 30:[50] 70:[50] 20:[50][30] 40:[50][30] 60:[50][70] 80:[50][70]
+      assertUnit(Spy::numLessthan() == 14);   // sorted? 30:[50], then max 50: 30:[50][50] 70:[50] 20:[70][50][30] 40:[70][50][30] 60:[70][50][70] 80:[70]
+      assertUnit(Spy::numEquals() == 7);     // equal   50: 30:[50] 20:[50][30] 40:[50][30] 60:[50][70], 70 and 80 go after the max
       assertUnit(Spy::numAssign() == 0);
       assertUnit(Spy::numDefault() == 0);
       assertUnit(Spy::numNondefault() == 0);
@@ -1657,6 +1712,38 @@ public:
       teardownStandardFixture(s);
    }
 
+   // rbegin() from the standard fixture, walking backwards
+   void test_rbegin_standard()
+   {  // setup
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //     +----+----+     +----+----+
+      //    20        40    60        80  
+      custom::set <Spy> s;
+      setupStandardFixture(s);
+      custom::set<Spy>::iterator it;
+      Spy::reset();
+      // exercise
+      it = s.rbegin();
+      // verify
+      assertUnit(Spy::numLessthan() == 0);    // does not look at any element
+      assertUnit(Spy::numEquals() == 0);      // does not look at any element
+      assertUnit(it.it.pNode == s.bst.root->pRight->pRight);
+      int num = 0;
+      bool descending = true;
+      for (Spy prev(99); it != s.rend(); --it, num++)
+      {
+         descending = descending && *it < prev;
+         prev = *it;
+      }
+      assertUnit(descending);
+      assertUnit(num == 7);
+      assertStandardFixture(s);
+      // teardown
+      teardownStandardFixture(s);
+   }
+
    // end() from the standard fixture.
    void test_end_standard()
    {  // setup
@@ -2120,6 +2207,145 @@ public:
       teardownStandardFixture(s);
    }
 
+   /***************************************
+    * BOUNDS
+    *  set::lower_bound(const T &)
+    *  set::upper_bound(const T &)
+    *  set::equal_range(const T &)
+    ***************************************/
+
+   // the first element not less than 35 is 40
+   void test_lowerBound_standard()
+   {  // setup
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //     +----+----+     +----+----+
+      //    20        40    60        80  
+      custom::set <Spy> s;
+      setupStandardFixture(s);
+      custom::set<Spy>::iterator it;
+      Spy spy(35);
+      Spy::reset();
+      // exercise
+      it = s.lower_bound(spy);
+      // verify
+      assertUnit(Spy::numLessthan() == 3);    // compare [50][30][40]
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(*it == Spy(40));
+      assertUnit(*s.upper_bound(Spy(40)) == Spy(50));
+      assertUnit(s.upper_bound(Spy(80)) == s.end());
+      assertStandardFixture(s);
+      // teardown
+      teardownStandardFixture(s);
+   }
+
+   // a set holds one of each, so the range is one long
+   void test_equalRange_standard()
+   {  // setup
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //     +----+----+     +----+----+
+      //    20        40    60        80  
+      custom::set <Spy> s;
+      setupStandardFixture(s);
+      Spy spy(70);
+      Spy::reset();
+      // exercise
+      auto range = s.equal_range(spy);
+      // verify
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(*range.first == Spy(70));
+      assertUnit(*range.second == Spy(80));
+      assertStandardFixture(s);
+      // teardown
+      teardownStandardFixture(s);
+   }
+
+   // everything in [25, 65) without starting from begin()
+   void test_bounds_rangeScan()
+   {  // setup
+      custom::set <int> s;
+      for (int i = 0; i < 100; i++)
+         s.insert(i * 5);
+      // exercise
+      int num = 0;
+      int sum = 0;
+      for (auto it = s.lower_bound(25); it != s.lower_bound(65); ++it)
+      {
+         num++;
+         sum += *it;
+      }
+      auto itBegin = s.lower_bound(100);
+      auto itEnd = s.upper_bound(200);
+      s.erase(itBegin, itEnd);
+      // verify
+      assertUnit(num == 8);                   // 25, 30, ... 60
+      assertUnit(sum == 340);
+      assertUnit(s.size() == 79);
+      assertUnit(*s.upper_bound(96) == 205);
+      assertUnit(s.erase(205) == 1);
+      assertUnit(s.erase(205) == 0);
+   }  // teardown
+
+   /***************************************
+    * ORDER STATISTICS
+    *  set::select(size_t)
+    *  set::rank(const T &)
+    ***************************************/
+
+   // the fourth smallest is the root
+   void test_select_standard()
+   {  // setup
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //     +----+----+     +----+----+
+      //    20        40    60        80  
+      custom::ranked_set <Spy> s{ Spy(50), Spy(30), Spy(70), Spy(20), Spy(40), Spy(60), Spy(80) };
+      custom::ranked_set<Spy>::iterator it;
+      Spy::reset();
+      // exercise
+      it = s.select(3);
+      // verify
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(it != s.end());
+      assertUnit(*it == Spy(50));
+      assertUnit(*s.select(1) == Spy(30));
+      assertUnit(s.select(7) == s.end());
+      assertUnit(s.size() == 7);
+   }  // teardown
+
+   // three elements are smaller than 42
+   void test_rank_standard()
+   {  // setup
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //     +----+----+     +----+----+
+      //    20        40    60        80  
+      custom::ranked_set <Spy> s{ Spy(50), Spy(30), Spy(70), Spy(20), Spy(40), Spy(60), Spy(80) };
+      Spy spy(42);
+      Spy::reset();
+      // exercise
+      size_t numSmaller = s.rank(spy);
+      // verify
+      assertUnit(Spy::numLessthan() == 3);    // compare [50][30][40]
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(numSmaller == 3);
+      assertUnit(s.rank(Spy(70)) == 5);
+      assertUnit(s.size() == 7);
+   }  // teardown
+
 
    /***************************************
     * INSERT
@@ -2163,7 +2389,7 @@ public:
          assertUnit(s.bst.root->pParent == nullptr);
       }
       // teardown
-      delete s.bst.root;
+      s.bst.deleteNode(s.bst.root);
       s.bst.root = nullptr;
       s.bst.numElements = 0;
    }
@@ -2178,9 +2404,10 @@ public:
       //    20        40    60     
       custom::set <Spy> s;
       setupStandardFixture(s);
-      delete s.bst.root->pRight->pRight;
+      s.bst.deleteNode(s.bst.root->pRight->pRight);
       s.bst.root->pRight->pRight = nullptr;
       s.bst.numElements = 6;
+      s.bst.rightmost = s.bst.root->pRight;
       Spy spy(80);
       Spy::reset();
       // exercise
@@ -2188,8 +2415,8 @@ public:
       // verify
       assertUnit(Spy::numCopy() == 1);        // copy-create [80]
       assertUnit(Spy::numAlloc() == 1);       // allocate [80]
-      assertUnit(Spy::numLessthan() == 2);    // compare [50][70]
-      assertUnit(Spy::numEquals() == 2);      // compare [50][70]
+      assertUnit(Spy::numLessthan() == 1);    // compare the max [70], and append
+      assertUnit(Spy::numEquals() == 0);      // compare [50][70]
       assertUnit(Spy::numDestructor() == 0);
       assertUnit(Spy::numDelete() == 0);
       assertUnit(Spy::numAssign() == 0);
@@ -2221,9 +2448,10 @@ public:
       //              40    60        80  
       custom::set <Spy> s;
       setupStandardFixture(s);
-      delete s.bst.root->pLeft->pLeft;
+      s.bst.deleteNode(s.bst.root->pLeft->pLeft);
       s.bst.root->pLeft->pLeft = nullptr;
       s.bst.numElements = 6;
+      s.bst.leftmost = s.bst.root->pLeft;
       Spy spy(20);
       Spy::reset();
       // exercise
@@ -2231,7 +2459,7 @@ public:
       // verify
       assertUnit(Spy::numCopy() == 1);        // copy-create [20]
       assertUnit(Spy::numAlloc() == 1);       // allocate [20]
-      assertUnit(Spy::numLessthan() == 2);    // compare [50][30]
+      assertUnit(Spy::numLessthan() == 3);    // compare the max [80], then [50][30]
       assertUnit(Spy::numEquals() == 2);      // compare [50][30]
       assertUnit(Spy::numDestructor() == 0);
       assertUnit(Spy::numDelete() == 0);
@@ -2264,7 +2492,7 @@ public:
       //    20        40              80  
       custom::set <Spy> s;
       setupStandardFixture(s);
-      delete s.bst.root->pRight->pLeft;
+      s.bst.deleteNode(s.bst.root->pRight->pLeft);
       s.bst.root->pRight->pLeft = nullptr;
       s.bst.numElements = 6;
       Spy spy(60);
@@ -2274,7 +2502,7 @@ public:
       // verify
       assertUnit(Spy::numCopy() == 1);        // copy-create [60]
       assertUnit(Spy::numAlloc() == 1);       // allocate [60]
-      assertUnit(Spy::numLessthan() == 2);    // compare [50][70]
+      assertUnit(Spy::numLessthan() == 3);    // compare the max [80], then [50][70]
       assertUnit(Spy::numEquals() == 2);      // compare [50][70]
       assertUnit(Spy::numDestructor() == 0);
       assertUnit(Spy::numDelete() == 0);
@@ -2312,7 +2540,7 @@ public:
       // exercise
       auto pairSet = s.insert(spy);
       // verify
-      assertUnit(Spy::numLessthan() == 2);    // compare [50][70]
+      assertUnit(Spy::numLessthan() == 3);    // compare the max [80], then [50][70]
       assertUnit(Spy::numEquals() == 3);      // compare [50][70][60]
       assertUnit(Spy::numCopy() == 0);
       assertUnit(Spy::numAlloc() == 0);
@@ -2337,6 +2565,49 @@ public:
       teardownStandardFixture(s);
    }
 
+   // insert next to a hint, skipping the walk down from the root
+   void test_insertHint_standardMiddle()
+   {  // setup
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //     +----+----+          +----+
+      //    20        40              80  
+      custom::set <Spy> s;
+      setupStandardFixture(s);
+      s.bst.deleteNode(s.bst.root->pRight->pLeft);
+      s.bst.root->pRight->pLeft = nullptr;
+      s.bst.numElements = 6;
+      custom::set <Spy>::iterator itHint(s.bst.root->pRight);
+      Spy spy(60);
+      Spy::reset();
+      // exercise
+      auto it = s.insert(itHint, spy);
+      // verify
+      assertUnit(Spy::numCopy() == 1);        // copy-create [60]
+      assertUnit(Spy::numAlloc() == 1);       // allocate [60]
+      assertUnit(Spy::numLessthan() == 2);    // compare the hint [70], then the one before [50]
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(it != s.end());
+      if (it != s.end())
+         assertUnit(*it == Spy(60));
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //     +----+----+     +----+----+
+      //    20        40    60        80  
+      assertStandardFixture(s);
+      // teardown
+      teardownStandardFixture(s);
+   }
+
    /***************************************
     * INSERT MOVE
     *  set::insert(T &&)
@@ -2380,7 +2651,7 @@ public:
          assertUnit(s.bst.root->pParent == nullptr);
       }
       // teardown
-      delete s.bst.root;
+      s.bst.deleteNode(s.bst.root);
       s.bst.root = nullptr;
       s.bst.numElements = 0;
    }
@@ -2395,17 +2666,18 @@ public:
       //    20        40    60     
       custom::set <Spy> s;
       setupStandardFixture(s);
-      delete s.bst.root->pRight->pRight;
+      s.bst.deleteNode(s.bst.root->pRight->pRight);
       s.bst.root->pRight->pRight = nullptr;
       s.bst.numElements = 6;
+      s.bst.rightmost = s.bst.root->pRight;
       Spy spy(80);
       Spy::reset();
       // exercise
       auto pairSet = s.insert(std::move(spy));
       // verify
       assertUnit(Spy::numCopyMove() == 1);    // copy-move [80]
-      assertUnit(Spy::numLessthan() == 2);    // compare [50][70]
-      assertUnit(Spy::numEquals() == 2);      // compare [50][70]
+      assertUnit(Spy::numLessthan() == 1);    // compare the max [70], and append
+      assertUnit(Spy::numEquals() == 0);      // compare [50][70]
       assertUnit(Spy::numCopy() == 0);
       assertUnit(Spy::numAlloc() == 0);
       assertUnit(Spy::numDestructor() == 0);
@@ -2439,16 +2711,17 @@ public:
       //              40    60        80  
       custom::set <Spy> s;
       setupStandardFixture(s);
-      delete s.bst.root->pLeft->pLeft;
+      s.bst.deleteNode(s.bst.root->pLeft->pLeft);
       s.bst.root->pLeft->pLeft = nullptr;
       s.bst.numElements = 6;
+      s.bst.leftmost = s.bst.root->pLeft;
       Spy spy(20);
       Spy::reset();
       // exercise
       auto pairSet = s.insert(std::move(spy));
       // verify
       assertUnit(Spy::numCopyMove() == 1);    // copy-move [20]
-      assertUnit(Spy::numLessthan() == 2);    // compare [50][30]
+      assertUnit(Spy::numLessthan() == 3);    // compare the max [80], then [50][30]
       assertUnit(Spy::numEquals() == 2);      // compare [50][30]
       assertUnit(Spy::numCopy() == 0);
       assertUnit(Spy::numAlloc() == 0);
@@ -2483,7 +2756,7 @@ public:
       //    20        40              80  
       custom::set <Spy> s;
       setupStandardFixture(s);
-      delete s.bst.root->pRight->pLeft;
+      s.bst.deleteNode(s.bst.root->pRight->pLeft);
       s.bst.root->pRight->pLeft = nullptr;
       s.bst.numElements = 6;
       Spy spy(60);
@@ -2492,7 +2765,7 @@ public:
       auto pairSet = s.insert(std::move(spy));
       // verify
       assertUnit(Spy::numCopyMove() == 1);  // copy-move [60]
-      assertUnit(Spy::numLessthan() == 2);    // compare [50][70]
+      assertUnit(Spy::numLessthan() == 3);    // compare the max [80], then [50][70]
       assertUnit(Spy::numEquals() == 2);      // compare [50][70]
       assertUnit(Spy::numCopy() == 0);
       assertUnit(Spy::numAlloc() == 0);
@@ -2532,7 +2805,7 @@ public:
       // exercise
       auto pairSet = s.insert(std::move(spy));
       // verify
-      assertUnit(Spy::numLessthan() == 2);    // compare [50][70]
+      assertUnit(Spy::numLessthan() == 3);    // compare the max [80], then [50][70]
       assertUnit(Spy::numEquals() == 3);      // compare [50][70][60]
       assertUnit(Spy::numCopy() == 0);
       assertUnit(Spy::numAlloc() == 0);
@@ -2595,8 +2868,8 @@ public:
       // verify
       assertUnit(Spy::numCopy() == 7);      // copy     [20][30][40][50][60][70][80]
       assertUnit(Spy::numAlloc() == 7);     // allocate [20][30][40][50][60][70][80]
-      assertUnit(Spy::numLessthan() == 10); // compare 50: 30:[50] 70:[50] 20:[50][30] 40:[50][30] 60:[50][70] 80:[50][70]
-      assertUnit(Spy::numEquals() == 10);   // equal   50: 30:[50] 70:[50] 20:[50][30] 40:[50][30] 60:[50][70] 80:[50][70]
+      assertUnit(Spy::numLessthan() == 13); // max 50: 30:[50][50] 70:[50] 20:[70][50][30] 40:[70][50][30] 60:[70][50][70] 80:[70]
+      assertUnit(Spy::numEquals() == 7);   // equal   50: 30:[50] 20:[50][30] 40:[50][30] 60:[50][70], 70 and 80 go after the max
       assertUnit(Spy::numDefault() == 0);
       assertUnit(Spy::numDelete() == 0);
       assertUnit(Spy::numNondefault() == 0);
@@ -2659,7 +2932,7 @@ public:
       // exercise
       s.insert(il);
       // verify
-      assertUnit(Spy::numLessthan() == 2);   // compare 50: 40:[50][30] 
+      assertUnit(Spy::numLessthan() == 4);   // max 50:[80] 40:[80][50][30]
       assertUnit(Spy::numEquals() == 4);     // equal   50:[50] 40:[50][30][40]
       assertUnit(Spy::numDestructor() == 0);
       assertUnit(Spy::numDelete() == 0);    
@@ -2681,22 +2954,23 @@ public:
       //          +-------+-------+
       //        (30b)           (70b)
       custom::set <Spy> s;
-      custom::BST <Spy>::BNode* p50 = new custom::BST<Spy>::BNode(Spy(50));
-      custom::BST <Spy>::BNode* p30 = new custom::BST<Spy>::BNode(Spy(30));
-      custom::BST <Spy>::BNode* p70 = new custom::BST<Spy>::BNode(Spy(70));
+      custom::BST <Spy>::BNode* p50 = s.bst.newNode(Spy(50));
+      custom::BST <Spy>::BNode* p30 = s.bst.newNode(Spy(30));
+      custom::BST <Spy>::BNode* p70 = s.bst.newNode(Spy(70));
       p50->isRed = false;
       p30->isRed = p70->isRed = true;
       s.bst.root = p30->pParent = p70->pParent = p50;
       p50->pRight = p70;
       p50->pLeft  = p30;
       s.bst.numElements = 3;
+      s.bst.resetEnds();
       std::initializer_list<Spy> il{ Spy(20), Spy(40), Spy(60), Spy(80) };
       Spy::reset();
       // exercise
       s.insert(il);
       // verify
-      assertUnit(Spy::numLessthan() == 8);   // compare 20:[50][30] 40:[50][30] 60:[50][70] 80:[50][70]  
-      assertUnit(Spy::numEquals() == 8);     // equal   20:[50][30] 40:[50][30] 60:[50][70] 80:[50][70]
+      assertUnit(Spy::numLessthan() == 10);   // max 20:[70][50][30] 40:[70][50][30] 60:[70][50][70] 80:[70]
+      assertUnit(Spy::numEquals() == 6);     // equal   20:[50][30] 40:[50][30] 60:[50][70], 80 goes after the max
       assertUnit(Spy::numCopy() == 4);       // create   [20][40][60][80]
       assertUnit(Spy::numAlloc() == 4);      // allocate [20][40][60][80]
       assertUnit(Spy::numDestructor() == 0);
@@ -2878,7 +3152,7 @@ public:
       assertUnit(itReturn == it);
       assertUnit(s.bst.root->pRight->pLeft == nullptr);
       assertUnit(s.bst.numElements == 6);
-      s.bst.root->pRight->pLeft = new custom::BST<Spy>::BNode(Spy(60));
+      s.bst.root->pRight->pLeft = s.bst.newNode(Spy(60));
       s.bst.root->pRight->pLeft->pParent = s.bst.root->pRight;
       s.bst.numElements = 7;
       assertStandardFixture(s);
@@ -2896,12 +3170,12 @@ public:
       //            +--+--+
       //           20    40
       custom::set <int> s;
-      auto p10 = new custom::BST<int>::BNode(10);
-      auto p20 = new custom::BST<int>::BNode(20);
-      auto p30 = new custom::BST<int>::BNode(30);
-      auto p40 = new custom::BST<int>::BNode(40);
-      auto p60 = new custom::BST<int>::BNode(60);
-      auto p50 = new custom::BST<int>::BNode(50);
+      auto p10 = s.bst.newNode(10);
+      auto p20 = s.bst.newNode(20);
+      auto p30 = s.bst.newNode(30);
+      auto p40 = s.bst.newNode(40);
+      auto p60 = s.bst.newNode(60);
+      auto p50 = s.bst.newNode(50);
       s.bst.root = p10->pParent = p60->pParent = p50;
       p50->pLeft = p30->pParent = p10;
       p50->pRight = p60;
@@ -2909,6 +3183,7 @@ public:
       p30->pLeft = p20;
       p30->pRight = p40;
       s.bst.numElements = 6;
+      s.bst.resetEnds();
       auto itBST = custom::BST <int> ::iterator(p10);
       auto it = custom::set <int> ::iterator(itBST);
       // exercise
@@ -2938,11 +3213,11 @@ public:
       assertUnit(p50->data == 50);
       assertUnit(p60->data == 60);
       // teardown
-      delete p20;
-      delete p30;
-      delete p40;
-      delete p50;
-      delete p60;
+      s.bst.deleteNode(p20);
+      s.bst.deleteNode(p30);
+      s.bst.deleteNode(p40);
+      s.bst.deleteNode(p50);
+      s.bst.deleteNode(p60);
       s.bst.numElements = 0;
       s.bst.root = nullptr;
    }
@@ -2959,14 +3234,14 @@ public:
       //            +-+
       //              40 
       custom::set <int> s;
-      auto p10 = new custom::BST<int>::BNode(10);
-      auto p20 = new custom::BST<int>::BNode(20);
-      auto p30 = new custom::BST<int>::BNode(30);
-      auto p40 = new custom::BST<int>::BNode(40);
-      auto p50 = new custom::BST<int>::BNode(50);
-      auto p60 = new custom::BST<int>::BNode(60);
-      auto p70 = new custom::BST<int>::BNode(70);
-      auto p80 = new custom::BST<int>::BNode(80);
+      auto p10 = s.bst.newNode(10);
+      auto p20 = s.bst.newNode(20);
+      auto p30 = s.bst.newNode(30);
+      auto p40 = s.bst.newNode(40);
+      auto p50 = s.bst.newNode(50);
+      auto p60 = s.bst.newNode(60);
+      auto p70 = s.bst.newNode(70);
+      auto p80 = s.bst.newNode(80);
       s.bst.root = p20->pParent = p80->pParent = p70;
       p10->pParent = p50->pParent = p70->pLeft = p20;
       p70->pRight = p80;
@@ -2976,6 +3251,7 @@ public:
       p50->pRight = p60;
       p30->pRight = p40;
       s.bst.numElements = 8;
+      s.bst.resetEnds();
       auto itBST = custom::BST <int> ::iterator(p20);
       auto it = custom::set <int> ::iterator(itBST);
       // exercise
@@ -3013,13 +3289,13 @@ public:
       assertUnit(p70->data == 70);
       assertUnit(p80->data == 80);
       // teardown
-      delete p10;
-      delete p30;
-      delete p40;
-      delete p50;
-      delete p60;
-      delete p70;
-      delete p80;
+      s.bst.deleteNode(p10);
+      s.bst.deleteNode(p30);
+      s.bst.deleteNode(p40);
+      s.bst.deleteNode(p50);
+      s.bst.deleteNode(p60);
+      s.bst.deleteNode(p70);
+      s.bst.deleteNode(p80);
       s.bst.numElements = 0;
       s.bst.root = nullptr;
    }
@@ -3119,7 +3395,7 @@ public:
       assertUnit(num == 1);
       assertUnit(s.bst.root->pRight->pLeft == nullptr);
       assertUnit(s.bst.numElements == 6);
-      s.bst.root->pRight->pLeft = new custom::BST<Spy>::BNode(Spy(60));
+      s.bst.root->pRight->pLeft = s.bst.newNode(Spy(60));
       s.bst.root->pRight->pLeft->pParent = s.bst.root->pRight;
       s.bst.numElements = 7;
       assertStandardFixture(s);
@@ -3137,12 +3413,12 @@ public:
       //            +--+--+
       //           20    40
       custom::set <int> s;
-      auto p10 = new custom::BST<int>::BNode(10);
-      auto p20 = new custom::BST<int>::BNode(20);
-      auto p30 = new custom::BST<int>::BNode(30);
-      auto p40 = new custom::BST<int>::BNode(40);
-      auto p50 = new custom::BST<int>::BNode(50);
-      auto p60 = new custom::BST<int>::BNode(60);
+      auto p10 = s.bst.newNode(10);
+      auto p20 = s.bst.newNode(20);
+      auto p30 = s.bst.newNode(30);
+      auto p40 = s.bst.newNode(40);
+      auto p50 = s.bst.newNode(50);
+      auto p60 = s.bst.newNode(60);
       s.bst.root = p10->pParent = p60->pParent = p50;
       p50->pLeft = p30->pParent = p10;
       p50->pRight = p60;
@@ -3150,6 +3426,7 @@ public:
       p30->pLeft = p20;
       p30->pRight = p40;
       s.bst.numElements = 6;
+      s.bst.resetEnds();
       // exercise
       size_t num = s.erase(10);
       // verify
@@ -3175,11 +3452,11 @@ public:
       assertUnit(p50->data == 50);
       assertUnit(p60->data == 60);
       // teardown
-      delete p20;
-      delete p30;
-      delete p40;
-      delete p50;
-      delete p60;
+      s.bst.deleteNode(p20);
+      s.bst.deleteNode(p30);
+      s.bst.deleteNode(p40);
+      s.bst.deleteNode(p50);
+      s.bst.deleteNode(p60);
       s.bst.numElements = 0;
       s.bst.root = nullptr;
    }
@@ -3196,14 +3473,14 @@ public:
       //            +-+
       //              40 
       custom::set <int> s;
-      auto p10 = new custom::BST<int>::BNode(10);
-      auto p20 = new custom::BST<int>::BNode(20);
-      auto p30 = new custom::BST<int>::BNode(30);
-      auto p40 = new custom::BST<int>::BNode(40);
-      auto p50 = new custom::BST<int>::BNode(50);
-      auto p60 = new custom::BST<int>::BNode(60);
-      auto p70 = new custom::BST<int>::BNode(70);
-      auto p80 = new custom::BST<int>::BNode(80);
+      auto p10 = s.bst.newNode(10);
+      auto p20 = s.bst.newNode(20);
+      auto p30 = s.bst.newNode(30);
+      auto p40 = s.bst.newNode(40);
+      auto p50 = s.bst.newNode(50);
+      auto p60 = s.bst.newNode(60);
+      auto p70 = s.bst.newNode(70);
+      auto p80 = s.bst.newNode(80);
       s.bst.root = p20->pParent = p80->pParent = p70;
       p10->pParent = p50->pParent = p70->pLeft = p20;
       p70->pRight = p80;
@@ -3213,6 +3490,7 @@ public:
       p50->pRight = p60;
       p30->pRight = p40;
       s.bst.numElements = 8;
+      s.bst.resetEnds();
       // exercise
       size_t num = s.erase(20);
       // verify
@@ -3246,13 +3524,13 @@ public:
       assertUnit(p70->data == 70);
       assertUnit(p80->data == 80);
       // teardown
-      delete p10;
-      delete p30;
-      delete p40;
-      delete p50;
-      delete p60;
-      delete p70;
-      delete p80;
+      s.bst.deleteNode(p10);
+      s.bst.deleteNode(p30);
+      s.bst.deleteNode(p40);
+      s.bst.deleteNode(p50);
+      s.bst.deleteNode(p60);
+      s.bst.deleteNode(p70);
+      s.bst.deleteNode(p80);
       s.bst.numElements = 0;
       s.bst.root = nullptr;
    }
@@ -3440,6 +3718,107 @@ public:
 
    }
 
+   /***************************************
+    * SET ALGEBRA
+    *    set::unite(const set &)
+    *    set::intersect(const set &)
+    *    set::subtract(const set &)
+    ***************************************/
+
+   // {20 30 40 50 60 70 80} and {10 30 50 90} share 30 and 50
+   void test_unite_standard()
+   {  // setup
+      custom::set<int> s{ 20, 30, 40, 50, 60, 70, 80 };
+      custom::set<int> sOther{ 10, 30, 50, 90 };
+      // exercise
+      s.unite(sOther);
+      // verify
+      assertUnit(s.size() == 9);
+      int expect[] = { 10, 20, 30, 40, 50, 60, 70, 80, 90 };
+      bool isSame = true;
+      int i = 0;
+      for (auto it = s.begin(); it != s.end(); ++it)
+         isSame = isSame && *it == expect[i++];
+      assertUnit(isSame);
+      assertUnit(sOther.size() == 4);
+   }  // teardown
+
+   void test_intersect_standard()
+   {  // setup
+      custom::set<int> s{ 20, 30, 40, 50, 60, 70, 80 };
+      custom::set<int> sOther{ 10, 30, 50, 90 };
+      // exercise
+      s.intersect(sOther);
+      // verify
+      assertUnit(s.size() == 2);
+      assertUnit(*s.begin() == 30);
+      assertUnit(*s.rbegin() == 50);
+   }  // teardown
+
+   void test_subtract_standard()
+   {  // setup
+      custom::set<int> s{ 20, 30, 40, 50, 60, 70, 80 };
+      custom::set<int> sOther{ 10, 30, 50, 90 };
+      // exercise
+      s.subtract(sOther);
+      // verify
+      assertUnit(s.size() == 5);
+      assertUnit(s.find(30) == s.end());
+      assertUnit(s.find(50) == s.end());
+      assertUnit(s.find(40) != s.end());
+      assertUnit(*s.begin() == 20);
+      assertUnit(*s.rbegin() == 80);
+   }  // teardown
+
+   /***************************************
+    * B-TREE BACKEND
+    *    btree_set
+    ***************************************/
+
+   // the same set, kept in a B-tree
+   void test_btree_insertFind()
+   {  // setup
+      custom::btree_set<int> s;
+      // exercise
+      for (int i = 0; i < 1000; i++)
+         s.insert(i * 7 % 1000);
+      auto result = s.insert(49);
+      // verify
+      assertUnit(!result.second);
+      assertUnit(*result.first == 49);
+      assertUnit(s.size() == 1000);
+      assertUnit(s.find(500) != s.end());
+      assertUnit(*s.find(500) == 500);
+      assertUnit(s.find(1000) == s.end());
+      assertUnit(*s.begin() == 0);
+      assertUnit(*s.rbegin() == 999);
+      int expect = 0;
+      bool inOrder = true;
+      for (auto it = s.begin(); it != s.end(); ++it)
+         inOrder = inOrder && *it == expect++;
+      assertUnit(inOrder);
+   }  // teardown
+
+   // erasing a range while the B-tree moves elements between nodes
+   void test_btree_eraseRange()
+   {  // setup
+      custom::btree_set<int> s;
+      for (int i = 0; i < 1000; i++)
+         s.insert(i);
+      auto itBegin = s.find(100);
+      auto itEnd = s.find(900);
+      // exercise
+      auto itReturn = s.erase(itBegin, itEnd);
+      // verify
+      assertUnit(s.size() == 200);
+      assertUnit(*itReturn == 900);
+      assertUnit(s.find(99) != s.end());
+      assertUnit(s.find(100) == s.end());
+      assertUnit(s.find(899) == s.end());
+      assertUnit(s.erase(950) == 1);
+      assertUnit(s.size() == 199);
+   }  // teardown
+
    /*************************************************************
     * SETUP STANDARD FIXTURE
     *                (50b)
@@ -3455,13 +3834,13 @@ public:
       assertUnit(s.bst.root == nullptr);
 
       // allocate
-      custom::BST<Spy>::BNode* p20 = new custom::BST<Spy>::BNode(Spy(20));
-      custom::BST<Spy>::BNode* p30 = new custom::BST<Spy>::BNode(Spy(30));
-      custom::BST<Spy>::BNode* p40 = new custom::BST<Spy>::BNode(Spy(40));
-      custom::BST<Spy>::BNode* p50 = new custom::BST<Spy>::BNode(Spy(50));
-      custom::BST<Spy>::BNode* p60 = new custom::BST<Spy>::BNode(Spy(60));
-      custom::BST<Spy>::BNode* p70 = new custom::BST<Spy>::BNode(Spy(70));
-      custom::BST<Spy>::BNode* p80 = new custom::BST<Spy>::BNode(Spy(80));
+      custom::BST<Spy>::BNode* p20 = s.bst.newNode(Spy(20));
+      custom::BST<Spy>::BNode* p30 = s.bst.newNode(Spy(30));
+      custom::BST<Spy>::BNode* p40 = s.bst.newNode(Spy(40));
+      custom::BST<Spy>::BNode* p50 = s.bst.newNode(Spy(50));
+      custom::BST<Spy>::BNode* p60 = s.bst.newNode(Spy(60));
+      custom::BST<Spy>::BNode* p70 = s.bst.newNode(Spy(70));
+      custom::BST<Spy>::BNode* p80 = s.bst.newNode(Spy(80));
 
       // hook up the pointers down
       p30->pLeft = p20;
@@ -3482,6 +3861,8 @@ public:
 
       // now assign everything to the bst
       s.bst.root = p50;
+      s.bst.leftmost = p20;
+      s.bst.rightmost = p80;
       s.bst.numElements = 7;
    }
 
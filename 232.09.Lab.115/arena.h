@@ -0,0 +1,174 @@
+/***********************************************************************
+ * Header:
+ *    ARENA
+ * Summary:
+ *    A node allocator for BST. Rather than asking the allocator for one
+ *    node at a time, the arena asks for slabs of nodes and hands them
+ *    out one by one, so the nodes of a tree sit next to each other in
+ *    memory. A node given back goes on a free list to be handed out
+ *    again. When the tree is cleared, the slabs go back all at once
+ *    without visiting the nodes in them.
+ *
+ *    The first slab holds 16 nodes, and each one after that twice as
+ *    many as the last, up to 4096 nodes a slab.
+ *
+ *    This will contain the class definition of:
+ *        arena                : Hands out memory for one T at a time
+ * Author
+ *    David Schaad, Tori Tremelling
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>  // for size_t
+#include <memory>   // for std::allocator
+#include <utility>  // for std::swap
+
+class TestArena;    // forward declaration for unit tests
+
+namespace custom
+{
+
+   /*****************************************************************
+    * ARENA
+    * Memory for one T at a time, carved from slabs drawn from A.
+    * The arena never constructs or destroys a T, it only hands
+    * out the room for one
+    *****************************************************************/
+   template <typename T, typename A = std::allocator<T>>
+   class arena
+   {
+      friend class ::TestArena; // give unit tests access to the privates
+   public:
+      static constexpr size_t SLAB_MIN = 16;    // cells in the first slab
+      static constexpr size_t SLAB_MAX = 4096;  // cells in a slab, at most
+
+      //
+      // Construct
+      //
+      arena(const A& a = A()) : alloc(a), pSlab(nullptr), pFree(nullptr),
+                                numSlabs(0), numUsed(0) {}
+      arena(const arena& rhs) = delete;
+      arena(arena&& rhs) : arena(rhs.alloc)
+      {
+         swap(rhs);
+      }
+      ~arena()
+      {
+         release();
+      }
+
+      //
+      // Assign
+      //
+      arena& operator = (const arena& rhs) = delete;
+      arena& operator = (arena&& rhs)
+      {
+         release();
+         swap(rhs);
+         return *this;
+      }
+      void swap(arena& rhs)
+      {
+         std::swap(alloc,    rhs.alloc);
+         std::swap(pSlab,    rhs.pSlab);
+         std::swap(pFree,    rhs.pFree);
+         std::swap(numSlabs, rhs.numSlabs);
+         std::swap(numUsed,  rhs.numUsed);
+      }
+
+      //
+      // Allocate and deallocate
+      //
+      T* allocate();
+      void deallocate(T* p);
+      void release();
+
+      //
+      // Status
+      //
+      size_t slabs() const { return numSlabs; }
+
+   private:
+      // A cell holds a T while handed out, and the next free cell while
+      // not. The first cell of each slab links to the slab before it
+      union Cell
+      {
+         Cell* pNext;
+         alignas(T) unsigned char storage[sizeof(T)];
+      };
+      using CellAlloc = typename std::allocator_traits<A>::template rebind_alloc<Cell>;
+
+      // cells in slab number iSlab, counting the link cell
+      static size_t slabSize(size_t iSlab)
+      {
+         return (iSlab < 8 ? SLAB_MIN << iSlab : SLAB_MAX) + 1;
+      }
+
+      CellAlloc alloc;        // where the slabs come from
+      Cell*  pSlab;           // newest slab, linked to the older ones
+      Cell*  pFree;           // cells given back, linked through pNext
+      size_t numSlabs;        // number of slabs we hold
+      size_t numUsed;         // cells of the newest slab handed out so far
+   };
+
+   /*****************************************************************
+    * ARENA :: ALLOCATE
+    * Room for one T. A cell given back is used first, then the
+    * next untouched cell of the newest slab, then a new slab
+    *****************************************************************/
+   template <typename T, typename A>
+   T* arena <T, A> ::allocate()
+   {
+      if (pFree)
+      {
+         Cell* pCell = pFree;
+         pFree = pFree->pNext;
+         return reinterpret_cast<T*>(pCell->storage);
+      }
+
+      if (!pSlab || numUsed + 1 == slabSize(numSlabs - 1))
+      {
+         Cell* pSlabNew = alloc.allocate(slabSize(numSlabs));
+         pSlabNew->pNext = pSlab;
+         pSlab = pSlabNew;
+         numSlabs++;
+         numUsed = 0;
+      }
+
+      return reinterpret_cast<T*>(pSlab[1 + numUsed++].storage);
+   }
+
+   /*****************************************************************
+    * ARENA :: DEALLOCATE
+    * Take back the room for one T, which must already be destroyed
+    *****************************************************************/
+   template <typename T, typename A>
+   void arena <T, A> ::deallocate(T* p)
+   {
+      assert(p != nullptr);
+      Cell* pCell = reinterpret_cast<Cell*>(p);
+      pCell->pNext = pFree;
+      pFree = pCell;
+   }
+
+   /*****************************************************************
+    * ARENA :: RELEASE
+    * Give every slab back. Any T still in them must already
+    * be destroyed. Costs one deallocate per slab, not per T
+    *****************************************************************/
+   template <typename T, typename A>
+   void arena <T, A> ::release()
+   {
+      while (pSlab)
+      {
+         Cell* pSlabOld = pSlab;
+         pSlab = pSlab->pNext;
+         alloc.deallocate(pSlabOld, slabSize(--numSlabs));
+      }
+      pFree = nullptr;
+      numUsed = 0;
+   }
+
+} // namespace custom
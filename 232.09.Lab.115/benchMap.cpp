@@ -0,0 +1,333 @@
+/***********************************************************************
+ * Header:
+ *    Bench
+ * Summary:
+ *    Driver to time map.h. It is not part of the unit tests; build
+ *    it on its own and with optimization:
+ *       g++ -std=c++17 -O2 -o benchMap benchMap.cpp
+ *       ./benchMap [number of keys, 10000000 when left off]
+ *    The B-tree runs on a tenth of the keys and then all of them, so
+ *    the default covers 1M keys and ./benchMap 100000000 covers 100M
+ *    Every line reports nanoseconds per operation, so a number that
+ *    holds steady while the count grows tenfold is a constant cost
+ * Author
+ *    David Schaad
+ ************************************************************************/
+
+#include "map.h"        // for map, ranked_map and btree_map
+#include <chrono>       // for steady_clock
+#include <cstdlib>      // for strtoul
+#include <iostream>     // for cout
+#include <iomanip>      // for setw
+#include <algorithm>    // for shuffle
+#include <numeric>      // for iota
+#include <vector>       // for the shuffled keys
+#include <random>       // for mt19937_64
+#include <string>       // for to_string
+using namespace std;
+
+/**********************************************************************
+ * NANOSECONDS PER
+ * Time f() and divide by how many operations it did
+ ***********************************************************************/
+template <class F>
+double nanosecondsPer(size_t num, F f)
+{
+   auto start = chrono::steady_clock::now();
+   f();
+   chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+   return num ? elapsed.count() / num : 0.0;
+}
+
+/**********************************************************************
+ * REPORT
+ * One line: what was timed, on how many keys, and its cost
+ ***********************************************************************/
+void report(const string& what, size_t num, double ns)
+{
+   cout << setw(36) << left << what
+        << setw(12) << right << num
+        << setw(10) << fixed << setprecision(1) << ns << " ns\n";
+}
+
+/**********************************************************************
+ * APPEND
+ * Insert 0, 1, 2, ... num-1. Each key lands right of the largest,
+ * so the rightmost fast path and a hint of end() both skip the walk
+ * from the root: the cost per key should not grow with num
+ ***********************************************************************/
+template <class Map>
+double appendAscending(size_t num)
+{
+   Map m;
+   return nanosecondsPer(num, [&]
+   {
+      for (size_t i = 0; i < num; i++)
+         m.insert(custom::make_pair(i, i));
+   });
+}
+
+template <class Map>
+double appendHinted(size_t num)
+{
+   Map m;
+   return nanosecondsPer(num, [&]
+   {
+      for (size_t i = 0; i < num; i++)
+         m.insert(m.end(), custom::make_pair(i, i));
+   });
+}
+
+void benchAppend(size_t num)
+{
+   for (size_t n : { num / 100, num / 10, num })
+   {
+      report("append: map", n, appendAscending<custom::map<size_t, size_t>>(n));
+      report("append: map, hint end()", n, appendHinted<custom::map<size_t, size_t>>(n));
+      report("append: ranked_map", n, appendAscending<custom::ranked_map<size_t, size_t>>(n));
+   }
+}
+
+/**********************************************************************
+ * CHURN
+ * Keep num/10 keys alive while erasing the oldest and inserting a
+ * new largest, round after round, like a window over timestamps.
+ * Erasing from one end and adding at the other is what skews a tree
+ * that does not rebalance on erase, so if erase ever stopped
+ * rebalancing, later rounds and the finds after them would slow
+ ***********************************************************************/
+void benchChurn(size_t num)
+{
+   size_t live = num / 10;
+   custom::map<size_t, size_t> m;
+   for (size_t i = 0; i < live; i++)
+      m.insert(custom::make_pair(i, i));
+
+   mt19937_64 random(232);
+   size_t oldest = 0;
+   for (int round = 1; round <= 5; round++)
+   {
+      double ns = nanosecondsPer(live, [&]
+      {
+         for (size_t i = 0; i < live; i++)
+         {
+            m.erase(oldest);
+            m.insert(custom::make_pair(oldest + live, oldest + live));
+            oldest++;
+         }
+      });
+      report("churn: round " + to_string(round) + ", erase+insert", live, ns);
+
+      size_t found = 0;
+      ns = nanosecondsPer(live, [&]
+      {
+         for (size_t i = 0; i < live; i++)
+            if (m.find(oldest + random() % live) != m.end())
+               found++;
+      });
+      report("churn: round " + to_string(round) + ", find", live, ns);
+      if (found != live)
+         cout << "churn lost " << live - found << " keys\n";
+   }
+}
+
+/**********************************************************************
+ * SHUFFLED
+ * The keys 0 through num-1 in a random order that is the same from
+ * run to run
+ ***********************************************************************/
+vector<size_t> shuffled(size_t num)
+{
+   vector<size_t> keys(num);
+   iota(keys.begin(), keys.end(), 0);
+   shuffle(keys.begin(), keys.end(), mt19937_64(232));
+   return keys;
+}
+
+/**********************************************************************
+ * BUILD, LOOKUP, DESTROY
+ * Insert num keys in a random order, find each of them again in
+ * another order, then destroy the map. All three lean on where the
+ * nodes live: the arena packs them together, and gives them back a
+ * slab at a time rather than one node at a time
+ ***********************************************************************/
+void benchBuild(size_t num)
+{
+   vector<size_t> keys = shuffled(num);
+   custom::map<size_t, size_t>* pMap = new custom::map<size_t, size_t>;
+
+   report("build: insert shuffled keys", num, nanosecondsPer(num, [&]
+   {
+      for (size_t key : keys)
+         pMap->insert(custom::make_pair(key, key));
+   }));
+
+   shuffle(keys.begin(), keys.end(), mt19937_64(233));
+   size_t found = 0;
+   report("build: find every key", num, nanosecondsPer(num, [&]
+   {
+      for (size_t key : keys)
+         if (pMap->find(key) != pMap->end())
+            found++;
+   }));
+   if (found != num)
+      cout << "build lost " << num - found << " keys\n";
+
+   report("build: destroy the map", num, nanosecondsPer(num, [&]
+   {
+      delete pMap;
+   }));
+}
+
+/**********************************************************************
+ * COPY AND CLEAR
+ * Copy a map of num keys into an empty map, assign it over a map
+ * that already holds as many nodes to reuse, then clear both. None
+ * of these recurse, so the cost per node should not depend on the
+ * shape of the tree
+ ***********************************************************************/
+void benchCopy(size_t num)
+{
+   vector<size_t> keys = shuffled(num);
+   custom::map<size_t, size_t> mSrc;
+   for (size_t key : keys)
+      mSrc.insert(custom::make_pair(key, key));
+
+   custom::map<size_t, size_t>* pCopy = nullptr;
+   report("copy: construct", num, nanosecondsPer(num, [&]
+   {
+      pCopy = new custom::map<size_t, size_t>(mSrc);
+   }));
+
+   custom::map<size_t, size_t> mDest;
+   for (size_t i = 0; i < num; i++)
+      mDest.insert(custom::make_pair(num + i, i));
+   report("copy: assign over num nodes", num, nanosecondsPer(num, [&]
+   {
+      mDest = *pCopy;
+   }));
+   if (mDest.size() != num)
+      cout << "copy lost " << num - mDest.size() << " keys\n";
+
+   report("copy: clear", num, nanosecondsPer(num, [&]
+   {
+      pCopy->clear();
+      mDest.clear();
+   }) / 2.0);
+   delete pCopy;
+}
+
+/**********************************************************************
+ * B-TREE
+ * The same inserts, finds and in-order walk over a map kept in a
+ * BST and one kept in a BTree. A find in the B-tree reads a few
+ * wide nodes rather than one node per level
+ ***********************************************************************/
+template <class Map>
+void benchTree(const char* name, const vector<size_t>& keys)
+{
+   size_t num = keys.size();
+   Map m;
+   string prefix = string("btree: ") + name;
+
+   report(prefix + " insert", num, nanosecondsPer(num, [&]
+   {
+      for (size_t key : keys)
+         m.insert(custom::make_pair(key, key));
+   }));
+
+   size_t found = 0;
+   report(prefix + " find", num, nanosecondsPer(num, [&]
+   {
+      for (size_t i = 0; i < num; i++)
+         if (m.find(keys[num - 1 - i]) != m.end())
+            found++;
+   }));
+   if (found != num)
+      cout << prefix << " lost " << num - found << " keys\n";
+
+   size_t sum = 0;
+   report(prefix + " walk in order", num, nanosecondsPer(num, [&]
+   {
+      for (auto it = m.begin(); it != m.end(); ++it)
+         sum += (*it).second;
+   }));
+   if (sum != num * (num - 1) / 2)
+      cout << prefix << " walked the wrong keys\n";
+}
+
+void benchBTree(size_t num)
+{
+   for (size_t n : { num / 10, num })
+   {
+      vector<size_t> keys = shuffled(n);
+      benchTree<custom::map<size_t, size_t>>("map", keys);
+      benchTree<custom::btree_map<size_t, size_t>>("btree_map", keys);
+   }
+}
+
+/**********************************************************************
+ * RANGE SCAN
+ * Visit every key in [a, a + 100) for random a. lower_bound goes
+ * straight to a; without it, a scan walks from begin() and skips
+ * everything smaller. The walk costs so much more that it gets far
+ * fewer queries. Both report nanoseconds per query
+ ***********************************************************************/
+template <class F>
+double scanRanges(custom::map<size_t, size_t>& m, size_t num, size_t numQueries, F first)
+{
+   const size_t WIDTH = 100;
+   mt19937_64 random(232);
+   size_t visited = 0;
+   double ns = nanosecondsPer(numQueries, [&]
+   {
+      for (size_t q = 0; q < numQueries; q++)
+      {
+         size_t a = random() % (num - WIDTH);
+         for (auto it = first(a); it != m.end() && (*it).first < a + WIDTH; ++it)
+            visited++;
+      }
+   });
+   if (visited != numQueries * WIDTH)
+      cout << "range scan visited " << visited << " keys\n";
+   return ns;
+}
+
+void benchRange(size_t num)
+{
+   if (num <= 100)
+      return;
+   custom::map<size_t, size_t> m;
+   for (size_t i = 0; i < num; i++)
+      m.insert(custom::make_pair(i, i));
+
+   report("range: lower_bound, 100 keys", num, scanRanges(m, num, 100000, [&](size_t a)
+   {
+      return m.lower_bound(a);
+   }));
+   report("range: walk from begin(), 100 keys", num, scanRanges(m, num, 10, [&](size_t a)
+   {
+      auto it = m.begin();
+      while (it != m.end() && (*it).first < a)
+         ++it;
+      return it;
+   }));
+}
+
+/**********************************************************************
+ * MAIN
+ * Run every benchmark on the number of keys asked for
+ ***********************************************************************/
+int main(int argc, char** argv)
+{
+   size_t num = argc > 1 ? strtoul(argv[1], nullptr, 10) : 10000000;
+
+   benchAppend(num);
+   benchChurn(num);
+   benchBuild(num);
+   benchCopy(num);
+   benchBTree(num);
+   benchRange(num);
+
+   return 0;
+}
@@ -22,6 +22,7 @@
 
 #include "pair.h"     // for pair
 #include "bst.h"      // no nested class necessary for this assignment
+#include "btree.h"    // or, for lots of keys, a B-tree
 
 #ifndef debug
 #ifdef DEBUG
@@ -38,15 +39,19 @@ namespace custom
 
    /*****************************************************************
     * MAP
-    * Create a Map, similar to a Binary Search Tree
+    * Create a Map, similar to a Binary Search Tree. A is where
+    * the nodes of the tree get their memory, and Tree is what
+    * keeps the pairs in order: a BST, a BST that counts its
+    * subtrees (see ranked_map), or a BTree (see btree_map)
     *****************************************************************/
-   template <class K, class V>
+   template <class K, class V, class A = std::allocator<pair<K, V>>,
+             class Tree = BST<pair<K, V>, A>>
    class map
    {
       friend class ::TestMap;
 
-      template <class KK, class VV>
-      friend void swap(map<KK, VV>& lhs, map<KK, VV>& rhs);
+      template <class KK, class VV, class AA, class TTree>
+      friend void swap(map<KK, VV, AA, TTree>& lhs, map<KK, VV, AA, TTree>& rhs);
    public:
       using Pairs = custom::pair<K, V>;
 
@@ -57,16 +62,15 @@ namespace custom
       map(const map& rhs) : bst(rhs.bst) {}
       map(map&& rhs) : bst(std::move(rhs.bst)) {}
 
+      // sorted input builds the tree directly rather than inserting
       template <class Iterator>
       map(Iterator first, Iterator last)
       {
-         clear();
-         insert(first, last);
+         bst.assign(first, last, true /*keepUnique*/);
       }
       map(const std::initializer_list <Pairs>& il)
       {
-         clear();
-         insert(il);
+         bst.assign(il.begin(), il.end(), true /*keepUnique*/);
       }
       ~map() {}
 
@@ -86,8 +90,7 @@ namespace custom
       }
       map& operator = (const std::initializer_list <Pairs>& il)
       {
-         clear();
-         insert(il);
+         bst.assign(il.begin(), il.end(), true /*keepUnique*/);
          return *this;
       }
 
@@ -104,6 +107,16 @@ namespace custom
          return bst.end();
       }
 
+      // the largest key; walk backwards with -- until rend()
+      iterator rbegin()
+      {
+         return bst.rbegin();
+      }
+      iterator rend()
+      {
+         return bst.rend();
+      }
+
       // 
       // Access
       //
@@ -116,6 +129,35 @@ namespace custom
          return bst.find(k);
       }
 
+      // the first key not less than k, the first greater than k,
+      // and both together
+      iterator lower_bound(const K& k) const
+      {
+         return bst.lower_bound(k);
+      }
+      iterator upper_bound(const K& k) const
+      {
+         return bst.upper_bound(k);
+      }
+      custom::pair<iterator, iterator> equal_range(const K& k) const
+      {
+         auto range = bst.equal_range(k);
+         return custom::make_pair(iterator(range.first), iterator(range.second));
+      }
+
+      // the pair with the k-th smallest key counting from zero, or
+      // end(). Only a ranked_map can answer these two
+      iterator select(size_t k) const
+      {
+         return bst.select(k);
+      }
+
+      // how many keys are smaller than k
+      size_t rank(const K& k) const
+      {
+         return bst.rank(k);
+      }
+
       //
       // Insert
       //
@@ -130,6 +172,16 @@ namespace custom
          return custom::make_pair(iterator(result.first), result.second);
       }
 
+      // rhs goes right next to hint when that is where it belongs
+      iterator insert(iterator hint, const Pairs& rhs)
+      {
+         return iterator(bst.insert(hint.it, rhs, true).first);
+      }
+      iterator insert(iterator hint, Pairs&& rhs)
+      {
+         return iterator(bst.insert(hint.it, std::move(rhs), true).first);
+      }
+
       template <class Iterator>
       void insert(Iterator first, Iterator last)
       {
@@ -153,6 +205,25 @@ namespace custom
       iterator erase(iterator it);
       iterator erase(iterator first, iterator last);
 
+      //
+      // Set algebra
+      //
+
+      // by key: keep what is in either map, what is in both, or what
+      // is only in this one. A key in both keeps this map's value
+      void unite(const map& rhs)
+      {
+         bst.unite(rhs.bst);
+      }
+      void intersect(const map& rhs)
+      {
+         bst.intersect(rhs.bst);
+      }
+      void subtract(const map& rhs)
+      {
+         bst.subtract(rhs.bst);
+      }
+
       //
       // Status
       //
@@ -169,7 +240,7 @@ namespace custom
    private:
 
       // the students DO NOT need to use a nested class
-      BST < pair <K, V >> bst;
+      Tree bst;
    };
 
 
@@ -178,18 +249,18 @@ namespace custom
     * Forward and reverse iterator through a Map, just call
     * through to BSTIterator
     *********************************************************/
-   template <typename K, typename V>
-   class map <K, V> ::iterator
+   template <typename K, typename V, typename A, typename Tree>
+   class map <K, V, A, Tree> ::iterator
    {
       friend class ::TestMap;
-      template <class KK, class VV>
+      template <class KK, class VV, class AA, class TTree>
       friend class custom::map;
    public:
       //
       // Construct
       //
       iterator() {}
-      iterator(const typename BST < pair <K, V> > ::iterator& itRHS) : it(itRHS) {}
+      iterator(const typename Tree::iterator& itRHS) : it(itRHS) {}
       iterator(const iterator& rhs) : it(rhs.it) {}
 
       //
@@ -255,7 +326,7 @@ namespace custom
    private:
 
       // Member variable
-      typename BST < pair <K, V >>  ::iterator it;
+      typename Tree::iterator it;
    };
 
 
@@ -263,8 +334,8 @@ namespace custom
     * MAP :: SUBSCRIPT
     * Retrieve an element from the map
     ****************************************************/
-   template <typename K, typename V>
-   V& map <K, V> :: operator [] (const K& key)
+   template <typename K, typename V, typename A, typename Tree>
+   V& map <K, V, A, Tree> :: operator [] (const K& key)
    {
       Pairs p(key);
       auto result = insert(p);
@@ -276,8 +347,8 @@ namespace custom
     * MAP :: SUBSCRIPT
     * Retrieve an element from the map
     ****************************************************/
-   template <typename K, typename V>
-   const V& map <K, V> :: operator [] (const K& key) const
+   template <typename K, typename V, typename A, typename Tree>
+   const V& map <K, V, A, Tree> :: operator [] (const K& key) const
    {
       Pairs p(key);
       auto it = bst.find(p);
@@ -290,8 +361,8 @@ namespace custom
     * MAP :: AT
     * Retrieve an element from the map
     ****************************************************/
-   template <typename K, typename V>
-   V& map <K, V> ::at(const K& key)
+   template <typename K, typename V, typename A, typename Tree>
+   V& map <K, V, A, Tree> ::at(const K& key)
    {
       iterator it = find(key);
 
@@ -305,8 +376,8 @@ namespace custom
     * MAP :: AT
     * Retrieve an element from the map
     ****************************************************/
-   template <typename K, typename V>
-   const V& map <K, V> ::at(const K& key) const
+   template <typename K, typename V, typename A, typename Tree>
+   const V& map <K, V, A, Tree> ::at(const K& key) const
    {
       auto it = bst.find(key);
 
@@ -320,8 +391,8 @@ namespace custom
     * SWAP
     * Swap two maps
     ****************************************************/
-   template <typename K, typename V>
-   void swap(map <K, V>& lhs, map <K, V>& rhs)
+   template <typename K, typename V, typename A, typename Tree>
+   void swap(map <K, V, A, Tree>& lhs, map <K, V, A, Tree>& rhs)
    {
       lhs.bst.swap(rhs.bst);
    }
@@ -330,8 +401,8 @@ namespace custom
     * ERASE
     * Erase one element
     ****************************************************/
-   template <typename K, typename V>
-   size_t map<K, V>::erase(const K& k)
+   template <typename K, typename V, typename A, typename Tree>
+   size_t map<K, V, A, Tree>::erase(const K& k)
    {
       auto it = find(k);
       if (it == end())
@@ -345,13 +416,17 @@ namespace custom
     * ERASE
     * Erase several elements
     ****************************************************/
-   template <typename K, typename V>
-   typename map<K, V>::iterator map<K, V>::erase(map<K, V>::iterator first, map<K, V>::iterator last)
+   template <typename K, typename V, typename A, typename Tree>
+   typename map<K, V, A, Tree>::iterator map<K, V, A, Tree>::erase(map<K, V, A, Tree>::iterator first, map<K, V, A, Tree>::iterator last)
    {
-      while (first != last)
-      {
-         erase(first++);
-      }
+      // a B-tree moves elements around as it erases, so last
+      // may not stay put; count the elements instead
+      size_t num = 0;
+      for (iterator it = first; it != last; ++it)
+         num++;
+
+      while (num--)
+         first = erase(first);
 
       return first;
    }
@@ -360,10 +435,27 @@ namespace custom
     * ERASE
     * Erase one element
     ****************************************************/
-   template <typename K, typename V>
-   typename map<K, V>::iterator map<K, V>::erase(map<K, V>::iterator it)
+   template <typename K, typename V, typename A, typename Tree>
+   typename map<K, V, A, Tree>::iterator map<K, V, A, Tree>::erase(map<K, V, A, Tree>::iterator it)
    {
       return iterator(bst.erase(it.it));
    }
 
+   /*****************************************************
+    * BTREE MAP
+    * A map kept in a B-tree rather than a BST
+    ****************************************************/
+   template <class K, class V, class A = std::allocator<pair<K, V>>>
+   using btree_map = map<K, V, A, BTree<pair<K, V>, A>>;
+
+   /*****************************************************
+    * RANKED MAP
+    * A map that can find the pair with the k-th smallest
+    * key and count the keys smaller than a key, both in
+    * O(log n). It pays for that with a count in every
+    * node, kept up on every insert and erase
+    ****************************************************/
+   template <class K, class V, class A = std::allocator<pair<K, V>>>
+   using ranked_map = map<K, V, A, BST<pair<K, V>, A, true>>;
+
 }; //  namespace custom
@@ -0,0 +1,205 @@
+/***********************************************************************
+ * Header:
+ *    TEST ARENA
+ * Summary:
+ *    Unit tests for arena
+ * Author
+ *    David Schaad, Tori Tremelling
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "arena.h"
+#include "unitTest.h"
+
+#include <vector>
+
+class TestArena : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_empty();
+
+      // Allocate
+      test_allocate_contiguous();
+      test_allocate_slabGrows();
+      test_allocate_slabMax();
+      test_deallocate_reuse();
+
+      // Release
+      test_release_all();
+      test_release_thenAllocate();
+
+      // Move
+      test_move_construct();
+      test_swap();
+
+      report("Arena");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // nothing is drawn from the allocator up front
+   void test_construct_empty()
+   {  // setup
+      // exercise
+      custom::arena<double> a;
+      // verify
+      assertUnit(a.slabs() == 0);
+      assertUnit(a.pSlab == nullptr);
+      assertUnit(a.pFree == nullptr);
+      assertUnit(a.numUsed == 0);
+   }  // teardown
+
+   /***************************************
+    * ALLOCATE
+    ***************************************/
+
+   // the cells of one slab sit side by side. A double fills its
+   // cell exactly, so its cells are one apart
+   void test_allocate_contiguous()
+   {  // setup
+      custom::arena<double> a;
+      // exercise
+      double* p0 = a.allocate();
+      double* p1 = a.allocate();
+      double* p2 = a.allocate();
+      // verify
+      assertUnit(a.slabs() == 1);
+      assertUnit(a.numUsed == 3);
+      assertUnit(p1 - p0 == 1);
+      assertUnit(p2 - p1 == 1);
+   }  // teardown
+
+   // a full slab is followed by one twice its size
+   void test_allocate_slabGrows()
+   {  // setup
+      custom::arena<int> a;
+      size_t numFirst = custom::arena<int>::SLAB_MIN;
+      for (size_t i = 0; i < numFirst; i++)
+         a.allocate();
+      // exercise
+      a.allocate();
+      // verify
+      assertUnit(a.slabs() == 2);
+      assertUnit(a.numUsed == 1);
+      assertUnit(a.slabSize(0) == numFirst + 1);
+      assertUnit(a.slabSize(1) == 2 * numFirst + 1);
+   }  // teardown
+
+   // slabs stop growing at SLAB_MAX
+   void test_allocate_slabMax()
+   {  // setup
+      // exercise
+      size_t sizeLate = custom::arena<int>::slabSize(40);
+      // verify
+      assertUnit(custom::arena<int>::slabSize(7) == 16 * 128 + 1);
+      assertUnit(custom::arena<int>::slabSize(8) == custom::arena<int>::SLAB_MAX + 1);
+      assertUnit(sizeLate == custom::arena<int>::SLAB_MAX + 1);
+   }  // teardown
+
+   // a cell given back is the next one handed out
+   void test_deallocate_reuse()
+   {  // setup
+      custom::arena<double> a;
+      double* p0 = a.allocate();
+      double* p1 = a.allocate();
+      double* p2 = a.allocate();
+      // exercise
+      a.deallocate(p1);
+      a.deallocate(p0);
+      double* pFirst = a.allocate();
+      double* pSecond = a.allocate();
+      double* pThird = a.allocate();
+      // verify
+      assertUnit(pFirst == p0);
+      assertUnit(pSecond == p1);
+      assertUnit(pThird == p2 + 1);      // free list empty, back to the slab
+      assertUnit(a.pFree == nullptr);
+      assertUnit(a.slabs() == 1);
+   }  // teardown
+
+   /***************************************
+    * RELEASE
+    ***************************************/
+
+   // every slab goes back at once
+   void test_release_all()
+   {  // setup
+      custom::arena<int> a;
+      for (int i = 0; i < 1000; i++)
+         a.allocate();
+      a.deallocate(a.allocate());
+      // exercise
+      a.release();
+      // verify
+      assertUnit(a.slabs() == 0);
+      assertUnit(a.pSlab == nullptr);
+      assertUnit(a.pFree == nullptr);
+      assertUnit(a.numUsed == 0);
+   }  // teardown
+
+   // after a release the arena starts over from a small slab
+   void test_release_thenAllocate()
+   {  // setup
+      custom::arena<int> a;
+      for (int i = 0; i < 100; i++)
+         a.allocate();
+      a.release();
+      // exercise
+      int* p = a.allocate();
+      // verify
+      assertUnit(p != nullptr);
+      assertUnit(a.slabs() == 1);
+      assertUnit(a.numUsed == 1);
+   }  // teardown
+
+   /***************************************
+    * MOVE
+    ***************************************/
+
+   // the slabs follow the move, the source is left empty
+   void test_move_construct()
+   {  // setup
+      custom::arena<int> aSrc;
+      int* p = aSrc.allocate();
+      aSrc.allocate();
+      aSrc.deallocate(p);
+      // exercise
+      custom::arena<int> aDest(std::move(aSrc));
+      // verify
+      assertUnit(aSrc.slabs() == 0);
+      assertUnit(aSrc.pFree == nullptr);
+      assertUnit(aDest.slabs() == 1);
+      assertUnit(aDest.numUsed == 2);
+      assertUnit(aDest.allocate() == p);
+   }  // teardown
+
+   // swap trades everything
+   void test_swap()
+   {  // setup
+      custom::arena<double> a1;
+      custom::arena<double> a2;
+      double* p = a1.allocate();
+      std::vector<double*> ps;
+      for (int i = 0; i < 20; i++)
+         ps.push_back(a2.allocate());
+      // exercise
+      a1.swap(a2);
+      // verify
+      assertUnit(a1.slabs() == 2);
+      assertUnit(a1.numUsed == 4);
+      assertUnit(a2.slabs() == 1);
+      assertUnit(a2.numUsed == 1);
+      assertUnit(a2.allocate() == p + 1);
+   }  // teardown
+};
+
+#endif // DEBUG
@@ -0,0 +1,624 @@
+/***********************************************************************
+ * Header:
+ *    TEST BTREE
+ * Summary:
+ *    Unit tests for BTree. Most use nodes of three elements so
+ *    splits, borrows and merges happen after only a few elements
+ * Author
+ *    David Schaad, Tori Tremelling
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "btree.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cstdlib>    // for std::rand
+#include <set>        // to check against
+#include <string>
+#include <vector>
+
+class TestBTree : public UnitTest
+{
+   // three elements a node, at least one
+   using Tree3 = custom::BTree<int, std::allocator<int>, 16>;
+
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_fanout();
+      test_constructCopy_standard();
+      test_constructMove_standard();
+
+      // Assign
+      test_assignMove_self();
+
+      // Insert
+      test_insert_oneLeaf();
+      test_insert_splitLeaf();
+      test_insert_splitRoot();
+      test_insert_duplicate();
+      test_insert_multi();
+
+      // Find
+      test_find_standard();
+      test_bounds_duplicates();
+
+      // Iterator
+      test_iterator_forward();
+      test_iterator_backward();
+
+      // Erase
+      test_erase_leaf();
+      test_erase_inner();
+      test_erase_borrow();
+      test_erase_merge();
+      test_erase_all();
+      test_erase_randomStress();
+      test_erase_strings();
+      test_clear_spy();
+
+      report("BTree");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // an empty tree has no nodes
+   void test_construct_default()
+   {  // setup
+      // exercise
+      Tree3 tree;
+      // verify
+      assertUnit(tree.root == nullptr);
+      assertUnit(tree.leftmost == nullptr);
+      assertUnit(tree.rightmost == nullptr);
+      assertUnit(tree.numElements == 0);
+      assertUnit(tree.begin() == tree.end());
+   }  // teardown
+
+   // an inner node holds as many elements and children as fit,
+   // never fewer than three elements
+   void test_construct_fanout()
+   {  // setup
+      // exercise
+      size_t numInt = custom::BTree<int>::MAX_KEYS;
+      size_t numDouble = custom::BTree<double>::MAX_KEYS;
+      // verify
+      assertUnit(numInt == (256 - 3 * sizeof(void*)) / (sizeof(int) + sizeof(void*)));
+      assertUnit(numDouble == (256 - 3 * sizeof(void*)) / (sizeof(double) + sizeof(void*)));
+      assertUnit(Tree3::MAX_KEYS == 3);
+      assertUnit(Tree3::MIN_KEYS == 1);
+      assertUnit(sizeof(custom::BTree<int>::Inner) <= 256);
+      assertUnit(sizeof(custom::BTree<double>::Inner) <= 256);
+      assertUnit(sizeof(custom::BTree<int>::Node) < sizeof(custom::BTree<int>::Inner));
+   }  // teardown
+
+   // a copy has the same shape and elements in new nodes
+   void test_constructCopy_standard()
+   {  // setup
+      Tree3 treeSrc;
+      setupStandardFixture(treeSrc);
+      // exercise
+      Tree3 treeDest(treeSrc);
+      // verify
+      assertUnit(treeDest.root != treeSrc.root);
+      assertUnit(treeDest.numElements == 7);
+      assertUnit(treeDest.root->numKeys == treeSrc.root->numKeys);
+      assertUnit(toVector(treeDest) == std::vector<int>({ 20, 30, 40, 50, 60, 70, 80 }));
+      assertUnit(isBTree(treeDest));
+      assertUnit(isBTree(treeSrc));
+   }  // teardown
+
+   // a move takes the nodes and leaves the source empty
+   void test_constructMove_standard()
+   {  // setup
+      Tree3 treeSrc;
+      setupStandardFixture(treeSrc);
+      auto pRoot = treeSrc.root;
+      // exercise
+      Tree3 treeDest(std::move(treeSrc));
+      // verify
+      assertUnit(treeDest.root == pRoot);
+      assertUnit(treeDest.numElements == 7);
+      assertUnit(treeSrc.root == nullptr);
+      assertUnit(treeSrc.numElements == 0);
+      assertUnit(isBTree(treeDest));
+   }  // teardown
+
+   /***************************************
+    * ASSIGN
+    ***************************************/
+
+   // moving a tree onto itself leaves it as it was
+   void test_assignMove_self()
+   {  // setup
+      Tree3 tree;
+      setupStandardFixture(tree);
+      auto pRoot = tree.root;
+      Tree3& alias = tree;
+      // exercise
+      tree = std::move(alias);
+      // verify
+      assertUnit(tree.root == pRoot);
+      assertUnit(tree.numElements == 7);
+      assertUnit(toVector(tree) == std::vector<int>({ 20, 30, 40, 50, 60, 70, 80 }));
+      assertUnit(isBTree(tree));
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // elements of a small tree sit side by side in one leaf
+   void test_insert_oneLeaf()
+   {  // setup
+      Tree3 tree;
+      // exercise
+      tree.insert(50);
+      tree.insert(30);
+      auto result = tree.insert(70);
+      // verify
+      //   [30 50 70]
+      assertUnit(result.second);
+      assertUnit(*result.first == 70);
+      assertUnit(tree.root->isLeaf);
+      assertUnit(tree.root->numKeys == 3);
+      assertUnit(tree.root->keys()[0] == 30);
+      assertUnit(tree.root->keys()[1] == 50);
+      assertUnit(tree.root->keys()[2] == 70);
+      assertUnit(isBTree(tree));
+   }  // teardown
+
+   // a full leaf splits, its middle element going up
+   void test_insert_splitLeaf()
+   {  // setup
+      //   [30 50 70]
+      Tree3 tree;
+      tree.insert(50);
+      tree.insert(30);
+      tree.insert(70);
+      // exercise
+      auto result = tree.insert(20);
+      // verify
+      //        [50]
+      //    +----+----+
+      //  [20 30]    [70]
+      assertUnit(result.second);
+      assertUnit(*result.first == 20);
+      assertUnit(!tree.root->isLeaf);
+      assertUnit(tree.root->numKeys == 1);
+      assertUnit(tree.root->keys()[0] == 50);
+      assertUnit(tree.root->children()[0]->numKeys == 2);
+      assertUnit(tree.root->children()[1]->keys()[0] == 70);
+      assertUnit(tree.leftmost == tree.root->children()[0]);
+      assertUnit(tree.rightmost == tree.root->children()[1]);
+      assertUnit(isBTree(tree));
+   }  // teardown
+
+   // a split that fills the root splits the root too
+   void test_insert_splitRoot()
+   {  // setup
+      Tree3 tree;
+      // exercise
+      for (int i = 1; i <= 10; i++)
+         tree.insert(i * 10);
+      // verify
+      assertUnit(height(tree.root) == 3);
+      assertUnit(tree.numElements == 10);
+      assertUnit(*tree.begin() == 10);
+      assertUnit(*tree.rbegin() == 100);
+      assertUnit(isBTree(tree));
+   }  // teardown
+
+   // a duplicate is turned away when asked
+   void test_insert_duplicate()
+   {  // setup
+      Tree3 tree;
+      setupStandardFixture(tree);
+      // exercise
+      auto result = tree.insert(40, true);
+      // verify
+      assertUnit(!result.second);
+      assertUnit(*result.first == 40);
+      assertUnit(tree.numElements == 7);
+      assertUnit(isBTree(tree));
+   }  // teardown
+
+   // and kept, after the others, when not
+   void test_insert_multi()
+   {  // setup
+      Tree3 tree;
+      setupStandardFixture(tree);
+      // exercise
+      for (int i = 0; i < 5; i++)
+         tree.insert(40);
+      // verify
+      assertUnit(tree.numElements == 12);
+      assertUnit(toVector(tree) == std::vector<int>({ 20, 30, 40, 40, 40, 40, 40, 40, 50, 60, 70, 80 }));
+      assertUnit(isBTree(tree));
+   }  // teardown
+
+   /***************************************
+    * FIND
+    ***************************************/
+
+   // find what is there, at any level, and not what is not
+   void test_find_standard()
+   {  // setup
+      Tree3 tree;
+      setupStandardFixture(tree);
+      bool found = true;
+      // exercise
+      for (int i = 20; i <= 80; i += 10)
+      {
+         auto it = tree.find(i);
+         found = found && it != tree.end() && *it == i;
+      }
+      // verify
+      assertUnit(found);
+      assertUnit(tree.find(45) == tree.end());
+      assertUnit(tree.find(10) == tree.end());
+      assertUnit(tree.find(90) == tree.end());
+   }  // teardown
+
+   // bounds that run across node boundaries
+   void test_bounds_duplicates()
+   {  // setup
+      Tree3 tree;
+      for (int i = 0; i < 20; i++)
+         for (int j = 0; j < 4; j++)
+            tree.insert(i);
+      // exercise
+      auto range = tree.equal_range(7);
+      // verify
+      int num = 0;
+      bool isEqual = true;
+      for (auto it = range.first; it != range.second; ++it, ++num)
+         isEqual = isEqual && *it == 7;
+      assertUnit(num == 4);
+      assertUnit(isEqual);
+      assertUnit(*range.second == 8);
+      assertUnit(*tree.lower_bound(-5) == 0);
+      assertUnit(tree.lower_bound(20) == tree.end());
+      assertUnit(tree.upper_bound(19) == tree.end());
+      assertUnit(tree.equal_range(50).first == tree.end());
+   }  // teardown
+
+   /***************************************
+    * ITERATOR
+    ***************************************/
+
+   // walk forward through leaves and up through inner nodes
+   void test_iterator_forward()
+   {  // setup
+      Tree3 tree;
+      for (int i = 100; i > 0; i--)
+         tree.insert(i);
+      int expect = 1;
+      bool inOrder = true;
+      // exercise
+      for (auto it = tree.begin(); it != tree.end(); ++it)
+         inOrder = inOrder && *it == expect++;
+      // verify
+      assertUnit(inOrder);
+      assertUnit(expect == 101);
+   }  // teardown
+
+   // and backward, past the first to rend()
+   void test_iterator_backward()
+   {  // setup
+      Tree3 tree;
+      for (int i = 1; i <= 100; i++)
+         tree.insert(i);
+      int expect = 100;
+      bool inOrder = true;
+      // exercise
+      for (auto it = tree.rbegin(); it != tree.rend(); --it)
+         inOrder = inOrder && *it == expect--;
+      // verify
+      assertUnit(inOrder);
+      assertUnit(expect == 0);
+   }  // teardown
+
+   /***************************************
+    * ERASE
+    ***************************************/
+
+   // erase from a leaf with elements to spare
+   void test_erase_leaf()
+   {  // setup
+      //        [50]
+      //    +----+----+
+      //  [20 30]    [70]
+      Tree3 tree;
+      for (int value : { 50, 30, 70, 20 })
+         tree.insert(value);
+      auto it = tree.find(20);
+      // exercise
+      auto itNext = tree.erase(it);
+      // verify
+      //        [50]
+      //    +----+----+
+      //    [30]     [70]
+      assertUnit(*itNext == 30);
+      assertUnit(tree.numElements == 3);
+      assertUnit(toVector(tree) == std::vector<int>({ 30, 50, 70 }));
+      assertUnit(isBTree(tree));
+   }  // teardown
+
+   // erase from an inner node, the successor taking its place
+   void test_erase_inner()
+   {  // setup
+      Tree3 tree;
+      setupStandardFixture(tree);
+      auto it = tree.find(tree.root->keys()[0]);
+      int erased = *it;
+      // exercise
+      auto itNext = tree.erase(it);
+      // verify
+      assertUnit(itNext != tree.end());
+      assertUnit(*itNext == erased + 10);
+      assertUnit(tree.numElements == 6);
+      assertUnit(tree.find(erased) == tree.end());
+      assertUnit(isBTree(tree));
+   }  // teardown
+
+   // a thin leaf borrows from its sibling through the parent
+   void test_erase_borrow()
+   {  // setup
+      //        [50]
+      //    +----+----+
+      //  [20 30]    [70]
+      Tree3 tree;
+      for (int value : { 50, 30, 70, 20 })
+         tree.insert(value);
+      auto it = tree.find(70);
+      // exercise
+      auto itNext = tree.erase(it);
+      // verify
+      //        [30]
+      //    +----+----+
+      //    [20]     [50]
+      assertUnit(itNext == tree.end());
+      assertUnit(tree.root->keys()[0] == 30);
+      assertUnit(tree.root->children()[1]->keys()[0] == 50);
+      assertUnit(isBTree(tree));
+   }  // teardown
+
+   // a thin leaf with thin siblings merges, and the tree shrinks
+   void test_erase_merge()
+   {  // setup
+      //        [50]
+      //    +----+----+
+      //    [30]     [70]
+      Tree3 tree;
+      for (int value : { 50, 30, 70, 20 })
+         tree.insert(value);
+      auto it = tree.find(20);
+      tree.erase(it);
+      it = tree.find(30);
+      // exercise
+      auto itNext = tree.erase(it);
+      // verify
+      //   [50 70]
+      assertUnit(*itNext == 50);
+      assertUnit(tree.root->isLeaf);
+      assertUnit(tree.root->numKeys == 2);
+      assertUnit(tree.leftmost == tree.root);
+      assertUnit(tree.rightmost == tree.root);
+      assertUnit(isBTree(tree));
+   }  // teardown
+
+   // erasing everything from the front leaves no nodes behind
+   void test_erase_all()
+   {  // setup
+      Tree3 tree;
+      for (int i = 0; i < 200; i++)
+         tree.insert(i * 7 % 200);
+      bool inOrder = true;
+      int expect = 0;
+      // exercise
+      for (auto it = tree.begin(); it != tree.end(); )
+      {
+         inOrder = inOrder && *it == expect++;
+         it = tree.erase(it);
+      }
+      // verify
+      assertUnit(inOrder);
+      assertUnit(expect == 200);
+      assertUnit(tree.root == nullptr);
+      assertUnit(tree.leftmost == nullptr);
+      assertUnit(tree.numElements == 0);
+   }  // teardown
+
+   // random inserts and erases, checked against std::set
+   void test_erase_randomStress()
+   {  // setup
+      custom::BTree<int, std::allocator<int>, 72> tree;   // four a node
+      std::set<int> expect;
+      std::srand(45);
+      bool same = true;
+      bool valid = true;
+      // exercise
+      for (int i = 0; i < 20000; i++)
+      {
+         int value = std::rand() % 2000;
+         if (std::rand() % 2)
+         {
+            bool inserted = tree.insert(value, true).second;
+            same = same && inserted == expect.insert(value).second;
+         }
+         else
+         {
+            auto it = tree.find(value);
+            same = same && (it != tree.end()) == (expect.count(value) == 1);
+            if (it != tree.end())
+            {
+               auto itNext = tree.erase(it);
+               auto itExpect = expect.upper_bound(value);
+               expect.erase(value);
+               same = same && (itNext == tree.end() ? itExpect == expect.end()
+                                                    : itExpect != expect.end() && *itNext == *itExpect);
+            }
+         }
+         if (i % 500 == 0)
+            valid = valid && isBTree(tree);
+      }
+      // verify
+      assertUnit(same);
+      assertUnit(valid);
+      assertUnit(isBTree(tree));
+      assertUnit(tree.numElements == expect.size());
+      assertUnit(toVector(tree) == std::vector<int>(expect.begin(), expect.end()));
+   }  // teardown
+
+   // elements that are not plain bytes move one at a time
+   void test_erase_strings()
+   {  // setup
+      custom::BTree<std::string, std::allocator<std::string>, 128> tree;
+      std::set<std::string> expect;
+      for (int i = 0; i < 500; i++)
+      {
+         std::string s = "key " + std::to_string(i * 37 % 500);
+         tree.insert(s, true);
+         expect.insert(s);
+      }
+      // exercise
+      for (int i = 0; i < 500; i += 2)
+      {
+         std::string s = "key " + std::to_string(i);
+         auto it = tree.find(s);
+         tree.erase(it);
+         expect.erase(s);
+      }
+      // verify
+      assertUnit(tree.numElements == 250);
+      bool same = true;
+      auto itExpect = expect.begin();
+      for (auto it = tree.begin(); it != tree.end(); ++it, ++itExpect)
+         same = same && *it == *itExpect;
+      assertUnit(same);
+      assertUnit(itExpect == expect.end());
+   }  // teardown
+
+   // clear destroys every element
+   void test_clear_spy()
+   {  // setup
+      custom::BTree<Spy, std::allocator<Spy>, 64> tree;
+      for (int i = 0; i < 100; i++)
+         tree.insert(Spy(i));
+      Spy::reset();
+      // exercise
+      tree.clear();
+      // verify
+      assertUnit(Spy::numDestructor() == 100);
+      assertUnit(tree.root == nullptr);
+      assertUnit(tree.numElements == 0);
+      assertUnit(tree.leaves.slabs() == 0);
+      assertUnit(tree.inners.slabs() == 0);
+   }  // teardown
+
+   /**************************************************************
+    * SETUP STANDARD FIXTURE
+    *            [40 60]
+    *      +--------+--------+
+    *   [20 30]    [50]    [70 80]
+    * or however the inserts leave it: the shape is checked
+    * by isBTree, not here
+    *************************************************************/
+   template <class Tree>
+   void setupStandardFixture(Tree& tree)
+   {
+      for (int value : { 50, 30, 70, 20, 40, 60, 80 })
+         tree.insert(value);
+   }
+
+   // the elements, in order
+   template <class Tree>
+   std::vector<int> toVector(const Tree& tree)
+   {
+      std::vector<int> v;
+      for (auto it = tree.begin(); it != tree.end(); ++it)
+         v.push_back(*it);
+      return v;
+   }
+
+   // levels from pNode down to a leaf, counting both
+   template <class Node>
+   int height(const Node* pNode)
+   {
+      int num = 0;
+      for (; pNode; pNode = pNode->isLeaf ? nullptr : pNode->children()[0])
+         num++;
+      return num;
+   }
+
+   /**************************************************************
+    * IS BTREE
+    * Every node but the root holds MIN_KEYS to MAX_KEYS elements,
+    * in order and between those of its parent, every leaf is the
+    * same depth, and the parent links, count and ends are right
+    *************************************************************/
+   template <class Tree>
+   bool isBTree(const Tree& tree)
+   {
+      if (!tree.root)
+         return tree.numElements == 0 && !tree.leftmost && !tree.rightmost;
+      if (tree.root->pParent || tree.root->numKeys == 0)
+         return false;
+
+      size_t num = 0;
+      int depth = height(tree.root);
+      if (!isBNode(tree, tree.root, nullptr, nullptr, 1, depth, num))
+         return false;
+
+      auto pLeft = tree.root;
+      auto pRight = tree.root;
+      while (!pLeft->isLeaf)
+         pLeft = pLeft->children()[0];
+      while (!pRight->isLeaf)
+         pRight = pRight->children()[pRight->numKeys];
+      return num == tree.numElements && pLeft == tree.leftmost && pRight == tree.rightmost;
+   }
+
+   template <class Tree, class Node>
+   bool isBNode(const Tree& tree, const Node* pNode, const int* pLow, const int* pHigh,
+                int level, int depth, size_t& num)
+   {
+      if (pNode != tree.root && (pNode->numKeys < Tree::MIN_KEYS || pNode->numKeys > Tree::MAX_KEYS))
+         return false;
+      for (size_t i = 0; i < pNode->numKeys; i++)
+      {
+         const int& key = pNode->keys()[i];
+         if ((pLow && key < *pLow) || (pHigh && *pHigh < key))
+            return false;
+         if (i > 0 && key < pNode->keys()[i - 1])
+            return false;
+      }
+      num += pNode->numKeys;
+
+      if (pNode->isLeaf)
+         return level == depth;
+      for (size_t i = 0; i <= pNode->numKeys; i++)
+      {
+         const Node* pChild = pNode->children()[i];
+         if (pChild->pParent != pNode || pChild->iParent != i)
+            return false;
+         const int* pLowChild = i == 0 ? pLow : &pNode->keys()[i - 1];
+         const int* pHighChild = i == pNode->numKeys ? pHigh : &pNode->keys()[i];
+         if (!isBNode(tree, pChild, pLowChild, pHighChild, level + 1, depth, num))
+            return false;
+      }
+      return true;
+   }
+};
+
+#endif // DEBUG
@@ -14,7 +14,9 @@
 
 #include "testSpy.h"       // for the spy unit tests
 #include "testPair.h"      // for the pair unit tests
+#include "testArena.h"     // for the arena unit tests
 #include "testBST.h"       // for the BST unit tests
+#include "testBTree.h"     // for the B-tree unit tests
 #include "testMap.h"       // for the map unit tests
 int Spy::counters[] = {};
 
@@ -28,7 +30,9 @@ int main()
    // unit tests
    TestSpy().run();
    TestPair().run();
+   TestArena().run();
    TestBST().run();
+   TestBTree().run();
    TestMap().run();
 #endif // DEBUG
    
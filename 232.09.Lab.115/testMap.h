@@ -42,6 +42,7 @@ public:
       test_constructRange_empty();
       test_constructRange_one();
       test_constructRange_standard();
+      test_constructRange_sorted();
       test_destructor_empty();
       test_destructor_standard();
 
@@ -67,6 +68,7 @@ public:
       test_begin_empty();
       test_begin_standard();
       test_end_standard();
+      test_rbegin_standard();
       test_iterator_increment_standardToChild();
       test_iterator_increment_standardToParent();
       test_iterator_dereference_standardRead();
@@ -95,12 +97,22 @@ public:
       test_find_standardRight();
       test_find_standardMissing();
 
+      // Bounds
+      test_lowerBound_standard();
+      test_equalRange_standardMissing();
+      test_bounds_rangeScan();
+
+      // Order statistics
+      test_select_standard();
+      test_rank_standard();
+
       // Insert
       test_insertCopy_empty();
       test_insertCopy_standardFront();
       test_insertCopy_standardMiddle();
       test_insertMove_empty();
       test_insertMove_standard();
+      test_insertHint_sorted();
 
       // Remove
       test_erase_emptyKey();
@@ -114,12 +126,20 @@ public:
       test_clear_empty();
       test_clear_standard();
 
+      // Set algebra
+      test_unite_keepsValue();
+      test_intersect_byKey();
+
       // Status
       test_empty_empty();
       test_empty_standard();
       test_size_empty();
       test_size_standard();
 
+      // B-tree backend
+      test_btree_subscript();
+      test_btree_eraseRange();
+
       report("Map");
    }
 
@@ -186,7 +206,7 @@ public:
       custom::map<std::string, Spy> mSrc;
       custom::pair<std::string, Spy> p50(std::string("50"), Spy(50));
       custom::BST < custom::pair<std::string, Spy> > ::BNode* bnode50;
-      bnode50 = new custom::BST < custom::pair<std::string, Spy> > ::BNode(p50);
+      bnode50 = mSrc.bst.newNode(p50);
       mSrc.bst.root = bnode50;
       mSrc.bst.numElements = 1;
       Spy::reset();
@@ -309,7 +329,7 @@ public:
       custom::map<std::string, Spy> mSrc;
       custom::pair<std::string, Spy> p50(std::string("50"), Spy(50));
       custom::BST < custom::pair<std::string, Spy> > ::BNode* bnode50;
-      bnode50 = new custom::BST < custom::pair<std::string, Spy> > ::BNode(p50);
+      bnode50 = mSrc.bst.newNode(p50);
       mSrc.bst.root = bnode50;
       mSrc.bst.numElements = 1;
       Spy::reset();
@@ -578,6 +598,47 @@ public:
       teardownStandardFixture(m);
    }
 
+   // keys already in order are laid out without inserting
+   void test_constructRange_sorted()
+   {  // setup
+      //      { ("30",30)  ("50",50)  ("70",70) }
+      custom::pair<std::string, Spy> p30(std::string("30"), Spy(30));
+      custom::pair<std::string, Spy> p50(std::string("50"), Spy(50));
+      custom::pair<std::string, Spy> p70(std::string("70"), Spy(70));
+      std::initializer_list<custom::pair<std::string, Spy>> il{ p30, p50, p70 };
+      auto itBegin = il.begin();
+      auto itEnd = il.end();
+      Spy::reset();
+      // exercise
+      custom::map<std::string, Spy> m(itBegin, itEnd);
+      // verify
+      assertUnit(Spy::numCopy() == 3);     // copy-create [30][50][70]
+      assertUnit(Spy::numAlloc() == 3);    // allocate    [30][50][70]
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(Spy::numLessthan() == 0);
+      //    "30"     "50"     "70" 
+      //   +----+   +----+   +----+
+      //   | 30 | - | 50 | - | 70 |
+      //   +----+   +----+   +----+
+      assertUnit(m.bst.numElements == 3);
+      assertUnit(m.bst.root != nullptr);
+      if (m.bst.root && m.bst.root->pLeft && m.bst.root->pRight)
+      {
+         assertUnit(m.bst.root->data.first == std::string("50"));
+         assertUnit(m.bst.root->pLeft->data.first == std::string("30"));
+         assertUnit(m.bst.root->pRight->data.first == std::string("70"));
+         assertUnit(m.bst.root->isRed == false);
+         assertUnit(m.bst.root->pLeft->isRed == true);
+         assertUnit(m.bst.root->pRight->isRed == true);
+         assertUnit(m.bst.leftmost == m.bst.root->pLeft);
+         assertUnit(m.bst.rightmost == m.bst.root->pRight);
+      }
+      // teardown
+      teardownStandardFixture(m);
+   }
+
    /***************************************
     * DESTRUCTOR
     ***************************************/
@@ -860,8 +921,8 @@ public:
       custom::pair<std::string, Spy> pair60(std::string("60"), Spy(60));
       custom::BST < custom::pair<std::string, Spy> > ::BNode* bnode40;
       custom::BST < custom::pair<std::string, Spy> > ::BNode* bnode60;
-      bnode40 = new custom::BST < custom::pair<std::string, Spy> > ::BNode(pair40);
-      bnode60 = new custom::BST < custom::pair<std::string, Spy> > ::BNode(pair60);
+      bnode40 = mDes.bst.newNode(pair40);
+      bnode60 = mDes.bst.newNode(pair60);
       bnode40->pRight = bnode60;
       bnode60->pParent = bnode40;
       bnode40->isRed = false;
@@ -1008,8 +1069,8 @@ public:
       custom::pair<std::string, Spy> pair60(std::string("60"), Spy(60));
       custom::BST < custom::pair<std::string, Spy> > ::BNode* bnode40;
       custom::BST < custom::pair<std::string, Spy> > ::BNode* bnode60;
-      bnode40 = new custom::BST < custom::pair<std::string, Spy> > ::BNode(pair40);
-      bnode60 = new custom::BST < custom::pair<std::string, Spy> > ::BNode(pair60);
+      bnode40 = mDes.bst.newNode(pair40);
+      bnode60 = mDes.bst.newNode(pair60);
       bnode40->pRight = bnode60;
       bnode60->pParent = bnode40;
       bnode40->isRed = false;
@@ -1151,8 +1212,8 @@ public:
       custom::pair<std::string, Spy> pair60(std::string("60"), Spy(60));
       custom::BST < custom::pair<std::string, Spy> > ::BNode* bnode40;
       custom::BST < custom::pair<std::string, Spy> > ::BNode* bnode60;
-      bnode40 = new custom::BST < custom::pair<std::string, Spy> > ::BNode(pair40);
-      bnode60 = new custom::BST < custom::pair<std::string, Spy> > ::BNode(pair60);
+      bnode40 = m.bst.newNode(pair40);
+      bnode60 = m.bst.newNode(pair60);
       bnode40->pRight = bnode60;
       bnode60->pParent = bnode40;
       bnode40->isRed = false;
@@ -1298,8 +1359,8 @@ public:
       custom::pair<std::string, Spy> pair60(std::string("60"), Spy(60));
       custom::BST < custom::pair<std::string, Spy> > ::BNode* bnode40;
       custom::BST < custom::pair<std::string, Spy> > ::BNode* bnode60;
-      bnode40 = new custom::BST < custom::pair<std::string, Spy> > ::BNode(pair40);
-      bnode60 = new custom::BST < custom::pair<std::string, Spy> > ::BNode(pair60);
+      bnode40 = mRHS.bst.newNode(pair40);
+      bnode60 = mRHS.bst.newNode(pair60);
       bnode40->pRight = bnode60;
       bnode60->pParent = bnode40;
       bnode40->isRed = false;
@@ -1494,6 +1555,39 @@ public:
       teardownStandardFixture(m);
    }
 
+   // rbegin() from the standard fixture, walking backwards
+   void test_rbegin_standard()
+   {  // setup
+      custom::map<std::string, Spy>::iterator it;
+      //    "30"     "50"     "70"   = m
+      //   +----+   +----+   +----+
+      //   | 30 | - | 50 | - | 70 |
+      //   +----+   +----+   +----+
+      custom::map<std::string, Spy> m;
+      setupStandardFixture(m);
+      Spy::reset();
+      // exercise
+      it = m.rbegin();
+      // verify
+      //    "30"     "50"     "70"   = m
+      //   +----+   +----+   +----+
+      //   | 30 | - | 50 | - | 70 |
+      //   +----+   +----+   +----+
+      //                       it
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(it.it.pNode == m.bst.root->pRight);
+      assertUnit((*it).first == std::string("70"));
+      --it;
+      assertUnit((*it).first == std::string("50"));
+      --it;
+      assertUnit((*it).first == std::string("30"));
+      --it;
+      assertUnit(it == m.rend());
+      assertStandardFixture(m);
+      // teardown
+      teardownStandardFixture(m);
+   }
+
    // iterator increment to the parent from the standard fixture
    void test_iterator_increment_standardToParent()
    {  // setup
@@ -1776,6 +1870,144 @@ public:
       teardownStandardFixture(m);
    }
 
+   /***************************************
+    * BOUNDS
+    *    map::lower_bound(const K &)
+    *    map::upper_bound(const K &)
+    *    map::equal_range(const K &)
+    ***************************************/
+
+   // "40" is not there, so the bound is the next key up
+   void test_lowerBound_standard()
+   {  // setup
+      custom::map<std::string, Spy>::iterator it;
+      //    "30"     "50"     "70"   = m
+      //   +----+   +----+   +----+
+      //   | 30 | - | 50 | - | 70 |
+      //   +----+   +----+   +----+
+      custom::map<std::string, Spy> m;
+      setupStandardFixture(m);
+      std::string s40("40");
+      Spy::reset();
+      // exercise
+      it = m.lower_bound(s40);
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(Spy::numLessthan() == 0);
+      //    "30"     "50"     "70"   = m
+      //   +----+   +----+   +----+
+      //   | 30 | - | 50 | - | 70 |
+      //   +----+   +----+   +----+
+      //              it
+      assertUnit(it.it.pNode == m.bst.root);
+      assertUnit(m.upper_bound(std::string("50")).it.pNode == m.bst.root->pRight);
+      assertUnit(m.upper_bound(std::string("70")).it.pNode == nullptr);
+      assertStandardFixture(m);
+      // teardown
+      teardownStandardFixture(m);
+   }
+
+   // an empty range for a key that is not there
+   void test_equalRange_standardMissing()
+   {  // setup
+      //    "30"     "50"     "70"   = m
+      //   +----+   +----+   +----+
+      //   | 30 | - | 50 | - | 70 |
+      //   +----+   +----+   +----+
+      custom::map<std::string, Spy> m;
+      setupStandardFixture(m);
+      std::string s60("60");
+      // exercise
+      auto range = m.equal_range(s60);
+      // verify
+      assertUnit(range.first == range.second);
+      assertUnit(range.first.it.pNode == m.bst.root->pRight);
+      assertStandardFixture(m);
+      // teardown
+      teardownStandardFixture(m);
+   }
+
+   // visit and then erase the keys in [100, 200)
+   void test_bounds_rangeScan()
+   {  // setup
+      custom::map<int, int> m;
+      for (int i = 0; i < 50; i++)
+         m[i * 10] = i;
+      // exercise
+      int sum = 0;
+      auto itEnd = m.lower_bound(200);
+      for (auto it = m.lower_bound(100); it != itEnd; ++it)
+         sum += (*it).second;
+      m.erase(m.lower_bound(100), itEnd);
+      // verify
+      assertUnit(sum == 145);                 // 10 + 11 + ... + 19
+      assertUnit(m.size() == 40);
+      assertUnit((*m.upper_bound(90)).first == 200);
+      assertUnit(m.erase(200) == 1);
+      assertUnit(m.erase(200) == 0);
+   }  // teardown
+
+   /***************************************
+    * ORDER STATISTICS
+    *    map::select(size_t)
+    *    map::rank(const K &)
+    ***************************************/
+
+   // the last pair is the third smallest key
+   void test_select_standard()
+   {  // setup
+      custom::ranked_map<std::string, Spy>::iterator it;
+      //    "30"     "50"     "70"   = m
+      //   +----+   +----+   +----+
+      //   | 30 | - | 50 | - | 70 |
+      //   +----+   +----+   +----+
+      custom::ranked_map<std::string, Spy> m;
+      m.insert(custom::make_pair(std::string("50"), Spy(50)));
+      m.insert(custom::make_pair(std::string("30"), Spy(30)));
+      m.insert(custom::make_pair(std::string("70"), Spy(70)));
+      Spy::reset();
+      // exercise
+      it = m.select(2);
+      // verify
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(Spy::numLessthan() == 0);
+      //    "30"     "50"     "70"   = m
+      //   +----+   +----+   +----+
+      //   | 30 | - | 50 | - | 70 |
+      //   +----+   +----+   +----+
+      //                       it
+      assertUnit(it.it.pNode == m.bst.root->pRight);
+      assertUnit(m.select(0).it.pNode == m.bst.root->pLeft);
+      assertUnit(m.select(3).it.pNode == nullptr);
+      assertUnit(m.size() == 3);
+   }  // teardown
+
+   // a missing key still has a rank
+   void test_rank_standard()
+   {  // setup
+      //    "30"     "50"     "70"   = m
+      //   +----+   +----+   +----+
+      //   | 30 | - | 50 | - | 70 |
+      //   +----+   +----+   +----+
+      custom::ranked_map<std::string, Spy> m;
+      m.insert(custom::make_pair(std::string("50"), Spy(50)));
+      m.insert(custom::make_pair(std::string("30"), Spy(30)));
+      m.insert(custom::make_pair(std::string("70"), Spy(70)));
+      std::string s60("60");
+      // exercise
+      size_t numSmaller = m.rank(s60);
+      // verify
+      assertUnit(numSmaller == 2);
+      assertUnit(m.rank(std::string("30")) == 0);
+      assertUnit(m.rank(std::string("99")) == 3);
+      assertUnit(m.size() == 3);
+   }  // teardown
+
    /***************************************
     * INSERT
     *    map::insert(const T &)
@@ -2096,6 +2328,24 @@ public:
    }
 
 
+   // insert sorted keys, each one hinted at the end
+   void test_insertHint_sorted()
+   {  // setup
+      custom::map<int, int> m;
+      // exercise
+      for (int i = 0; i < 1000; i++)
+         m.insert(m.end(), custom::pair<int, int>(i, i * i));
+      // verify
+      assertUnit(m.size() == 1000);
+      assertUnit(m.bst.root != nullptr);
+      assertUnit((*m.begin()).first == 0);
+      assertUnit(m[999] == 998001);
+      assertUnit(m.bst.rightmost != nullptr);
+      if (m.bst.rightmost)
+         assertUnit(m.bst.rightmost->data.first == 999);
+      // teardown
+   }
+
    /***************************************
     * SQUARE BRACKET
     *     map::operator[](const T &)
@@ -3137,6 +3387,83 @@ public:
       // teardown
       teardownStandardFixture(m);
    }
+   /***************************************
+    * SET ALGEBRA
+    *    map::unite(const map &)
+    *    map::intersect(const map &)
+    *    map::subtract(const map &)
+    ***************************************/
+
+   // a key in both maps keeps the value it had here
+   void test_unite_keepsValue()
+   {  // setup
+      custom::map<int, std::string> m{ {1, "one"}, {2, "two"}, {3, "three"} };
+      custom::map<int, std::string> mOther{ {3, "drei"}, {4, "vier"} };
+      // exercise
+      m.unite(mOther);
+      // verify
+      assertUnit(m.size() == 4);
+      assertUnit(m[3] == std::string("three"));
+      assertUnit(m[4] == std::string("vier"));
+   }  // teardown
+
+   // only the keys are compared, not the values
+   void test_intersect_byKey()
+   {  // setup
+      custom::map<int, std::string> m{ {1, "one"}, {2, "two"}, {3, "three"} };
+      custom::map<int, std::string> mOther{ {3, "drei"}, {4, "vier"} };
+      custom::map<int, std::string> mSubtract(m);
+      // exercise
+      m.intersect(mOther);
+      mSubtract.subtract(mOther);
+      // verify
+      assertUnit(m.size() == 1);
+      assertUnit((*m.begin()).second == std::string("three"));
+      assertUnit(mSubtract.size() == 2);
+      assertUnit(mSubtract.find(3) == mSubtract.end());
+   }  // teardown
+
+   /***************************************
+    * B-TREE BACKEND
+    *    btree_map
+    ***************************************/
+
+   // the same map, kept in a B-tree
+   void test_btree_subscript()
+   {  // setup
+      custom::btree_map<int, std::string> m;
+      // exercise
+      for (int i = 0; i < 500; i++)
+         m[i * 3 % 500] = std::to_string(i * 3 % 500);
+      m[7] += "!";
+      // verify
+      assertUnit(m.size() == 500);
+      assertUnit(m[7] == std::string("7!"));
+      assertUnit(m.at(499) == std::string("499"));
+      assertUnit((*m.begin()).first == 0);
+      assertUnit((*m.rbegin()).first == 499);
+      assertUnit(m.find(500) == m.end());
+   }  // teardown
+
+   // erasing a range while the B-tree moves elements between nodes
+   void test_btree_eraseRange()
+   {  // setup
+      custom::btree_map<int, int> m;
+      for (int i = 0; i < 1000; i++)
+         m[i] = -i;
+      // exercise
+      auto itReturn = m.erase(m.find(10), m.find(990));
+      // verify
+      assertUnit(m.size() == 20);
+      assertUnit((*itReturn).first == 990);
+      assertUnit(m.erase(5) == 1);
+      assertUnit(m.erase(500) == 0);
+      int num = 0;
+      for (auto it = m.begin(); it != m.end(); ++it)
+         num++;
+      assertUnit(num == 19);
+   }  // teardown
+
    /****************************************************************
     * Setup Standard Fixture
     *    "30"     "50"     "70"
@@ -3162,9 +3489,9 @@ public:
       custom::BST < custom::pair<std::string, Spy> > ::BNode* bnode30;
       custom::BST < custom::pair<std::string, Spy> > ::BNode* bnode50;
       custom::BST < custom::pair<std::string, Spy> > ::BNode* bnode70;
-      bnode30 = new custom::BST < custom::pair<std::string, Spy> > ::BNode(pair30);
-      bnode50 = new custom::BST < custom::pair<std::string, Spy> > ::BNode(pair50);
-      bnode70 = new custom::BST < custom::pair<std::string, Spy> > ::BNode(pair70);
+      bnode30 = m.bst.newNode(pair30);
+      bnode50 = m.bst.newNode(pair50);
+      bnode70 = m.bst.newNode(pair70);
 
       // hook up the links and stuff
       bnode50->pLeft  = bnode30;
@@ -3175,6 +3502,8 @@ public:
 
       // place the nodes in the bst
       m.bst.root = bnode50;
+      m.bst.leftmost = bnode30;
+      m.bst.rightmost = bnode70;
       m.bst.numElements = 3;
    }
 
@@ -3257,23 +3586,23 @@ public:
          if (m.bst.root->pLeft)
          {
             if (m.bst.root->pLeft->pLeft)
-               delete m.bst.root->pLeft->pLeft;
+               m.bst.deleteNode(m.bst.root->pLeft->pLeft);
             if (m.bst.root->pLeft->pRight)
-               delete m.bst.root->pLeft->pRight;
+               m.bst.deleteNode(m.bst.root->pLeft->pRight);
 
-            delete m.bst.root->pLeft;
+            m.bst.deleteNode(m.bst.root->pLeft);
          }
 
          if (m.bst.root->pRight)
          {
             if (m.bst.root->pRight->pLeft)
-               delete m.bst.root->pRight->pLeft;
+               m.bst.deleteNode(m.bst.root->pRight->pLeft);
             if (m.bst.root->pRight->pRight)
-               delete m.bst.root->pRight->pRight;
+               m.bst.deleteNode(m.bst.root->pRight->pRight);
 
-            delete m.bst.root->pRight;
+            m.bst.deleteNode(m.bst.root->pRight);
          }
-         delete m.bst.root;
+         m.bst.deleteNode(m.bst.root);
       }
       m.bst.root = nullptr;
       m.bst.numElements = 0;
@@ -3287,23 +3616,23 @@ public:
          if (m.bst.root->pLeft && m.bst.root->pLeft != m.bst.root)
          {
             if (m.bst.root->pLeft->pLeft && m.bst.root->pLeft->pLeft != m.bst.root->pLeft)
-               delete m.bst.root->pLeft->pLeft;
+               m.bst.deleteNode(m.bst.root->pLeft->pLeft);
             if (m.bst.root->pLeft->pRight && m.bst.root->pLeft->pRight != m.bst.root->pLeft)
-               delete m.bst.root->pLeft->pRight;
+               m.bst.deleteNode(m.bst.root->pLeft->pRight);
 
-            delete m.bst.root->pLeft;
+            m.bst.deleteNode(m.bst.root->pLeft);
          }
 
          if (m.bst.root->pRight && m.bst.root->pRight != m.bst.root)
          {
             if (m.bst.root->pRight->pLeft && m.bst.root->pRight->pLeft != m.bst.root->pRight)
-               delete m.bst.root->pRight->pLeft;
+               m.bst.deleteNode(m.bst.root->pRight->pLeft);
             if (m.bst.root->pRight->pRight && m.bst.root->pRight->pRight != m.bst.root->pRight)
-               delete m.bst.root->pRight->pRight;
+               m.bst.deleteNode(m.bst.root->pRight->pRight);
 
-            delete m.bst.root->pRight;
+            m.bst.deleteNode(m.bst.root->pRight);
          }
-         delete m.bst.root;
+         m.bst.deleteNode(m.bst.root);
       }
       m.bst.root = nullptr;
       m.bst.numElements = 0;
@@ -13,6 +13,11 @@
  *    This will contain the class definition of:
  *        deque                 : A class that represents a deque
  *        deque::iterator       : An iterator through a deque
+ *
+ *    The elements live in blocks of cells, and a map holds a pointer
+ *    to each block. A block holds about BlockBytes worth of elements,
+ *    rounded down to a power of two and never fewer than 16, so small
+ *    elements get long blocks and even large ones get 16 to a block
  * Author
  *    David Schaad, Tori Tremelling
  ************************************************************************/
@@ -21,6 +26,7 @@
 
  // Debug stuff
 #include <cassert>
+#include <cstddef>  // for size_t and ptrdiff_t
 #include <memory>   // for std::allocator
 
 class TestDeque;    // forward declaration for TestDeque unit test class
@@ -31,7 +37,7 @@ namespace custom
    /******************************************************
     * DEQUE
     *****************************************************/
-   template <typename T, typename A = std::allocator<T>>
+   template <typename T, typename A = std::allocator<T>, size_t BlockBytes = 512>
    class deque
    {
       friend class ::TestDeque; // give unit tests access to the privates
@@ -40,12 +46,14 @@ namespace custom
       // 
       // Construct
       //
-      deque(const A& a = A()) : alloc(a), numCells(16), numBlocks(0), numElements(0), iaFront(0), data(nullptr) {} // Default cells per block is 16 
+      deque(const A& a = A()) : alloc(a), numCells(cellsPerBlock), numBlocks(0), numElements(0), iaFront(0), data(nullptr),
+                                pSpare(nullptr), numSpare(0), numSpareMax(2) {}
       deque(const deque& rhs);
       ~deque()
       {
          clear();
-         delete[] data;
+         releaseSpareBlocks();
+         deallocateMap(data, numBlocks);
       }
 
       //
@@ -89,15 +97,15 @@ namespace custom
          assert(numElements != 0);
          return data[ ibFromID(numElements - 1) ][ icFromID(numElements - 1) ];
       }
-      T& operator[](int id)
+      T& operator[](size_t id)
       {
-         assert(0 <= id && id < numElements);
+         assert(id < numElements);
          assert(data[ ibFromID(id) ] != NULL);
          return data[ ibFromID(id) ][ icFromID(id) ];
       }
-      const T& operator[](int id) const
+      const T& operator[](size_t id) const
       {
-         assert(0 <= id && id < numElements);
+         assert(id < numElements);
          assert(data[ ibFromID(id) ] != NULL);
          return data[ ibFromID(id) ][ icFromID(id) ];
       }
@@ -126,44 +134,97 @@ namespace custom
          return size() == 0;
       }
 
+      //
+      // Spare blocks: emptied blocks kept for reuse instead of
+      // going back to the allocator
+      //
+      size_t max_spare_blocks() const { return numSpareMax; }
+      void   max_spare_blocks(size_t num);
+
    private:
-      // array index from deque index
-      int iaFromID(int id) const
+      using MapAlloc = typename std::allocator_traits<A>::template rebind_alloc<T*>;
+
+      // the largest shift whose block fits in numCellsMax, but at least 16 cells
+      static constexpr size_t shiftFor(size_t numCellsMax, size_t shift = 4)
+      {
+         return (size_t(2) << shift) <= numCellsMax ? shiftFor(numCellsMax, shift + 1) : shift;
+      }
+
+      // The number of cells in the blocks we make ourselves. It is a
+      // power of two known at compile time, so finding an element in
+      // such a block is a shift and a mask rather than a division
+      static constexpr size_t cellShift = shiftFor(BlockBytes / sizeof(T));
+      static constexpr size_t cellsPerBlock = size_t(1) << cellShift;
+      static constexpr size_t cellMask = cellsPerBlock - 1;
+
+      // array index from deque index. Both id and iaFront are less than
+      // the number of cells, so wrapping is at most one subtraction
+      size_t iaFromID(size_t id) const
       {
          if (numCells == 0 || numBlocks == 0)
             return 0;
 
-         return (id + iaFront) % (numCells * numBlocks);
+         size_t ia = id + iaFront;
+         size_t numCellsTotal = numCells * numBlocks;
+         if (ia >= numCellsTotal)
+            ia -= numCellsTotal;
+         assert(ia < numCellsTotal);
+         return ia;
+      }
+
+      // block and cell index from array index
+      size_t ibFromIA(size_t ia) const
+      {
+         return numCells == cellsPerBlock ? ia >> cellShift : ia / numCells;
+      }
+      size_t icFromIA(size_t ia) const
+      {
+         return numCells == cellsPerBlock ? ia & cellMask : ia % numCells;
       }
 
       // block index from deque index
-      int ibFromID(int id) const
+      size_t ibFromID(size_t id) const
       {
-         int ib = iaFromID(id) / numCells;
+         size_t ib = ibFromIA(iaFromID(id));
          assert(ib < numBlocks);
          return ib;
       }
 
       // cell index from deque index
-      int icFromID(int id) const
+      size_t icFromID(size_t id) const
       {
-         int ic = iaFromID(id) % numCells;
+         size_t ic = icFromIA(iaFromID(id));
          assert(ic < numCells);
          return ic;
       }
 
       // reallocate
-      void reallocate(int numBlocksNew);
+      void reallocate(size_t numBlocksNew);
+
+      // get a map of num empty blocks from the allocator, and give one back
+      T** allocateMap(size_t num);
+      void deallocateMap(T** pMap, size_t num);
+
+      // copy the elements of rhs into fresh blocks
+      void copyElements(const deque& rhs);
 
       // helper function
       bool isAllBlocksFilled() const;
 
+      // get a block from the spares or the allocator, and give one back
+      T* allocateBlock();
+      void deallocateBlock(T* pBlock);
+      void releaseSpareBlocks();
+
       A    alloc;                // use alloacator for memory allocation
       size_t numCells;           // number of cells in a block
       size_t numBlocks;          // number of blocks in the data array
       size_t numElements;        // number of elements in the deque
-      int iaFront;               // array-centered index of the front of the deque
+      size_t iaFront;            // array-centered index of the front of the deque
       T** data;                  // array of arrays
+      T* pSpare;                 // first spare block, each holding a pointer to the next
+      size_t numSpare;           // number of spare blocks
+      size_t numSpareMax;        // most spare blocks we will keep
    };
 
    /**************************************************
@@ -177,8 +238,8 @@ namespace custom
     * This particular iterator is a bi-directional meaning
     * that ++ and -- both work.  Not all iterators are that way.
     *************************************************/
-   template <typename T, typename A>
-   class deque <T, A> ::iterator
+   template <typename T, typename A, size_t BlockBytes>
+   class deque <T, A, BlockBytes> ::iterator
    {
       friend class ::TestDeque; // give unit tests access to the privates
    public:
@@ -186,7 +247,7 @@ namespace custom
       // Construct
       //
       iterator() : id(0), d(nullptr) {}
-      iterator(int id, deque* d) : id(id), d(d)
+      iterator(size_t id, deque* d) : id(id), d(d)
       {
          this->id = id;
          this->d = d;
@@ -220,11 +281,11 @@ namespace custom
       // 
       // Arithmetic
       //
-      int operator - (iterator it) const
+      ptrdiff_t operator - (iterator it) const
       {
-         return id - it.id;
+         return (ptrdiff_t)(id - it.id);
       }
-      iterator& operator += (int offset)
+      iterator& operator += (ptrdiff_t offset)
       {
          id += offset;
          return *this;
@@ -253,7 +314,7 @@ namespace custom
       }
 
    private:
-      int id;
+      size_t id;
       deque* d;
    };
 
@@ -262,35 +323,23 @@ namespace custom
     * Allocate the space for the elements and
     * call the copy constructor on each element
     ****************************************/
-   template <typename T, typename A>
-   deque <T, A> ::deque(const deque& rhs)
+   template <typename T, typename A, size_t BlockBytes>
+   deque <T, A, BlockBytes> ::deque(const deque& rhs)
       : alloc(rhs.alloc),
-      numCells(16),                 // normalize to default cells-per-block expected by tests
+      numCells(cellsPerBlock),      // normalize to default cells-per-block expected by tests
       numBlocks(0),
       numElements(rhs.numElements),
       iaFront(0),
-      data(nullptr)
+      data(nullptr),
+      pSpare(nullptr),
+      numSpare(0),
+      numSpareMax(rhs.numSpareMax)
    {
       // empty source -> empty destination
       if (numElements == 0 || rhs.data == nullptr || rhs.numBlocks == 0)
          return;
 
-      // create a single block big enough to hold all elements contiguously
-      numBlocks = 1;
-      data = new T * [numBlocks];
-      for (size_t ib = 0; ib < numBlocks; ++ib)
-         data[ib] = nullptr;
-
-      data[0] = alloc.allocate(numCells);
-
-      // construct each element sequentially in the single destination block
-      for (size_t id = 0; id < numElements; ++id)
-      {
-         int srcIb = rhs.ibFromID(static_cast<int>(id));
-         int srcIc = rhs.icFromID(static_cast<int>(id));
-
-         alloc.construct(&data[0][static_cast<int>(id)], rhs.data[srcIb][srcIc]);
-      }
+      copyElements(rhs);
    }
 
    /*****************************************
@@ -298,8 +347,8 @@ namespace custom
     * Allocate the space for the elements and
     * call the copy constructor on each element
     ****************************************/
-   template <typename T, typename A>
-   deque <T, A>& deque <T, A> :: operator = (deque& rhs)
+   template <typename T, typename A, size_t BlockBytes>
+   deque <T, A, BlockBytes>& deque <T, A, BlockBytes> :: operator = (deque& rhs)
    {     
       // self-assignment
       if (this == &rhs)
@@ -320,37 +369,53 @@ namespace custom
       if (rhs.numElements == 0)
          return *this;
 
-      numCells = 16;
-      numBlocks = 1;
+      // the spares are the old block size
+      releaseSpareBlocks();
+      deallocateMap(data, numBlocks);
+
+      numCells = cellsPerBlock;
       numElements = rhs.numElements;
       iaFront = 0;
+      copyElements(rhs);
 
-      data = new T * [numBlocks];
-      data[0] = alloc.allocate(numCells);
+      return *this;
+   }
 
-      for (size_t i = 0; i < numElements; i++)
+   /*****************************************
+    * DEQUE :: COPY ELEMENTS
+    * Lay the elements of rhs out from the start of
+    * just enough new blocks. numCells and numElements
+    * are already set, and there is no map yet
+    ****************************************/
+   template <typename T, typename A, size_t BlockBytes>
+   void deque <T, A, BlockBytes> ::copyElements(const deque& rhs)
+   {
+      numBlocks = ibFromIA(numElements - 1) + 1;
+      data = allocateMap(numBlocks);
+      for (size_t ib = 0; ib < numBlocks; ib++)
+         data[ib] = allocateBlock();
+
+      for (size_t id = 0; id < numElements; id++)
       {
-         int ib = rhs.ibFromID((int)i);
-         int ic = rhs.icFromID((int)i);
+         size_t srcIb = rhs.ibFromID(id);
+         size_t srcIc = rhs.icFromID(id);
 
-         alloc.construct(&data[0][i], rhs.data[ib][ic]);
+         alloc.construct(&data[ibFromIA(id)][icFromIA(id)], rhs.data[srcIb][srcIc]);
       }
-
-      return *this;
    }
 
    /*****************************************
     * DEQUE :: PUSH_BACK
     * add an element to the back of the deque
     ****************************************/
-   template <typename T, typename A>
-   void deque <T, A> ::push_back(const T& t)
+   template <typename T, typename A, size_t BlockBytes>
+   void deque <T, A, BlockBytes> ::push_back(const T& t)
    {
       if (numBlocks == 0)
          reallocate(1);
 
       // Locate the cell index of the tail of the deque
-      int icTail;
+      size_t icTail;
       if (numElements == 0)
          icTail = numCells - 1;
       else
@@ -359,16 +424,13 @@ namespace custom
       // Allocate new blocks as needed
       if (isAllBlocksFilled() && (icTail == (numCells - 1)))
       {
-         if (numBlocks == 0)
-            reallocate(1);
-         else
-            reallocate(numBlocks * 2);
+         reallocate(numBlocks * 2);
       }
 
       // Determine the block index and allocate cells if neccessary
-      int ib = ibFromID(numElements);
+      size_t ib = ibFromID(numElements);
       if (data[ib] == nullptr)
-         data[ib] = alloc.allocate(numCells);
+         data[ib] = allocateBlock();
 
       // Assign the value 't' to the block
       alloc.construct(&data[ib][ icFromID(numElements) ], t);
@@ -379,14 +441,14 @@ namespace custom
     * DEQUE :: PUSH_BACK - move
     * add an element to the back of the deque
     ****************************************/
-   template <typename T, typename A>
-   void deque <T, A> ::push_back(T&& t)
+   template <typename T, typename A, size_t BlockBytes>
+   void deque <T, A, BlockBytes> ::push_back(T&& t)
    {
       if (numBlocks == 0)
          reallocate(1);
 
       // Locate the cell index of the tail of the deque
-      int icTail;
+      size_t icTail;
       if (numElements == 0)
          icTail = numCells - 1;
       else
@@ -395,16 +457,13 @@ namespace custom
       // Allocate new blocks as needed
       if (isAllBlocksFilled() && (icTail == (numCells - 1)))
       {
-         if (numBlocks == 0)
-            reallocate(1);
-         else
-            reallocate(numBlocks * 2);
+         reallocate(numBlocks * 2);
       }
 
       // Determine the block index and allocate cells if neccessary
-      int ib = ibFromID(numElements);
+      size_t ib = ibFromID(numElements);
       if (data[ib] == nullptr)
-         data[ib] = alloc.allocate(numCells);
+         data[ib] = allocateBlock();
 
       // Move-assign the value 't' to the block 
       alloc.construct(&data[ib][ icFromID(numElements) ], std::move(t));
@@ -415,14 +474,14 @@ namespace custom
     * DEQUE :: PUSH_FRONT
     * add an element to the front of the deque
     ****************************************/
-   template <typename T, typename A>
-   void deque <T, A> ::push_front(const T& t)
+   template <typename T, typename A, size_t BlockBytes>
+   void deque <T, A, BlockBytes> ::push_front(const T& t)
    {
       if (numBlocks == 0)
          reallocate(1);
 
       // Locate the cell index of the head of the deque
-      int icHead;
+      size_t icHead;
       if (numElements == 0)
          icHead = 0;
       else
@@ -431,10 +490,7 @@ namespace custom
       // Allocate new blocks as needed
       if (isAllBlocksFilled() && (icHead == 0))
       {
-         if (numBlocks == 0)
-            reallocate(1);
-         else
-            reallocate(numBlocks * 2);
+         reallocate(numBlocks * 2);
       }
 
       // Adjust the front array index, wrapping as needed
@@ -444,9 +500,9 @@ namespace custom
          iaFront = (numBlocks * numCells) - 1;
 
       // Determine the block index and allocate cells if neccessary
-      int ib = ibFromID(0);
+      size_t ib = ibFromID(0);
       if (data[ib] == nullptr)
-         data[ib] = alloc.allocate(numCells);
+         data[ib] = allocateBlock();
 
       // Assign the value 't' to the block
       alloc.construct(&data[ib][ icFromID(0) ], t);
@@ -457,14 +513,14 @@ namespace custom
     * DEQUE :: PUSH_FRONT - move
     * add an element to the front of the deque
     ****************************************/
-   template <typename T, typename A>
-   void deque <T, A> ::push_front(T&& t)
+   template <typename T, typename A, size_t BlockBytes>
+   void deque <T, A, BlockBytes> ::push_front(T&& t)
    {
       if (numBlocks == 0)
          reallocate(1);
 
       // Locate the cell index of the head of the deque
-      int icHead;
+      size_t icHead;
       if (numElements == 0)
          icHead = 0;
       else
@@ -473,10 +529,7 @@ namespace custom
       // Allocate new blocks as needed
       if (isAllBlocksFilled() && (icHead == 0))
       {
-         if (numBlocks == 0)
-            reallocate(1);
-         else
-            reallocate(numBlocks * 2);
+         reallocate(numBlocks * 2);
       }
 
       // Adjust the front array index, wrapping as needed
@@ -486,9 +539,9 @@ namespace custom
          iaFront = (numBlocks * numCells) - 1;
 
       // Determine the block index and allocate cells if neccessary
-      int ib = ibFromID(0);
+      size_t ib = ibFromID(0);
       if (data[ib] == nullptr)
-         data[ib] = alloc.allocate(numCells);
+         data[ib] = allocateBlock();
 
       // Move-assign the value 't' to the block
       alloc.construct(&data[ib][ icFromID(0) ], std::move(t));
@@ -499,8 +552,8 @@ namespace custom
     * DEQUE :: CLEAR
     * Remove all the elements from a deque
     ****************************************/
-   template <typename T, typename A>
-   void deque <T, A> ::clear()
+   template <typename T, typename A, size_t BlockBytes>
+   void deque <T, A, BlockBytes> ::clear()
    {
       // Can't clear an empty deque
       if (data == nullptr || numBlocks == 0)
@@ -513,8 +566,8 @@ namespace custom
       // Destroy constructed elements
       for (size_t i = 0; i < numElements; i++)
       {
-         int ib = ibFromID(i);
-         int ic = icFromID(i);
+         size_t ib = ibFromID(i);
+         size_t ic = icFromID(i);
          alloc.destroy(&data[ib][ic]);
       }
 
@@ -523,7 +576,7 @@ namespace custom
       {
          if (data[ib])
          {
-            alloc.deallocate(data[ib], numCells);
+            deallocateBlock(data[ib]);
             data[ib] = nullptr;
          }
       }
@@ -536,13 +589,13 @@ namespace custom
     * DEQUE :: POP FRONT
     * Remove the front element from a deque
     ****************************************/
-   template <typename T, typename A>
-   void deque <T, A> ::pop_front()
+   template <typename T, typename A, size_t BlockBytes>
+   void deque <T, A, BlockBytes> ::pop_front()
    {
       assert(numElements > 0);
 
-      int ib = ibFromID(0);
-      int ic = icFromID(0);
+      size_t ib = ibFromID(0);
+      size_t ic = icFromID(0);
 
       alloc.destroy(&data[ib][ic]);
 
@@ -554,30 +607,24 @@ namespace custom
          iaFront = 0;
          if (data && data[ib])
          {
-            alloc.deallocate(data[ib], numCells);
+            deallocateBlock(data[ib]);
             data[ib] = nullptr;
          }
          return;
       }
 
       // advance the front offset
-      iaFront = (iaFront + 1) % (numCells * numBlocks);
+      if (++iaFront == numCells * numBlocks)
+         iaFront = 0;
 
-      // check whether the block that lost the element now contains any remaining elements
-      bool hasAny = false;
-      for (size_t id = 0; id < numElements; ++id)
-      {
-         if (ibFromID(static_cast<int>(id)) == ib)
-         {
-            hasAny = true;
-            break;
-         }
-      }
+      // The elements are contiguous, so the block is empty only when the
+      // front just left it and the back has not wrapped around into it
+      bool isEmpty = (ic == numCells - 1) && (ibFromID(numElements - 1) != ib);
 
       // if the block is now empty, deallocate it
-      if (!hasAny && data && data[ib])
+      if (isEmpty && data && data[ib])
       {
-         alloc.deallocate(data[ib], numCells);
+         deallocateBlock(data[ib]);
          data[ib] = nullptr;
       }
    }
@@ -586,14 +633,14 @@ namespace custom
     * DEQUE :: POP_BACK
     * Remove the back element from a deque
     ****************************************/
-   template <typename T, typename A>
-   void deque <T, A> ::pop_back()
+   template <typename T, typename A, size_t BlockBytes>
+   void deque <T, A, BlockBytes> ::pop_back()
    {
       assert(numElements > 0);
 
-      int id = numElements - 1;
-      int ib = ibFromID(id);
-      int ic = icFromID(id);
+      size_t id = numElements - 1;
+      size_t ib = ibFromID(id);
+      size_t ic = icFromID(id);
 
       alloc.destroy(&data[ib][ic]);
 
@@ -606,76 +653,147 @@ namespace custom
          iaFront = 0;
          if (data && data[ib])
          {
-            alloc.deallocate(data[ib], numCells);
+            deallocateBlock(data[ib]);
             data[ib] = nullptr;
          }
          return;
       }
-      // check whether the block that lost the element now contains any remaining elements
-      bool hasAny = false;
-      for (size_t i = 0; i < numElements; ++i)
-      {
-         if (ibFromID(static_cast<int>(i)) == ib)
-         {
-            hasAny = true;
-            break;
-         }
-      }
+      // The elements are contiguous, so the block is empty only when the
+      // back just left it and the front is not wrapped around in it
+      bool isEmpty = (ic == 0) && (ibFromID(0) != ib);
 
       // if the block is now empty, deallocate it
-      if (!hasAny && data && data[ib])
+      if (isEmpty && data && data[ib])
       {
-         alloc.deallocate(data[ib], numCells);
+         deallocateBlock(data[ib]);
          data[ib] = nullptr;
       }
    }
 
    /*****************************************
     * DEQUE :: REALLOCATE
-    * Remove all the elements from a deque
+    * Move the block holding the front to the start of a
+    * map with room for numBlocksNew blocks. The blocks
+    * themselves are only relinked, never copied
+    ****************************************/
+   template <typename T, typename A, size_t BlockBytes>
+   void deque <T, A, BlockBytes> ::reallocate(size_t numBlocksNew)
+   {
+      assert(numBlocksNew > numBlocks);
+      size_t ibFront = ibFromIA(iaFront);
+
+      // the blocks go, in order, to the start of the bigger map
+      T** dataNew = allocateMap(numBlocksNew);
+      for (size_t ib = 0; ib < numBlocks; ib++)
+         dataNew[ib] = data[(ibFront + ib) % numBlocks];
+
+      deallocateMap(data, numBlocks);
+      data = dataNew;
+      numBlocks = numBlocksNew;
+
+      // keep iaFront's offset within a block so element positions remain correct 
+      iaFront = icFromIA(iaFront);
+   }
+
+   /*****************************************
+    * DEQUE :: ALLOCATE MAP
+    * A map of num blocks, none of them allocated yet
     ****************************************/
-   template <typename T, typename A>
-   void deque <T, A> ::reallocate(int numBlocksNew)
+   template <typename T, typename A, size_t BlockBytes>
+   T** deque <T, A, BlockBytes> ::allocateMap(size_t num)
    {
-      // Allocate a new array of arrays that is numBlocksNew size
-      T** newData = new T * [numBlocksNew];
+      T** pMap = MapAlloc(alloc).allocate(num);
+      for (size_t ib = 0; ib < num; ib++)
+         pMap[ib] = nullptr;
+      return pMap;
+   }
 
-      for (int i = 0; i < numBlocksNew; i++)
-         newData[i] = nullptr;
+   /*****************************************
+    * DEQUE :: DEALLOCATE MAP
+    * Give a map of num blocks back. The blocks
+    * themselves must already be taken care of
+    ****************************************/
+   template <typename T, typename A, size_t BlockBytes>
+   void deque <T, A, BlockBytes> ::deallocateMap(T** pMap, size_t num)
+   {
+      if (pMap)
+         MapAlloc(alloc).deallocate(pMap, num);
+   }
 
-      // Copy elements in order
-      for (size_t id = 0; id < numElements; ++id)
+   /*****************************************
+    * DEQUE :: MAX SPARE BLOCKS
+    * Set how many emptied blocks to keep for reuse.
+    * Zero hands every emptied block straight back
+    ****************************************/
+   template <typename T, typename A, size_t BlockBytes>
+   void deque <T, A, BlockBytes> ::max_spare_blocks(size_t num)
+   {
+      numSpareMax = num;
+      while (numSpare > numSpareMax)
       {
-         int oldIb = ibFromID((int)id);
-         int newIb = (int)id / (int)numCells;
-         if (newData[newIb] == nullptr)
-         {
-            // Transfer ownership of the whole block pointer 
-            newData[newIb] = data[oldIb];
-            data[oldIb] = nullptr;
-         }
+         T* pBlock = pSpare;
+         pSpare = *reinterpret_cast<T**>(pBlock);
+         numSpare--;
+         alloc.deallocate(pBlock, numCells);
       }
+   }
 
-      // Deallocate any old blocks not moved 
-      for (size_t ib = 0; ib < numBlocks; ++ib)
-         if (data && data[ib])
-            alloc.deallocate(data[ib], numCells);
+   /*****************************************
+    * DEQUE :: ALLOCATE BLOCK
+    * Reuse a spare block if we have one, otherwise
+    * get a new one from the allocator
+    ****************************************/
+   template <typename T, typename A, size_t BlockBytes>
+   T* deque <T, A, BlockBytes> ::allocateBlock()
+   {
+      if (!pSpare)
+         return alloc.allocate(numCells);
 
-      delete[] data;
+      T* pBlock = pSpare;
+      pSpare = *reinterpret_cast<T**>(pBlock);
+      numSpare--;
+      return pBlock;
+   }
 
-      data = newData;
-      numBlocks = numBlocksNew;
+   /*****************************************
+    * DEQUE :: DEALLOCATE BLOCK
+    * Keep an emptied block as a spare if there is
+    * room, otherwise give it back to the allocator.
+    * A spare holds no elements, so its first cell
+    * holds the pointer to the next spare
+    ****************************************/
+   template <typename T, typename A, size_t BlockBytes>
+   void deque <T, A, BlockBytes> ::deallocateBlock(T* pBlock)
+   {
+      if (numSpare >= numSpareMax)
+      {
+         alloc.deallocate(pBlock, numCells);
+         return;
+      }
 
-      // keep iaFront's offset within a block so element positions remain correct 
-      iaFront = iaFront % (int)numCells;
+      *reinterpret_cast<T**>(pBlock) = pSpare;
+      pSpare = pBlock;
+      numSpare++;
+   }
+
+   /*****************************************
+    * DEQUE :: RELEASE SPARE BLOCKS
+    * Give every spare block back to the allocator
+    ****************************************/
+   template <typename T, typename A, size_t BlockBytes>
+   void deque <T, A, BlockBytes> ::releaseSpareBlocks()
+   {
+      size_t numSpareMaxOld = numSpareMax;
+      max_spare_blocks(0);
+      numSpareMax = numSpareMaxOld;
    }
 
    /*****************************************
     * DEQUE :: IS ALL BLOCKS FILLED?
     * return TRUE if all the blocks are filled
     ****************************************/
-   template <typename T, typename A>
-   bool deque <T, A> ::isAllBlocksFilled() const
+   template <typename T, typename A, size_t BlockBytes>
+   bool deque <T, A, BlockBytes> ::isAllBlocksFilled() const
    {
       // We have no choice but to check each block looking for a NULLPTR
       for (size_t ib = 0; ib < numBlocks; ib++)
@@ -0,0 +1,412 @@
+/***********************************************************************
+ * Header:
+ *    RING BUFFER
+ * Summary:
+ *    Fixed-capacity queues for handing elements from one thread to
+ *    another without a mutex and without allocating once built
+ *
+ *    This will contain the class definition of:
+ *        ring_buffer       : one producer, one consumer, wait-free
+ *        mpmc_ring_buffer  : any number of producers and consumers
+ *
+ *    Both use the same index math as deque: an element is known by an
+ *    ever-increasing id, and its slot in the array is the id wrapped by
+ *    the capacity. The capacity is rounded up to a power of two so that
+ *    wrapping is a mask rather than a division. The head (next id to
+ *    read) and the tail (next id to write) are each on their own cache
+ *    line so the producer and consumer do not fight over one line.
+ * Author
+ *    David Schaad, Tori Tremelling
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <algorithm>   // for std::max
+#include <atomic>   // for std::atomic
+#include <cstddef>  // for size_t and ptrdiff_t
+#include <memory>   // for std::allocator
+#include <new>      // for placement new
+#include <type_traits>  // for std::is_nothrow_constructible
+#include <utility>  // for std::move
+
+class TestRingBuffer;    // forward declaration for TestRingBuffer unit test class
+
+namespace custom
+{
+   // keep the head and the tail from sharing a cache line
+   static constexpr size_t CACHE_LINE = 64;
+
+   // the smallest power of two that is at least num
+   inline size_t ringCapacity(size_t num)
+   {
+      size_t capacity = 1;
+      while (capacity < num)
+         capacity <<= 1;
+      return capacity;
+   }
+
+   /******************************************************
+    * RING BUFFER
+    * Single producer, single consumer. Every push and pop
+    * finishes in a bounded number of steps
+    *****************************************************/
+   template <typename T, typename A = std::allocator<T>>
+   class ring_buffer
+   {
+      friend class ::TestRingBuffer; // give unit tests access to the privates
+   public:
+
+      //
+      // Construct
+      //
+      ring_buffer(size_t num, const A& a = A());
+      ring_buffer(const ring_buffer& rhs) = delete;
+      ring_buffer& operator = (const ring_buffer& rhs) = delete;
+      ~ring_buffer();
+
+      //
+      // Insert: producer thread only
+      //
+      bool push(const T& t) { return emplace(t); }
+      bool push(T&& t)      { return emplace(std::move(t)); }
+      template <class Iterator>
+      size_t push(Iterator first, Iterator last);
+
+      //
+      // Remove: consumer thread only
+      //
+      bool pop(T& t)        { return pop(&t, 1) == 1; }
+      template <class OutputIterator>
+      size_t pop(OutputIterator out, size_t num);
+
+      //
+      // Status
+      //
+      size_t capacity() const { return numCells; }
+      size_t size()     const { return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire); }
+      bool   empty()    const { return size() == 0; }
+
+   private:
+      // array index from id
+      size_t iaFromID(size_t id) const { return id & mask; }
+
+      template <class U>
+      bool emplace(U&& u);
+
+      A      alloc;                             // use allocator for memory allocation
+      size_t numCells;                          // number of cells, a power of two
+      size_t mask;                              // numCells - 1
+      T*     data;                              // the cells themselves
+
+      alignas(CACHE_LINE) std::atomic<size_t> tail;  // next id to write
+      size_t headCache;                              // the producer's last look at head
+
+      alignas(CACHE_LINE) std::atomic<size_t> head;  // next id to read
+      size_t tailCache;                              // the consumer's last look at tail
+   };
+
+   /*****************************************
+    * RING BUFFER :: CONSTRUCTOR
+    * Room for at least num elements
+    ****************************************/
+   template <typename T, typename A>
+   ring_buffer <T, A> ::ring_buffer(size_t num, const A& a)
+      : alloc(a), numCells(ringCapacity(num)), mask(numCells - 1),
+        data(nullptr), tail(0), headCache(0), head(0), tailCache(0)
+   {
+      data = alloc.allocate(numCells);
+   }
+
+   /*****************************************
+    * RING BUFFER :: DESTRUCTOR
+    * Destroy whatever was never popped
+    ****************************************/
+   template <typename T, typename A>
+   ring_buffer <T, A> :: ~ring_buffer()
+   {
+      for (size_t id = head.load(); id != tail.load(); id++)
+         data[iaFromID(id)].~T();
+      alloc.deallocate(data, numCells);
+   }
+
+   /*****************************************
+    * RING BUFFER :: EMPLACE
+    * Build an element at the tail, if there is room
+    ****************************************/
+   template <typename T, typename A>
+   template <class U>
+   bool ring_buffer <T, A> ::emplace(U&& u)
+   {
+      size_t id = tail.load(std::memory_order_relaxed);
+
+      // Only look at the consumer's index when we seem to be full
+      if (id - headCache == numCells)
+      {
+         headCache = head.load(std::memory_order_acquire);
+         if (id - headCache == numCells)
+            return false;
+      }
+
+      new (data + iaFromID(id)) T(std::forward<U>(u));
+      tail.store(id + 1, std::memory_order_release);
+      return true;
+   }
+
+   /*****************************************
+    * RING BUFFER :: PUSH RANGE
+    * Copy as much of a range as fits, publishing
+    * it all at once. Returns how many went in
+    ****************************************/
+   template <typename T, typename A>
+   template <class Iterator>
+   size_t ring_buffer <T, A> ::push(Iterator first, Iterator last)
+   {
+      size_t idBegin = tail.load(std::memory_order_relaxed);
+      headCache = head.load(std::memory_order_acquire);
+
+      size_t id = idBegin;
+      for (; first != last && id - headCache != numCells; ++first, ++id)
+         new (data + iaFromID(id)) T(*first);
+
+      if (id != idBegin)
+         tail.store(id, std::memory_order_release);
+      return id - idBegin;
+   }
+
+   /*****************************************
+    * RING BUFFER :: POP
+    * Move up to num elements from the head to out,
+    * freeing their cells all at once. Returns how
+    * many came out
+    ****************************************/
+   template <typename T, typename A>
+   template <class OutputIterator>
+   size_t ring_buffer <T, A> ::pop(OutputIterator out, size_t num)
+   {
+      size_t idBegin = head.load(std::memory_order_relaxed);
+
+      // Only look at the producer's index when we seem to be short
+      if (tailCache - idBegin < num)
+         tailCache = tail.load(std::memory_order_acquire);
+
+      size_t id = idBegin;
+      for (; id != tailCache && id - idBegin < num; ++id)
+      {
+         T& t = data[iaFromID(id)];
+         *out = std::move(t);
+         ++out;
+         t.~T();
+      }
+
+      if (id != idBegin)
+         head.store(id, std::memory_order_release);
+      return id - idBegin;
+   }
+
+   /******************************************************
+    * MPMC RING BUFFER
+    * Any number of producers and consumers. Each cell
+    * carries a sequence number saying whose turn it is:
+    *    id      the cell is free for the producer of id
+    *    id + 1  the cell holds id for its consumer
+    * A thread claims an id by bumping the head or tail,
+    * and only then touches the cell
+    *****************************************************/
+   template <typename T, typename A = std::allocator<T>>
+   class mpmc_ring_buffer
+   {
+      friend class ::TestRingBuffer; // give unit tests access to the privates
+      static_assert(std::is_nothrow_move_constructible<T>::value,
+                    "mpmc_ring_buffer moves T into a claimed cell, which may not throw");
+   public:
+
+      //
+      // Construct
+      //
+      mpmc_ring_buffer(size_t num, const A& a = A());
+      mpmc_ring_buffer(const mpmc_ring_buffer& rhs) = delete;
+      mpmc_ring_buffer& operator = (const mpmc_ring_buffer& rhs) = delete;
+      ~mpmc_ring_buffer();
+
+      //
+      // Insert
+      //
+      bool push(const T& t) { return emplace(t); }
+      bool push(T&& t)      { return emplace(std::move(t)); }
+
+      //
+      // Remove
+      //
+      bool pop(T& t);
+
+      //
+      // Status
+      //
+      size_t capacity() const { return numCells; }
+      size_t size()     const;
+      bool   empty()    const { return size() == 0; }
+
+   private:
+      struct Cell
+      {
+         std::atomic<size_t> sequence;                // whose turn it is
+         alignas(T) unsigned char storage[sizeof(T)]; // the element, built in place
+
+         T& value() { return *reinterpret_cast<T*>(storage); }
+      };
+      using CellAlloc = typename std::allocator_traits<A>::template rebind_alloc<Cell>;
+
+      // array index from id
+      size_t iaFromID(size_t id) const { return id & mask; }
+
+      // A claimed cell must be filled or no consumer gets past it,
+      // so a constructor that may throw runs before the claim
+      template <class U>
+      bool emplace(U&& u)
+      {
+         return emplace(std::forward<U>(u), std::is_nothrow_constructible<T, U&&>());
+      }
+      template <class U>
+      bool emplace(U&& u, std::false_type)
+      {
+         T t(std::forward<U>(u));
+         return emplace(std::move(t), std::true_type());
+      }
+      template <class U>
+      bool emplace(U&& u, std::true_type);
+
+      CellAlloc alloc;                          // use allocator for memory allocation
+      size_t numCells;                          // number of cells, a power of two
+      size_t mask;                              // numCells - 1
+      Cell*  cells;                             // the cells themselves
+
+      alignas(CACHE_LINE) std::atomic<size_t> tail;  // next id to write
+      alignas(CACHE_LINE) std::atomic<size_t> head;  // next id to read
+   };
+
+   /*****************************************
+    * MPMC RING BUFFER :: CONSTRUCTOR
+    * Room for at least num elements. Cell i is free
+    * for the producer of id i. One cell is not enough:
+    * "holds id" and "free for id + 1" would look the same
+    ****************************************/
+   template <typename T, typename A>
+   mpmc_ring_buffer <T, A> ::mpmc_ring_buffer(size_t num, const A& a)
+      : alloc(a), numCells(std::max<size_t>(2, ringCapacity(num))), mask(numCells - 1),
+        cells(nullptr), tail(0), head(0)
+   {
+      cells = alloc.allocate(numCells);
+      for (size_t ia = 0; ia < numCells; ia++)
+      {
+         new (cells + ia) Cell;
+         cells[ia].sequence.store(ia, std::memory_order_relaxed);
+      }
+   }
+
+   /*****************************************
+    * MPMC RING BUFFER :: DESTRUCTOR
+    * Destroy whatever was never popped
+    ****************************************/
+   template <typename T, typename A>
+   mpmc_ring_buffer <T, A> :: ~mpmc_ring_buffer()
+   {
+      for (size_t id = head.load(); id != tail.load(); id++)
+         cells[iaFromID(id)].value().~T();
+      for (size_t ia = 0; ia < numCells; ia++)
+         cells[ia].~Cell();
+      alloc.deallocate(cells, numCells);
+   }
+
+   /*****************************************
+    * MPMC RING BUFFER :: SIZE
+    * Only a snapshot while other threads are busy
+    ****************************************/
+   template <typename T, typename A>
+   size_t mpmc_ring_buffer <T, A> ::size() const
+   {
+      size_t idHead = head.load(std::memory_order_acquire);
+      size_t idTail = tail.load(std::memory_order_acquire);
+      return idTail > idHead ? idTail - idHead : 0;
+   }
+
+   /*****************************************
+    * MPMC RING BUFFER :: EMPLACE
+    * Claim the next id and build an element in its
+    * cell, which cannot throw. Returns false if the
+    * buffer is full
+    ****************************************/
+   template <typename T, typename A>
+   template <class U>
+   bool mpmc_ring_buffer <T, A> ::emplace(U&& u, std::true_type)
+   {
+      size_t id = tail.load(std::memory_order_relaxed);
+      Cell* pCell;
+      for (;;)
+      {
+         pCell = cells + iaFromID(id);
+         size_t sequence = pCell->sequence.load(std::memory_order_acquire);
+         ptrdiff_t diff = (ptrdiff_t)sequence - (ptrdiff_t)id;
+
+         // The cell is ready for id: try to claim it
+         if (diff == 0)
+         {
+            if (tail.compare_exchange_weak(id, id + 1, std::memory_order_relaxed))
+               break;
+         }
+
+         // The cell still holds the element from a lap ago: we are full
+         else if (diff < 0)
+            return false;
+
+         // Someone claimed id before us: try the newest tail
+         else
+            id = tail.load(std::memory_order_relaxed);
+      }
+
+      new (pCell->storage) T(std::forward<U>(u));
+      pCell->sequence.store(id + 1, std::memory_order_release);
+      return true;
+   }
+
+   /*****************************************
+    * MPMC RING BUFFER :: POP
+    * Claim the next id and move its element out.
+    * Returns false if the buffer is empty
+    ****************************************/
+   template <typename T, typename A>
+   bool mpmc_ring_buffer <T, A> ::pop(T& t)
+   {
+      size_t id = head.load(std::memory_order_relaxed);
+      Cell* pCell;
+      for (;;)
+      {
+         pCell = cells + iaFromID(id);
+         size_t sequence = pCell->sequence.load(std::memory_order_acquire);
+         ptrdiff_t diff = (ptrdiff_t)sequence - (ptrdiff_t)(id + 1);
+
+         // The cell holds id: try to claim it
+         if (diff == 0)
+         {
+            if (head.compare_exchange_weak(id, id + 1, std::memory_order_relaxed))
+               break;
+         }
+
+         // Nothing has been written to the cell yet: we are empty
+         else if (diff < 0)
+            return false;
+
+         // Someone claimed id before us: try the newest head
+         else
+            id = head.load(std::memory_order_relaxed);
+      }
+
+      t = std::move(pCell->value());
+      pCell->value().~T();
+
+      // The cell is free for the producer one lap from now
+      pCell->sequence.store(id + numCells, std::memory_order_release);
+      return true;
+   }
+
+} // namespace custom
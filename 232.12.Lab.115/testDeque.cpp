@@ -14,6 +14,7 @@
 
 #include "testDeque.h"       // for the deque unit tests
 #include "testSpy.h"         // for the spy unit tests
+#include "testRingBuffer.h"  // for the ring buffer unit tests
 int Spy::counters[] = {};
 
 /**********************************************************************
@@ -26,6 +27,7 @@ int main()
    // unit tests
    TestSpy().run();
    TestDeque().run();
+   TestRingBuffer().run();
 #endif // DEBUG
    
    return 0;
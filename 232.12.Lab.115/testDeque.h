@@ -21,6 +21,44 @@
 
 #include <deque>
 
+/***************************************
+ * COUNTING ALLOCATOR
+ * Hands out blocks like std::allocator but counts
+ * every allocate and deallocate
+ ***************************************/
+class CountingAllocatorBase
+{
+public:
+   static int& numAllocate()   { static int num = 0; return num; }
+   static int& numDeallocate() { static int num = 0; return num; }
+   static void reset()         { numAllocate() = numDeallocate() = 0; }
+};
+
+template <class T>
+class CountingAllocator : public CountingAllocatorBase
+{
+public:
+   using value_type = T;
+
+   CountingAllocator() {}
+   template <class U>
+   CountingAllocator(const CountingAllocator<U>&) {}
+
+   T* allocate(size_t num)
+   {
+      numAllocate()++;
+      return std::allocator<T>().allocate(num);
+   }
+   void deallocate(T* p, size_t num)
+   {
+      numDeallocate()++;
+      std::allocator<T>().deallocate(p, num);
+   }
+   template <class U>
+   void construct(T* p, U&& u) { new (p) T(std::forward<U>(u)); }
+   void destroy(T* p)          { p->~T(); }
+};
+
 class TestDeque : public UnitTest
 {
 public:
@@ -35,17 +73,22 @@ public:
       test_icFromID_3x3();
       test_iaFromID_4x1();
       test_iaFromID_3x3();
+      test_fromID_powerOfTwo();
+      test_fromID_large();
       test_realloc_emptyToOne();
       test_realloc_oneToTwo();
       test_realloc_shift();
       test_realloc_wrapBetweenBlocks();
       test_realloc_complex();
+      test_realloc_mapAllocator();
+      test_blockSize_byElement();
 
       // Construct
       test_construct_default();
       test_constructCopy_empty();
       test_constructCopy_standard();
       test_constructCopy_wrapped();
+      test_constructCopy_manyBlocks();
       
       // Destruct
       test_destruct_default();
@@ -109,11 +152,19 @@ public:
       test_popfront_lastElement();
       test_popfront_lastInBlock(); 
       test_popfront_complex();
+      test_popfront_wrappedSameBlock();
       test_popback_unwrap();
       test_popback_standard();
       test_popback_lastElement();
       test_popback_lastInBlock();
       test_popback_complex();
+      test_popback_wrappedSameBlock();
+
+      // Spare blocks
+      test_spare_fifoSteadyState();
+      test_spare_none();
+      test_spare_shrink();
+      test_spare_destructor();
 
       // Status
       test_size_empty();
@@ -332,6 +383,55 @@ public:
       // teardown
       teardownStandardFixture(d);
    }
+
+   // Our own block size takes the shift and mask path, and agrees
+   // with the division the other sizes use
+   void test_fromID_powerOfTwo()
+   {  // setup
+      custom::deque<Spy> d;
+      const size_t num = d.cellsPerBlock;
+      d.numBlocks = 3;
+      d.numCells = num;
+      d.iaFront = 2 * num + num / 2;
+      // exercise
+      size_t ibFront = d.ibFromID(0);
+      size_t icFront = d.icFromID(0);
+      size_t ibWrap = d.ibFromID(num / 2);
+      size_t icWrap = d.icFromID(num / 2);
+      size_t ibLast = d.ibFromID(num + num / 2 - 1);
+      size_t icLast = d.icFromID(num + num / 2 - 1);
+      // verify
+      assertUnit(ibFront == 2);
+      assertUnit(icFront == num / 2);
+      assertUnit(ibWrap == 0);
+      assertUnit(icWrap == 0);
+      assertUnit(ibLast == 0);
+      assertUnit(icLast == num - 1);
+      // teardown
+      teardownStandardFixture(d);
+   }
+
+   // Indices past what an int can hold
+   void test_fromID_large()
+   {  // setup
+      custom::deque<Spy> d;
+      const size_t numTotal = size_t(1) << 32;
+      d.numCells = d.cellsPerBlock;
+      d.numBlocks = numTotal / d.numCells;
+      d.iaFront = numTotal - 3;
+      // exercise
+      size_t ia0 = d.iaFromID(0);
+      size_t ia5 = d.iaFromID(5);
+      size_t ibBig = d.ibFromID((size_t(1) << 31) + 7);
+      size_t icBig = d.icFromID((size_t(1) << 31) + 7);
+      // verify
+      assertUnit(ia0 == numTotal - 3);
+      assertUnit(ia5 == 2);
+      assertUnit(ibBig == ((size_t(1) << 31) + 4) / d.numCells);
+      assertUnit(icBig == 4);
+      // teardown
+      teardownStandardFixture(d);
+   }
    
    /***************************************
     * INDEX TRANSLATORS
@@ -384,7 +484,7 @@ public:
       d.numCells = 3;
       d.numElements = 1;
       d.numBlocks = 1;
-      d.data = new Spy * [1];
+      d.data = d.allocateMap(1);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.alloc.construct(&d.data[0][1], Spy(99));
       d.iaFront = 1;
@@ -441,7 +541,7 @@ public:
       d.numCells = 3;
       d.numElements = 3;
       d.numBlocks = 2;
-      d.data = new Spy * [2];
+      d.data = d.allocateMap(2);
       d.data[0] = nullptr;
       d.data[1] = d.alloc.allocate(d.numCells);
       d.alloc.construct(&d.data[1][0], Spy(67));
@@ -508,7 +608,7 @@ public:
       d.numCells = 2;
       d.numElements = 3;
       d.numBlocks = 4;
-      d.data = new Spy * [4];
+      d.data = d.allocateMap(4);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.data[1] = nullptr;
       d.data[2] = nullptr;
@@ -581,7 +681,7 @@ public:
       d.numCells = 3;
       d.numElements = 8;
       d.numBlocks = 3;
-      d.data = new Spy * [3];
+      d.data = d.allocateMap(3);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.data[1] = d.alloc.allocate(d.numCells);
       d.data[2] = d.alloc.allocate(d.numCells);
@@ -651,6 +751,128 @@ public:
       teardownStandardFixture(d);
    }
 
+   // the map comes from the allocator just like the blocks
+   void test_realloc_mapAllocator()
+   {  // setup
+      CountingAllocatorBase::reset();
+      {
+         custom::deque<int, CountingAllocator<int>, 64> d;   // 16 cells a block
+         // exercise
+         d.push_back(26);
+         // verify
+         assertUnit(CountingAllocatorBase::numAllocate() == 2);   // map and block
+         for (int i = 0; i < 16; i++)
+            d.push_back(i);
+         assertUnit(CountingAllocatorBase::numAllocate() == 4);   // bigger map and block
+         assertUnit(CountingAllocatorBase::numDeallocate() == 1); // old map
+      }  // teardown
+      assertUnit(CountingAllocatorBase::numAllocate() == CountingAllocatorBase::numDeallocate());
+   }
+
+   // a block holds about BlockBytes, a power of two, at least 16 cells
+   void test_blockSize_byElement()
+   {  // setup
+      struct Big { char bytes[1024]; };
+      // exercise
+      size_t numChar    = custom::deque<char>::cellsPerBlock;
+      size_t numSpy     = custom::deque<Spy>::cellsPerBlock;
+      size_t numBig     = custom::deque<Big>::cellsPerBlock;
+      size_t numOdd     = custom::deque<char[3]>::cellsPerBlock;
+      size_t numLarge   = custom::deque<int, std::allocator<int>, 4096>::cellsPerBlock;
+      // verify
+      assertUnit(numChar == 512);
+      assertUnit(numSpy == 512 / sizeof(Spy));
+      assertUnit(numBig == 16);
+      assertUnit(numOdd == 128);     // 170 rounded down
+      assertUnit(numLarge == 1024);
+      assertUnit(custom::deque<Spy>().numCells == numSpy);
+   }
+
+   /***************************************
+    * SPARE BLOCKS
+    ***************************************/
+
+   // a sliding FIFO window reuses its blocks
+   void test_spare_fifoSteadyState()
+   {  // setup
+      custom::deque<int, CountingAllocator<int>, 64> d;   // 16 cells a block
+      for (int i = 0; i < 40; i++)
+         d.push_back(i);
+      for (int i = 0; i < 20; i++)
+         d.pop_front();
+      CountingAllocatorBase::reset();
+      // exercise
+      for (int i = 40; i < 1040; i++)
+      {
+         d.push_back(i);
+         d.pop_front();
+      }
+      // verify
+      assertUnit(CountingAllocatorBase::numAllocate() == 0);
+      assertUnit(CountingAllocatorBase::numDeallocate() == 0);
+      assertUnit(d.size() == 20);
+      assertUnit(d.front() == 1020);
+      assertUnit(d.back() == 1039);
+   }  // teardown
+
+   // with no spares every crossing goes to the allocator
+   void test_spare_none()
+   {  // setup
+      custom::deque<int, CountingAllocator<int>, 64> d;   // 16 cells a block
+      d.max_spare_blocks(0);
+      for (int i = 0; i < 40; i++)
+         d.push_back(i);
+      for (int i = 0; i < 20; i++)
+         d.pop_front();
+      CountingAllocatorBase::reset();
+      // exercise
+      for (int i = 40; i < 1040; i++)
+      {
+         d.push_back(i);
+         d.pop_front();
+      }
+      // verify
+      assertUnit(CountingAllocatorBase::numAllocate() > 0);
+      assertUnit(CountingAllocatorBase::numAllocate() == CountingAllocatorBase::numDeallocate());
+      assertUnit(d.numSpare == 0);
+      assertUnit(d.front() == 1020);
+   }  // teardown
+
+   // lowering the limit gives the extra spares back
+   void test_spare_shrink()
+   {  // setup
+      custom::deque<int, CountingAllocator<int>, 64> d;   // 16 cells a block
+      d.max_spare_blocks(4);
+      for (int i = 0; i < 64; i++)
+         d.push_back(i);
+      while (!d.empty())
+         d.pop_back();
+      assertUnit(d.numSpare == 4);
+      CountingAllocatorBase::reset();
+      // exercise
+      d.max_spare_blocks(1);
+      // verify
+      assertUnit(CountingAllocatorBase::numDeallocate() == 3);
+      assertUnit(d.numSpare == 1);
+      assertUnit(d.max_spare_blocks() == 1);
+   }  // teardown
+
+   // every block, spare or not, goes back when we are done
+   void test_spare_destructor()
+   {  // setup
+      CountingAllocatorBase::reset();
+      {
+         custom::deque<int, CountingAllocator<int>> d;
+         for (int i = 0; i < 100; i++)
+            d.push_back(i);
+         for (int i = 0; i < 50; i++)
+            d.pop_front();
+      }  // exercise
+      // verify
+      assertUnit(CountingAllocatorBase::numAllocate() > 0);
+      assertUnit(CountingAllocatorBase::numAllocate() == CountingAllocatorBase::numDeallocate());
+   }
+
    /***************************************
     * CONSTRUCTORS
     ***************************************/
@@ -853,7 +1075,7 @@ public:
       //   +----+
       assertUnit(dDes.numElements == 4);
       assertUnit(dDes.numBlocks == 1);
-      assertUnit(dDes.numCells == 16);
+      assertUnit(dDes.numCells == dDes.cellsPerBlock);
       assertUnit(dDes.data != nullptr);
       if (dDes.data != nullptr && dDes.data[0])
       {
@@ -868,6 +1090,24 @@ public:
       teardownStandardFixture(dDes);
    }
 
+   // copy constructor where the source fills many blocks
+   void test_constructCopy_manyBlocks()
+   {  // setup
+      custom::deque<int> dSrc;
+      for (int i = 0; i < 1000; i++)
+         dSrc.push_front(i);
+      // exercise
+      custom::deque<int> dDes(dSrc);
+      // verify
+      assertUnit(dDes.size() == 1000);
+      assertUnit(dDes.iaFront == 0);
+      assertUnit(dDes.numBlocks == (1000 + dDes.numCells - 1) / dDes.numCells);
+      bool isSame = true;
+      for (size_t id = 0; id < 1000; id++)
+         isSame = isSame && dDes[id] == dSrc[id];
+      assertUnit(isSame);
+   }  // teardown
+
    // copy constructor where the source is wrapped. Need to unwrap
    void test_constructCopy_wrapped()
    {  // setup
@@ -883,7 +1123,7 @@ public:
       dSrc.numCells = 3;
       dSrc.numElements = 3;
       dSrc.numBlocks = 7;
-      dSrc.data = new Spy * [7];
+      dSrc.data = dSrc.allocateMap(7);
       dSrc.data[0] = dSrc.alloc.allocate(dSrc.numCells);
       dSrc.data[1] = nullptr;
       dSrc.data[2] = nullptr;
@@ -918,7 +1158,7 @@ public:
       //   +----+
       assertUnit(dDes.numElements == 3);
       assertUnit(dDes.numBlocks == 1);
-      assertUnit(dDes.numCells == 16);
+      assertUnit(dDes.numCells == dDes.cellsPerBlock);
       assertUnit(dDes.data != nullptr);
       if (dDes.data != nullptr && dDes.data[0])
       {
@@ -976,7 +1216,7 @@ public:
          d.numBlocks = 1;
          d.numCells = 7;
          d.numElements = 0;
-         d.data = new Spy * [1];
+         d.data = d.allocateMap(1);
          d.data[0] = alloc.allocate(7);
          Spy::reset();
       }  // exercise
@@ -1009,7 +1249,7 @@ public:
          d.numBlocks = 1;
          d.numCells = 7;
          d.numElements = 7;
-         d.data = new Spy * [1];
+         d.data = d.allocateMap(1);
          d.data[0] = alloc.allocate(7);
          new((void*)(&(d.data[0][0]))) Spy(00);
          new((void*)(&(d.data[0][1]))) Spy(01);
@@ -1049,7 +1289,7 @@ public:
          d.numBlocks = 1;
          d.numCells = 7;
          d.numElements = 4;
-         d.data = new Spy * [1];
+         d.data = d.allocateMap(1);
          d.data[0] = alloc.allocate(7);
          new((void*)(&(d.data[0][2]))) Spy(02);
          new((void*)(&(d.data[0][3]))) Spy(03);
@@ -1085,7 +1325,7 @@ public:
          d.numBlocks = 4;
          d.numCells = 3;
          d.numElements = 6;
-         d.data = new Spy * [4];
+         d.data = d.allocateMap(4);
          d.data[0] = nullptr;
          d.data[1] = alloc.allocate(3);
          d.data[2] = alloc.allocate(3);
@@ -1234,7 +1474,7 @@ public:
       //   +----+
       assertUnit(dDes.numElements == 4);
       assertUnit(dDes.numBlocks == 1);
-      assertUnit(dDes.numCells == 16);
+      assertUnit(dDes.numCells == dDes.cellsPerBlock);
       assertUnit(dDes.data != nullptr);
       if (dDes.data != nullptr && dDes.data[0])
       {
@@ -1301,7 +1541,7 @@ public:
       dSrc.numCells = 3;
       dSrc.numElements = 3;
       dSrc.numBlocks = 7;
-      dSrc.data = new Spy * [7];
+      dSrc.data = dSrc.allocateMap(7);
       dSrc.data[0] = dSrc.alloc.allocate(dSrc.numCells);
       dSrc.data[1] = nullptr;
       dSrc.data[2] = nullptr;
@@ -1337,7 +1577,7 @@ public:
       //   +----+
       assertUnit(dDes.numElements == 3);
       assertUnit(dDes.numBlocks == 1);
-      assertUnit(dDes.numCells == 16);
+      assertUnit(dDes.numCells == dDes.cellsPerBlock);
       assertUnit(dDes.data != nullptr);
       if (dDes.data != nullptr && dDes.data[0])
       {
@@ -1593,7 +1833,7 @@ public:
       d.numCells = 4;
       d.numElements = 2;
       d.numBlocks = 1;
-      d.data = new Spy * [1];
+      d.data = d.allocateMap(1);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.alloc.construct(&d.data[0][2], Spy(11));
       d.alloc.construct(&d.data[0][3], Spy(28));
@@ -1657,7 +1897,7 @@ public:
       d.numCells = 3;
       d.numElements = 8;
       d.numBlocks = 3;
-      d.data = new Spy * [3];
+      d.data = d.allocateMap(3);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.data[1] = d.alloc.allocate(d.numCells);
       d.data[2] = d.alloc.allocate(d.numCells);
@@ -1914,7 +2154,7 @@ public:
       d.numCells = 4;
       d.numElements = 2;
       d.numBlocks = 1;
-      d.data = new Spy * [1];
+      d.data = d.allocateMap(1);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.alloc.construct(&d.data[0][0], Spy(11));
       d.alloc.construct(&d.data[0][1], Spy(28));
@@ -1981,7 +2221,7 @@ public:
       d.numCells = 3;
       d.numElements = 8;
       d.numBlocks = 3;
-      d.data = new Spy * [3];
+      d.data = d.allocateMap(3);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.data[1] = d.alloc.allocate(d.numCells);
       d.data[2] = d.alloc.allocate(d.numCells);
@@ -2072,7 +2312,7 @@ public:
       d.numCells = 3;
       d.numElements = 2;
       d.numBlocks = 7;
-      d.data = new Spy * [7];
+      d.data = d.allocateMap(7);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.data[1] = nullptr;
       d.data[2] = nullptr;
@@ -2209,7 +2449,7 @@ public:
       d.numCells = 4;
       d.numElements = 3;
       d.numBlocks = 1;
-      d.data = new Spy * [1];
+      d.data = d.allocateMap(1);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.alloc.construct(&d.data[0][3], Spy(11));
       d.alloc.construct(&d.data[0][0], Spy(28));
@@ -2271,7 +2511,7 @@ public:
       d.numCells = 4;
       d.numElements = 1;
       d.numBlocks = 1;
-      d.data = new Spy * [1];
+      d.data = d.allocateMap(1);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.alloc.construct(&d.data[0][1], Spy(31));
       d.iaFront = 1;
@@ -2377,7 +2617,7 @@ public:
       d.numCells = 3;
       d.numElements = 3;
       d.numBlocks = 7;
-      d.data = new Spy * [7];
+      d.data = d.allocateMap(7);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.data[1] = nullptr;
       d.data[2] = nullptr;
@@ -2435,6 +2675,42 @@ public:
       teardownStandardFixture(d);
    }
 
+   // the front leaves a block that the back has wrapped into
+   void test_popfront_wrappedSameBlock()
+   {  // setup
+      //                   iaFront
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 49 | 55 |    | 31 |
+      //    +----+----+----+----+
+      //      |
+      //    +----+
+      //    |    |
+      //    +----+
+      custom::deque<Spy> d;
+      setupWrappedSingleBlockFixture(d);
+      Spy::reset();
+      // exercise
+      d.pop_front();
+      // verify
+      assertUnit(Spy::numDelete() == 1);        // delete 31
+      assertUnit(Spy::numDestructor() == 1);    // destroy 31
+      assertUnit(d.numElements == 2);
+      assertUnit(d.iaFront == 0);
+      assertUnit(d.data != nullptr);
+      if (d.data)
+      {
+         assertUnit(d.data[0] != nullptr);      // 49 and 55 are still here
+         if (d.data[0])
+         {
+            assertUnit(d.data[0][0] == Spy(49));
+            assertUnit(d.data[0][1] == Spy(55));
+         }
+      }
+      // teardown
+      teardownStandardFixture(d);
+   }
+
    /***************************************
     * POP BACK
     ***************************************/
@@ -2507,7 +2783,7 @@ public:
       d.numCells = 4;
       d.numElements = 2;
       d.numBlocks = 1;
-      d.data = new Spy * [1];
+      d.data = d.allocateMap(1);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.alloc.construct(&d.data[0][2], Spy(11));
       d.alloc.construct(&d.data[0][3], Spy(28));
@@ -2567,7 +2843,7 @@ public:
       d.numCells = 4;
       d.numElements = 1;
       d.numBlocks = 1;
-      d.data = new Spy * [1];
+      d.data = d.allocateMap(1);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.alloc.construct(&d.data[0][1], Spy(31));
       d.iaFront = 1;
@@ -2672,7 +2948,7 @@ public:
       d.numCells = 3;
       d.numElements = 3;
       d.numBlocks = 7;
-      d.data = new Spy * [7];
+      d.data = d.allocateMap(7);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.data[1] = nullptr;
       d.data[2] = nullptr;
@@ -2731,6 +3007,40 @@ public:
       teardownStandardFixture(d);
    }
 
+   // the back leaves a block that the front has wrapped into
+   void test_popback_wrappedSameBlock()
+   {  // setup
+      //                   iaFront
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 49 | 55 |    | 31 |
+      //    +----+----+----+----+
+      //      |
+      //    +----+
+      //    |    |
+      //    +----+
+      custom::deque<Spy> d;
+      setupWrappedSingleBlockFixture(d);
+      d.pop_back();
+      Spy::reset();
+      // exercise
+      d.pop_back();
+      // verify
+      assertUnit(Spy::numDelete() == 1);        // delete 49
+      assertUnit(Spy::numDestructor() == 1);    // destroy 49
+      assertUnit(d.numElements == 1);
+      assertUnit(d.iaFront == 3);
+      assertUnit(d.data != nullptr);
+      if (d.data)
+      {
+         assertUnit(d.data[0] != nullptr);      // 31 is still here
+         if (d.data[0])
+            assertUnit(d.data[0][3] == Spy(31));
+      }
+      // teardown
+      teardownStandardFixture(d);
+   }
+
 
    /***************************************
     * BACK
@@ -2785,7 +3095,7 @@ public:
       d.numCells = 3;
       d.numElements = 4;
       d.iaFront = 10;
-      d.data = new Spy * [d.numBlocks];
+      d.data = d.allocateMap(d.numBlocks);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.data[1] = nullptr;
       d.data[2] = nullptr;
@@ -2859,7 +3169,7 @@ public:
       d.numCells = 16;
       d.numElements = 3;
       d.iaFront = 0;
-      d.data = new Spy * [1];
+      d.data = d.allocateMap(1);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.alloc.construct(&d.data[0][0], Spy(59));
       d.alloc.construct(&d.data[0][1], Spy(67));
@@ -2888,7 +3198,7 @@ public:
       //   |    |
       //   +----+
       assertUnit(d2.numBlocks == 1);
-      assertUnit(d2.numCells == 16);
+      assertUnit(d2.numCells == d2.cellsPerBlock);
       assertUnit(d2.numElements == 3);
       assertUnit(d2.iaFront == 0);
       assertUnit(d2.data != nullptr);
@@ -2973,7 +3283,7 @@ public:
       d.numCells = 3;
       d.numElements = 4;
       d.iaFront = 10;
-      d.data = new Spy * [d.numBlocks];
+      d.data = d.allocateMap(d.numBlocks);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.data[1] = nullptr;
       d.data[2] = nullptr;
@@ -3134,7 +3444,7 @@ public:
       d.numCells = 16;
       d.numElements = 3;
       d.iaFront = 0;
-      d.data = new Spy * [1];
+      d.data = d.allocateMap(1);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.alloc.construct(&d.data[0][0], Spy(59));
       d.alloc.construct(&d.data[0][1], Spy(67));
@@ -3163,7 +3473,7 @@ public:
       //   |    |
       //   +----+
       assertUnit(d2.numBlocks == 1);
-      assertUnit(d2.numCells == 16);
+      assertUnit(d2.numCells == d2.cellsPerBlock);
       assertUnit(d2.numElements == 3);
       assertUnit(d2.iaFront == 0);
       assertUnit(d2.data != nullptr);
@@ -3251,7 +3561,7 @@ public:
       d.numCells = 3;
       d.numElements = 4;
       d.iaFront = 10;
-      d.data = new Spy * [d.numBlocks];
+      d.data = d.allocateMap(d.numBlocks);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.data[1] = nullptr;
       d.data[2] = nullptr;
@@ -3330,7 +3640,7 @@ public:
       d.numCells = 16;
       d.numElements = 3;
       d.iaFront = 0;
-      d.data = new Spy * [1];
+      d.data = d.allocateMap(1);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.alloc.construct(&d.data[0][0], Spy(59));
       d.alloc.construct(&d.data[0][1], Spy(67));
@@ -3359,7 +3669,7 @@ public:
       //   |    |
       //   +----+
       assertUnit(d2.numBlocks == 1);
-      assertUnit(d2.numCells == 16);
+      assertUnit(d2.numCells == d2.cellsPerBlock);
       assertUnit(d2.numElements == 3);
       assertUnit(d2.iaFront == 0);
       assertUnit(d2.data != nullptr);
@@ -3459,7 +3769,7 @@ public:
       d.numCells = 3;
       d.numElements = 4;
       d.iaFront = 10;
-      d.data = new Spy * [d.numBlocks];
+      d.data = d.allocateMap(d.numBlocks);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.data[1] = nullptr;
       d.data[2] = nullptr;
@@ -3950,7 +4260,7 @@ public:
       d.numCells    = 3;
       d.numElements = 4;
       d.iaFront     = 4;
-      d.data = new Spy * [d.numBlocks];
+      d.data = d.allocateMap(d.numBlocks);
 
       d.data[0] = nullptr;
       d.data[1] = d.alloc.allocate(d.numCells);
@@ -3963,13 +4273,37 @@ public:
       d.alloc.construct(&d.data[2][1], Spy(67));
    }
 
+   /*************************************************************
+    * SETUP WRAPPED SINGLE BLOCK FIXTURE
+    *    [31, 49, 55]
+    *
+    *      0    1    2    3
+    *    +----+----+----+----+
+    *    | 49 | 55 |    | 31 |
+    *    +----+----+----+----+
+    *************************************************************/
+   void setupWrappedSingleBlockFixture(custom::deque<Spy>& d)
+   {
+      d.numBlocks   = 1;
+      d.numCells    = 4;
+      d.numElements = 3;
+      d.iaFront     = 3;
+      d.data = d.allocateMap(d.numBlocks);
+
+      d.data[0] = d.alloc.allocate(d.numCells);
+
+      d.alloc.construct(&d.data[0][3], Spy(31));
+      d.alloc.construct(&d.data[0][0], Spy(49));
+      d.alloc.construct(&d.data[0][1], Spy(55));
+   }
+
    /*************************************************************
     * VERIFY EMPTY FIXTURE
     *************************************************************/
    void assertEmptyFixtureParameters(const custom::deque<Spy>& d, int line, const char* function)
    {
       assertIndirect(d.numBlocks == 0);
-      assertIndirect(d.numCells == 16);
+      assertIndirect(d.numCells == d.cellsPerBlock);
       assertIndirect(d.numElements == 0);
       assertIndirect(d.iaFront == 0);
       assertIndirect(d.data == nullptr);
@@ -4028,6 +4362,7 @@ public:
     *************************************************************/
    void teardownStandardFixture(custom::deque<Spy>& d)
    {
+      d.releaseSpareBlocks();
       if (d.data)
       {
          for (size_t id = 0; id < d.numElements; id++)
@@ -4049,7 +4384,7 @@ public:
          if (d.numBlocks > 4 && d.data[4])
             d.alloc.deallocate(d.data[4], d.numCells);
 
-         delete [] d.data;
+         d.deallocateMap(d.data, d.numBlocks);
       }
       d.data = nullptr;
       d.numBlocks = 0;
@@ -0,0 +1,435 @@
+/***********************************************************************
+ * Header:
+ *    TEST RING BUFFER
+ * Summary:
+ *    Unit tests for ring_buffer and mpmc_ring_buffer
+ * Author
+ *    David Schaad, Tori Tremelling
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "ring_buffer.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <atomic>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+class TestRingBuffer : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_roundUp();
+      test_construct_padded();
+      test_destructor_partial();
+
+      // Single producer, single consumer
+      test_push_copy();
+      test_push_full();
+      test_pop_empty();
+      test_pop_move();
+      test_pushPop_wrap();
+      test_pushRange_partial();
+      test_popBulk_some();
+      test_threads_spsc();
+
+      // Many producers, many consumers
+      test_mpmc_pushPop();
+      test_mpmc_full();
+      test_mpmc_capacityOne();
+      test_mpmc_throw();
+      test_mpmc_destructor();
+      test_threads_mpmc();
+
+      report("RingBuffer");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // the capacity is rounded up to a power of two
+   void test_construct_roundUp()
+   {  // setup
+      Spy::reset();
+      // exercise
+      custom::ring_buffer<Spy> rb(10);
+      custom::mpmc_ring_buffer<Spy> rbMpmc(16);
+      // verify
+      assertUnit(Spy::numDefault() == 0);     // cells are not built up front
+      assertUnit(rb.capacity() == 16);
+      assertUnit(rb.mask == 15);
+      assertUnit(rb.empty());
+      assertUnit(rbMpmc.capacity() == 16);
+      assertUnit(rbMpmc.empty());
+   }
+
+   // the head and tail live on different cache lines
+   void test_construct_padded()
+   {  // setup
+      custom::ring_buffer<int> rb(4);
+      custom::mpmc_ring_buffer<int> rbMpmc(4);
+      // exercise
+      auto distance = (const char*)&rb.head - (const char*)&rb.tail;
+      auto distanceMpmc = (const char*)&rbMpmc.head - (const char*)&rbMpmc.tail;
+      // verify
+      assertUnit(distance >= (ptrdiff_t)custom::CACHE_LINE);
+      assertUnit(distanceMpmc >= (ptrdiff_t)custom::CACHE_LINE);
+      assertUnit((size_t)&rb.tail % custom::CACHE_LINE == 0);
+   }
+
+   // the destructor only destroys what is still in there
+   void test_destructor_partial()
+   {  // setup
+      {
+         custom::ring_buffer<Spy> rb(4);
+         rb.push(Spy(26));
+         rb.push(Spy(49));
+         rb.push(Spy(67));
+         Spy s;
+         rb.pop(s);
+         Spy::reset();
+      }  // exercise
+      // verify
+      assertUnit(Spy::numDestructor() == 3);  // [49][67] and s
+      assertUnit(Spy::numDelete() == 3);
+   }
+
+   /***************************************
+    * SINGLE PRODUCER, SINGLE CONSUMER
+    ***************************************/
+
+   // push a copy, nothing else is built
+   void test_push_copy()
+   {  // setup
+      custom::ring_buffer<Spy> rb(4);
+      Spy s26(26);
+      Spy::reset();
+      // exercise
+      bool pushed = rb.push(s26);
+      // verify
+      assertUnit(pushed);
+      assertUnit(Spy::numCopy() == 1);        // copy-create [26]
+      assertUnit(Spy::numAlloc() == 1);       // allocate [26]
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(rb.size() == 1);
+      assertUnit(rb.data[0] == Spy(26));
+   }  // teardown
+
+   // a full buffer refuses the push
+   void test_push_full()
+   {  // setup
+      custom::ring_buffer<int> rb(4);
+      for (int value : { 26, 49, 67, 89 })
+         rb.push(value);
+      // exercise
+      bool pushed = rb.push(99);
+      // verify
+      assertUnit(!pushed);
+      assertUnit(rb.size() == 4);
+      assertUnit(rb.tail == 4);
+   }  // teardown
+
+   // an empty buffer has nothing to pop
+   void test_pop_empty()
+   {  // setup
+      custom::ring_buffer<Spy> rb(4);
+      Spy s;
+      Spy::reset();
+      // exercise
+      bool popped = rb.pop(s);
+      // verify
+      assertUnit(!popped);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(s.empty());
+   }  // teardown
+
+   // pop moves the element out and destroys its cell
+   void test_pop_move()
+   {  // setup
+      custom::ring_buffer<Spy> rb(4);
+      rb.push(Spy(26));
+      rb.push(Spy(49));
+      Spy s;
+      Spy::reset();
+      // exercise
+      bool popped = rb.pop(s);
+      // verify
+      assertUnit(popped);
+      assertUnit(Spy::numAssignMove() == 1);  // move [26] out
+      assertUnit(Spy::numDestructor() == 1);  // the moved-from [26]
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(s == Spy(26));
+      assertUnit(rb.size() == 1);
+   }  // teardown
+
+   // ids keep counting up while the cells wrap around
+   void test_pushPop_wrap()
+   {  // setup
+      custom::ring_buffer<int> rb(4);
+      std::vector<int> values;
+      // exercise
+      for (int i = 0; i < 10; i++)
+      {
+         rb.push(i);
+         rb.push(i + 100);
+         int value;
+         rb.pop(value);
+         values.push_back(value);
+         rb.pop(value);
+         values.push_back(value);
+      }
+      // verify
+      assertUnit(rb.head == 20);
+      assertUnit(rb.tail == 20);
+      assertUnit(rb.iaFromID(rb.tail) == 0);
+      assertUnit(values.size() == 20);
+      assertUnit(values[18] == 9);
+      assertUnit(values[19] == 109);
+   }  // teardown
+
+   // only what fits of a range goes in
+   void test_pushRange_partial()
+   {  // setup
+      custom::ring_buffer<int> rb(4);
+      rb.push(11);
+      std::vector<int> v { 26, 49, 67, 89 };
+      // exercise
+      size_t num = rb.push(v.begin(), v.end());
+      // verify
+      assertUnit(num == 3);
+      assertUnit(rb.size() == 4);
+      assertUnit(rb.data[3] == 67);
+   }  // teardown
+
+   // pop three of the four in one go
+   void test_popBulk_some()
+   {  // setup
+      custom::ring_buffer<int> rb(4);
+      for (int value : { 26, 49, 67, 89 })
+         rb.push(value);
+      std::vector<int> values;
+      // exercise
+      size_t num = rb.pop(std::back_inserter(values), 3);
+      // verify
+      assertUnit(num == 3);
+      assertUnit(values == std::vector<int>({ 26, 49, 67 }));
+      assertUnit(rb.head == 3);
+      assertUnit(rb.size() == 1);
+   }  // teardown
+
+   // one producer, one consumer, everything arrives in order
+   void test_threads_spsc()
+   {  // setup
+      custom::ring_buffer<int> rb(64);
+      const int num = 100000;
+      int numOutOfOrder = 0;
+      long long sum = 0;
+      // exercise
+      std::thread producer([&rb]()
+      {
+         for (int i = 1; i <= num; )
+            if (rb.push(i))
+               i++;
+      });
+      std::thread consumer([&rb, &numOutOfOrder, &sum]()
+      {
+         int last = 0;
+         int batch[16];
+         while (last < num)
+         {
+            size_t numPopped = rb.pop(batch, 16);
+            for (size_t i = 0; i < numPopped; i++)
+            {
+               if (batch[i] != last + 1)
+                  numOutOfOrder++;
+               last = batch[i];
+               sum += batch[i];
+            }
+         }
+      });
+      producer.join();
+      consumer.join();
+      // verify
+      assertUnit(numOutOfOrder == 0);
+      assertUnit(sum == (long long)num * (num + 1) / 2);
+      assertUnit(rb.empty());
+   }  // teardown
+
+   /***************************************
+    * MANY PRODUCERS, MANY CONSUMERS
+    ***************************************/
+
+   // first in, first out, and the sequence numbers move a lap on
+   void test_mpmc_pushPop()
+   {  // setup
+      custom::mpmc_ring_buffer<Spy> rb(4);
+      rb.push(Spy(26));
+      rb.push(Spy(49));
+      Spy s;
+      Spy::reset();
+      // exercise
+      bool popped = rb.pop(s);
+      // verify
+      assertUnit(popped);
+      assertUnit(Spy::numAssignMove() == 1);  // move [26] out
+      assertUnit(Spy::numDestructor() == 1);  // the moved-from [26]
+      assertUnit(s == Spy(26));
+      assertUnit(rb.size() == 1);
+      assertUnit(rb.cells[0].sequence == 4);  // free for id 4
+      assertUnit(rb.cells[1].sequence == 2);  // holds id 1
+      assertUnit(rb.cells[2].sequence == 2);  // free for id 2
+   }  // teardown
+
+   // a full buffer refuses the push, an empty one the pop
+   void test_mpmc_full()
+   {  // setup
+      custom::mpmc_ring_buffer<int> rb(2);
+      rb.push(26);
+      rb.push(49);
+      int value = 0;
+      // exercise
+      bool pushed = rb.push(67);
+      rb.pop(value);
+      rb.pop(value);
+      bool popped = rb.pop(value);
+      // verify
+      assertUnit(!pushed);
+      assertUnit(!popped);
+      assertUnit(value == 49);
+      assertUnit(rb.empty());
+   }  // teardown
+
+   // one cell cannot tell "holds id" from "free for id + 1", so
+   // asking for one gets two
+   void test_mpmc_capacityOne()
+   {  // setup
+      custom::mpmc_ring_buffer<int> rb(1);
+      int value = 0;
+      // exercise
+      bool pushed26 = rb.push(26);
+      bool pushed49 = rb.push(49);
+      bool pushed67 = rb.push(67);
+      rb.pop(value);
+      // verify
+      assertUnit(rb.capacity() == 2);
+      assertUnit(pushed26);
+      assertUnit(pushed49);
+      assertUnit(!pushed67);
+      assertUnit(value == 26);
+      assertUnit(rb.size() == 1);
+   }  // teardown
+
+   // a copy that throws claims no cell, so the buffer keeps going
+   void test_mpmc_throw()
+   {  // setup
+      struct Fussy
+      {
+         int value;
+         Fussy(int value) : value(value) {}
+         Fussy(const Fussy& rhs) : value(rhs.value) { if (value < 0) throw value; }
+         Fussy(Fussy&& rhs) noexcept = default;
+         Fussy& operator = (Fussy&& rhs) noexcept = default;
+      };
+      custom::mpmc_ring_buffer<Fussy> rb(4);
+      Fussy bad(-1);
+      Fussy good(49);
+      Fussy value(0);
+      bool threw = false;
+      // exercise
+      rb.push(Fussy(26));
+      try
+      {
+         rb.push(bad);
+      }
+      catch (int)
+      {
+         threw = true;
+      }
+      rb.push(good);
+      // verify
+      assertUnit(threw);
+      assertUnit(rb.size() == 2);
+      assertUnit(rb.pop(value) && value.value == 26);
+      assertUnit(rb.pop(value) && value.value == 49);
+      assertUnit(rb.empty());
+   }  // teardown
+
+   // the destructor only destroys what is still in there
+   void test_mpmc_destructor()
+   {  // setup
+      {
+         custom::mpmc_ring_buffer<Spy> rb(4);
+         rb.push(Spy(26));
+         rb.push(Spy(49));
+         Spy::reset();
+      }  // exercise
+      // verify
+      assertUnit(Spy::numDestructor() == 2);  // [26][49]
+      assertUnit(Spy::numDelete() == 2);
+   }
+
+   // several producers and consumers lose nothing, and each
+   // producer's elements come out in the order they went in
+   void test_threads_mpmc()
+   {  // setup
+      custom::mpmc_ring_buffer<int> rb(64);
+      const int numThreads = 4;
+      const int numPerThread = 20000;
+      const int numTotal = numThreads * numPerThread;
+      std::atomic<int> numPopped(0);
+      std::vector<long long> sums(numThreads, 0);
+      std::vector<int> numOutOfOrder(numThreads, 0);
+      std::vector<std::thread> threads;
+      // exercise
+      for (int id = 0; id < numThreads; id++)
+         threads.push_back(std::thread([&rb, id]()
+         {
+            for (int i = 1; i <= numPerThread; )
+               if (rb.push(id * numPerThread + i))
+                  i++;
+         }));
+      for (int id = 0; id < numThreads; id++)
+         threads.push_back(std::thread([&, id]()
+         {
+            std::vector<int> last(numThreads, 0);
+            int value;
+            while (numPopped.load() < numTotal)
+               if (rb.pop(value))
+               {
+                  int producer = (value - 1) / numPerThread;
+                  int sequence = value - producer * numPerThread;
+                  if (sequence <= last[producer])
+                     numOutOfOrder[id]++;
+                  last[producer] = sequence;
+                  sums[id] += value;
+                  numPopped++;
+               }
+         }));
+      for (auto& thread : threads)
+         thread.join();
+      // verify
+      long long sum = 0;
+      int outOfOrder = 0;
+      for (int id = 0; id < numThreads; id++)
+      {
+         sum += sums[id];
+         outOfOrder += numOutOfOrder[id];
+      }
+      assertUnit(sum == (long long)numTotal * (numTotal + 1) / 2);
+      assertUnit(outOfOrder == 0);
+      assertUnit(rb.empty());
+   }  // teardown
+};
+
+#endif // DEBUG
@@ -236,9 +236,9 @@ namespace custom
       // 
       // Construct
       iterator() {}
-      iterator(const typename custom::vector<custom::list<T>>::iterator& itVectorEnd,
-         const typename custom::vector<custom::list<T>>::iterator& itVector,
-         const typename custom::list<T>::iterator& itList) :itVectorEnd(itVectorEnd), itVector(itVector), itList(itList) {
+      iterator(const typename custom::vector<custom::list<T, A>>::iterator& itVectorEnd,
+         const typename custom::vector<custom::list<T, A>>::iterator& itVector,
+         const typename custom::list<T, A>::iterator& itList) :itVectorEnd(itVectorEnd), itVector(itVector), itList(itList) {
       }
       iterator(const iterator& rhs) : itVectorEnd(rhs.itVectorEnd), itVector(rhs.itVector), itList(rhs.itList) {}
 
@@ -285,9 +285,9 @@ namespace custom
       }
 
    private:
-      typename vector<list<T>>::iterator itVectorEnd;
-      typename list<T>::iterator itList;
-      typename vector<list<T>>::iterator itVector;
+      typename vector<list<T, A>>::iterator itVectorEnd;
+      typename list<T, A>::iterator itList;
+      typename vector<list<T, A>>::iterator itVector;
    };
 
 
@@ -307,7 +307,7 @@ namespace custom
       // Construct
       //
       local_iterator() : itList() {}
-      local_iterator(const typename custom::list<T>::iterator& itList) : itList(itList) {}
+      local_iterator(const typename custom::list<T, A>::iterator& itList) : itList(itList) {}
       local_iterator(const local_iterator& rhs) : itList(rhs.itList) {}
 
       //
@@ -355,7 +355,7 @@ namespace custom
       }
 
    private:
-      typename list<T>::iterator itList;
+      typename list<T, A>::iterator itList;
    };
 
 
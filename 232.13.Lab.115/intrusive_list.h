@@ -0,0 +1,377 @@
+/***********************************************************************
+ * Header:
+ *    INTRUSIVE LIST
+ * Summary:
+ *    A doubly linked list that does not own its elements. The pNext and
+ *    pPrev pointers live in a hook inside the user's type, so inserting
+ *    and erasing never allocates, and an object with several hooks can
+ *    sit on several lists at once:
+ *
+ *       struct Page
+ *       {
+ *          custom::list_hook<Page> lru;
+ *          custom::list_hook<Page> dirty;
+ *       };
+ *       custom::intrusive_list<Page, &Page::lru>   lruList;
+ *       custom::intrusive_list<Page, &Page::dirty> dirtyList;
+ *
+ *    This will contain the class definition of:
+ *        list_hook                : The links an element carries
+ *        intrusive_list           : A list of elements linked by a hook
+ *        intrusive_list::iterator : An iterator through intrusive_list
+ *
+ *    The caller keeps each element alive while it is on a list, and an
+ *    element may only be on one list per hook.
+ * Author
+ *    David Schaad, Tori Tremelling
+ ************************************************************************/
+
+#pragma once
+#include <cassert>     // for ASSERT
+#include <cstddef>     // for size_t
+#include <utility>     // for std::swap
+
+class TestIntrusiveList; // forward declaration for unit tests
+
+namespace custom
+{
+
+   /**************************************************
+    * LIST HOOK
+    * The links of one list, embedded in the element
+    **************************************************/
+   template <typename T>
+   class list_hook
+   {
+   public:
+      list_hook() : pNext(nullptr), pPrev(nullptr) {}
+
+      // copying an element does not put the copy on its lists
+      list_hook(const list_hook&) : pNext(nullptr), pPrev(nullptr) {}
+      list_hook& operator = (const list_hook&) { return *this; }
+
+      T* pNext;          // pointer to next element
+      T* pPrev;          // pointer to previous element
+   };
+
+   /**************************************************
+    * INTRUSIVE LIST
+    * Just like list, but the elements are the user's
+    * and the links live in the Hook member of T
+    **************************************************/
+   template <typename T, list_hook<T> T::* Hook>
+   class intrusive_list
+   {
+      friend class ::TestIntrusiveList; // give unit tests access to the privates
+   public:
+
+      //
+      // Construct
+      //
+
+      intrusive_list() : numElements(0), pHead(nullptr), pTail(nullptr) {}
+      intrusive_list(const intrusive_list& rhs) = delete;
+      intrusive_list(intrusive_list&& rhs) : numElements(rhs.numElements), pHead(rhs.pHead), pTail(rhs.pTail)
+      {
+         rhs.pHead = rhs.pTail = nullptr;
+         rhs.numElements = 0;
+      }
+      ~intrusive_list()
+      {
+         clear();
+      }
+
+      //
+      // Assign
+      //
+
+      intrusive_list& operator = (const intrusive_list& rhs) = delete;
+      intrusive_list& operator = (intrusive_list&& rhs)
+      {
+         clear();
+         swap(rhs);
+         return *this;
+      }
+      void swap(intrusive_list& rhs)
+      {
+         std::swap(rhs.pHead, pHead);
+         std::swap(rhs.pTail, pTail);
+         std::swap(rhs.numElements, numElements);
+      }
+
+      //
+      // Iterator
+      //
+
+      class iterator;
+      iterator begin() const  { return iterator(pHead); }
+      iterator rbegin() const { return iterator(pTail); }
+      iterator end() const    { return iterator(nullptr); }
+
+      //
+      // Access
+      //
+
+      T& front();
+      T& back();
+
+      //
+      // Insert
+      //
+
+      void push_front(T& t) { link(pHead, &t); }
+      void push_back(T& t)  { link(nullptr, &t); }
+      iterator insert(iterator it, T& t)
+      {
+         link(it.p, &t);
+         return iterator(&t);
+      }
+
+      //
+      // Remove
+      //
+
+      void pop_back()  { if (pTail) unlink(pTail); }
+      void pop_front() { if (pHead) unlink(pHead); }
+      void clear();
+      iterator erase(const iterator& it);
+      void erase(T& t) { unlink(&t); }
+
+      //
+      // Status
+      //
+
+      bool empty()  const { return !pHead; }
+      size_t size() const { return numElements; }
+
+      // is t on this list? Its neighbors, or our ends, point back at it
+      bool isLinked(const T& t) const;
+
+   private:
+      static list_hook<T>& hook(T* p) { return p->*Hook; }
+
+      void link(T* pPos, T* pNew);
+      void unlink(T* pRemove);
+
+      // member variables
+      size_t numElements; // number of elements on the list
+      T* pHead;           // pointer to the first element
+      T* pTail;           // pointer to the last element
+   };
+
+   /*************************************************
+    * INTRUSIVE LIST ITERATOR
+    * Iterate through an intrusive list
+    ************************************************/
+   template <typename T, list_hook<T> T::* Hook>
+   class intrusive_list <T, Hook> ::iterator
+   {
+      friend class ::TestIntrusiveList; // give unit tests access to the privates
+      friend class intrusive_list <T, Hook>;
+
+   public:
+      // constructors, destructors, and assignment operator
+      iterator() : p(nullptr) {}
+      iterator(T* pRHS) : p(pRHS) {}
+      iterator(const iterator& rhs) : p(rhs.p) {}
+
+      iterator& operator = (const iterator& rhs)
+      {
+         p = rhs.p;
+         return *this;
+      }
+
+      // equals, not equals operator
+      bool operator == (const iterator& rhs) const { return p == rhs.p; }
+      bool operator != (const iterator& rhs) const { return p != rhs.p; }
+
+      // dereference operator, fetch an element
+      T& operator * ()  { return *p; }
+      T* operator -> () { return p; }
+
+      // postfix increment
+      iterator operator ++ (int postfix)
+      {
+         iterator tmp = *this;
+         ++(*this);
+         return tmp;
+      }
+
+      // prefix increment
+      iterator& operator ++ ()
+      {
+         p = hook(p).pNext;
+         return *this;
+      }
+
+      // postfix decrement
+      iterator operator -- (int postfix)
+      {
+         iterator tmp = *this;
+         --(*this);
+         return tmp;
+      }
+
+      // prefix decrement
+      iterator& operator -- ()
+      {
+         p = hook(p).pPrev;
+         return *this;
+      }
+
+   private:
+
+      T* p;
+   };
+
+   /**********************************************
+    * INTRUSIVE LIST :: CLEAR
+    * Take every element off the list. The elements
+    * themselves are left alone
+    *     COST   : O(n)
+    *********************************************/
+   template <typename T, list_hook<T> T::* Hook>
+   void intrusive_list <T, Hook> ::clear()
+   {
+      T* p = pHead;
+      while (p != nullptr)
+      {
+         T* pNext = hook(p).pNext;
+         hook(p).pNext = hook(p).pPrev = nullptr;
+         p = pNext;
+      }
+      pHead = pTail = nullptr;
+      numElements = 0;
+   }
+
+   /*********************************************
+    * INTRUSIVE LIST :: FRONT
+    * retrieves the first element in the list
+    *     COST   : O(1)
+    *********************************************/
+   template <typename T, list_hook<T> T::* Hook>
+   T& intrusive_list <T, Hook> ::front()
+   {
+      if (!empty())
+         return *pHead;
+      throw("ERROR: unable to access data from an empty list");
+   }
+
+   /*********************************************
+    * INTRUSIVE LIST :: BACK
+    * retrieves the last element in the list
+    *     COST   : O(1)
+    *********************************************/
+   template <typename T, list_hook<T> T::* Hook>
+   T& intrusive_list <T, Hook> ::back()
+   {
+      if (!empty())
+         return *pTail;
+      throw("ERROR: unable to access data from an empty list");
+   }
+
+   /******************************************
+    * INTRUSIVE LIST :: ERASE
+    * take an element off the list
+    *     INPUT  : an iterator to the element being removed
+    *     OUTPUT : iterator to the element after it
+    *     COST   : O(1)
+    ******************************************/
+   template <typename T, list_hook<T> T::* Hook>
+   typename intrusive_list <T, Hook> ::iterator intrusive_list <T, Hook> ::erase(const iterator& it)
+   {
+      if (it == end())
+         return end();
+
+      T* pNext = hook(it.p).pNext;
+      unlink(it.p);
+      return iterator(pNext);
+   }
+
+   /******************************************
+    * INTRUSIVE LIST :: LINK
+    * put an element in front of pPos, or on the end
+    * if pPos is nullptr
+    *     INPUT  : where it goes, and the element
+    *     COST   : O(1)
+    ******************************************/
+   template <typename T, list_hook<T> T::* Hook>
+   void intrusive_list <T, Hook> ::link(T* pPos, T* pNew)
+   {
+      assert(hook(pNew).pNext == nullptr && hook(pNew).pPrev == nullptr && pHead != pNew);
+
+      T* pPrev = pPos ? hook(pPos).pPrev : pTail;
+      hook(pNew).pPrev = pPrev;
+      hook(pNew).pNext = pPos;
+
+      if (pPrev)
+         hook(pPrev).pNext = pNew;
+      else
+         pHead = pNew;
+
+      if (pPos)
+         hook(pPos).pPrev = pNew;
+      else
+         pTail = pNew;
+
+      numElements++;
+   }
+
+   /******************************************
+    * INTRUSIVE LIST :: UNLINK
+    * take an element off the list and clear its hook
+    *     INPUT  : the element
+    *     COST   : O(1)
+    ******************************************/
+   template <typename T, list_hook<T> T::* Hook>
+   void intrusive_list <T, Hook> ::unlink(T* pRemove)
+   {
+      assert(isLinked(*pRemove));
+
+      T* pNext = hook(pRemove).pNext;
+      T* pPrev = hook(pRemove).pPrev;
+
+      if (pNext)
+         hook(pNext).pPrev = pPrev;
+      else
+         pTail = pPrev;
+
+      if (pPrev)
+         hook(pPrev).pNext = pNext;
+      else
+         pHead = pNext;
+
+      hook(pRemove).pNext = hook(pRemove).pPrev = nullptr;
+      numElements--;
+   }
+
+   /******************************************
+    * INTRUSIVE LIST :: IS LINKED
+    * An element on this list is pointed to by the
+    * elements on either side of it, or by pHead and
+    * pTail when it is at an end. One that is on no
+    * list has empty links, so it fails both
+    *     INPUT  : the element
+    *     OUTPUT : true if it is on this list
+    *     COST   : O(1)
+    ******************************************/
+   template <typename T, list_hook<T> T::* Hook>
+   bool intrusive_list <T, Hook> ::isLinked(const T& t) const
+   {
+      const list_hook<T>& links = t.*Hook;
+      bool isFrontOk = links.pPrev ? (links.pPrev->*Hook).pNext == &t : pHead == &t;
+      bool isBackOk  = links.pNext ? (links.pNext->*Hook).pPrev == &t : pTail == &t;
+      return isFrontOk && isBackOk;
+   }
+
+   /**********************************************
+    * SWAP
+    * Swap two intrusive lists
+    *********************************************/
+   template <typename T, list_hook<T> T::* Hook>
+   void swap(intrusive_list <T, Hook>& lhs, intrusive_list <T, Hook>& rhs)
+   {
+      lhs.swap(rhs);
+   }
+
+}; // namespace custom
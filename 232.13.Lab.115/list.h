@@ -22,6 +22,8 @@
 #include <iostream>    // for nullptr
 #include <new>         // std::bad_alloc
 #include <memory>      // for std::allocator
+#include <functional>  // for std::less
+#include <utility>     // for std::forward and std::piecewise_construct
 
 class TestList; // forward declaration for unit tests
 class TestHash; // forward declaration for hash used later
@@ -45,8 +47,8 @@ namespace custom
       // Construct
       //
 
-      list(const A& a = A()) : numElements(0), pHead(nullptr), pTail(nullptr) {}
-      list(const list <T, A>& rhs, const A& a = A()) : numElements(0), pHead(nullptr), pTail(nullptr), alloc(a)
+      list(const A& a = A()) : alloc(a), numElements(0), pHead(nullptr), pTail(nullptr) {}
+      list(const list <T, A>& rhs, const A& a = A()) : alloc(a), numElements(0), pHead(nullptr), pTail(nullptr)
       {
          for (const auto& item : rhs)
             push_back(item);
@@ -54,13 +56,13 @@ namespace custom
       list(list <T, A>&& rhs, const A& a = A());
       list(size_t num, const T& t, const A& a = A());
       list(size_t num, const A& a = A());
-      list(const std::initializer_list<T>& il, const A& a = A()) : numElements(0), pHead(nullptr), pTail(nullptr), alloc(a)
+      list(const std::initializer_list<T>& il, const A& a = A()) : alloc(a), numElements(0), pHead(nullptr), pTail(nullptr)
       {
          for (const auto& item : il)
             push_back(item);
       }
       template <class Iterator>
-      list(Iterator first, Iterator last, const A& a = A()) : numElements(0), pHead(nullptr), pTail(nullptr), alloc(a)
+      list(Iterator first, Iterator last, const A& a = A()) : alloc(a), numElements(0), pHead(nullptr), pTail(nullptr)
       {
          for (auto it = first; it != last; ++it)
             push_back(*it);
@@ -122,6 +124,12 @@ namespace custom
       void push_back(T&& data);
       iterator insert(iterator it, const T& data);
       iterator insert(iterator it, T&& data);
+      template <class ... Args>
+      T& emplace_front(Args&& ... args);
+      template <class ... Args>
+      T& emplace_back(Args&& ... args);
+      template <class ... Args>
+      iterator emplace(iterator it, Args&& ... args);
 
       //
       // Remove
@@ -132,6 +140,20 @@ namespace custom
       void clear();
       iterator erase(const iterator& it);
 
+      //
+      // Splice and Sort
+      //
+
+      void splice(iterator pos, list <T, A>& rhs);
+      void splice(iterator pos, list <T, A>& rhs, iterator it);
+      void splice(iterator pos, list <T, A>& rhs, iterator first, iterator last);
+      void merge(list <T, A>& rhs) { merge(rhs, std::less<T>()); }
+      template <class Compare>
+      void merge(list <T, A>& rhs, Compare comp);
+      void sort() { sort(std::less<T>()); }
+      template <class Compare>
+      void sort(Compare comp);
+
       //
       // Status
       //
@@ -143,8 +165,20 @@ namespace custom
       // nested linked list class
       class Node;
 
+      // the allocator, rebound to hand out whole nodes
+      using NodeAlloc  = typename std::allocator_traits<A>::template rebind_alloc<Node>;
+      using NodeTraits = std::allocator_traits<NodeAlloc>;
+
+      template <class ... Args>
+      Node* allocate(Args&& ... args);
+      void deallocate(Node* p);
+
+      // move a chain of nodes without touching their data
+      static void unlink(list <T, A>& owner, Node* pFirst, Node* pLast);
+      void link(Node* pPos, Node* pFirst, Node* pLast);
+
       // member variables
-      A    alloc;         // use alloacator for memory allocation
+      NodeAlloc alloc;    // use allocator for memory allocation
       size_t numElements; // though we could count, it is faster to keep a variable
       Node* pHead;       // pointer to the beginning of the list
       Node* pTail;       // pointer to the ending of the list
@@ -170,6 +204,10 @@ namespace custom
 
       Node(T&& data) : data(std::move(data)), pNext(nullptr), pPrev(nullptr) {}
 
+      template <class ... Args>
+      Node(std::piecewise_construct_t, Args&& ... args) :
+         data(std::forward<Args>(args)...), pNext(nullptr), pPrev(nullptr) {}
+
       //
       // Member Variables
       //
@@ -258,7 +296,7 @@ namespace custom
     * Create a list initialized to a value
     ****************************************/
    template <typename T, typename A>
-   list <T, A> ::list(size_t num, const T& t, const A& a) : numElements(0), pHead(nullptr), pTail(nullptr), alloc(a)
+   list <T, A> ::list(size_t num, const T& t, const A& a) : alloc(a), numElements(0), pHead(nullptr), pTail(nullptr)
    {
       for (size_t i = 0; i < num; i++)
          push_back(t);
@@ -269,12 +307,12 @@ namespace custom
     * Create a list initialized to a value
     ****************************************/
    template <typename T, typename A>
-   list <T, A> ::list(size_t num, const A& a) : numElements(0), pHead(nullptr), pTail(nullptr)
+   list <T, A> ::list(size_t num, const A& a) : alloc(a), numElements(0), pHead(nullptr), pTail(nullptr)
    {
       for (size_t i = 0; i < num; ++i)
       {
          // Initialize each node
-         Node* pNew = new Node();
+         Node* pNew = allocate();
 
          pNew->pPrev = pTail;
          pNew->pNext = nullptr;
@@ -292,11 +330,13 @@ namespace custom
 
    /*****************************************
     * LIST :: MOVE constructors
-    * Steal the values from the RHS
+    * Steal the values from the RHS. The nodes came from
+    * the RHS allocator, so we take that one too and the
+    * allocator passed in goes unused
     ****************************************/
    template <typename T, typename A>
-   list <T, A> ::list(list <T, A>&& rhs, const A& a) :
-      numElements(rhs.numElements), pHead(rhs.pHead), pTail(rhs.pTail), alloc(a)
+   list <T, A> ::list(list <T, A>&& rhs, const A& /* a */) :
+      alloc(rhs.alloc), numElements(rhs.numElements), pHead(rhs.pHead), pTail(rhs.pTail)
    {
       rhs.pHead = rhs.pTail = nullptr;
       rhs.numElements = 0;
@@ -407,7 +447,7 @@ namespace custom
       while (p != nullptr)
       {
          Node* pNext = p->pNext;
-         delete p;
+         deallocate(p);
          p = pNext;
       }
       pHead = pTail = nullptr;
@@ -425,7 +465,7 @@ namespace custom
    void list <T, A> ::push_back(const T& data)
    {
       // Pass 'data' to the constructor to copy it
-      Node* pNew = new Node(data);
+      Node* pNew = allocate(data);
 
       pNew->pPrev = pTail;
       pNew->pNext = nullptr;
@@ -444,7 +484,7 @@ namespace custom
    void list <T, A> ::push_back(T&& data)
    {
       // Use std::move to pass 'data' to the constructor
-      Node* pNew = new Node(std::move(data));
+      Node* pNew = allocate(std::move(data));
 
       pNew->pPrev = pTail;
       pNew->pNext = nullptr;
@@ -470,7 +510,7 @@ namespace custom
    void list <T, A> ::push_front(const T& data)
    {
       // Pass 'data' to the constructor to copy it
-      Node* pNew = new Node(data);
+      Node* pNew = allocate(data);
 
       pNew->pNext = pHead;
       pNew->pPrev = nullptr;
@@ -489,7 +529,7 @@ namespace custom
    void list <T, A> ::push_front(T&& data)
    {
       // Use std::move to pass 'data' to the constructor
-      Node* pNew = new Node(std::move(data));
+      Node* pNew = allocate(std::move(data));
 
       pNew->pNext = pHead;
       pNew->pPrev = nullptr;
@@ -529,7 +569,7 @@ namespace custom
       else
          pHead = nullptr;
 
-      delete pRemove;
+      deallocate(pRemove);
       numElements--;
    }
 
@@ -557,7 +597,7 @@ namespace custom
       else
          pTail = nullptr;
 
-      delete pRemove;
+      deallocate(pRemove);
       numElements--;
    }
 
@@ -625,7 +665,7 @@ namespace custom
       else
          pHead = pNext;
 
-      delete pDelete;
+      deallocate(pDelete);
       numElements--;
 
       // Return an iterator to the next node in the list
@@ -663,7 +703,7 @@ namespace custom
       Node* pPrev = pNext->pPrev;
 
       // Creating the new Node
-      Node* pNew = new Node(data);
+      Node* pNew = allocate(data);
 
       // Connect pNew to the list nodes first
       pNew->pNext = pNext;
@@ -709,7 +749,7 @@ namespace custom
       Node* pPrev = pNext->pPrev;
 
       // Creating the new Node
-      Node* pNew = new Node(std::move(data));
+      Node* pNew = allocate(std::move(data));
 
       // Connect pNew to the list nodes first
       pNew->pNext = pNext;
@@ -723,12 +763,336 @@ namespace custom
       return iterator(pNew);
    }
 
-   /**********************************************
-    * LIST :: assignment operator - MOVE
-    * Copy one list onto another
-    *     INPUT  : a list to be moved
+   /*********************************************
+    * LIST :: EMPLACE FRONT
+    * build an item at the head of the list
+    *     INPUT  : what to build the item from
+    *     OUTPUT : the new item
+    *     COST   : O(1)
+    *********************************************/
+   template <typename T, typename A>
+   template <class ... Args>
+   T& list <T, A> ::emplace_front(Args&& ... args)
+   {
+      Node* pNew = allocate(std::piecewise_construct, std::forward<Args>(args)...);
+      link(pHead, pNew, pNew);
+      numElements++;
+      return pNew->data;
+   }
+
+   /*********************************************
+    * LIST :: EMPLACE BACK
+    * build an item at the end of the list
+    *     INPUT  : what to build the item from
+    *     OUTPUT : the new item
+    *     COST   : O(1)
+    *********************************************/
+   template <typename T, typename A>
+   template <class ... Args>
+   T& list <T, A> ::emplace_back(Args&& ... args)
+   {
+      Node* pNew = allocate(std::piecewise_construct, std::forward<Args>(args)...);
+      link(nullptr, pNew, pNew);
+      numElements++;
+      return pNew->data;
+   }
+
+   /******************************************
+    * LIST :: EMPLACE
+    * build an item in the middle of the list
+    *     INPUT  : where the item goes, in front of it
+    *              what to build the item from
+    *     OUTPUT : iterator to the new item
+    *     COST   : O(1)
+    ******************************************/
+   template <typename T, typename A>
+   template <class ... Args>
+   typename list <T, A> ::iterator list <T, A> ::emplace(iterator it, Args&& ... args)
+   {
+      Node* pNew = allocate(std::piecewise_construct, std::forward<Args>(args)...);
+      link(it.p, pNew, pNew);
+      numElements++;
+      return iterator(pNew);
+   }
+
+   /******************************************
+    * LIST :: SPLICE
+    * move every node of rhs in front of pos
+    *     INPUT  : where they go and where they come from
     *     OUTPUT :
-    *     COST   : O(n) with respect to the size of the LHS
+    *     COST   : O(1)
+    ******************************************/
+   template <typename T, typename A>
+   void list <T, A> ::splice(iterator pos, list <T, A>& rhs)
+   {
+      if (&rhs == this || rhs.empty())
+         return;
+
+      Node* pFirst = rhs.pHead;
+      Node* pLast = rhs.pTail;
+      numElements += rhs.numElements;
+      rhs.pHead = rhs.pTail = nullptr;
+      rhs.numElements = 0;
+
+      link(pos.p, pFirst, pLast);
+   }
+
+   /******************************************
+    * LIST :: SPLICE
+    * move the node at it in front of pos. rhs may
+    * be this list
+    *     INPUT  : where it goes and where it comes from
+    *     OUTPUT :
+    *     COST   : O(1)
+    ******************************************/
+   template <typename T, typename A>
+   void list <T, A> ::splice(iterator pos, list <T, A>& rhs, iterator it)
+   {
+      // Nothing to move, or it is already in front of pos
+      if (it == rhs.end() || pos == it || pos.p == it.p->pNext)
+         return;
+
+      unlink(rhs, it.p, it.p);
+      rhs.numElements--;
+      link(pos.p, it.p, it.p);
+      numElements++;
+   }
+
+   /******************************************
+    * LIST :: SPLICE
+    * move the nodes [first, last) in front of pos.
+    * rhs may be this list, but pos may not be in the range
+    *     INPUT  : where they go and where they come from
+    *     OUTPUT :
+    *     COST   : O(1) within a list. From another list
+    *              the range is counted to keep size() O(1)
+    ******************************************/
+   template <typename T, typename A>
+   void list <T, A> ::splice(iterator pos, list <T, A>& rhs, iterator first, iterator last)
+   {
+      if (first == last)
+         return;
+
+      Node* pFirst = first.p;
+      Node* pLast = last.p ? last.p->pPrev : rhs.pTail;
+
+      if (&rhs != this)
+      {
+         size_t num = 1;
+         for (Node* p = pFirst; p != pLast; p = p->pNext)
+            num++;
+         rhs.numElements -= num;
+         numElements += num;
+      }
+      else if (pos == last)
+         return;
+
+      unlink(rhs, pFirst, pLast);
+      link(pos.p, pFirst, pLast);
+   }
+
+   /******************************************
+    * LIST :: MERGE
+    * move every node of the sorted rhs into this
+    * sorted list, keeping it sorted. Equal elements
+    * from this list stay in front of those from rhs
+    *     INPUT  : the list to empty into this one
+    *              the ordering both lists are sorted by
+    *     OUTPUT :
+    *     COST   : O(n + m)
+    ******************************************/
+   template <typename T, typename A>
+   template <class Compare>
+   void list <T, A> ::merge(list <T, A>& rhs, Compare comp)
+   {
+      if (&rhs == this)
+         return;
+
+      Node* p = pHead;
+      Node* q = rhs.pHead;
+      while (p && q)
+      {
+         if (comp(q->data, p->data))
+         {
+            Node* pNext = q->pNext;
+            link(p, q, q);
+            q = pNext;
+         }
+         else
+            p = p->pNext;
+      }
+
+      // Whatever is left in rhs goes on the end
+      if (q)
+         link(nullptr, q, rhs.pTail);
+
+      numElements += rhs.numElements;
+      rhs.pHead = rhs.pTail = nullptr;
+      rhs.numElements = 0;
+   }
+
+   /******************************************
+    * LIST :: SORT
+    * stable bottom-up merge sort. Runs of width 1, 2,
+    * 4, ... are merged pairwise by relinking nodes, so
+    * nothing is allocated and no element is copied
+    *     INPUT  : the ordering to sort by
+    *     OUTPUT :
+    *     COST   : O(n log n)
+    ******************************************/
+   template <typename T, typename A>
+   template <class Compare>
+   void list <T, A> ::sort(Compare comp)
+   {
+      if (numElements < 2)
+         return;
+
+      for (size_t width = 1; ; width *= 2)
+      {
+         Node* p = pHead;
+         Node* pNewHead = nullptr;
+         Node* pNewTail = nullptr;
+         size_t numMerges = 0;
+
+         while (p)
+         {
+            // p starts a run of up to width nodes, q the run after it
+            numMerges++;
+            Node* q = p;
+            size_t numP = 0;
+            while (numP < width && q)
+            {
+               numP++;
+               q = q->pNext;
+            }
+            size_t numQ = width;
+
+            // Merge the two runs onto the end of the new chain
+            while (numP > 0 || (numQ > 0 && q))
+            {
+               Node* pTake;
+               if (numP == 0 || (numQ > 0 && q && comp(q->data, p->data)))
+               {
+                  pTake = q;
+                  q = q->pNext;
+                  numQ--;
+               }
+               else
+               {
+                  pTake = p;
+                  p = p->pNext;
+                  numP--;
+               }
+
+               pTake->pPrev = pNewTail;
+               if (pNewTail)
+                  pNewTail->pNext = pTake;
+               else
+                  pNewHead = pTake;
+               pNewTail = pTake;
+            }
+            p = q;
+         }
+         pNewTail->pNext = nullptr;
+         pHead = pNewHead;
+         pTail = pNewTail;
+
+         // One merge means one run: we are done
+         if (numMerges <= 1)
+            return;
+      }
+   }
+
+   /******************************************
+    * LIST :: UNLINK
+    * take the chain pFirst ... pLast out of owner,
+    * leaving the chain's own links alone
+    *     INPUT  : the list holding the chain, and the chain
+    *     OUTPUT :
+    *     COST   : O(1)
+    ******************************************/
+   template <typename T, typename A>
+   void list <T, A> ::unlink(list <T, A>& owner, Node* pFirst, Node* pLast)
+   {
+      if (pFirst->pPrev)
+         pFirst->pPrev->pNext = pLast->pNext;
+      else
+         owner.pHead = pLast->pNext;
+
+      if (pLast->pNext)
+         pLast->pNext->pPrev = pFirst->pPrev;
+      else
+         owner.pTail = pFirst->pPrev;
+   }
+
+   /******************************************
+    * LIST :: LINK
+    * put the chain pFirst ... pLast in front of pPos,
+    * or on the end if pPos is nullptr
+    *     INPUT  : where the chain goes, and the chain
+    *     OUTPUT :
+    *     COST   : O(1)
+    ******************************************/
+   template <typename T, typename A>
+   void list <T, A> ::link(Node* pPos, Node* pFirst, Node* pLast)
+   {
+      Node* pPrev = pPos ? pPos->pPrev : pTail;
+
+      pFirst->pPrev = pPrev;
+      pLast->pNext = pPos;
+
+      if (pPrev)
+         pPrev->pNext = pFirst;
+      else
+         pHead = pFirst;
+
+      if (pPos)
+         pPos->pPrev = pLast;
+      else
+         pTail = pLast;
+   }
+
+   /******************************************
+    * LIST :: ALLOCATE
+    * Get a node from the allocator and build it
+    *     INPUT  : what to build the node's data from
+    *     OUTPUT : the new node
+    *     COST   : O(1)
+    ******************************************/
+   template <typename T, typename A>
+   template <class ... Args>
+   typename list <T, A> ::Node* list <T, A> ::allocate(Args&& ... args)
+   {
+      Node* pNew = NodeTraits::allocate(alloc, 1);
+      try
+      {
+         NodeTraits::construct(alloc, pNew, std::forward<Args>(args)...);
+      }
+      catch (...)
+      {
+         NodeTraits::deallocate(alloc, pNew, 1);
+         throw;
+      }
+      return pNew;
+   }
+
+   /******************************************
+    * LIST :: DEALLOCATE
+    * Destroy a node and give it back to the allocator
+    *     INPUT  : the node, already unlinked
+    *     OUTPUT :
+    *     COST   : O(1)
+    ******************************************/
+   template <typename T, typename A>
+   void list <T, A> ::deallocate(Node* p)
+   {
+      NodeTraits::destroy(alloc, p);
+      NodeTraits::deallocate(alloc, p, 1);
+   }
+
+   /**********************************************
+    * SWAP
+    * Swap two lists
     *********************************************/
    template <typename T, typename A>
    void swap(list <T, A>& lhs, list <T, A>& rhs)
@@ -0,0 +1,422 @@
+/***********************************************************************
+ * Module:
+ *    Lock-Free Queue
+ * Summary:
+ *    A concurrent queue that many threads can push onto and pop from
+ *    without a mutex (a Michael-Scott queue)
+ *
+ *    This will contain the class definition of:
+ *       lockfree_queue    : thread-safe First-in-First-out container
+ *
+ *    The nodes are linked front to back just like list. The front node
+ *    is always a dummy: the first element lives in the node after it.
+ *    Producers link new nodes after the tail, consumers move the head
+ *    forward. The head, the tail and every pNext are tagged pointers: the
+ *    node address lives in the low bits of a 64-bit word and a
+ *    modification counter in the high bits, so a node that is recycled
+ *    between our read and our CAS (the ABA problem) will not fool us.
+ *
+ *    A node is recycled only after it has both stopped being the dummy
+ *    and had its element taken, which may happen on two different
+ *    threads in either order. Recycled nodes go to an internal free list
+ *    and are never handed back to the heap while the queue is alive.
+ * Author
+ *    David Schaad, Tori Tremelling
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>  // because I am paranoid
+#include <atomic>   // for std::atomic
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint64_t and uintptr_t
+#include <new>      // for placement new
+#include <utility>  // for std::move
+
+class TestLockFreeQueue; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * LOCK-FREE QUEUE
+ * First-in-First-out data structure, safe to share
+ * between any number of producers and consumers
+ *************************************************/
+template<class T>
+class lockfree_queue
+{
+   friend class ::TestLockFreeQueue; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   lockfree_queue();
+   lockfree_queue(const lockfree_queue <T> & rhs) = delete;
+   lockfree_queue <T> & operator = (const lockfree_queue <T> & rhs) = delete;
+   ~lockfree_queue();
+
+   //
+   // Insert
+   //
+
+   void push(const T& t)  { pushChain(allocate(t), nullptr); }
+   void push(T&& t)       { pushChain(allocate(std::move(t)), nullptr); }
+   template <class Iterator>
+   void push(Iterator first, Iterator last);
+
+   //
+   // Remove
+   //
+
+   bool pop(T& t)         { return pop(&t, 1) == 1; }
+   template <class OutputIterator>
+   size_t pop(OutputIterator out, size_t num);
+
+   //
+   // Status
+   //
+   size_t size () const { return numElements.load(std::memory_order_relaxed); }
+   bool empty   () const;
+
+private:
+
+   struct Node
+   {
+      alignas(T) unsigned char storage[sizeof(T)]; // the user data, built in place
+      std::atomic<uint64_t> pNext;                 // tagged pointer to the next node
+      std::atomic<int> numHolds;                   // who still needs the node
+      std::atomic<Node*> pFree;                    // next node on the free list
+
+      T& data() { return *reinterpret_cast<T*>(storage); }
+   };
+
+   // where the tag starts within a tagged pointer
+   static constexpr int TAG_SHIFT = (sizeof(void*) == 8 ? 48 : 32);
+   static constexpr uint64_t PTR_MASK = ((uint64_t)1 << TAG_SHIFT) - 1;
+
+   static Node* ptrOf(uint64_t tagged) { return reinterpret_cast<Node*>((uintptr_t)(tagged & PTR_MASK)); }
+   static uint64_t tagOf(uint64_t tagged) { return tagged >> TAG_SHIFT; }
+   static uint64_t pack(Node* p, uint64_t tag)
+   {
+      assert(((uint64_t)reinterpret_cast<uintptr_t>(p) & ~PTR_MASK) == 0);
+      return (uint64_t)reinterpret_cast<uintptr_t>(p) | (tag << TAG_SHIFT);
+   }
+
+   Node* allocate();
+   template <class U>
+   Node* allocate(U&& u);
+   void release(Node* pNode);
+   void pushChain(Node* pFirst, Node* pLast);
+
+   std::atomic<uint64_t> head;        // tagged pointer to the dummy node
+   std::atomic<uint64_t> tail;        // tagged pointer to the last node, or one just before it
+   std::atomic<uint64_t> freeList;    // tagged pointer to the recycled nodes
+   std::atomic<size_t>   numElements; // number of elements in the queue
+};
+
+/*****************************************************
+ * LOCK-FREE QUEUE :: CONSTRUCTOR
+ * An empty queue is just the dummy node
+ ****************************************************/
+template <class T>
+lockfree_queue <T> :: lockfree_queue() : freeList(0), numElements(0)
+{
+   Node* pDummy = allocate();
+   pDummy->numHolds.store(1, std::memory_order_relaxed);  // only the head holds it
+   head.store(pack(pDummy, 0), std::memory_order_relaxed);
+   tail.store(pack(pDummy, 0), std::memory_order_relaxed);
+}
+
+/*****************************************************
+ * LOCK-FREE QUEUE :: DESTRUCTOR
+ * Only one thread may be using the queue now, so we can
+ * walk both chains and hand the nodes back to the heap
+ ****************************************************/
+template <class T>
+lockfree_queue <T> :: ~lockfree_queue()
+{
+   Node* p = ptrOf(head.load());
+   Node* pNext = ptrOf(p->pNext.load(std::memory_order_relaxed));
+   delete p;   // the dummy has no data
+   for (p = pNext; p; p = pNext)
+   {
+      pNext = ptrOf(p->pNext.load(std::memory_order_relaxed));
+      p->data().~T();
+      delete p;
+   }
+
+   for (p = ptrOf(freeList.load()); p; p = pNext)
+   {
+      pNext = p->pFree.load(std::memory_order_relaxed);
+      delete p;
+   }
+}
+
+/*****************************************************
+ * LOCK-FREE QUEUE :: EMPTY
+ * Is there a node after the dummy?
+ ****************************************************/
+template <class T>
+bool lockfree_queue <T> ::empty() const
+{
+   for (;;)
+   {
+      uint64_t oldHead = head.load(std::memory_order_acquire);
+      uint64_t next = ptrOf(oldHead)->pNext.load(std::memory_order_acquire);
+      if (oldHead == head.load(std::memory_order_acquire))
+         return ptrOf(next) == nullptr;
+   }
+}
+
+/*****************************************************
+ * LOCK-FREE QUEUE :: ALLOCATE
+ * Grab a recycled node if there is one, otherwise go
+ * to the heap. Its pNext keeps counting up from where
+ * it was so stale readers cannot be fooled
+ ****************************************************/
+template <class T>
+typename lockfree_queue <T> ::Node* lockfree_queue <T> ::allocate()
+{
+   uint64_t oldTop = freeList.load(std::memory_order_acquire);
+   Node* pNode;
+   do
+   {
+      pNode = ptrOf(oldTop);
+      if (!pNode)
+      {
+         pNode = new Node;
+         pNode->pNext.store(0, std::memory_order_relaxed);
+         pNode->pFree.store(nullptr, std::memory_order_relaxed);
+         pNode->numHolds.store(2, std::memory_order_relaxed);
+         return pNode;
+      }
+
+      // pNode may be taken and reused by another thread right now. That is
+      // fine: the node is never freed, and the tag makes our CAS fail.
+   }
+   while (!freeList.compare_exchange_weak(oldTop,
+                                          pack(pNode->pFree.load(std::memory_order_relaxed), tagOf(oldTop) + 1),
+                                          std::memory_order_acquire,
+                                          std::memory_order_acquire));
+
+   uint64_t next = pNode->pNext.load(std::memory_order_relaxed);
+   pNode->pNext.store(pack(nullptr, tagOf(next) + 1), std::memory_order_relaxed);
+   pNode->numHolds.store(2, std::memory_order_relaxed);  // the head and the consumer
+   return pNode;
+}
+
+/*****************************************************
+ * LOCK-FREE QUEUE :: ALLOCATE
+ * Get a node and build the user data in it
+ ****************************************************/
+template <class T>
+template <class U>
+typename lockfree_queue <T> ::Node* lockfree_queue <T> ::allocate(U&& u)
+{
+   Node* pNode = allocate();
+   try
+   {
+      new (pNode->storage) T(std::forward<U>(u));
+   }
+   catch (...)
+   {
+      pNode->numHolds.store(1, std::memory_order_relaxed);
+      release(pNode);
+      throw;
+   }
+   return pNode;
+}
+
+/*****************************************************
+ * LOCK-FREE QUEUE :: RELEASE
+ * Drop one hold on a node. The last one out puts the
+ * node on the free list
+ ****************************************************/
+template <class T>
+void lockfree_queue <T> ::release(Node* pNode)
+{
+   if (pNode->numHolds.fetch_sub(1, std::memory_order_acq_rel) != 1)
+      return;
+
+   uint64_t oldTop = freeList.load(std::memory_order_relaxed);
+   do
+   {
+      pNode->pFree.store(ptrOf(oldTop), std::memory_order_relaxed);
+   }
+   while (!freeList.compare_exchange_weak(oldTop, pack(pNode, tagOf(oldTop) + 1),
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed));
+}
+
+/*****************************************************
+ * LOCK-FREE QUEUE :: PUSH CHAIN
+ * Publish a chain of nodes already holding user data
+ * with a single CAS on the last node's pNext
+ ****************************************************/
+template <class T>
+void lockfree_queue <T> ::pushChain(Node* pFirst, Node* pLast)
+{
+   size_t num = 1;
+   if (!pLast)
+      pLast = pFirst;
+   else
+      for (Node* p = pFirst; p != pLast; p = ptrOf(p->pNext.load(std::memory_order_relaxed)))
+         num++;
+
+   // count first so a racing pop never sees the size go below zero
+   numElements.fetch_add(num, std::memory_order_relaxed);
+
+   uint64_t oldTail;
+   for (;;)
+   {
+      oldTail = tail.load(std::memory_order_acquire);
+      Node* pTail = ptrOf(oldTail);
+      uint64_t next = pTail->pNext.load(std::memory_order_acquire);
+      if (oldTail != tail.load(std::memory_order_acquire))
+         continue;
+
+      // The tail really is last: hang our chain off it
+      if (ptrOf(next) == nullptr)
+      {
+         if (pTail->pNext.compare_exchange_weak(next, pack(pFirst, tagOf(next) + 1),
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed))
+            break;
+      }
+
+      // Someone else linked a node but has not moved the tail yet: help them
+      else
+         tail.compare_exchange_weak(oldTail, pack(ptrOf(next), tagOf(oldTail) + 1),
+                                    std::memory_order_release,
+                                    std::memory_order_relaxed);
+   }
+
+   // Point the tail at our last node. If this fails, someone helped us
+   tail.compare_exchange_strong(oldTail, pack(pLast, tagOf(oldTail) + 1),
+                                std::memory_order_release,
+                                std::memory_order_relaxed);
+}
+
+/*****************************************************
+ * LOCK-FREE QUEUE :: PUSH RANGE
+ * Push an entire range with one CAS. The first item
+ * in the range comes out first, just as if each had
+ * been pushed in turn
+ ****************************************************/
+template <class T>
+template <class Iterator>
+void lockfree_queue <T> ::push(Iterator first, Iterator last)
+{
+   if (first == last)
+      return;
+
+   // build the chain privately: nobody else can see it yet
+   Node* pFirst = allocate(*first);
+   Node* pLast = pFirst;
+   try
+   {
+      for (++first; first != last; ++first)
+      {
+         Node* pNew = allocate(*first);
+         uint64_t next = pLast->pNext.load(std::memory_order_relaxed);
+         pLast->pNext.store(pack(pNew, tagOf(next) + 1), std::memory_order_relaxed);
+         pLast = pNew;
+      }
+   }
+   catch (...)
+   {
+      for (Node* p = pFirst; p; )
+      {
+         Node* pNext = (p == pLast ? nullptr : ptrOf(p->pNext.load(std::memory_order_relaxed)));
+         p->data().~T();
+         p->numHolds.store(1, std::memory_order_relaxed);
+         release(p);
+         p = pNext;
+      }
+      throw;
+   }
+
+   pushChain(pFirst, pLast);
+}
+
+/*****************************************************
+ * LOCK-FREE QUEUE :: POP
+ * Remove up to num elements from the front with a
+ * single CAS on the head, handing them to out in order.
+ * Returns how many were removed
+ ****************************************************/
+template <class T>
+template <class OutputIterator>
+size_t lockfree_queue <T> ::pop(OutputIterator out, size_t num)
+{
+   if (num == 0)
+      return 0;
+
+   uint64_t oldHead;
+   Node* pLast;
+   size_t numTaken;
+   for (;;)
+   {
+      oldHead = head.load(std::memory_order_acquire);
+      uint64_t oldTail = tail.load(std::memory_order_acquire);
+      Node* pHead = ptrOf(oldHead);
+      Node* pTail = ptrOf(oldTail);
+      uint64_t next = pHead->pNext.load(std::memory_order_acquire);
+      if (oldHead != head.load(std::memory_order_acquire))
+         continue;
+
+      if (pHead == pTail)
+      {
+         // Nothing after the dummy: the queue is empty
+         if (ptrOf(next) == nullptr)
+            return 0;
+
+         // The tail is lagging: help it along before we pass it
+         tail.compare_exchange_weak(oldTail, pack(ptrOf(next), tagOf(oldTail) + 1),
+                                    std::memory_order_release,
+                                    std::memory_order_relaxed);
+         continue;
+      }
+
+      // Walk forward to the node that will become the new dummy, never
+      // going past the tail we saw. Stop early if the head moves on.
+      pLast = ptrOf(next);
+      numTaken = 1;
+      while (numTaken < num && pLast != pTail)
+      {
+         Node* pNext = ptrOf(pLast->pNext.load(std::memory_order_acquire));
+         if (!pNext || oldHead != head.load(std::memory_order_acquire))
+            break;
+         pLast = pNext;
+         numTaken++;
+      }
+
+      if (head.compare_exchange_weak(oldHead, pack(pLast, tagOf(oldHead) + 1),
+                                     std::memory_order_acq_rel,
+                                     std::memory_order_relaxed))
+         break;
+   }
+   numElements.fetch_sub(numTaken, std::memory_order_relaxed);
+
+   // The elements after the old dummy up to pLast are ours now. Each node
+   // we walk past is released twice: once for its element, once for no
+   // longer being the dummy. pLast is the new dummy and keeps that hold.
+   Node* p = ptrOf(oldHead);
+   for (size_t i = 0; i < numTaken; i++)
+   {
+      Node* pValue = ptrOf(p->pNext.load(std::memory_order_acquire));
+      *out = std::move(pValue->data());
+      ++out;
+      pValue->data().~T();
+      release(pValue);
+      release(p);
+      p = pValue;
+   }
+
+   return numTaken;
+}
+
+} // custom namespace
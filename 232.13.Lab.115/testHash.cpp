@@ -16,6 +16,9 @@
 #include "testList.h"       // for the list unit tests
 #include "testVector.h"     // for the vector unit tests
 #include "testSpy.h"        // for the spy unit tests
+#include "testUnrolledList.h" // for the unrolled list unit tests
+#include "testIntrusiveList.h" // for the intrusive list unit tests
+#include "testLockFreeQueue.h" // for the lock-free queue unit tests
 int Spy::counters[] = {};
 
 /**********************************************************************
@@ -29,6 +32,9 @@ int main()
    TestSpy().run();
    TestPair().run();
    TestList().run();
+   TestUnrolledList().run();
+   TestIntrusiveList().run();
+   TestLockFreeQueue().run();
    TestVector().run();
    TestHash().run();
 #endif // DEBUG
@@ -14,6 +14,7 @@
 #include "hash.h"
 #include "unitTest.h"
 #include "spy.h"
+#include "testList.h"    // for CountingAllocator
 
 #include <cassert>
 #include <memory>
@@ -137,6 +138,9 @@ public:
       test_loadFactor_default();
       test_loadFactor_two();
       test_setLoadFactor_five();
+
+      // Allocator
+      test_allocator_buckets();
       
       report("Hash");
    }
@@ -2880,6 +2884,31 @@ public:
       teardownStandardFixture(us);
    }
 
+   /***************************************
+    * ALLOCATOR
+    ***************************************/
+
+   // the bucket nodes come from the hash's allocator
+   void test_allocator_buckets()
+   {  // setup
+      CountingAllocatorBase::reset();
+      {
+         custom::unordered_set<int, std::hash<int>, std::equal_to<int>, CountingAllocator<int>> us;
+         us.insert(31);
+         us.insert(49);
+         us.insert(67);
+         // exercise
+         us.erase(49);
+         // verify
+         assertUnit(CountingAllocatorBase::numAllocate() == 3);
+         assertUnit(CountingAllocatorBase::numDeallocate() == 1);
+         assertUnit(us.size() == 2);
+         assertUnit(*us.find(31) == 31);
+         assertUnit(us.find(49) == us.end());
+      }  // teardown
+      assertUnit(CountingAllocatorBase::numDeallocate() == 3);
+   }
+
    /*************************************************************
     * SETUP STANDARD FIXTURE
     *      h[0] --> 31 
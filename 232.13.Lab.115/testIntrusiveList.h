@@ -0,0 +1,345 @@
+/***********************************************************************
+ * Header:
+ *    TEST INTRUSIVE LIST
+ * Summary:
+ *    Unit tests for intrusive_list
+ * Author
+ *    David Schaad, Tori Tremelling
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "intrusive_list.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <vector>
+
+#define assertOrder(l, ...)  assertOrderParameters(l, __VA_ARGS__, __LINE__, __FUNCTION__)
+
+/***************************************
+ * PAGE
+ * An element that can be on two lists at once
+ ***************************************/
+struct Page
+{
+   Page(int id) : data(id) {}
+
+   Spy data;
+   custom::list_hook<Page> lru;
+   custom::list_hook<Page> dirty;
+};
+
+class TestIntrusiveList : public UnitTest
+{
+   using LruList   = custom::intrusive_list<Page, &Page::lru>;
+   using DirtyList = custom::intrusive_list<Page, &Page::dirty>;
+
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_constructMove_standard();
+      test_destructor_standard();
+
+      // Insert
+      test_pushBack_empty();
+      test_pushFront_standard();
+      test_insert_standardMiddle();
+
+      // Remove
+      test_erase_standardMiddle();
+      test_erase_element();
+      test_isLinked_standard();
+      test_popFront_standard();
+      test_popBack_single();
+      test_clear_standard();
+
+      // Several lists
+      test_twoLists_independent();
+      test_twoLists_moveToFront();
+
+      report("IntrusiveList");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, nothing on the list
+   void test_construct_default()
+   {  // setup
+      // exercise
+      LruList l;
+      // verify
+      assertUnit(l.empty());
+      assertUnit(l.size() == 0);
+      assertUnit(l.pHead == nullptr);
+      assertUnit(l.pTail == nullptr);
+   }
+
+   // move constructor takes the elements along
+   void test_constructMove_standard()
+   {  // setup
+      Page p11(11), p26(26), p31(31);
+      LruList lSrc;
+      setupStandardFixture(lSrc, p11, p26, p31);
+      // exercise
+      LruList lDes(std::move(lSrc));
+      // verify
+      assertUnit(lSrc.empty());
+      assertOrder(lSrc, { });
+      assertOrder(lDes, { &p11, &p26, &p31 });
+   }  // teardown
+
+   // destroying the list leaves the elements alone but unhooked
+   void test_destructor_standard()
+   {  // setup
+      Page p11(11), p26(26), p31(31);
+      {
+         LruList l;
+         setupStandardFixture(l, p11, p26, p31);
+         Spy::reset();
+      }  // exercise
+      // verify
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(p26.lru.pNext == nullptr);
+      assertUnit(p26.lru.pPrev == nullptr);
+      assertUnit(p26.data == Spy(26));
+   }
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // push onto an empty list: nothing is made or copied
+   void test_pushBack_empty()
+   {  // setup
+      Page p11(11);
+      LruList l;
+      Spy::reset();
+      // exercise
+      l.push_back(p11);
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertOrder(l, { &p11 });
+   }  // teardown
+
+   // push onto the front of the standard fixture
+   void test_pushFront_standard()
+   {  // setup
+      Page p11(11), p26(26), p31(31), p99(99);
+      LruList l;
+      setupStandardFixture(l, p11, p26, p31);
+      // exercise
+      l.push_front(p99);
+      // verify
+      assertUnit(&l.front() == &p99);
+      assertOrder(l, { &p99, &p11, &p26, &p31 });
+   }  // teardown
+
+   // insert into the middle of the standard fixture
+   void test_insert_standardMiddle()
+   {  // setup
+      Page p11(11), p26(26), p31(31), p99(99);
+      LruList l;
+      setupStandardFixture(l, p11, p26, p31);
+      Spy::reset();
+      // exercise
+      auto it = l.insert(++l.begin(), p99);
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(&*it == &p99);
+      assertOrder(l, { &p11, &p99, &p26, &p31 });
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erase the middle of the standard fixture
+   void test_erase_standardMiddle()
+   {  // setup
+      Page p11(11), p26(26), p31(31);
+      LruList l;
+      setupStandardFixture(l, p11, p26, p31);
+      Spy::reset();
+      // exercise
+      auto it = l.erase(++l.begin());
+      // verify
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(&*it == &p31);
+      assertUnit(p26.lru.pNext == nullptr);
+      assertUnit(p26.lru.pPrev == nullptr);
+      assertOrder(l, { &p11, &p31 });
+   }  // teardown
+
+   // erase an element we hold, no iterator needed
+   void test_erase_element()
+   {  // setup
+      Page p11(11), p26(26), p31(31);
+      LruList l;
+      setupStandardFixture(l, p11, p26, p31);
+      // exercise
+      l.erase(p31);
+      // verify
+      assertUnit(&l.back() == &p26);
+      assertOrder(l, { &p11, &p26 });
+   }  // teardown
+
+   // only an element on this list is linked: not one on no list,
+   // nor one on another list
+   void test_isLinked_standard()
+   {  // setup
+      Page p11(11), p26(26), p31(31), p99(99);
+      LruList l;
+      LruList lOther;
+      setupStandardFixture(l, p11, p26, p31);
+      lOther.push_back(p99);
+      // exercise
+      bool isLinked26 = l.isLinked(p26);
+      bool isLinked99 = l.isLinked(p99);
+      l.erase(p26);
+      bool isErased26 = !l.isLinked(p26);
+      bool isFree26 = !l.isLinked(p26) && !lOther.isLinked(p26);
+      // verify
+      assertUnit(isLinked26);
+      assertUnit(l.isLinked(p11));
+      assertUnit(l.isLinked(p31));
+      assertUnit(!isLinked99);
+      assertUnit(lOther.isLinked(p99));
+      assertUnit(isErased26);
+      assertUnit(isFree26);
+      assertUnit(l.size() == 2);
+      assertOrder(l, { &p11, &p31 });
+   }  // teardown
+
+   // pop the front of the standard fixture
+   void test_popFront_standard()
+   {  // setup
+      Page p11(11), p26(26), p31(31);
+      LruList l;
+      setupStandardFixture(l, p11, p26, p31);
+      // exercise
+      l.pop_front();
+      // verify
+      assertOrder(l, { &p26, &p31 });
+   }  // teardown
+
+   // pop the only element
+   void test_popBack_single()
+   {  // setup
+      Page p11(11);
+      LruList l;
+      l.push_back(p11);
+      // exercise
+      l.pop_back();
+      // verify
+      assertUnit(l.empty());
+      assertOrder(l, { });
+   }  // teardown
+
+   // clear the standard fixture, the elements survive
+   void test_clear_standard()
+   {  // setup
+      Page p11(11), p26(26), p31(31);
+      LruList l;
+      setupStandardFixture(l, p11, p26, p31);
+      Spy::reset();
+      // exercise
+      l.clear();
+      // verify
+      assertUnit(Spy::numDestructor() == 0);
+      assertOrder(l, { });
+      assertUnit(p11.lru.pNext == nullptr);
+      assertUnit(p31.lru.pPrev == nullptr);
+   }  // teardown
+
+   /***************************************
+    * SEVERAL LISTS
+    ***************************************/
+
+   // the same elements on two lists in different orders
+   void test_twoLists_independent()
+   {  // setup
+      Page p11(11), p26(26), p31(31);
+      LruList lru;
+      DirtyList dirty;
+      setupStandardFixture(lru, p11, p26, p31);
+      // exercise
+      dirty.push_back(p31);
+      dirty.push_back(p11);
+      // verify
+      assertOrder(lru, { &p11, &p26, &p31 });
+      assertOrder(dirty, { &p31, &p11 });
+   }  // teardown
+
+   // touching an element moves it to the front of one list only
+   void test_twoLists_moveToFront()
+   {  // setup
+      Page p11(11), p26(26), p31(31);
+      LruList lru;
+      DirtyList dirty;
+      setupStandardFixture(lru, p11, p26, p31);
+      dirty.push_back(p26);
+      dirty.push_back(p31);
+      Spy::reset();
+      // exercise
+      lru.erase(p31);
+      lru.push_front(p31);
+      dirty.erase(p26);
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertOrder(lru, { &p31, &p11, &p26 });
+      assertOrder(dirty, { &p31 });
+   }  // teardown
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *      11 - 26 - 31
+    *************************************************************/
+   void setupStandardFixture(LruList& l, Page& p11, Page& p26, Page& p31)
+   {
+      l.push_back(p11);
+      l.push_back(p26);
+      l.push_back(p31);
+   }
+
+   /*************************************************************
+    * VERIFY ORDER
+    * The list holds exactly these elements, linked both ways
+    *************************************************************/
+   template <class List>
+   void assertOrderParameters(const List& l, const std::vector<Page*>& pages,
+                              int line, const char* function)
+   {
+      assertIndirect(l.numElements == pages.size());
+      Page* pPrev = nullptr;
+      Page* p = l.pHead;
+      for (Page* pPage : pages)
+      {
+         assertIndirect(p == pPage);
+         if (p != pPage)
+            return;
+         assertIndirect(l.hook(p).pPrev == pPrev);
+         pPrev = p;
+         p = l.hook(p).pNext;
+      }
+      assertIndirect(p == nullptr);
+      assertIndirect(l.pTail == pPrev);
+   }
+};
+
+#endif // DEBUG
@@ -20,6 +20,50 @@
 #include <cassert>
 #include <memory>
 #include <iostream>
+#include <algorithm>
+
+/***************************************
+ * COUNTING ALLOCATOR
+ * Hands out memory like std::allocator but counts
+ * every call, whatever type it has been rebound to
+ ***************************************/
+class CountingAllocatorBase
+{
+public:
+   static int& numAllocate()   { static int num = 0; return num; }
+   static int& numDeallocate() { static int num = 0; return num; }
+   static void reset()         { numAllocate() = numDeallocate() = 0; }
+};
+
+template <class T>
+class CountingAllocator : public CountingAllocatorBase
+{
+public:
+   using value_type = T;
+
+   CountingAllocator() {}
+   template <class U>
+   CountingAllocator(const CountingAllocator<U>&) {}
+
+   T* allocate(size_t num)
+   {
+      numAllocate()++;
+      return std::allocator<T>().allocate(num);
+   }
+   void deallocate(T* p, size_t num)
+   {
+      numDeallocate()++;
+      std::allocator<T>().deallocate(p, num);
+   }
+
+   template <class U>
+   bool operator == (const CountingAllocator<U>&) const { return true; }
+   template <class U>
+   bool operator != (const CountingAllocator<U>&) const { return false; }
+};
+
+#define assertNoDataMoves()  assertNoDataMovesParameters(__LINE__, __FUNCTION__)
+#define assertList(l, ...)  assertListParameters(l, __VA_ARGS__, __LINE__, __FUNCTION__)
 
 class TestList : public UnitTest
 {
@@ -100,6 +144,12 @@ public:
       test_insertMove_empty();
       test_insertMove_standardFront();
       test_insertMove_standardMiddle();
+      test_emplaceBack_empty();
+      test_emplaceBack_standard();
+      test_emplaceFront_standard();
+      test_emplace_standardMiddle();
+      test_emplace_standardEnd();
+      test_emplace_default();
 
       // Remove
       test_clear_empty();
@@ -121,6 +171,23 @@ public:
       test_empty_empty();
       test_empty_three();
 
+      // Splice and Sort
+      test_splice_whole();
+      test_splice_wholeEmpty();
+      test_splice_single();
+      test_splice_singleSameList();
+      test_splice_range();
+      test_splice_rangeSameList();
+      test_merge_standard();
+      test_merge_stable();
+      test_sort_standard();
+      test_sort_stable();
+      test_sort_large();
+
+      // Allocator
+      test_allocator_nodes();
+      test_allocator_moveConstruct();
+
       report("List");
    }
 
@@ -617,6 +684,310 @@ public:
       teardownStandardFixture(l);
    }
 
+   /***************************************
+    * EMPLACE
+    ***************************************/
+
+   // build an element at the back of an empty list
+   void test_emplaceBack_empty()
+   {  // setup
+      custom::list<Spy> l;
+      Spy::reset();
+      // exercise
+      Spy& s = l.emplace_back(99);
+      // verify
+      assertUnit(Spy::numNondefault() == 1);  // build [99] in place
+      assertUnit(Spy::numAlloc() == 1);       // allocate [99]
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(&s == &l.pHead->data);
+      assertList(l, { 99 });
+   }  // teardown
+
+   // build an element at the back of the standard fixture
+   void test_emplaceBack_standard()
+   {  // setup
+      custom::list<Spy> l{ Spy(11), Spy(26), Spy(31) };
+      Spy::reset();
+      // exercise
+      l.emplace_back(99);
+      // verify
+      assertUnit(Spy::numNondefault() == 1);  // build [99] in place
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertList(l, { 11, 26, 31, 99 });
+   }  // teardown
+
+   // build an element at the front of the standard fixture
+   void test_emplaceFront_standard()
+   {  // setup
+      custom::list<Spy> l{ Spy(11), Spy(26), Spy(31) };
+      Spy::reset();
+      // exercise
+      Spy& s = l.emplace_front(99);
+      // verify
+      assertUnit(Spy::numNondefault() == 1);  // build [99] in place
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(&s == &l.pHead->data);
+      assertList(l, { 99, 11, 26, 31 });
+   }  // teardown
+
+   // build an element in the middle of the standard fixture
+   void test_emplace_standardMiddle()
+   {  // setup
+      custom::list<Spy> l{ Spy(11), Spy(26), Spy(31) };
+      Spy::reset();
+      // exercise
+      auto it = l.emplace(++l.begin(), 99);
+      // verify
+      assertUnit(Spy::numNondefault() == 1);  // build [99] in place
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(it.p == l.pHead->pNext);
+      assertList(l, { 11, 99, 26, 31 });
+   }  // teardown
+
+   // build an element at the end of the standard fixture
+   void test_emplace_standardEnd()
+   {  // setup
+      custom::list<Spy> l{ Spy(11), Spy(26), Spy(31) };
+      Spy::reset();
+      // exercise
+      auto it = l.emplace(l.end(), 99);
+      // verify
+      assertUnit(Spy::numNondefault() == 1);  // build [99] in place
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(it.p == l.pTail);
+      assertList(l, { 11, 26, 31, 99 });
+   }  // teardown
+
+   // emplace with no arguments uses the default constructor
+   void test_emplace_default()
+   {  // setup
+      custom::list<Spy> l;
+      Spy::reset();
+      // exercise
+      l.emplace_back();
+      // verify
+      assertUnit(Spy::numDefault() == 1);     // build [] in place
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(l.size() == 1);
+      assertUnit(l.front().empty());
+   }  // teardown
+
+   /***************************************
+    * SPLICE AND SORT
+    ***************************************/
+
+   // move a whole list into the middle of another
+   void test_splice_whole()
+   {  // setup
+      custom::list<Spy> lDes{ Spy(11), Spy(26), Spy(31) };
+      custom::list<Spy> lSrc{ Spy(49), Spy(67) };
+      Spy::reset();
+      // exercise
+      lDes.splice(++lDes.begin(), lSrc);
+      // verify
+      assertNoDataMoves();
+      assertList(lDes, { 11, 49, 67, 26, 31 });
+      assertList(lSrc, { });
+   }  // teardown
+
+   // move an empty list onto the end of another
+   void test_splice_wholeEmpty()
+   {  // setup
+      custom::list<Spy> lDes{ Spy(11), Spy(26) };
+      custom::list<Spy> lSrc;
+      Spy::reset();
+      // exercise
+      lDes.splice(lDes.end(), lSrc);
+      // verify
+      assertNoDataMoves();
+      assertList(lDes, { 11, 26 });
+      assertList(lSrc, { });
+   }  // teardown
+
+   // move one node from another list onto the end
+   void test_splice_single()
+   {  // setup
+      custom::list<Spy> lDes{ Spy(11), Spy(26) };
+      custom::list<Spy> lSrc{ Spy(31), Spy(49), Spy(67) };
+      Spy::reset();
+      // exercise
+      lDes.splice(lDes.end(), lSrc, ++lSrc.begin());
+      // verify
+      assertNoDataMoves();
+      assertList(lDes, { 11, 26, 49 });
+      assertList(lSrc, { 31, 67 });
+   }  // teardown
+
+   // move the last node of a list to its front
+   void test_splice_singleSameList()
+   {  // setup
+      custom::list<Spy> l{ Spy(11), Spy(26), Spy(31) };
+      Spy::reset();
+      // exercise
+      l.splice(l.begin(), l, l.rbegin());
+      // verify
+      assertNoDataMoves();
+      assertList(l, { 31, 11, 26 });
+   }  // teardown
+
+   // move the middle of one list to the front of another
+   void test_splice_range()
+   {  // setup
+      custom::list<Spy> lDes{ Spy(11), Spy(26) };
+      custom::list<Spy> lSrc{ Spy(31), Spy(49), Spy(67), Spy(83) };
+      Spy::reset();
+      // exercise
+      lDes.splice(lDes.begin(), lSrc, ++lSrc.begin(), lSrc.rbegin());
+      // verify
+      assertNoDataMoves();
+      assertList(lDes, { 49, 67, 11, 26 });
+      assertList(lSrc, { 31, 83 });
+   }  // teardown
+
+   // move the front of a list to its end
+   void test_splice_rangeSameList()
+   {  // setup
+      custom::list<Spy> l{ Spy(11), Spy(26), Spy(31), Spy(49) };
+      Spy::reset();
+      // exercise
+      l.splice(l.end(), l, l.begin(), ++(++l.begin()));
+      // verify
+      assertNoDataMoves();
+      assertList(l, { 31, 49, 11, 26 });
+   }  // teardown
+
+   // merge two sorted lists
+   void test_merge_standard()
+   {  // setup
+      custom::list<Spy> lDes{ Spy(11), Spy(31), Spy(67) };
+      custom::list<Spy> lSrc{ Spy(5), Spy(26), Spy(49), Spy(83), Spy(99) };
+      Spy::reset();
+      // exercise
+      lDes.merge(lSrc);
+      // verify
+      assertNoDataMoves();
+      assertList(lDes, { 5, 11, 26, 31, 49, 67, 83, 99 });
+      assertList(lSrc, { });
+   }  // teardown
+
+   // equal elements of this list stay in front of those merged in
+   void test_merge_stable()
+   {  // setup
+      custom::list<Spy> lDes{ Spy(11), Spy(31) };
+      custom::list<Spy> lSrc{ Spy(31), Spy(49) };
+      auto pDes31 = lDes.pTail;
+      auto pSrc31 = lSrc.pHead;
+      // exercise
+      lDes.merge(lSrc);
+      // verify
+      assertList(lDes, { 11, 31, 31, 49 });
+      assertUnit(lDes.pHead->pNext == pDes31);
+      assertUnit(pDes31->pNext == pSrc31);
+   }  // teardown
+
+   // sort a short list
+   void test_sort_standard()
+   {  // setup
+      custom::list<Spy> l{ Spy(49), Spy(11), Spy(83), Spy(26), Spy(67), Spy(31) };
+      Spy::reset();
+      // exercise
+      l.sort();
+      // verify
+      assertNoDataMoves();
+      assertList(l, { 11, 26, 31, 49, 67, 83 });
+   }  // teardown
+
+   // equal elements keep their order
+   void test_sort_stable()
+   {  // setup
+      custom::list<Spy> l{ Spy(31), Spy(11), Spy(39), Spy(35), Spy(14) };
+      auto p31 = l.pHead;
+      auto p39 = p31->pNext->pNext;
+      auto p35 = p39->pNext;
+      // exercise
+      l.sort([](const Spy& lhs, const Spy& rhs) { return lhs.get() / 10 < rhs.get() / 10; });
+      // verify
+      assertList(l, { 11, 14, 31, 39, 35 });
+      assertUnit(l.pHead->pNext->pNext == p31);
+      assertUnit(p31->pNext == p39);
+      assertUnit(p39->pNext == p35);
+   }  // teardown
+
+   // sort enough elements to take many passes
+   void test_sort_large()
+   {  // setup
+      custom::list<Spy> l;
+      std::vector<int> values;
+      for (int i = 0; i < 1000; i++)
+      {
+         int value = (i * 7919) % 1009;
+         l.push_back(Spy(value));
+         values.push_back(value);
+      }
+      std::sort(values.begin(), values.end());
+      Spy::reset();
+      // exercise
+      l.sort();
+      // verify
+      assertNoDataMoves();
+      assertList(l, values);
+   }  // teardown
+
+   /***************************************
+    * ALLOCATOR
+    ***************************************/
+
+   // every node comes from and goes back to the allocator
+   void test_allocator_nodes()
+   {  // setup
+      CountingAllocatorBase::reset();
+      {
+         custom::list<Spy, CountingAllocator<Spy>> l(2);
+         l.push_back(Spy(11));
+         l.push_front(Spy(26));
+         l.insert(++l.begin(), Spy(31));
+         // exercise
+         l.erase(l.begin());
+         l.pop_back();
+         l.pop_front();
+         // verify
+         assertUnit(CountingAllocatorBase::numAllocate() == 5);
+         assertUnit(CountingAllocatorBase::numDeallocate() == 3);
+         assertUnit(l.size() == 2);
+      }  // teardown
+      assertUnit(CountingAllocatorBase::numDeallocate() == 5);
+   }
+
+   // the move constructor takes the allocator along with the nodes
+   void test_allocator_moveConstruct()
+   {  // setup
+      CountingAllocatorBase::reset();
+      {
+         custom::list<Spy, CountingAllocator<Spy>> lSrc;
+         lSrc.push_back(Spy(11));
+         lSrc.push_back(Spy(26));
+         // exercise
+         custom::list<Spy, CountingAllocator<Spy>> lDes(std::move(lSrc));
+         // verify
+         assertUnit(CountingAllocatorBase::numAllocate() == 2);
+         assertUnit(CountingAllocatorBase::numDeallocate() == 0);
+         assertUnit(lSrc.empty());
+         assertUnit(lDes.size() == 2);
+      }  // teardown
+      assertUnit(CountingAllocatorBase::numDeallocate() == 2);
+   }
+
 
    /***************************************
     * ASSIGN
@@ -3176,6 +3547,46 @@ public:
       }
    }
 
+   /****************************************************************
+    * Verify no Spy was made, copied, moved or destroyed
+    ****************************************************************/
+   void assertNoDataMovesParameters(int line, const char* function)
+   {
+      assertIndirect(Spy::numAlloc() == 0);
+      assertIndirect(Spy::numDelete() == 0);
+      assertIndirect(Spy::numDefault() == 0);
+      assertIndirect(Spy::numNondefault() == 0);
+      assertIndirect(Spy::numCopy() == 0);
+      assertIndirect(Spy::numCopyMove() == 0);
+      assertIndirect(Spy::numAssign() == 0);
+      assertIndirect(Spy::numAssignMove() == 0);
+      assertIndirect(Spy::numSwap() == 0);
+      assertIndirect(Spy::numDestructor() == 0);
+   }
+
+   /****************************************************************
+    * Verify a list holds these values and is linked both ways
+    ****************************************************************/
+   void assertListParameters(const custom::list<Spy>& l, const std::vector<int>& values,
+                             int line, const char* function)
+   {
+      assertIndirect(l.numElements == values.size());
+      auto pPrev = l.pHead ? l.pHead->pPrev : nullptr;
+      auto p = l.pHead;
+      for (int value : values)
+      {
+         assertIndirect(p != nullptr);
+         if (!p)
+            return;
+         assertIndirect(p->data == Spy(value));
+         assertIndirect(p->pPrev == pPrev);
+         pPrev = p;
+         p = p->pNext;
+      }
+      assertIndirect(p == nullptr);
+      assertIndirect(l.pTail == pPrev);
+   }
+
    /****************************************************************
     * Verify Empty Fixture
     ****************************************************************/
@@ -0,0 +1,374 @@
+/***********************************************************************
+ * Header:
+ *    TEST LOCK-FREE QUEUE
+ * Summary:
+ *    Unit tests for lockfree_queue
+ * Author
+ *    David Schaad, Tori Tremelling
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "lockfree_queue.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <atomic>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+class TestLockFreeQueue : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_destructor_standard();
+
+      // Insert
+      test_pushCopy_empty();
+      test_pushMove_empty();
+      test_pushRange_empty();
+      test_pushRange_standard();
+
+      // Remove
+      test_pop_empty();
+      test_pop_standard();
+      test_popBulk_some();
+      test_popBulk_more();
+      test_pop_recycle();
+
+      // Threads
+      test_threads_pushPop();
+      test_threads_pushPopBulk();
+
+      report("LockFreeQueue");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, only the dummy node
+   void test_construct_default()
+   {  // setup
+      Spy::reset();
+      // exercise
+      custom::lockfree_queue<Spy> q;
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(q.empty());
+      assertUnit(q.size() == 0);
+      assertUnit(q.ptrOf(q.head) != nullptr);
+      assertUnit(q.ptrOf(q.head) == q.ptrOf(q.tail));
+      assertUnit(q.freeList == 0);
+   }
+
+   // destructor of a 4-element collection
+   void test_destructor_standard()
+   {  // setup
+      {
+         custom::lockfree_queue<Spy> q;
+         setupStandardFixture(q);
+         Spy::reset();
+      } // exercise
+      // verify
+      assertUnit(Spy::numDestructor() == 4); // destructor for [26,49,67,89]
+      assertUnit(Spy::numDelete() == 4);     // delete [26,49,67,89]
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+   }
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // push a copy onto an empty queue
+   void test_pushCopy_empty()
+   {  // setup
+      custom::lockfree_queue<Spy> q;
+      Spy s26(26);
+      Spy::reset();
+      // exercise
+      q.push(s26);
+      // verify
+      assertUnit(Spy::numCopy() == 1);      // copy-create [26]
+      assertUnit(Spy::numAlloc() == 1);     // allocate [26]
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(q.size() == 1);
+      assertUnit(!q.empty());
+      assertUnit(q.ptrOf(q.tail)->data() == Spy(26));
+   }  // teardown
+
+   // move a value onto an empty queue
+   void test_pushMove_empty()
+   {  // setup
+      custom::lockfree_queue<Spy> q;
+      Spy s26(26);
+      Spy::reset();
+      // exercise
+      q.push(std::move(s26));
+      // verify
+      assertUnit(Spy::numCopyMove() == 1);  // move-create [26]
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(s26.empty());
+      assertUnit(q.size() == 1);
+      assertUnit(q.ptrOf(q.tail)->data() == Spy(26));
+   }  // teardown
+
+   // push an empty range, nothing happens
+   void test_pushRange_empty()
+   {  // setup
+      custom::lockfree_queue<Spy> q;
+      std::vector<Spy> v;
+      Spy::reset();
+      // exercise
+      q.push(v.begin(), v.end());
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(q.empty());
+      assertUnit(q.tagOf(q.tail) == 0);     // never touched the tail
+   }  // teardown
+
+   // push four elements in one batch
+   void test_pushRange_standard()
+   {  // setup
+      custom::lockfree_queue<Spy> q;
+      std::vector<Spy> v { Spy(26), Spy(49), Spy(67), Spy(89) };
+      Spy::reset();
+      // exercise
+      q.push(v.begin(), v.end());
+      // verify
+      assertUnit(Spy::numCopy() == 4);      // copy-create [26,49,67,89]
+      assertUnit(Spy::numAlloc() == 4);     // allocate [26,49,67,89]
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(q.tagOf(q.tail) == 1);     // the tail moved once
+      assertStandardFixture(q);
+   }  // teardown
+
+   /***************************************
+    * POP
+    ***************************************/
+
+   // pop from an empty queue
+   void test_pop_empty()
+   {  // setup
+      custom::lockfree_queue<Spy> q;
+      Spy value;
+      Spy::reset();
+      // exercise
+      bool popped = q.pop(value);
+      // verify
+      assertUnit(!popped);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(value.empty());
+      assertUnit(q.empty());
+   }  // teardown
+
+   // pop the front off the standard fixture
+   void test_pop_standard()
+   {  // setup
+      custom::lockfree_queue<Spy> q;
+      setupStandardFixture(q);
+      Spy value;
+      Spy::reset();
+      // exercise
+      bool popped = q.pop(value);
+      // verify
+      assertUnit(popped);
+      assertUnit(Spy::numAssignMove() == 1);  // move [26] out
+      assertUnit(Spy::numDestructor() == 1);  // the moved-from [26]
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(value == Spy(26));
+      assertUnit(q.size() == 3);
+      assertUnit(q.ptrOf(q.freeList) != nullptr);  // the old dummy
+   }  // teardown
+
+   // pop three of the four in one go
+   void test_popBulk_some()
+   {  // setup
+      custom::lockfree_queue<int> q;
+      for (int value : { 26, 49, 67, 89 })
+         q.push(value);
+      auto tagHead = q.tagOf(q.head);
+      std::vector<int> values;
+      // exercise
+      size_t num = q.pop(std::back_inserter(values), 3);
+      // verify
+      assertUnit(num == 3);
+      assertUnit(values == std::vector<int>({ 26, 49, 67 }));
+      assertUnit(q.tagOf(q.head) == tagHead + 1);  // one CAS on the head
+      assertUnit(q.size() == 1);
+      int value = 0;
+      assertUnit(q.pop(value) && value == 89);
+      assertUnit(q.empty());
+   }  // teardown
+
+   // ask for more than there are
+   void test_popBulk_more()
+   {  // setup
+      custom::lockfree_queue<int> q;
+      for (int value : { 26, 49, 67, 89 })
+         q.push(value);
+      int values[10] = {};
+      // exercise
+      size_t num = q.pop(values, 10);
+      // verify
+      assertUnit(num == 4);
+      assertUnit(values[0] == 26);
+      assertUnit(values[3] == 89);
+      assertUnit(values[4] == 0);
+      assertUnit(q.empty());
+      assertUnit(q.size() == 0);
+      assertUnit(q.ptrOf(q.head) == q.ptrOf(q.tail));
+   }  // teardown
+
+   // popped nodes are reused by the next push
+   void test_pop_recycle()
+   {  // setup
+      custom::lockfree_queue<int> q;
+      auto pDummy = q.ptrOf(q.head);
+      q.push(26);
+      q.push(49);
+      int value = 0;
+      q.pop(value);
+      // exercise
+      q.push(67);
+      // verify
+      assertUnit(q.ptrOf(q.tail) == pDummy);
+      assertUnit(q.ptrOf(q.freeList) == nullptr);
+      assertUnit(q.size() == 2);
+      assertUnit(q.pop(value) && value == 49);
+      assertUnit(q.pop(value) && value == 67);
+      assertUnit(!q.pop(value));
+   }  // teardown
+
+   /***************************************
+    * THREADS
+    ***************************************/
+
+   // several producers and consumers lose nothing, and each
+   // producer's elements come out in the order they went in
+   void test_threads_pushPop()
+   {
+      runProducersConsumers(1);
+   }
+
+   // the same, consumers taking up to eight at a time
+   void test_threads_pushPopBulk()
+   {
+      runProducersConsumers(8);
+   }
+
+   /*************************************************************
+    * RUN PRODUCERS AND CONSUMERS
+    * Four producers push 1 ... numPerThread tagged with their id.
+    * Four consumers pop batches of up to numBatch until everything
+    * is accounted for
+    *************************************************************/
+   void runProducersConsumers(size_t numBatch)
+   {  // setup
+      custom::lockfree_queue<int> q;
+      const int numThreads = 4;
+      const int numPerThread = 20000;
+      const int numTotal = numThreads * numPerThread;
+      std::atomic<int> numPopped(0);
+      std::vector<long long> sums(numThreads, 0);
+      std::vector<int> numOutOfOrder(numThreads, 0);
+      std::vector<std::thread> threads;
+      // exercise
+      for (int id = 0; id < numThreads; id++)
+         threads.push_back(std::thread([&q, id]()
+         {
+            for (int i = 1; i <= numPerThread; i++)
+               q.push(id * numPerThread + i);
+         }));
+      for (int id = 0; id < numThreads; id++)
+         threads.push_back(std::thread([&, id]()
+         {
+            std::vector<int> last(numThreads, 0);
+            std::vector<int> batch(numBatch);
+            while (numPopped.load() < numTotal)
+            {
+               size_t num = q.pop(batch.begin(), numBatch);
+               for (size_t i = 0; i < num; i++)
+               {
+                  int producer = (batch[i] - 1) / numPerThread;
+                  int sequence = batch[i] - producer * numPerThread;
+                  if (sequence <= last[producer])
+                     numOutOfOrder[id]++;
+                  last[producer] = sequence;
+                  sums[id] += batch[i];
+               }
+               numPopped += (int)num;
+            }
+         }));
+      for (auto& thread : threads)
+         thread.join();
+      // verify
+      long long sum = 0;
+      int outOfOrder = 0;
+      for (int id = 0; id < numThreads; id++)
+      {
+         sum += sums[id];
+         outOfOrder += numOutOfOrder[id];
+      }
+      long long expected = (long long)numTotal * (numTotal + 1) / 2;
+      assertUnit(sum == expected);
+      assertUnit(outOfOrder == 0);
+      assertUnit(numPopped == numTotal);
+      assertUnit(q.empty());
+      assertUnit(q.size() == 0);
+   }  // teardown
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *      [ 26, 49, 67, 89 ]  (26 in front)
+    *************************************************************/
+   void setupStandardFixture(custom::lockfree_queue<Spy>& q)
+   {
+      q.push(Spy(26));
+      q.push(Spy(49));
+      q.push(Spy(67));
+      q.push(Spy(89));
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *      [ 26, 49, 67, 89 ]  (26 in front)
+    *************************************************************/
+   void assertStandardFixtureParameters(const custom::lockfree_queue<Spy>& q, int line, const char* function)
+   {
+      assertIndirect(q.size() == 4);
+      assertIndirect(!q.empty());
+      auto p = q.ptrOf(q.ptrOf(q.head)->pNext);
+      for (int value : { 26, 49, 67, 89 })
+      {
+         assertIndirect(p != nullptr);
+         if (!p)
+            return;
+         assertIndirect(p->data() == Spy(value));
+         p = q.ptrOf(p->pNext);
+      }
+      assertIndirect(p == nullptr);
+      assertIndirect(q.ptrOf(q.tail) != nullptr && q.ptrOf(q.tail)->data() == Spy(89));
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,530 @@
+/***********************************************************************
+ * Header:
+ *    TEST UNROLLED LIST
+ * Summary:
+ *    Unit tests for unrolled_list
+ * Author
+ *    David Schaad, Tori Tremelling
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "unrolled_list.h"
+#include "unitTest.h"
+#include "spy.h"
+#include "testList.h"    // for CountingAllocator
+
+#include <list>
+#include <vector>
+#include <cstdlib>
+
+#define assertLayout(l, ...)  assertLayoutParameters(l, __VA_ARGS__, __LINE__, __FUNCTION__)
+
+class TestUnrolledList : public UnitTest
+{
+   // four elements to a node so the tests can see splits and merges
+   using List = custom::unrolled_list<Spy, std::allocator<Spy>, 4>;
+
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_capacity();
+      test_constructCopy_standard();
+      test_constructMove_standard();
+      test_destructor_standard();
+
+      // Assign
+      test_assign_bigToSmall();
+      test_assign_smallToBig();
+
+      // Iterator
+      test_iterator_forward();
+      test_iterator_backward();
+
+      // Insert
+      test_pushBack_newNode();
+      test_pushFront_split();
+      test_pushFront_room();
+      test_insert_middleSplit();
+      test_insert_end();
+      test_insert_alias();
+
+      // Remove
+      test_erase_emptyNode();
+      test_erase_merge();
+      test_erase_last();
+      test_popFront_standard();
+      test_popBack_standard();
+      test_clear_standard();
+
+      // Allocator
+      test_allocator_nodes();
+
+      // Against std::list
+      test_random_againstStdList();
+
+      report("UnrolledList");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, no allocations
+   void test_construct_default()
+   {  // setup
+      Spy::reset();
+      // exercise
+      List l;
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(l.empty());
+      assertUnit(l.size() == 0);
+      assertUnit(l.pHead == nullptr);
+      assertUnit(l.pTail == nullptr);
+   }
+
+   // the default node holds about 64 bytes worth, at least four
+   void test_construct_capacity()
+   {  // setup
+      struct Big { char bytes[64]; };
+      custom::unrolled_list<int> lInt;
+      custom::unrolled_list<Big> lBig;
+      // exercise
+      lInt.push_back(1);
+      lBig.push_back(Big());
+      // verify
+      assertUnit(sizeof(lInt.pHead->storage) == 64);
+      assertUnit(sizeof(lBig.pHead->storage) == 4 * sizeof(Big));
+   }  // teardown
+
+   // copy constructor of the standard fixture
+   void test_constructCopy_standard()
+   {  // setup
+      List lSrc;
+      setupStandardFixture(lSrc);
+      Spy::reset();
+      // exercise
+      List lDes(lSrc);
+      // verify
+      assertUnit(Spy::numCopy() == 6);        // copy [11][26][31][49][67][83]
+      assertUnit(Spy::numAlloc() == 6);
+      assertUnit(Spy::numDelete() == 0);
+      assertStandardFixture(lSrc);
+      assertLayout(lDes, { { 11, 26, 31, 49 }, { 67, 83 } });
+   }  // teardown
+
+   // move constructor of the standard fixture
+   void test_constructMove_standard()
+   {  // setup
+      List lSrc;
+      setupStandardFixture(lSrc);
+      Spy::reset();
+      // exercise
+      List lDes(std::move(lSrc));
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(lSrc.empty());
+      assertUnit(lSrc.pHead == nullptr);
+      assertStandardFixture(lDes);
+   }  // teardown
+
+   // destructor of the standard fixture
+   void test_destructor_standard()
+   {  // setup
+      {
+         List l;
+         setupStandardFixture(l);
+         Spy::reset();
+      }  // exercise
+      // verify
+      assertUnit(Spy::numDestructor() == 6);
+      assertUnit(Spy::numDelete() == 6);
+   }
+
+   /***************************************
+    * ASSIGN
+    ***************************************/
+
+   // assign two elements onto the standard fixture
+   void test_assign_bigToSmall()
+   {  // setup
+      List lSrc;
+      lSrc.push_back(Spy(99));
+      lSrc.push_back(Spy(88));
+      List lDes;
+      setupStandardFixture(lDes);
+      Spy::reset();
+      // exercise
+      lDes = lSrc;
+      // verify
+      assertUnit(Spy::numAssign() == 2);      // [99][88] onto [11][26]
+      assertUnit(Spy::numDestructor() == 4);  // destroy [31][49][67][83]
+      assertUnit(Spy::numAlloc() == 0);
+      assertLayout(lDes, { { 99, 88 } });
+   }  // teardown
+
+   // assign the standard fixture onto two elements
+   void test_assign_smallToBig()
+   {  // setup
+      List lSrc;
+      setupStandardFixture(lSrc);
+      List lDes;
+      lDes.push_back(Spy(99));
+      lDes.push_back(Spy(88));
+      Spy::reset();
+      // exercise
+      lDes = lSrc;
+      // verify
+      assertUnit(Spy::numAssign() == 2);      // [11][26] onto [99][88]
+      assertUnit(Spy::numCopy() == 4);        // copy [31][49][67][83]
+      assertUnit(Spy::numDestructor() == 0);
+      assertLayout(lDes, { { 11, 26, 31, 49 }, { 67, 83 } });
+   }  // teardown
+
+   /***************************************
+    * ITERATOR
+    ***************************************/
+
+   // walk forward across a node boundary
+   void test_iterator_forward()
+   {  // setup
+      List l;
+      setupStandardFixture(l);
+      std::vector<int> values;
+      // exercise
+      for (auto it = l.begin(); it != l.end(); ++it)
+         values.push_back((*it).get());
+      // verify
+      assertUnit(values == std::vector<int>({ 11, 26, 31, 49, 67, 83 }));
+   }  // teardown
+
+   // walk backward across a node boundary
+   void test_iterator_backward()
+   {  // setup
+      List l;
+      setupStandardFixture(l);
+      std::vector<int> values;
+      // exercise
+      for (auto it = l.rbegin(); it != l.end(); --it)
+         values.push_back((*it).get());
+      // verify
+      assertUnit(values == std::vector<int>({ 83, 67, 49, 31, 26, 11 }));
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // push onto a full tail: a new node is added
+   void test_pushBack_newNode()
+   {  // setup
+      List l;
+      for (int value : { 11, 26, 31, 49 })
+         l.push_back(Spy(value));
+      Spy s67(67);
+      Spy::reset();
+      // exercise
+      l.push_back(s67);
+      // verify
+      assertUnit(Spy::numCopy() == 1);        // copy [67]
+      assertUnit(Spy::numAlloc() == 1);
+      assertUnit(Spy::numCopyMove() == 0);    // nothing else moved
+      assertUnit(Spy::numAssignMove() == 0);
+      assertLayout(l, { { 11, 26, 31, 49 }, { 67 } });
+   }  // teardown
+
+   // push onto a full head: the head is split
+   void test_pushFront_split()
+   {  // setup
+      List l;
+      for (int value : { 11, 26, 31, 49 })
+         l.push_back(Spy(value));
+      Spy::reset();
+      // exercise
+      l.push_front(Spy(99));
+      // verify
+      assertUnit(Spy::numCopyMove() == 4);    // [99] aside, [31][49] to the new node, [26] up
+      assertUnit(Spy::numAssignMove() == 2);  // [11] up, [99] in
+      assertUnit(Spy::numCopy() == 0);
+      assertLayout(l, { { 99, 11, 26 }, { 31, 49 } });
+   }  // teardown
+
+   // push to the front of a node when the previous one has room
+   void test_pushFront_room()
+   {  // setup
+      List l;
+      setupStandardFixture(l);
+      l.erase(l.begin());
+      l.push_back(Spy(91));
+      l.push_back(Spy(95));                   // { 26, 31, 49 }, { 67, 83, 91, 95 }
+      List::iterator it(l.pHead->pNext, 0);   // 67
+      Spy::reset();
+      // exercise
+      it = l.insert(it, Spy(99));
+      // verify
+      assertUnit(Spy::numCopyMove() == 1);    // only [99] moves in
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(it.p == l.pHead);
+      assertUnit(it.i == 3);
+      assertLayout(l, { { 26, 31, 49, 99 }, { 67, 83, 91, 95 } });
+   }  // teardown
+
+   // insert into the middle of a full node
+   void test_insert_middleSplit()
+   {  // setup
+      List l;
+      setupStandardFixture(l);
+      List::iterator it(l.pHead, 3);          // 49
+      // exercise
+      it = l.insert(it, Spy(99));
+      // verify
+      assertUnit(*it == Spy(99));
+      assertUnit(it.i == 1);
+      assertUnit(l.size() == 7);
+      assertLayout(l, { { 11, 26 }, { 31, 99, 49 }, { 67, 83 } });
+   }  // teardown
+
+   // insert at the end goes to the tail
+   void test_insert_end()
+   {  // setup
+      List l;
+      setupStandardFixture(l);
+      // exercise
+      auto it = l.insert(l.end(), Spy(99));
+      // verify
+      assertUnit(it.p == l.pTail);
+      assertUnit(*it == Spy(99));
+      assertLayout(l, { { 11, 26, 31, 49 }, { 67, 83, 99 } });
+   }  // teardown
+
+   // the new element is a copy of one that moves to make room
+   void test_insert_alias()
+   {  // setup
+      List l;
+      setupStandardFixture(l);                // { 11, 26, 31, 49 }, { 67, 83 }
+      List::iterator it(l.pHead, 1);          // 26
+      // exercise
+      it = l.insert(it, *it);                 // split, then slide [26] up
+      l.push_front(l.front());                // slide [11] up
+      l.push_front(l.front());                // split, then slide [11] up
+      // verify
+      assertUnit(l.size() == 9);
+      assertLayout(l, { { 11, 11, 11 }, { 26, 26 }, { 31, 49 }, { 67, 83 } });
+   }  // teardown
+
+   /***************************************
+    * ERASE
+    ***************************************/
+
+   // erase the only element of a node: the node goes away
+   void test_erase_emptyNode()
+   {  // setup
+      List l;
+      for (int value : { 11, 26, 31, 49, 67 })
+         l.push_back(Spy(value));
+      List::iterator it(l.pTail, 0);          // 67
+      // exercise
+      it = l.erase(it);
+      // verify
+      assertUnit(it == l.end());
+      assertUnit(l.pHead == l.pTail);
+      assertLayout(l, { { 11, 26, 31, 49 } });
+   }  // teardown
+
+   // a node that drops below half full takes in its neighbor
+   void test_erase_merge()
+   {  // setup
+      List l;
+      setupStandardFixture(l);
+      l.erase(List::iterator(l.pHead, 3));    // { 11, 26, 31 }, { 67, 83 }
+      l.erase(List::iterator(l.pHead, 2));    // { 11, 26 }, { 67, 83 }
+      // exercise
+      auto it = l.erase(List::iterator(l.pHead, 1));
+      // verify
+      assertUnit(*it == Spy(67));
+      assertUnit(it.p == l.pHead);
+      assertLayout(l, { { 11, 67, 83 } });
+   }  // teardown
+
+   // erase the last element of the list
+   void test_erase_last()
+   {  // setup
+      List l;
+      l.push_back(Spy(11));
+      Spy::reset();
+      // exercise
+      auto it = l.erase(l.begin());
+      // verify
+      assertUnit(Spy::numDestructor() == 1);
+      assertUnit(it == l.end());
+      assertUnit(l.empty());
+      assertUnit(l.pHead == nullptr);
+      assertUnit(l.pTail == nullptr);
+   }  // teardown
+
+   // pop the front of the standard fixture
+   void test_popFront_standard()
+   {  // setup
+      List l;
+      setupStandardFixture(l);
+      // exercise
+      l.pop_front();
+      // verify
+      assertUnit(l.front() == Spy(26));
+      assertLayout(l, { { 26, 31, 49 }, { 67, 83 } });
+   }  // teardown
+
+   // pop the back of the standard fixture
+   void test_popBack_standard()
+   {  // setup
+      List l;
+      setupStandardFixture(l);
+      // exercise
+      l.pop_back();
+      l.pop_back();
+      // verify
+      assertUnit(l.back() == Spy(49));
+      assertLayout(l, { { 11, 26, 31, 49 } });
+   }  // teardown
+
+   // clear the standard fixture
+   void test_clear_standard()
+   {  // setup
+      List l;
+      setupStandardFixture(l);
+      Spy::reset();
+      // exercise
+      l.clear();
+      // verify
+      assertUnit(Spy::numDestructor() == 6);
+      assertUnit(Spy::numDelete() == 6);
+      assertUnit(l.empty());
+      assertUnit(l.size() == 0);
+      assertUnit(l.pHead == nullptr);
+      assertUnit(l.pTail == nullptr);
+   }  // teardown
+
+   /***************************************
+    * ALLOCATOR
+    ***************************************/
+
+   // every node comes from and goes back to the allocator
+   void test_allocator_nodes()
+   {  // setup
+      CountingAllocatorBase::reset();
+      {
+         custom::unrolled_list<int, CountingAllocator<int>, 4> l;
+         for (int value : { 11, 26, 31, 49, 67 })
+            l.push_back(value);                // { 11, 26, 31, 49 }, { 67 }
+         // exercise
+         l.pop_back();
+         // verify
+         assertUnit(CountingAllocatorBase::numAllocate() == 2);
+         assertUnit(CountingAllocatorBase::numDeallocate() == 1);
+         assertUnit(l.size() == 4);
+      }  // teardown
+      assertUnit(CountingAllocatorBase::numDeallocate() == 2);
+   }
+
+   /***************************************
+    * AGAINST STD::LIST
+    ***************************************/
+
+   // a long run of random inserts and erases matches std::list
+   void test_random_againstStdList()
+   {  // setup
+      custom::unrolled_list<int, std::allocator<int>, 4> l;
+      std::list<int> lStd;
+      std::srand(232);
+      bool fSame = true;
+      // exercise
+      for (int round = 0; round < 5000; round++)
+      {
+         size_t pos = lStd.empty() ? 0 : (size_t)std::rand() % (lStd.size() + 1);
+         auto it = l.begin();
+         auto itStd = lStd.begin();
+         for (size_t i = 0; i < pos; i++, ++it, ++itStd)
+            ;
+
+         if (std::rand() % 3 != 0 || itStd == lStd.end())
+         {
+            it = l.insert(it, round);
+            itStd = lStd.insert(itStd, round);
+         }
+         else
+         {
+            it = l.erase(it);
+            itStd = lStd.erase(itStd);
+         }
+         fSame = fSame && (it == l.end()) == (itStd == lStd.end());
+         fSame = fSame && (it == l.end() || *it == *itStd);
+      }
+      // verify
+      assertUnit(fSame);
+      assertUnit(l.size() == lStd.size());
+      std::vector<int> values;
+      for (auto it = l.begin(); it != l.end(); ++it)
+         values.push_back(*it);
+      assertUnit(values == std::vector<int>(lStd.begin(), lStd.end()));
+   }  // teardown
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *      +----+----+----+----+   +----+----+
+    *      | 11 | 26 | 31 | 49 | - | 67 | 83 |
+    *      +----+----+----+----+   +----+----+
+    *************************************************************/
+   void setupStandardFixture(List& l)
+   {
+      for (int value : { 11, 26, 31, 49, 67, 83 })
+         l.push_back(Spy(value));
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *************************************************************/
+   void assertStandardFixtureParameters(const List& l, int line, const char* function)
+   {
+      assertLayoutParameters(l, { { 11, 26, 31, 49 }, { 67, 83 } }, line, function);
+   }
+
+   /*************************************************************
+    * VERIFY LAYOUT
+    * Every node, in order, with its elements and its links
+    *************************************************************/
+   void assertLayoutParameters(const List& l, const std::vector<std::vector<int>>& layout,
+                               int line, const char* function)
+   {
+      size_t num = 0;
+      List::Node* pPrev = nullptr;
+      List::Node* p = l.pHead;
+      for (const auto& node : layout)
+      {
+         assertIndirect(p != nullptr);
+         if (!p)
+            return;
+         assertIndirect(p->pPrev == pPrev);
+         assertIndirect(p->count == node.size());
+         for (size_t i = 0; i < node.size() && i < p->count; i++)
+            assertIndirect(p->data()[i] == Spy(node[i]));
+         num += node.size();
+         pPrev = p;
+         p = p->pNext;
+      }
+      assertIndirect(p == nullptr);
+      assertIndirect(l.pTail == pPrev);
+      assertIndirect(l.numElements == num);
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,638 @@
+/***********************************************************************
+ * Header:
+ *    UNROLLED LIST
+ * Summary:
+ *    A variation of our std::list where every node holds a small array
+ *    of elements instead of just one. Walking the list then touches one
+ *    node per handful of elements rather than one node per element.
+ *
+ *    This will contain the class definition of:
+ *        unrolled_list           : A list of small arrays
+ *        unrolled_list::iterator : An iterator through unrolled_list
+ *
+ *    The elements of a node are packed at the front of its array. A full
+ *    node is split in half to make room for an insert, and a node that
+ *    drops below half full after an erase absorbs its neighbor when they
+ *    fit together. Unlike list, an insert or erase invalidates iterators
+ *    to the other elements of the nodes it touches.
+ * Author
+ *    David Schaad, Tori Tremelling
+ ************************************************************************/
+
+#pragma once
+#include <cassert>     // for ASSERT
+#include <cstddef>     // for size_t
+#include <new>         // for placement new
+#include <memory>      // for std::allocator
+#include <initializer_list>
+#include <utility>     // for std::move and std::forward
+
+class TestUnrolledList; // forward declaration for unit tests
+
+namespace custom
+{
+
+   /**************************************************
+    * UNROLLED LIST
+    * Just like list, but N elements to a node. By default
+    * a node holds about 64 bytes of elements, and never
+    * fewer than four of them.
+    **************************************************/
+   template <typename T, typename A = std::allocator<T>,
+             size_t N = (64 / sizeof(T) > 4 ? 64 / sizeof(T) : 4)>
+   class unrolled_list
+   {
+      friend class ::TestUnrolledList; // give unit tests access to the privates
+      static_assert(N >= 2, "a node must hold at least two elements");
+   public:
+
+      //
+      // Construct
+      //
+
+      unrolled_list(const A& a = A()) : alloc(a), numElements(0), pHead(nullptr), pTail(nullptr) {}
+      unrolled_list(const unrolled_list& rhs, const A& a = A()) : alloc(a), numElements(0), pHead(nullptr), pTail(nullptr)
+      {
+         for (const auto& item : rhs)
+            push_back(item);
+      }
+      // the nodes stay with rhs's allocator, so a goes unused
+      unrolled_list(unrolled_list&& rhs, const A& /* a */ = A()) :
+         alloc(rhs.alloc), numElements(rhs.numElements), pHead(rhs.pHead), pTail(rhs.pTail)
+      {
+         rhs.pHead = rhs.pTail = nullptr;
+         rhs.numElements = 0;
+      }
+      unrolled_list(size_t num, const T& t, const A& a = A()) : alloc(a), numElements(0), pHead(nullptr), pTail(nullptr)
+      {
+         for (size_t i = 0; i < num; i++)
+            push_back(t);
+      }
+      unrolled_list(const std::initializer_list<T>& il, const A& a = A()) : alloc(a), numElements(0), pHead(nullptr), pTail(nullptr)
+      {
+         for (const auto& item : il)
+            push_back(item);
+      }
+      template <class Iterator>
+      unrolled_list(Iterator first, Iterator last, const A& a = A()) : alloc(a), numElements(0), pHead(nullptr), pTail(nullptr)
+      {
+         for (auto it = first; it != last; ++it)
+            push_back(*it);
+      }
+      ~unrolled_list()
+      {
+         clear();
+      }
+
+      //
+      // Assign
+      //
+
+      unrolled_list& operator = (const unrolled_list& rhs);
+      unrolled_list& operator = (unrolled_list&& rhs)
+      {
+         clear();
+         swap(rhs);
+         return *this;
+      }
+      unrolled_list& operator = (const std::initializer_list<T>& il);
+      void swap(unrolled_list& rhs)
+      {
+         std::swap(rhs.pHead, pHead);
+         std::swap(rhs.pTail, pTail);
+         std::swap(rhs.numElements, numElements);
+         std::swap(rhs.alloc, alloc);
+      }
+
+      //
+      // Iterator
+      //
+
+      class iterator;
+      iterator begin() const { return iterator(pHead, 0); }
+      iterator rbegin() const { return pTail ? iterator(pTail, pTail->count - 1) : end(); }
+      iterator end() const { return iterator(nullptr, 0); }
+
+      //
+      // Access
+      //
+
+      T& front();
+      T& back();
+
+      //
+      // Insert
+      //
+
+      void push_front(const T& data) { insertAt(pHead, 0, data); }
+      void push_front(T&& data)      { insertAt(pHead, 0, std::move(data)); }
+      void push_back(const T& data)  { insertAt(nullptr, 0, data); }
+      void push_back(T&& data)       { insertAt(nullptr, 0, std::move(data)); }
+      iterator insert(iterator it, const T& data) { return insertAt(it.p, it.i, data); }
+      iterator insert(iterator it, T&& data)      { return insertAt(it.p, it.i, std::move(data)); }
+
+      //
+      // Remove
+      //
+
+      void pop_back()  { if (pTail) erase(rbegin()); }
+      void pop_front() { if (pHead) erase(begin()); }
+      void clear();
+      iterator erase(const iterator& it);
+
+      //
+      // Status
+      //
+
+      bool empty()  const { return !pHead; }
+      size_t size() const { return numElements; }
+
+   private:
+      // nested node class
+      class Node;
+
+      template <class U>
+      iterator insertAt(Node* p, size_t i, U&& data);
+      Node* split(Node* p);
+      void merge(Node* p);
+      void unlink(Node* p);
+
+      // the allocator, rebound to hand out whole nodes
+      using NodeAlloc  = typename std::allocator_traits<A>::template rebind_alloc<Node>;
+      using NodeTraits = std::allocator_traits<NodeAlloc>;
+
+      Node* allocate();
+      void deallocate(Node* p);
+
+      // member variables
+      NodeAlloc alloc;    // use allocator for memory allocation
+      size_t numElements; // total number of elements in every node
+      Node* pHead;        // pointer to the first node
+      Node* pTail;        // pointer to the last node
+   };
+
+   /*************************************************
+    * UNROLLED LIST NODE
+    * Up to N elements, built in place, packed at the
+    * front of the array
+    *************************************************/
+   template <typename T, typename A, size_t N>
+   class unrolled_list <T, A, N> ::Node
+   {
+   public:
+      Node() : count(0), pNext(nullptr), pPrev(nullptr) {}
+
+      T* data() { return reinterpret_cast<T*>(storage); }
+
+      size_t count;       // number of elements in use
+      Node* pNext;        // pointer to next node
+      Node* pPrev;        // pointer to previous node
+      alignas(T) unsigned char storage[N * sizeof(T)]; // the elements themselves
+   };
+
+   /*************************************************
+    * UNROLLED LIST ITERATOR
+    * A node and a position within that node
+    ************************************************/
+   template <typename T, typename A, size_t N>
+   class unrolled_list <T, A, N> ::iterator
+   {
+      friend class ::TestUnrolledList; // give unit tests access to the privates
+      template <typename TT, typename AA, size_t NN>
+      friend class custom::unrolled_list;
+
+   public:
+      // constructors, destructors, and assignment operator
+      iterator() : p(nullptr), i(0) {}
+      iterator(Node* pRHS, size_t iRHS) : p(pRHS), i(iRHS) {}
+      iterator(const iterator& rhs) : p(rhs.p), i(rhs.i) {}
+
+      iterator& operator = (const iterator& rhs)
+      {
+         p = rhs.p;
+         i = rhs.i;
+         return *this;
+      }
+
+      // equals, not equals operator
+      bool operator == (const iterator& rhs) const { return p == rhs.p && i == rhs.i; }
+      bool operator != (const iterator& rhs) const { return !(*this == rhs); }
+
+      // dereference operator, fetch an element
+      T& operator * ()
+      {
+         return p->data()[i];
+      }
+
+      // postfix increment
+      iterator operator ++ (int postfix)
+      {
+         iterator tmp = *this;
+         ++(*this);
+         return tmp;
+      }
+
+      // prefix increment: the next slot, or the start of the next node
+      iterator& operator ++ ()
+      {
+         if (++i == p->count)
+         {
+            p = p->pNext;
+            i = 0;
+         }
+         return *this;
+      }
+
+      // postfix decrement
+      iterator operator -- (int postfix)
+      {
+         iterator tmp = *this;
+         --(*this);
+         return tmp;
+      }
+
+      // prefix decrement: the previous slot, or the end of the previous node
+      iterator& operator -- ()
+      {
+         if (i > 0)
+            --i;
+         else
+         {
+            p = p->pPrev;
+            i = p ? p->count - 1 : 0;
+         }
+         return *this;
+      }
+
+   private:
+
+      Node* p;    // the node we are in
+      size_t i;   // our slot in that node
+   };
+
+   /**********************************************
+    * UNROLLED LIST :: assignment operator
+    * Copy one list onto another, reusing the
+    * elements we already have
+    *     INPUT  : a list to be copied
+    *     OUTPUT :
+    *     COST   : O(n)
+    *********************************************/
+   template <typename T, typename A, size_t N>
+   unrolled_list <T, A, N>& unrolled_list <T, A, N> :: operator = (const unrolled_list& rhs)
+   {
+      if (this == &rhs)
+         return *this;
+
+      auto itRHS = rhs.begin();
+      auto itLHS = begin();
+
+      // While both lists still have elements, replace the data of those elements
+      while (itRHS != rhs.end() && itLHS != end())
+      {
+         *itLHS = *itRHS;
+         ++itRHS;
+         ++itLHS;
+      }
+
+      // If there are still elements in the rhs, add them to the lhs
+      while (itRHS != rhs.end())
+      {
+         push_back(*itRHS);
+         ++itRHS;
+      }
+
+      // If there are still elements in the lhs, remove them from the back
+      while (numElements > rhs.numElements)
+         pop_back();
+
+      return *this;
+   }
+
+   /**********************************************
+    * UNROLLED LIST :: assignment operator
+    * Copy an initializer list onto the list
+    *     INPUT  : the values to be copied
+    *     OUTPUT :
+    *     COST   : O(n)
+    *********************************************/
+   template <typename T, typename A, size_t N>
+   unrolled_list <T, A, N>& unrolled_list <T, A, N> :: operator = (const std::initializer_list<T>& il)
+   {
+      auto itRHS = il.begin();
+      auto itLHS = begin();
+
+      while (itRHS != il.end() && itLHS != end())
+      {
+         *itLHS = *itRHS;
+         ++itRHS;
+         ++itLHS;
+      }
+
+      while (itRHS != il.end())
+      {
+         push_back(*itRHS);
+         ++itRHS;
+      }
+
+      while (numElements > il.size())
+         pop_back();
+
+      return *this;
+   }
+
+   /**********************************************
+    * UNROLLED LIST :: CLEAR
+    * Remove all the items currently in the list
+    *     COST   : O(n)
+    *********************************************/
+   template <typename T, typename A, size_t N>
+   void unrolled_list <T, A, N> ::clear()
+   {
+      Node* p = pHead;
+      while (p != nullptr)
+      {
+         Node* pNext = p->pNext;
+         for (size_t i = 0; i < p->count; i++)
+            p->data()[i].~T();
+         deallocate(p);
+         p = pNext;
+      }
+      pHead = pTail = nullptr;
+      numElements = 0;
+   }
+
+   /*********************************************
+    * UNROLLED LIST :: FRONT
+    * retrieves the first element in the list
+    *     COST   : O(1)
+    *********************************************/
+   template <typename T, typename A, size_t N>
+   T& unrolled_list <T, A, N> ::front()
+   {
+      if (!empty())
+         return pHead->data()[0];
+      throw("ERROR: unable to access data from an empty list");
+   }
+
+   /*********************************************
+    * UNROLLED LIST :: BACK
+    * retrieves the last element in the list
+    *     COST   : O(1)
+    *********************************************/
+   template <typename T, typename A, size_t N>
+   T& unrolled_list <T, A, N> ::back()
+   {
+      if (!empty())
+         return pTail->data()[pTail->count - 1];
+      throw("ERROR: unable to access data from an empty list");
+   }
+
+   /******************************************
+    * UNROLLED LIST :: INSERT AT
+    * Put a new element in front of slot i of node p.
+    * A null p means the end of the list. data may be
+    * one of our own elements, so unless the new one
+    * goes on the end of a node, where nothing moves,
+    * it is built before anything else is touched
+    *     INPUT  : the position and the data
+    *     OUTPUT : iterator to the new item
+    *     COST   : O(N)
+    ******************************************/
+   template <typename T, typename A, size_t N>
+   template <class U>
+   typename unrolled_list <T, A, N> ::iterator unrolled_list <T, A, N> ::insertAt(Node* p, size_t i, U&& data)
+   {
+      // At the end, we go after the last element of the last node
+      if (!p)
+      {
+         if (!pTail || pTail->count == N)
+         {
+            Node* pNew = allocate();
+            try
+            {
+               new (pNew->data()) T(std::forward<U>(data));
+            }
+            catch (...)
+            {
+               deallocate(pNew);
+               throw;
+            }
+            pNew->count = 1;
+            pNew->pPrev = pTail;
+            if (pTail)
+               pTail->pNext = pNew;
+            else
+               pHead = pNew;
+            pTail = pNew;
+            numElements++;
+            return iterator(pNew, 0);
+         }
+         p = pTail;
+         i = p->count;
+      }
+
+      // No room at the front of this node, but some at the end of the last
+      else if (p->count == N && i == 0 && p->pPrev && p->pPrev->count < N)
+      {
+         p = p->pPrev;
+         i = p->count;
+      }
+
+      // Room at the end of the node: nothing else moves
+      if (i == p->count && p->count < N)
+      {
+         new (p->data() + i) T(std::forward<U>(data));
+         p->count++;
+         numElements++;
+         return iterator(p, i);
+      }
+
+      T value(std::forward<U>(data));
+
+      // No room here at all: split this node
+      if (p->count == N)
+      {
+         Node* pNew = split(p);
+         if (i > p->count)
+         {
+            i -= p->count;
+            p = pNew;
+         }
+      }
+
+      // Open a hole at slot i by sliding the rest up one
+      T* pData = p->data();
+      if (i < p->count)
+      {
+         new (pData + p->count) T(std::move(pData[p->count - 1]));
+         p->count++;
+         for (size_t j = p->count - 2; j > i; j--)
+            pData[j] = std::move(pData[j - 1]);
+         pData[i] = std::move(value);
+      }
+      else
+      {
+         new (pData + i) T(std::move(value));
+         p->count++;
+      }
+
+      numElements++;
+      return iterator(p, i);
+   }
+
+   /******************************************
+    * UNROLLED LIST :: SPLIT
+    * Move the back half of a full node into a new
+    * node right after it
+    *     INPUT  : the full node
+    *     OUTPUT : the new node
+    *     COST   : O(N)
+    ******************************************/
+   template <typename T, typename A, size_t N>
+   typename unrolled_list <T, A, N> ::Node* unrolled_list <T, A, N> ::split(Node* p)
+   {
+      Node* pNew = allocate();
+
+      size_t keep = p->count / 2;
+      for (size_t j = keep; j < p->count; j++)
+      {
+         new (pNew->data() + (j - keep)) T(std::move(p->data()[j]));
+         p->data()[j].~T();
+      }
+      pNew->count = p->count - keep;
+      p->count = keep;
+
+      pNew->pPrev = p;
+      pNew->pNext = p->pNext;
+      if (p->pNext)
+         p->pNext->pPrev = pNew;
+      else
+         pTail = pNew;
+      p->pNext = pNew;
+
+      return pNew;
+   }
+
+   /******************************************
+    * UNROLLED LIST :: MERGE
+    * Move every element of the next node onto the
+    * end of this one and drop the next node
+    *     COST   : O(N)
+    ******************************************/
+   template <typename T, typename A, size_t N>
+   void unrolled_list <T, A, N> ::merge(Node* p)
+   {
+      Node* pNext = p->pNext;
+      assert(pNext && p->count + pNext->count <= N);
+
+      for (size_t j = 0; j < pNext->count; j++)
+      {
+         new (p->data() + p->count + j) T(std::move(pNext->data()[j]));
+         pNext->data()[j].~T();
+      }
+      p->count += pNext->count;
+      pNext->count = 0;
+
+      unlink(pNext);
+      deallocate(pNext);
+   }
+
+   /******************************************
+    * UNROLLED LIST :: UNLINK
+    * Take an empty node out of the chain
+    *     COST   : O(1)
+    ******************************************/
+   template <typename T, typename A, size_t N>
+   void unrolled_list <T, A, N> ::unlink(Node* p)
+   {
+      if (p->pNext)
+         p->pNext->pPrev = p->pPrev;
+      else
+         pTail = p->pPrev;
+
+      if (p->pPrev)
+         p->pPrev->pNext = p->pNext;
+      else
+         pHead = p->pNext;
+   }
+
+   /******************************************
+    * UNROLLED LIST :: ERASE
+    * remove an item from the middle of the list
+    *     INPUT  : an iterator to the item being removed
+    *     OUTPUT : iterator to the item after it
+    *     COST   : O(N)
+    ******************************************/
+   template <typename T, typename A, size_t N>
+   typename unrolled_list <T, A, N> ::iterator unrolled_list <T, A, N> ::erase(const iterator& it)
+   {
+      // We don't want to erase if the iterator is invalid (nullptr)
+      if (it == end())
+         return end();
+
+      Node* p = it.p;
+      size_t i = it.i;
+      T* pData = p->data();
+
+      // Slide everything after slot i down one
+      for (size_t j = i; j + 1 < p->count; j++)
+         pData[j] = std::move(pData[j + 1]);
+      pData[p->count - 1].~T();
+      p->count--;
+      numElements--;
+
+      // An empty node leaves the chain
+      if (p->count == 0)
+      {
+         Node* pNext = p->pNext;
+         unlink(p);
+         deallocate(p);
+         return iterator(pNext, 0);
+      }
+
+      // A thin node absorbs its neighbor when they fit together
+      if (p->count < N / 2 && p->pNext && p->count + p->pNext->count <= N)
+         merge(p);
+
+      if (i < p->count)
+         return iterator(p, i);
+      return iterator(p->pNext, 0);
+   }
+
+   /******************************************
+    * UNROLLED LIST :: ALLOCATE
+    * Get an empty node from the allocator
+    *     COST   : O(1)
+    ******************************************/
+   template <typename T, typename A, size_t N>
+   typename unrolled_list <T, A, N> ::Node* unrolled_list <T, A, N> ::allocate()
+   {
+      Node* pNew = NodeTraits::allocate(alloc, 1);
+      NodeTraits::construct(alloc, pNew);
+      return pNew;
+   }
+
+   /******************************************
+    * UNROLLED LIST :: DEALLOCATE
+    * Give an empty node back to the allocator
+    *     COST   : O(1)
+    ******************************************/
+   template <typename T, typename A, size_t N>
+   void unrolled_list <T, A, N> ::deallocate(Node* p)
+   {
+      NodeTraits::destroy(alloc, p);
+      NodeTraits::deallocate(alloc, p, 1);
+   }
+
+   /**********************************************
+    * SWAP
+    * Swap two unrolled lists
+    *********************************************/
+   template <typename T, typename A, size_t N>
+   void swap(unrolled_list <T, A, N>& lhs, unrolled_list <T, A, N>& rhs)
+   {
+      lhs.swap(rhs);
+   }
+
+}; // namespace custom